@@ -0,0 +1,71 @@
+#include "benchjvm.h"
+#include <iostream>
+#include <vector>
+
+JavaVM* BenchJvm::s_vm = nullptr;
+JNIEnv* BenchJvm::s_env = nullptr;
+
+JNIEnv* BenchJvm::start(const std::string& classPath, const std::string& libraryPath)
+{
+    if (s_vm != nullptr) {
+        return s_env;
+    }
+
+    std::string classPathOption = "-Djava.class.path=" + classPath;
+    std::string libraryPathOption = "-Djava.library.path=" + libraryPath;
+
+    std::vector<JavaVMOption> options(2);
+    options[0].optionString = const_cast<char*>(classPathOption.c_str());
+    options[1].optionString = const_cast<char*>(libraryPathOption.c_str());
+
+    JavaVMInitArgs args;
+    args.version = JNI_VERSION_1_8;
+    args.nOptions = static_cast<jint>(options.size());
+    args.options = options.data();
+    args.ignoreUnrecognized = JNI_FALSE;
+
+    if (JNI_CreateJavaVM(&s_vm, reinterpret_cast<void**>(&s_env), &args) != JNI_OK) {
+        std::cerr << "[BENCH] ERROR: JNI_CreateJavaVM failed" << std::endl;
+        s_vm = nullptr;
+        s_env = nullptr;
+        return nullptr;
+    }
+
+    return s_env;
+}
+
+jobjectArray BenchJvm::stringArray(JNIEnv* env, const char* const* values, int count)
+{
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray array = env->NewObjectArray(count, stringClass, nullptr);
+
+    for (int i = 0; i < count; ++i) {
+        jstring value = env->NewStringUTF(values[i]);
+        env->SetObjectArrayElement(array, i, value);
+        env->DeleteLocalRef(value);
+    }
+
+    env->DeleteLocalRef(stringClass);
+    return array;
+}
+
+jobject BenchJvm::newInstance(JNIEnv* env, const char* className)
+{
+    jclass cls = env->FindClass(className);
+    if (cls == nullptr) {
+        std::cerr << "[BENCH] ERROR: Class not found: " << className << std::endl;
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+        return nullptr;
+    }
+
+    jmethodID ctor = env->GetMethodID(cls, "<init>", "()V");
+    jobject instance = ctor ? env->NewObject(cls, ctor) : nullptr;
+    if (instance == nullptr) {
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+    }
+
+    env->DeleteLocalRef(cls);
+    return instance;
+}
@@ -0,0 +1,48 @@
+#ifndef BENCHJVM_H
+#define BENCHJVM_H
+
+#include <jni.h>
+#include <string>
+
+/**
+ * Embedded JVM for native benchmark executables.
+ *
+ * The bridge normally lives inside a JVM that loaded libqmlbridge.
+ * Benchmarks invert that: the executable links the bridge and starts
+ * its own JVM with JNI_CreateJavaVM, so natives can be called directly
+ * with a real JNIEnv.
+ */
+class BenchJvm
+{
+public:
+    /**
+     * Create the JVM (once per process).
+     *
+     * @param classPath Classpath containing qml.Bridge and bench helpers
+     * @param libraryPath java.library.path (directory of libqmlbridge)
+     * @return JNIEnv for the calling thread, or nullptr on failure
+     */
+    static JNIEnv* start(const std::string& classPath, const std::string& libraryPath);
+
+    static JavaVM* vm() { return s_vm; }
+    static JNIEnv* env() { return s_env; }
+
+    /**
+     * Build a Java String[] from C strings.
+     */
+    static jobjectArray stringArray(JNIEnv* env, const char* const* values, int count);
+
+    /**
+     * Instantiate a Java class through its no-arg constructor.
+     *
+     * @param className JNI class name, e.g. "qml/bench/NoopSignalHandler"
+     * @return Local reference, or nullptr on failure
+     */
+    static jobject newInstance(JNIEnv* env, const char* className);
+
+private:
+    static JavaVM* s_vm;
+    static JNIEnv* s_env;
+};
+
+#endif // BENCHJVM_H
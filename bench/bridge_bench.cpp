@@ -0,0 +1,417 @@
+/**
+ * cuirq_bench - microbenchmarks for the bridge hot paths.
+ *
+ * Runs headless (-platform offscreen) against an embedded JVM and writes
+ * Google Benchmark JSON to stdout, so results can be diffed across
+ * versions (e.g. with benchmark's tools/compare.py).
+ *
+ * Bridge log output is discarded while benchmarks run: it is still
+ * formatted (so its cost is measured) but never reaches the terminal.
+ *
+ * Usage:
+ *   cuirq_bench [--benchmark_filter=<regex>] [--benchmark_out=results.json]
+ */
+
+#include "benchjvm.h"
+#include "qmlbridge.h"
+#include "jvmlistmodel.h"
+#include "signalforwarder.h"
+#include "qmlwatcher.h"
+#include "seriespyramid.h"
+#include "spatialindex.h"
+
+#include <benchmark/benchmark.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QPolygonF>
+#include <QQmlApplicationEngine>
+#include <QString>
+#include <QTemporaryDir>
+#include <QVariantList>
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Swallows everything written to it (used to mute std::cout)
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char* /* s */, std::streamsize n) override { return n; }
+};
+
+void discardQtMessages(QtMsgType, const QMessageLogContext&, const QString&)
+{
+}
+
+// Build a JSON array of `rows` objects shaped like a typical todo/file list
+QString makeJsonRows(int rows)
+{
+    QString json;
+    json.reserve(rows * 64);
+    json.append('[');
+    for (int i = 0; i < rows; ++i) {
+        if (i > 0) {
+            json.append(',');
+        }
+        json.append(QStringLiteral("{\"id\":%1,\"name\":\"Item %1\",\"done\":%2,\"score\":%3}")
+                        .arg(i)
+                        .arg(i % 2 == 0 ? QStringLiteral("true") : QStringLiteral("false"))
+                        .arg(i * 0.5));
+    }
+    json.append(']');
+    return json;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// JNI marshaling
+// ---------------------------------------------------------------------------
+
+static void BM_JstringToStdString(benchmark::State& state)
+{
+    JNIEnv* env = BenchJvm::env();
+    std::string payload(static_cast<size_t>(state.range(0)), 'x');
+    jstring jstr = env->NewStringUTF(payload.c_str());
+
+    for (auto _ : state) {
+        std::string result = jstringToStdString(env, jstr);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    env->DeleteLocalRef(jstr);
+}
+BENCHMARK(BM_JstringToStdString)->Arg(16)->Arg(256)->Arg(4096)->Arg(65536);
+
+static void BM_SetContextProperty(benchmark::State& state)
+{
+    JNIEnv* env = BenchJvm::env();
+    jstring name = env->NewStringUTF("benchValue");
+    jstring values[2] = { env->NewStringUTF("hello"), env->NewStringUTF("world") };
+
+    int i = 0;
+    for (auto _ : state) {
+        Java_qml_Bridge_setContextProperty(env, nullptr, name, values[i++ & 1]);
+    }
+
+    env->DeleteLocalRef(values[1]);
+    env->DeleteLocalRef(values[0]);
+    env->DeleteLocalRef(name);
+}
+BENCHMARK(BM_SetContextProperty);
+
+// ---------------------------------------------------------------------------
+// JvmListModel
+// ---------------------------------------------------------------------------
+
+static void BM_ModelSetJsonData(benchmark::State& state)
+{
+    const int rows = static_cast<int>(state.range(0));
+    const QString json = makeJsonRows(rows);
+    JvmListModel model;
+
+    for (auto _ : state) {
+        model.setJsonData(json);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(state.iterations() * json.size() * static_cast<int64_t>(sizeof(QChar)));
+}
+BENCHMARK(BM_ModelSetJsonData)->Arg(10)->Arg(1000)->Arg(10000)->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ModelData(benchmark::State& state)
+{
+    const int rows = static_cast<int>(state.range(0));
+    JvmListModel model;
+    model.setJsonData(makeJsonRows(rows));
+    const QList<int> roles = model.roleNames().keys();
+
+    int row = 0;
+    for (auto _ : state) {
+        const QModelIndex index = model.index(row, 0);
+        for (int role : roles) {
+            QVariant value = model.data(index, role);
+            benchmark::DoNotOptimize(value);
+        }
+        row = (row + 1) % rows;
+    }
+
+    state.SetItemsProcessed(state.iterations() * roles.size());
+}
+BENCHMARK(BM_ModelData)->Arg(1000)->Arg(100000);
+
+// data() on the GUI thread while a worker keeps publishing fresh rows;
+// pending snapshots are adopted every `rows` reads, as the event loop would
+static void BM_ModelDataWhilePublishing(benchmark::State& state)
+{
+    const int rows = static_cast<int>(state.range(0));
+    const QString json = makeJsonRows(rows);
+    JvmListModel model;
+    model.setJsonData(json);
+    const QList<int> roles = model.roleNames().keys();
+
+    std::atomic<bool> stop{false};
+    std::thread producer([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            model.setJsonData(json);
+        }
+    });
+
+    int row = 0;
+    for (auto _ : state) {
+        const QModelIndex index = model.index(row, 0);
+        for (int role : roles) {
+            QVariant value = model.data(index, role);
+            benchmark::DoNotOptimize(value);
+        }
+        if (++row == rows) {
+            row = 0;
+            QCoreApplication::processEvents();
+        }
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+    QCoreApplication::processEvents();
+
+    state.SetItemsProcessed(state.iterations() * roles.size());
+}
+BENCHMARK(BM_ModelDataWhilePublishing)->Arg(1000)->Arg(10000);
+
+// One keyed patch while a snapshot of the rows is held, as a background
+// sort or export would: the edit copies one chunk, not the whole model
+static void BM_ModelPatchWithSnapshot(benchmark::State& state)
+{
+    const int rows = static_cast<int>(state.range(0));
+    JvmListModel model;
+    model.setJsonData(makeJsonRows(rows));
+    model.setKeyRole(QStringLiteral("id"));
+
+    int row = 0;
+    for (auto _ : state) {
+        const RowStore snapshot = model.rows();
+        model.patch(QString::number(row), QStringLiteral("score"), row);
+        benchmark::DoNotOptimize(snapshot.size());
+        row = (row + 7919) % rows;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ModelPatchWithSnapshot)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+// ---------------------------------------------------------------------------
+// SpatialIndex (NodeCanvas hit-testing)
+// ---------------------------------------------------------------------------
+
+// 120x60 items on a jittered grid, 224 units apart
+static void fillGrid(SpatialIndex& index, int items)
+{
+    const int columns = 256;
+    for (int i = 0; i < items; ++i) {
+        const qreal jitter = (i * 7919 % 97) - 48;
+        index.insert(i, QRectF((i % columns) * 224 + jitter, (i / columns) * 224 - jitter, 120, 60));
+    }
+}
+
+static void BM_SpatialIndexMove(benchmark::State& state)
+{
+    const int items = static_cast<int>(state.range(0));
+    SpatialIndex index;
+    fillGrid(index, items);
+
+    int i = 0;
+    qreal offset = 0;
+    for (auto _ : state) {
+        QRectF rect = index.rect(i);
+        rect.translate(offset, -offset);
+        index.insert(i, rect);
+        offset = offset == 0 ? 3 : -offset;
+        i = (i + 1) % items;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndexMove)->Arg(50000);
+
+static void BM_SpatialIndexLasso(benchmark::State& state)
+{
+    const int items = static_cast<int>(state.range(0));
+    SpatialIndex index;
+    fillGrid(index, items);
+
+    // Roughly 1200x900 lasso (a viewport-sized selection)
+    QPolygonF lasso;
+    for (int p = 0; p < 32; ++p) {
+        const qreal angle = 2 * 3.14159265358979 * p / 32;
+        lasso << QPointF(6000 + 600 * std::cos(angle), 5000 + 450 * std::sin(angle));
+    }
+
+    size_t hits = 0;
+    for (auto _ : state) {
+        const QVector<int> selected = index.insidePolygon(lasso);
+        hits = selected.size();
+        benchmark::DoNotOptimize(selected.data());
+    }
+    state.counters["hits"] = static_cast<double>(hits);
+}
+BENCHMARK(BM_SpatialIndexLasso)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+// ---------------------------------------------------------------------------
+// SeriesPyramid (TimeSeriesChart decimation)
+// ---------------------------------------------------------------------------
+
+static void fillWalk(SeriesPyramid& series, int points)
+{
+    QVector<double> y(points);
+    double value = 0;
+    for (int i = 0; i < points; ++i) {
+        value += ((i * 7919) % 201 - 100) / 100.0;
+        y[i] = value;
+    }
+    series.append(nullptr, y.constData(), points);
+}
+
+// One frame of a 1920px chart over the whole series
+static void BM_SeriesDecimate(benchmark::State& state)
+{
+    const int points = static_cast<int>(state.range(0));
+    const bool lttb = state.range(1) != 0;
+    SeriesPyramid series;
+    fillWalk(series, points);
+
+    for (auto _ : state) {
+        QVector<QPointF> line = lttb ? series.decimateLttb(0, points, 1920) : series.decimateMinMax(0, points, 1920);
+        benchmark::DoNotOptimize(line.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points);
+}
+BENCHMARK(BM_SeriesDecimate)->ArgsProduct({ { 100000, 1000000 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+
+static void BM_SeriesAppend(benchmark::State& state)
+{
+    SeriesPyramid series;
+    fillWalk(series, 1000000);
+    const double y[64] = {};
+
+    for (auto _ : state) {
+        series.append(nullptr, y, 64);
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_SeriesAppend);
+
+// ---------------------------------------------------------------------------
+// SignalForwarder (QML → JNI → Java round trip)
+// ---------------------------------------------------------------------------
+
+static void BM_EmitSignal(benchmark::State& state)
+{
+    JNIEnv* env = BenchJvm::env();
+    jobject handler = BenchJvm::newInstance(env, "qml/bench/NoopSignalHandler");
+    if (handler == nullptr) {
+        state.SkipWithError("NoopSignalHandler not on classpath");
+        return;
+    }
+
+    SignalForwarder forwarder(BenchJvm::vm());
+    forwarder.registerHandler(QStringLiteral("bench"), env, handler);
+
+    const QString signalName = QStringLiteral("bench");
+    QVariantList args;
+    for (int i = 0; i < state.range(0); ++i) {
+        args.append(QStringLiteral("arg%1").arg(i));
+    }
+
+    for (auto _ : state) {
+        forwarder.emitSignal(signalName, args);
+    }
+
+    forwarder.unregisterHandler(signalName, env);
+    env->DeleteLocalRef(handler);
+}
+BENCHMARK(BM_EmitSignal)->Arg(0)->Arg(2)->Arg(8);
+
+// ---------------------------------------------------------------------------
+// QmlWatcher reload latency
+// ---------------------------------------------------------------------------
+
+static void BM_QmlWatcherReload(benchmark::State& state)
+{
+    QTemporaryDir dir;
+    const QString qmlPath = dir.filePath(QStringLiteral("bench.qml"));
+
+    QFile file(qmlPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        state.SkipWithError("Could not write temporary QML file");
+        return;
+    }
+    file.write("import QtQuick\n"
+               "Item {\n"
+               "    width: 400; height: 300\n"
+               "    Repeater { model: 50; Rectangle { width: 10; height: 10 } }\n"
+               "}\n");
+    file.close();
+
+    QQmlApplicationEngine engine;
+    engine.load(QUrl::fromLocalFile(qmlPath));
+    QmlWatcher watcher(&engine);
+    watcher.setAutoReload(false);
+    watcher.watchFile(qmlPath);
+
+    for (auto _ : state) {
+        watcher.reload();
+
+        // Old roots are deleted with deleteLater(); flush them outside the timing
+        state.PauseTiming();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_QmlWatcherReload)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    JNIEnv* env = BenchJvm::start(CUIRQ_BENCH_CLASSPATH, CUIRQ_BENCH_LIBRARY_PATH);
+    if (env == nullptr) {
+        return 1;
+    }
+
+    // Initialize the bridge exactly as the JVM would, but headless
+    const char* qtArgs[] = { "cuirq_bench", "-platform", "offscreen" };
+    jobjectArray jargs = BenchJvm::stringArray(env, qtArgs, 3);
+    Java_qml_Bridge_initialize(env, nullptr, jargs);
+    env->DeleteLocalRef(jargs);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // Results go to the real stdout; bridge logging goes nowhere
+    std::ostream results(std::cout.rdbuf());
+    NullBuffer nullBuffer;
+    std::cout.rdbuf(&nullBuffer);
+    qInstallMessageHandler(discardQtMessages);
+
+    benchmark::JSONReporter reporter;
+    reporter.SetOutputStream(&results);
+    reporter.SetErrorStream(&std::cerr);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    std::cout.rdbuf(results.rdbuf());
+    return 0;
+}
@@ -0,0 +1,608 @@
+/**
+ * cuirq_stress - headless frame-time stress harness.
+ *
+ * Loads reference QML scenes offscreen, drives them through the bridge
+ * natives at scripted update rates and records:
+ *   - per-frame intervals from QQuickWindow::frameSwapped (FrameTimer)
+ *   - GUI-thread stalls: lateness of a high-frequency precise timer
+ *
+ * Each scenario runs in its own child process (Qt and the embedded JVM can
+ * only be initialized once per process). The parent merges the results
+ * into one JSON report and exits non-zero if any budget is exceeded.
+ *
+ * Usage:
+ *   cuirq_stress [--report stress.json] [--duration 10] [--warmup 2]
+ *                [--scenario listview|nodecanvas|nodecanvas-native|dashboard] [--hardware]
+ *
+ * --hardware keeps Qt's default scene graph backend; by default the
+ * software backend is used so results do not depend on GPU drivers.
+ */
+
+#include "benchjvm.h"
+#include "qmlbridge.h"
+#include "frametimer.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointF>
+#include <QProcess>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Scenarios
+// ---------------------------------------------------------------------------
+
+struct Scenario
+{
+    const char* name;
+    const char* qmlFile;
+    int updateHz;
+    double frameP95BudgetMs;
+    double stallP99BudgetMs;
+    std::function<void(JNIEnv*)> setup;            // before the scene loads
+    std::function<void(JNIEnv*, int tick)> tick;   // at updateHz
+};
+
+// Pre-built Java strings so the harness itself adds no marshaling cost
+struct Payloads
+{
+    QVector<jstring> a;
+    QVector<jstring> b;
+    QVector<jstring> names;
+};
+
+jstring toJava(JNIEnv* env, const QString& value)
+{
+    jstring local = env->NewStringUTF(value.toUtf8().constData());
+    jstring global = static_cast<jstring>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    return global;
+}
+
+QString listRowsJson(int rows, const QString& prefix)
+{
+    QString json;
+    json.reserve(rows * 64);
+    json.append('[');
+    for (int i = 0; i < rows; ++i) {
+        if (i > 0) {
+            json.append(',');
+        }
+        json.append(QStringLiteral("{\"id\":%1,\"name\":\"%2 %1\",\"done\":%3,\"score\":%4}")
+                        .arg(i)
+                        .arg(prefix)
+                        .arg(i % 3 == 0 ? QStringLiteral("true") : QStringLiteral("false"))
+                        .arg(i * 0.25));
+    }
+    json.append(']');
+    return json;
+}
+
+// Node positions for animation frame `frame`: a grid that gently orbits
+QVector<QPointF> nodePositions(int nodes, int frame)
+{
+    QVector<QPointF> positions;
+    positions.reserve(nodes);
+    const double phase = frame * 2.0 * M_PI / 120.0;
+    for (int i = 0; i < nodes; ++i) {
+        const double baseX = 40 + (i % 20) * 60;
+        const double baseY = 40 + (i / 20) * 70;
+        positions.append(QPointF(baseX + 12 * std::cos(phase + i), baseY + 12 * std::sin(phase + i)));
+    }
+    return positions;
+}
+
+Scenario listViewScenario()
+{
+    auto payloads = std::make_shared<Payloads>();
+    Scenario s;
+    s.name = "listview";
+    s.qmlFile = "listview.qml";
+    s.updateHz = 10;
+    s.frameP95BudgetMs = 1000.0 / 60.0 * 1.2;
+    s.stallP99BudgetMs = 50.0;
+
+    s.setup = [payloads](JNIEnv* env) {
+        payloads->a.append(toJava(env, listRowsJson(100000, QStringLiteral("Item"))));
+        payloads->b.append(toJava(env, listRowsJson(100000, QStringLiteral("Row"))));
+        for (int i = 0; i < 100; ++i) {
+            payloads->names.append(toJava(env, QStringLiteral("tick %1").arg(i)));
+        }
+
+        jstring model = toJava(env, QStringLiteral("rows"));
+        Java_qml_Bridge_createModel(env, nullptr, model);
+        Java_qml_Bridge_setModelData(env, nullptr, model, payloads->a.first());
+        payloads->names.append(model);
+
+        jstring status = env->NewStringUTF("status");
+        Java_qml_Bridge_setContextProperty(env, nullptr, status, payloads->names.first());
+        env->DeleteLocalRef(status);
+    };
+
+    // Status text every tick, full 100k-row replacement every 2 seconds
+    s.tick = [payloads](JNIEnv* env, int tick) {
+        jstring status = env->NewStringUTF("status");
+        Java_qml_Bridge_setContextProperty(env, nullptr, status, payloads->names.at(tick % 100));
+        env->DeleteLocalRef(status);
+
+        if (tick > 0 && tick % 20 == 0) {
+            jstring model = payloads->names.last();
+            Java_qml_Bridge_setModelData(env, nullptr, model,
+                                         (tick / 20) % 2 ? payloads->b.first() : payloads->a.first());
+        }
+    };
+    return s;
+}
+
+Scenario nodeCanvasScenario()
+{
+    auto payloads = std::make_shared<Payloads>();
+    Scenario s;
+    s.name = "nodecanvas";
+    s.qmlFile = "nodecanvas.qml";
+    s.updateHz = 60;
+    s.frameP95BudgetMs = 1000.0 / 60.0 * 1.2;
+    s.stallP99BudgetMs = 33.0;
+
+    s.setup = [payloads](JNIEnv* env) {
+        const int nodeCount = 200;
+        const int frames = 120;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            const QVector<QPointF> pos = nodePositions(nodeCount, frame);
+
+            QJsonArray nodes;
+            for (int i = 0; i < nodeCount; ++i) {
+                nodes.append(QJsonObject{
+                    { "id", i },
+                    { "x", pos[i].x() },
+                    { "y", pos[i].y() },
+                    { "label", QStringLiteral("node %1").arg(i) }
+                });
+            }
+
+            // Each node wired to its right and lower neighbours
+            QJsonArray edges;
+            for (int i = 0; i < nodeCount; ++i) {
+                for (int j : { i + 1, i + 20 }) {
+                    if (j >= nodeCount || (j == i + 1 && j % 20 == 0)) {
+                        continue;
+                    }
+                    edges.append(QJsonObject{
+                        { "x1", pos[i].x() + 80 }, { "y1", pos[i].y() + 20 },
+                        { "x2", pos[j].x() },      { "y2", pos[j].y() + 20 }
+                    });
+                }
+            }
+
+            payloads->a.append(toJava(env, QString::fromUtf8(QJsonDocument(nodes).toJson(QJsonDocument::Compact))));
+            payloads->b.append(toJava(env, QString::fromUtf8(QJsonDocument(edges).toJson(QJsonDocument::Compact))));
+        }
+
+        payloads->names.append(toJava(env, QStringLiteral("nodes")));
+        payloads->names.append(toJava(env, QStringLiteral("edges")));
+        for (jstring model : payloads->names) {
+            Java_qml_Bridge_createModel(env, nullptr, model);
+        }
+        Java_qml_Bridge_setModelData(env, nullptr, payloads->names[0], payloads->a.first());
+        Java_qml_Bridge_setModelData(env, nullptr, payloads->names[1], payloads->b.first());
+    };
+
+    s.tick = [payloads](JNIEnv* env, int tick) {
+        const int frame = tick % payloads->a.size();
+        Java_qml_Bridge_setModelData(env, nullptr, payloads->names[0], payloads->a.at(frame));
+        Java_qml_Bridge_setModelData(env, nullptr, payloads->names[1], payloads->b.at(frame));
+    };
+    return s;
+}
+
+// Same graph and animation as nodecanvas, drawn by the native NodeCanvas item
+// and animated with bulk moveCanvasNodes calls instead of model resets
+Scenario nativeNodeCanvasScenario()
+{
+    struct Arrays
+    {
+        jstring canvas = nullptr;
+        jintArray ids = nullptr;
+        jfloatArray rects = nullptr;
+        jintArray ports = nullptr;
+        jobjectArray labels = nullptr;
+        jintArray edges = nullptr;
+        QVector<jfloatArray> positions;
+        bool loaded = false;
+    };
+    auto arrays = std::make_shared<Arrays>();
+
+    Scenario s;
+    s.name = "nodecanvas-native";
+    s.qmlFile = "nodecanvas_native.qml";
+    s.updateHz = 60;
+    s.frameP95BudgetMs = 1000.0 / 60.0 * 1.2;
+    s.stallP99BudgetMs = 33.0;
+
+    s.setup = [arrays](JNIEnv* env) {
+        const int nodeCount = 200;
+        const int frames = 120;
+        auto global = [env](auto local) {
+            auto ref = static_cast<decltype(local)>(env->NewGlobalRef(local));
+            env->DeleteLocalRef(local);
+            return ref;
+        };
+
+        QVector<jint> ids(nodeCount);
+        QVector<jint> ports(nodeCount * 2, 1);
+        QVector<jfloat> rects;
+        const QVector<QPointF> start = nodePositions(nodeCount, 0);
+        jclass stringClass = env->FindClass("java/lang/String");
+        arrays->labels = global(env->NewObjectArray(nodeCount, stringClass, nullptr));
+        env->DeleteLocalRef(stringClass);
+        for (int i = 0; i < nodeCount; ++i) {
+            ids[i] = i;
+            rects << start[i].x() << start[i].y() << 80 << 40;
+            jstring label = env->NewStringUTF(QStringLiteral("node %1").arg(i).toUtf8().constData());
+            env->SetObjectArrayElement(arrays->labels, i, label);
+            env->DeleteLocalRef(label);
+        }
+
+        QVector<jint> edges;
+        for (int i = 0; i < nodeCount; ++i) {
+            for (int j : { i + 1, i + 20 }) {
+                if (j >= nodeCount || (j == i + 1 && j % 20 == 0)) {
+                    continue;
+                }
+                edges << i << 0 << j << 0;
+            }
+        }
+
+        arrays->canvas = toJava(env, QStringLiteral("graph"));
+        arrays->ids = global(env->NewIntArray(nodeCount));
+        env->SetIntArrayRegion(arrays->ids, 0, nodeCount, ids.constData());
+        arrays->rects = global(env->NewFloatArray(rects.size()));
+        env->SetFloatArrayRegion(arrays->rects, 0, rects.size(), rects.constData());
+        arrays->ports = global(env->NewIntArray(ports.size()));
+        env->SetIntArrayRegion(arrays->ports, 0, ports.size(), ports.constData());
+        arrays->edges = global(env->NewIntArray(edges.size()));
+        env->SetIntArrayRegion(arrays->edges, 0, edges.size(), edges.constData());
+
+        for (int frame = 0; frame < frames; ++frame) {
+            const QVector<QPointF> pos = nodePositions(nodeCount, frame);
+            QVector<jfloat> xy;
+            for (const QPointF& p : pos) {
+                xy << p.x() << p.y();
+            }
+            jfloatArray array = global(env->NewFloatArray(xy.size()));
+            env->SetFloatArrayRegion(array, 0, xy.size(), xy.constData());
+            arrays->positions.append(array);
+        }
+    };
+
+    // The canvas only exists once the scene is loaded: push the graph on the first tick
+    s.tick = [arrays](JNIEnv* env, int tick) {
+        if (!arrays->loaded) {
+            Java_qml_Bridge_setCanvasNodes(env, nullptr, arrays->canvas, arrays->ids, arrays->rects,
+                                           nullptr, arrays->ports, arrays->labels);
+            Java_qml_Bridge_setCanvasEdges(env, nullptr, arrays->canvas, arrays->edges, nullptr);
+            arrays->loaded = true;
+        }
+        Java_qml_Bridge_moveCanvasNodes(env, nullptr, arrays->canvas, arrays->ids,
+                                        arrays->positions.at(tick % arrays->positions.size()));
+    };
+    return s;
+}
+
+Scenario dashboardScenario()
+{
+    auto payloads = std::make_shared<Payloads>();
+    Scenario s;
+    s.name = "dashboard";
+    s.qmlFile = "dashboard.qml";
+    s.updateHz = 60;
+    s.frameP95BudgetMs = 1000.0 / 60.0 * 1.2;
+    s.stallP99BudgetMs = 33.0;
+
+    s.setup = [payloads](JNIEnv* env) {
+        for (int k = 0; k < 48; ++k) {
+            payloads->names.append(toJava(env, QStringLiteral("k%1").arg(k)));
+        }
+        for (int v = 0; v < 64; ++v) {
+            payloads->a.append(toJava(env, QString::number(50.0 + 50.0 * std::sin(v * 2.0 * M_PI / 64.0), 'f', 3)));
+        }
+        for (int k = 0; k < 48; ++k) {
+            Java_qml_Bridge_setContextProperty(env, nullptr, payloads->names[k], payloads->a.first());
+        }
+    };
+
+    s.tick = [payloads](JNIEnv* env, int tick) {
+        for (int k = 0; k < payloads->names.size(); ++k) {
+            Java_qml_Bridge_setContextProperty(env, nullptr, payloads->names[k],
+                                               payloads->a.at((tick + k) % payloads->a.size()));
+        }
+    };
+    return s;
+}
+
+QVector<Scenario> allScenarios()
+{
+    return { listViewScenario(), nodeCanvasScenario(), nativeNodeCanvasScenario(), dashboardScenario() };
+}
+
+// ---------------------------------------------------------------------------
+// GUI-thread stall probe
+// ---------------------------------------------------------------------------
+
+/**
+ * Measures how late a precise timer fires on the GUI thread.
+ *
+ * Lateness beyond the timer interval is time the event loop spent blocked
+ * (bridge calls, model resets, JS, layout).
+ */
+class StallProbe : public QObject
+{
+public:
+    explicit StallProbe(int intervalMs)
+        : m_intervalMs(intervalMs)
+        , m_lastNs(-1)
+    {
+        m_timer.setTimerType(Qt::PreciseTimer);
+        m_timer.setInterval(intervalMs);
+        connect(&m_timer, &QTimer::timeout, this, [this]() { sample(); });
+        m_clock.start();
+        m_timer.start();
+    }
+
+    void reset()
+    {
+        m_samples.clear();
+        m_lastNs = -1;
+    }
+
+    const QVector<double>& samples() const { return m_samples; }
+
+private:
+    void sample()
+    {
+        const qint64 now = m_clock.nsecsElapsed();
+        if (m_lastNs >= 0) {
+            m_samples.append(std::max(0.0, (now - m_lastNs) / 1e6 - m_intervalMs));
+        }
+        m_lastNs = now;
+    }
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    int m_intervalMs;
+    qint64 m_lastNs;
+    QVector<double> m_samples;
+};
+
+QJsonObject percentiles(const QVector<double>& values)
+{
+    return QJsonObject{
+        { "p50", FrameTimer::percentile(values, 50) },
+        { "p95", FrameTimer::percentile(values, 95) },
+        { "p99", FrameTimer::percentile(values, 99) },
+        { "max", FrameTimer::percentile(values, 100) },
+        { "count", static_cast<int>(values.size()) }
+    };
+}
+
+void spin(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+bool writeJson(const QString& path, const QJsonObject& object)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cerr << "[STRESS] ERROR: Cannot write " << path.toStdString() << std::endl;
+        return false;
+    }
+    file.write(QJsonDocument(object).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Child: run one scenario in this process
+// ---------------------------------------------------------------------------
+
+int runScenario(const Scenario& scenario, const QString& reportPath,
+                double durationSec, double warmupSec, bool hardware)
+{
+    if (!hardware) {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    }
+
+    JNIEnv* env = BenchJvm::start(CUIRQ_BENCH_CLASSPATH, CUIRQ_BENCH_LIBRARY_PATH);
+    if (env == nullptr) {
+        return 2;
+    }
+
+    const char* qtArgs[] = { "cuirq_stress", "-platform", "offscreen" };
+    jobjectArray jargs = BenchJvm::stringArray(env, qtArgs, 3);
+    Java_qml_Bridge_initialize(env, nullptr, jargs);
+    env->DeleteLocalRef(jargs);
+
+    scenario.setup(env);
+
+    const QString qmlPath = QStringLiteral(CUIRQ_STRESS_SCENES_DIR "/") + QString::fromUtf8(scenario.qmlFile);
+    jstring jpath = env->NewStringUTF(qmlPath.toUtf8().constData());
+    const bool loaded = Java_qml_Bridge_loadQml(env, nullptr, jpath) == JNI_TRUE;
+    env->DeleteLocalRef(jpath);
+
+    QQuickWindow* window = nullptr;
+    for (QWindow* candidate : QGuiApplication::topLevelWindows()) {
+        if ((window = qobject_cast<QQuickWindow*>(candidate)) != nullptr) {
+            break;
+        }
+    }
+
+    if (!loaded || window == nullptr) {
+        std::cerr << "[STRESS] ERROR: Scene did not produce a QQuickWindow: "
+                  << qmlPath.toStdString() << std::endl;
+        return 2;
+    }
+
+    FrameTimer frames(window, 1 << 16);
+    StallProbe stalls(4);
+
+    int tick = 0;
+    QTimer driver;
+    driver.setTimerType(Qt::PreciseTimer);
+    driver.setInterval(1000 / scenario.updateHz);
+    QObject::connect(&driver, &QTimer::timeout, [&]() { scenario.tick(env, tick++); });
+    driver.start();
+
+    spin(static_cast<int>(warmupSec * 1000));
+    frames.reset();
+    stalls.reset();
+
+    QElapsedTimer measured;
+    measured.start();
+    spin(static_cast<int>(durationSec * 1000));
+    const double elapsedSec = measured.nsecsElapsed() / 1e9;
+    driver.stop();
+
+    const QVector<double> frameSamples = frames.samples();
+    const double frameP95 = FrameTimer::percentile(frameSamples, 95);
+    const double stallP99 = FrameTimer::percentile(stalls.samples(), 99);
+    const bool pass = !frameSamples.isEmpty()
+        && frameP95 <= scenario.frameP95BudgetMs
+        && stallP99 <= scenario.stallP99BudgetMs;
+
+    QJsonObject result{
+        { "name", QString::fromUtf8(scenario.name) },
+        { "update_hz", scenario.updateHz },
+        { "duration_s", elapsedSec },
+        { "updates", tick },
+        { "frames", static_cast<qint64>(frames.frameCount()) },
+        { "fps", elapsedSec > 0 ? frames.frameCount() / elapsedSec : 0.0 },
+        { "frame_ms", percentiles(frameSamples) },
+        { "stall_ms", percentiles(stalls.samples()) },
+        { "budget", QJsonObject{
+              { "frame_p95_ms", scenario.frameP95BudgetMs },
+              { "stall_p99_ms", scenario.stallP99BudgetMs } } },
+        { "pass", pass }
+    };
+
+    return writeJson(reportPath, result) ? 0 : 2;
+}
+
+// ---------------------------------------------------------------------------
+// Parent: run every scenario in a child process and merge the reports
+// ---------------------------------------------------------------------------
+
+int runAll(const QStringList& scenarioNames, const QString& reportPath, const QStringList& passThrough)
+{
+    QTemporaryDir tmp;
+    QJsonArray results;
+    bool allPassed = true;
+
+    for (const QString& name : scenarioNames) {
+        const QString childReport = tmp.filePath(name + QStringLiteral(".json"));
+        QStringList args = passThrough;
+        args << QStringLiteral("--scenario") << name << QStringLiteral("--report") << childReport;
+
+        std::cerr << "[STRESS] Running scenario: " << name.toStdString() << std::endl;
+        QProcess::execute(QCoreApplication::applicationFilePath(), args);
+
+        QFile file(childReport);
+        if (!file.open(QIODevice::ReadOnly)) {
+            results.append(QJsonObject{ { "name", name }, { "pass", false }, { "error", "scenario crashed or failed to start" } });
+            allPassed = false;
+            continue;
+        }
+
+        const QJsonObject result = QJsonDocument::fromJson(file.readAll()).object();
+        allPassed = allPassed && result.value("pass").toBool();
+        results.append(result);
+    }
+
+    QJsonObject report{
+        { "tool", "cuirq_stress" },
+        { "qt_version", QString::fromUtf8(qVersion()) },
+        { "backend", passThrough.contains(QStringLiteral("--hardware")) ? "default" : "software" },
+        { "scenarios", results },
+        { "pass", allPassed }
+    };
+
+    if (!writeJson(reportPath, report)) {
+        return 2;
+    }
+
+    std::cout << QJsonDocument(report).toJson(QJsonDocument::Indented).constData();
+    return allPassed ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // Parse arguments without creating the Qt application: the child lets
+    // the bridge create QGuiApplication through Bridge.initialize
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments << QString::fromLocal8Bit(argv[i]);
+    }
+
+    QCommandLineParser parser;
+    parser.addOption({ "report", "JSON report path", "path", "stress-report.json" });
+    parser.addOption({ "duration", "Measured seconds per scenario", "seconds", "10" });
+    parser.addOption({ "warmup", "Warm-up seconds per scenario", "seconds", "2" });
+    parser.addOption({ "scenario", "Run only this scenario in-process", "name" });
+    parser.addOption({ "hardware", "Use the default scene graph backend instead of software" });
+    parser.process(arguments);
+
+    const QString reportPath = parser.value("report");
+    const double duration = parser.value("duration").toDouble();
+    const double warmup = parser.value("warmup").toDouble();
+    const bool hardware = parser.isSet("hardware");
+
+    const QVector<Scenario> scenarios = allScenarios();
+
+    if (parser.isSet("scenario")) {
+        const QString wanted = parser.value("scenario");
+        for (const Scenario& scenario : scenarios) {
+            if (wanted == QString::fromUtf8(scenario.name)) {
+                return runScenario(scenario, reportPath, duration, warmup, hardware);
+            }
+        }
+        std::cerr << "[STRESS] ERROR: Unknown scenario: " << wanted.toStdString() << std::endl;
+        return 2;
+    }
+
+    QCoreApplication app(argc, argv);
+
+    QStringList names;
+    for (const Scenario& scenario : scenarios) {
+        names << QString::fromUtf8(scenario.name);
+    }
+
+    QStringList passThrough{ "--duration", parser.value("duration"), "--warmup", parser.value("warmup") };
+    if (hardware) {
+        passThrough << QStringLiteral("--hardware");
+    }
+
+    return runAll(names, reportPath, passThrough);
+}
@@ -0,0 +1,16 @@
+package qml.bench;
+
+import qml.Bridge;
+
+/**
+ * Signal handler that does nothing.
+ *
+ * Used by the native benchmarks to measure the pure QML → JNI → Java
+ * dispatch cost without any handler work on the Java side.
+ */
+public final class NoopSignalHandler implements Bridge.SignalHandler {
+    @Override
+    public void handle(String[] args) {
+        // Intentionally empty
+    }
+}
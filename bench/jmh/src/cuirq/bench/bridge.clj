@@ -0,0 +1,69 @@
+(ns cuirq.bench.bridge
+  "JMH benchmark functions for the JVM → Qt bridge.
+
+   Each benchmark includes the JVM-side work a real app pays for:
+   string creation, clojure.data.json serialization and garbage."
+  (:require [clojure.data.json :as json]
+            [cuirq.core :as cuirq]
+            [cuirq.models :as models]
+            [cuirq.state :as state])
+  (:import [java.io Writer]
+           [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(def ^:private null-writer
+  "Swallows the println output of the wrapped API so the terminal does not
+   dominate the measurement (formatting is still paid for)."
+  (proxy [Writer] []
+    (write
+      ([_])
+      ([_ _ _]))
+    (flush [])
+    (close [])))
+
+(defmacro ^:private quietly
+  [& body]
+  `(binding [*out* null-writer]
+     ~@body))
+
+;; States
+
+(defn start-qt
+  "Initialize Qt headless and register the fixtures used by the benchmarks."
+  []
+  (quietly
+    (Bridge/initialize (into-array String ["cuirq-jmh" "-platform" "offscreen"]))
+    (models/create-model! :bench)
+    (cuirq/on-signal! :bench (fn [_args] nil))
+    (state/set-state! {:count 0}))
+  :qt)
+
+(defn make-rows
+  "Build `n` rows shaped like a typical list model item."
+  [n]
+  (let [n (if (string? n) (Long/parseLong n) (long n))]
+    (mapv (fn [i] {:id i :name (str "Item " i) :done (even? i) :score (* i 0.5)})
+          (range n))))
+
+;; Benchmarks
+
+(def ^:private counter (atom 0))
+
+(defn set-context-property
+  [_qt]
+  (Bridge/setContextProperty "benchValue" (str (swap! counter inc))))
+
+(defn set-model-data
+  [_qt rows]
+  (quietly
+    (models/set-data! :bench rows)))
+
+(defn signal-callback
+  [_qt]
+  (Bridge/emitSignal "bench" (into-array String ["a" "b"])))
+
+(defn update-state
+  [_qt]
+  (quietly
+    (state/update-state! update :count inc)))
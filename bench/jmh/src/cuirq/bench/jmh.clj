@@ -0,0 +1,37 @@
+(ns cuirq.bench.jmh
+  "Runs bench/jmh/jmh.edn with the GC profiler so every result carries the
+   allocation rate per operation next to its latency."
+  (:require [clojure.edn :as edn]
+            [clojure.java.io :as io]
+            [clojure.pprint :as pprint]
+            [jmh.core :as jmh]))
+
+(def ^:private alloc-key "·gc.alloc.rate.norm")
+
+(defn- summarize
+  [result]
+  (let [[score unit] (:score result)
+        [alloc alloc-unit] (get-in result [:secondary alloc-key :score])]
+    {:benchmark (name (:name result))
+     :params (pr-str (:params result {}))
+     :latency (format "%.3f %s" (double score) unit)
+     :alloc (if alloc
+              (format "%.1f %s" (double alloc) alloc-unit)
+              "n/a")}))
+
+(defn -main
+  "Usage: clojure -M:jmh [name-regex]"
+  [& [select]]
+  (let [env (cond-> (edn/read-string (slurp "bench/jmh/jmh.edn"))
+              select (update :benchmarks
+                             (fn [benchmarks]
+                               (filterv #(re-find (re-pattern select) (name (:name %)))
+                                        benchmarks))))
+        results (jmh/run env {:profilers ["gc"]
+                              :status true})
+        out (io/file "build/bench/jmh-results.edn")]
+    (io/make-parents out)
+    (spit out (with-out-str (pprint/pprint results)))
+    (pprint/print-table [:benchmark :params :latency :alloc] (map summarize results))
+    (println (str "\nFull results written to " out))
+    (shutdown-agents)))
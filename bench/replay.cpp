@@ -0,0 +1,398 @@
+/**
+ * cuirq_replay - replay a recorded bridge session and report frame timings.
+ *
+ * Reads a log written by Bridge.startRecording and applies every call to
+ * StateObject / JvmListModel / SignalForwarder and a loaded QML scene, in
+ * process and without a JVM, then prints a JSON report with frame-time
+ * percentiles and per-call apply latency.
+ *
+ * Usage:
+ *   cuirq_replay session.cuirqrec [--qml ui/main.qml] [--speed recorded|max|<factor>]
+ *                [--report replay.json] [--tail 1000] [--hardware] [--visible]
+ *
+ * --speed recorded keeps the recorded timing (a factor of 2 plays twice as
+ * fast); max applies calls back to back, one per event-loop iteration, so
+ * rendering still interleaves. --qml overrides the scene: it replaces the
+ * path of recorded loads, or is loaded up front if the session was
+ * recorded after loading.
+ *
+ * Signals are dispatched through SignalForwarder, but with no JVM there is
+ * no Java handler: the replay measures the Qt side of a session only.
+ */
+
+#include "frametimer.h"
+#include "jvmlistmodel.h"
+#include "qmlwatcher.h"
+#include "recorder.h"
+#include "signalforwarder.h"
+#include "stateobject.h"
+#include "trace.h"
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlApplicationEngine>
+#include <QQmlContext>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+#include <iostream>
+#include <memory>
+
+namespace {
+
+const char* typeName(Recorder::RecordType type)
+{
+    switch (type) {
+    case Recorder::SetProperty:  return "setProperty";
+    case Recorder::CreateModel:  return "createModel";
+    case Recorder::SetModelData: return "setModelData";
+    case Recorder::ClearModel:   return "clearModel";
+    case Recorder::EmitSignal:   return "emitSignal";
+    case Recorder::LoadQml:      return "loadQml";
+    case Recorder::ReloadQml:    return "reloadQml";
+    case Recorder::DestroyModel: return "destroyModel";
+    case Recorder::SetModelKey:  return "setModelKey";
+    case Recorder::PatchModel:   return "patchModel";
+    case Recorder::ApplyModelPatch: return "applyModelPatch";
+    case Recorder::ApplyStatePatch: return "applyStatePatch";
+    }
+    return "unknown";
+}
+
+QJsonObject percentiles(const QVector<double>& values)
+{
+    return QJsonObject{
+        { "p50", FrameTimer::percentile(values, 50) },
+        { "p95", FrameTimer::percentile(values, 95) },
+        { "p99", FrameTimer::percentile(values, 99) },
+        { "max", FrameTimer::percentile(values, 100) },
+        { "count", static_cast<int>(values.size()) }
+    };
+}
+
+class Replayer : public QObject
+{
+public:
+    Replayer(const QString& recordingPath, const QString& qmlOverride, double speed, int tailMs)
+        : m_recordingPath(recordingPath)
+        , m_qmlOverride(qmlOverride)
+        , m_speed(speed)
+        , m_tailMs(tailMs)
+    {
+        m_engine = new QQmlApplicationEngine(this);
+        m_forwarder = new SignalForwarder(nullptr, this);
+        m_state = new StateObject(this);
+        m_watcher = new QmlWatcher(m_engine, this);
+        m_watcher->setAutoReload(false);
+
+        QQmlContext* context = m_engine->rootContext();
+        context->setContextProperty("signalForwarder", m_forwarder);
+        context->setContextProperty("state", m_state);
+        context->setContextProperty("tracer", new QmlTracer(this));
+    }
+
+    bool start()
+    {
+        // The scene is loaded up front only if the session has no load of its own
+        bool recordedLoad = false;
+        {
+            RecordingReader scan;
+            if (!scan.open(m_recordingPath)) {
+                std::cerr << "[REPLAY] ERROR: " << scan.errorString().toStdString() << std::endl;
+                return false;
+            }
+            RecordedCall call;
+            while (scan.next(call)) {
+                if (call.type == Recorder::LoadQml) {
+                    recordedLoad = true;
+                    break;
+                }
+            }
+        }
+
+        if (!m_reader.open(m_recordingPath)) {
+            std::cerr << "[REPLAY] ERROR: " << m_reader.errorString().toStdString() << std::endl;
+            return false;
+        }
+
+        if (!recordedLoad && !m_qmlOverride.isEmpty() && !load(m_qmlOverride)) {
+            return false;
+        }
+
+        m_hasPending = m_reader.next(m_pending);
+        m_clock.start();
+        QTimer::singleShot(0, this, [this]() { step(); });
+        return true;
+    }
+
+    QJsonObject report() const
+    {
+        QVector<double> frames = m_frameSamples;
+        quint64 frameCount = m_frameCount;
+        if (m_frameTimer) {
+            frames += m_frameTimer->samples();
+            frameCount += m_frameTimer->frameCount();
+        }
+
+        QJsonObject byType;
+        QJsonObject applyUs;
+        for (auto it = m_applyUs.begin(); it != m_applyUs.end(); ++it) {
+            byType.insert(it.key(), static_cast<int>(it.value().size()));
+            applyUs.insert(it.key(), percentiles(it.value()));
+        }
+
+        const double durationSec = m_durationNs / 1e9;
+        QJsonObject result{
+            { "tool", "cuirq_replay" },
+            { "recording", m_recordingPath },
+            { "qt_version", QString::fromUtf8(qVersion()) },
+            { "speed", m_speed > 0 ? QJsonValue(m_speed) : QJsonValue("max") },
+            { "records", m_records },
+            { "records_by_type", byType },
+            { "duration_s", durationSec },
+            { "frames", static_cast<qint64>(frameCount) },
+            { "fps", durationSec > 0 ? frameCount / durationSec : 0.0 },
+            { "frame_ms", percentiles(frames) },
+            { "apply_us", applyUs }
+        };
+        if (m_speed > 0) {
+            result.insert("lag_ms", percentiles(m_lagMs));
+        }
+        if (!m_reader.errorString().isEmpty()) {
+            result.insert("error", m_reader.errorString());
+        }
+        return result;
+    }
+
+private:
+    void step()
+    {
+        if (!m_hasPending) {
+            m_durationNs = m_clock.nsecsElapsed();
+            QTimer::singleShot(m_tailMs, qApp, &QCoreApplication::quit);
+            return;
+        }
+
+        if (m_speed > 0) {
+            const double dueMs = m_pending.timestampUs / 1000.0 / m_speed;
+            const double nowMs = m_clock.nsecsElapsed() / 1e6;
+            if (nowMs < dueMs) {
+                QTimer::singleShot(static_cast<int>(dueMs - nowMs), Qt::PreciseTimer, this, [this]() { step(); });
+                return;
+            }
+            m_lagMs.append(nowMs - dueMs);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        apply(m_pending);
+        m_applyUs[QString::fromUtf8(typeName(m_pending.type))].append(timer.nsecsElapsed() / 1000.0);
+        ++m_records;
+
+        m_hasPending = m_reader.next(m_pending);
+
+        // Back to the event loop between calls so frames interleave as they did live
+        QTimer::singleShot(0, this, [this]() { step(); });
+    }
+
+    void apply(const RecordedCall& call)
+    {
+        const QString first = call.fields.value(0);
+        const QString second = call.fields.value(1);
+
+        switch (call.type) {
+        case Recorder::SetProperty:
+            m_state->setProp(first, second);
+            break;
+        case Recorder::CreateModel:
+            model(first);
+            break;
+        case Recorder::SetModelData:
+            model(first)->setJsonData(second);
+            break;
+        case Recorder::ClearModel:
+            model(first)->clear();
+            break;
+        case Recorder::EmitSignal: {
+            QVariantList args;
+            for (const QString& arg : call.args) {
+                args << arg;
+            }
+            m_forwarder->emitSignal(first, args);
+            break;
+        }
+        case Recorder::LoadQml:
+            load(m_qmlOverride.isEmpty() ? first : m_qmlOverride);
+            break;
+        case Recorder::ReloadQml:
+            m_watcher->reload();
+            attachFrameTimer();
+            break;
+        case Recorder::DestroyModel:
+            if (JvmListModel* destroyed = m_models.take(first)) {
+                m_engine->rootContext()->setContextProperty(first, QVariant::fromValue<QObject*>(nullptr));
+                destroyed->deleteLater();
+            }
+            break;
+        case Recorder::SetModelKey:
+            model(first)->setKeyRole(second);
+            break;
+        case Recorder::PatchModel:
+            model(first)->patchMany(QJsonDocument::fromJson(second.toUtf8()).array());
+            break;
+        case Recorder::ApplyModelPatch:
+            model(first)->applyJsonPatch(QJsonDocument::fromJson(second.toUtf8()).array());
+            break;
+        case Recorder::ApplyStatePatch:
+            m_state->applyJsonPatch(QJsonDocument::fromJson(first.toUtf8()).array());
+            break;
+        }
+    }
+
+    JvmListModel* model(const QString& name)
+    {
+        JvmListModel* existing = m_models.value(name, nullptr);
+        if (existing) {
+            return existing;
+        }
+        // Created before recording started: create on first use
+        auto* created = new JvmListModel(m_engine);
+        created->setObjectName(name);
+        m_models.insert(name, created);
+        m_engine->rootContext()->setContextProperty(name, created);
+        return created;
+    }
+
+    bool load(const QString& path)
+    {
+        m_engine->load(QUrl::fromLocalFile(path));
+        if (m_engine->rootObjects().isEmpty()) {
+            std::cerr << "[REPLAY] ERROR: Failed to load QML file: " << path.toStdString() << std::endl;
+            return false;
+        }
+        m_watcher->watchFile(path);
+        attachFrameTimer();
+        return true;
+    }
+
+    // Follow the newest window (loads and reloads replace it)
+    void attachFrameTimer()
+    {
+        QQuickWindow* window = nullptr;
+        const QList<QObject*> roots = m_engine->rootObjects();
+        for (auto it = roots.rbegin(); it != roots.rend() && window == nullptr; ++it) {
+            window = qobject_cast<QQuickWindow*>(*it);
+        }
+        if (window == nullptr || (m_frameTimer && m_frameWindow == window)) {
+            return;
+        }
+
+        if (m_frameTimer) {
+            m_frameSamples += m_frameTimer->samples();
+            m_frameCount += m_frameTimer->frameCount();
+        }
+        m_frameTimer = std::make_unique<FrameTimer>(window, 1 << 16);
+        m_frameWindow = window;
+    }
+
+    QString m_recordingPath;
+    QString m_qmlOverride;
+    double m_speed;
+    int m_tailMs;
+
+    QQmlApplicationEngine* m_engine;
+    SignalForwarder* m_forwarder;
+    StateObject* m_state;
+    QmlWatcher* m_watcher;
+    QHash<QString, JvmListModel*> m_models;
+
+    RecordingReader m_reader;
+    RecordedCall m_pending;
+    bool m_hasPending = false;
+    QElapsedTimer m_clock;
+    qint64 m_durationNs = 0;
+    int m_records = 0;
+
+    std::unique_ptr<FrameTimer> m_frameTimer;
+    QQuickWindow* m_frameWindow = nullptr;
+    QVector<double> m_frameSamples;
+    quint64 m_frameCount = 0;
+    QVector<double> m_lagMs;
+    QHash<QString, QVector<double>> m_applyUs;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments << QString::fromLocal8Bit(argv[i]);
+    }
+
+    QCommandLineParser parser;
+    parser.addPositionalArgument("recording", "Log written by Bridge.startRecording");
+    parser.addOption({ "qml", "Scene to load (overrides recorded loads)", "path" });
+    parser.addOption({ "speed", "recorded, max, or a speed factor", "speed", "recorded" });
+    parser.addOption({ "report", "JSON report path", "path" });
+    parser.addOption({ "tail", "Milliseconds to keep rendering after the last call", "ms", "1000" });
+    parser.addOption({ "hardware", "Use the default scene graph backend instead of software" });
+    parser.addOption({ "visible", "Show the window instead of rendering offscreen" });
+    parser.process(arguments);
+
+    if (parser.positionalArguments().size() != 1) {
+        std::cerr << "Usage: cuirq_replay <recording> [--qml scene.qml] [--speed recorded|max|<factor>]"
+                  << std::endl;
+        return 2;
+    }
+
+    double speed = 1.0;
+    const QString speedArg = parser.value("speed");
+    if (speedArg == QStringLiteral("max")) {
+        speed = 0.0;
+    } else if (speedArg != QStringLiteral("recorded")) {
+        bool ok = false;
+        speed = speedArg.toDouble(&ok);
+        if (!ok || speed <= 0.0) {
+            std::cerr << "[REPLAY] ERROR: Invalid --speed: " << speedArg.toStdString() << std::endl;
+            return 2;
+        }
+    }
+
+    if (!parser.isSet("visible") && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    if (!parser.isSet("hardware")) {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    }
+
+    QGuiApplication app(argc, argv);
+
+    Replayer replayer(parser.positionalArguments().first(), parser.value("qml"),
+                      speed, parser.value("tail").toInt());
+    if (!replayer.start()) {
+        return 2;
+    }
+
+    app.exec();
+
+    const QByteArray json = QJsonDocument(replayer.report()).toJson(QJsonDocument::Indented);
+    if (parser.isSet("report")) {
+        QFile file(parser.value("report"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << "[REPLAY] ERROR: Cannot write " << parser.value("report").toStdString() << std::endl;
+            return 2;
+        }
+        file.write(json);
+    }
+    std::cout << json.constData();
+    return 0;
+}
@@ -0,0 +1,50 @@
+import QtQuick
+
+// Stress scene: dashboard of 48 tiles bound to state properties k0..k47,
+// all updated at the script rate through setContextProperty.
+Window {
+    width: 1200
+    height: 800
+    visible: true
+    title: "stress: dashboard"
+
+    Grid {
+        anchors.fill: parent
+        anchors.margins: 8
+        columns: 8
+        spacing: 8
+
+        Repeater {
+            model: 48
+            delegate: Rectangle {
+                required property int index
+                readonly property real value: parseFloat(state["k" + index]) || 0
+
+                width: 140
+                height: 120
+                radius: 4
+                color: "#20252b"
+
+                Text {
+                    anchors { left: parent.left; top: parent.top; margins: 8 }
+                    text: "metric " + index
+                    color: "#9aa"
+                }
+
+                Text {
+                    anchors.centerIn: parent
+                    text: value.toFixed(2)
+                    font.pixelSize: 24
+                    color: "white"
+                }
+
+                Rectangle {
+                    anchors { left: parent.left; bottom: parent.bottom; margins: 8 }
+                    height: 6
+                    width: (parent.width - 16) * Math.min(1, Math.abs(value) / 100)
+                    color: value > 50 ? "#e0603a" : "#3ac47d"
+                }
+            }
+        }
+    }
+}
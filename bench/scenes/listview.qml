@@ -0,0 +1,47 @@
+import QtQuick
+
+// Stress scene: 100k-row ListView that scrolls continuously.
+// Driven by: model "rows" (bulk replacements) and state.status.
+Window {
+    width: 800
+    height: 600
+    visible: true
+    title: "stress: listview"
+
+    ListView {
+        id: list
+        anchors.fill: parent
+        model: rows
+        clip: true
+        cacheBuffer: 400
+
+        delegate: Rectangle {
+            width: ListView.view.width
+            height: 28
+            color: index % 2 === 0 ? "#f4f4f4" : "white"
+
+            Row {
+                anchors.verticalCenter: parent.verticalCenter
+                x: 8
+                spacing: 12
+                Text { text: model.id }
+                Text { text: model.name; width: 240; elide: Text.ElideRight }
+                Text { text: model.done ? "done" : "open" }
+                Text { text: model.score }
+            }
+        }
+
+        // Keep frames coming: scroll through the list forever
+        NumberAnimation on contentY {
+            from: 0
+            to: Math.max(0, list.contentHeight - list.height)
+            duration: 600000
+            loops: Animation.Infinite
+        }
+    }
+
+    Text {
+        anchors { right: parent.right; bottom: parent.bottom; margins: 8 }
+        text: state.status || ""
+    }
+}
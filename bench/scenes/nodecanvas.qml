@@ -0,0 +1,52 @@
+import QtQuick
+
+// Stress scene: 200 nodes with wires, the classic QML delegate approach
+// (Rectangle + Text + MouseArea per node, rotated Rectangles as wires).
+// Driven by: models "nodes" and "edges", replaced at the script rate.
+Window {
+    width: 1280
+    height: 800
+    visible: true
+    title: "stress: node canvas"
+
+    Item {
+        anchors.fill: parent
+
+        Repeater {
+            model: edges
+            delegate: Rectangle {
+                x: model.x1
+                y: model.y1
+                width: Math.sqrt(Math.pow(model.x2 - model.x1, 2) + Math.pow(model.y2 - model.y1, 2))
+                height: 2
+                color: "#667"
+                transformOrigin: Item.TopLeft
+                rotation: Math.atan2(model.y2 - model.y1, model.x2 - model.x1) * 180 / Math.PI
+            }
+        }
+
+        Repeater {
+            model: nodes
+            delegate: Rectangle {
+                x: model.x
+                y: model.y
+                width: 80
+                height: 40
+                radius: 6
+                color: "#3b6ea5"
+                border.color: "#1d3a5a"
+
+                Text {
+                    anchors.centerIn: parent
+                    text: model.label
+                    color: "white"
+                }
+
+                MouseArea {
+                    anchors.fill: parent
+                    onClicked: signalForwarder.emitSignal("nodeClicked", [model.id])
+                }
+            }
+        }
+    }
+}
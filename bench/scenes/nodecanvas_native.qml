@@ -0,0 +1,26 @@
+import QtQuick
+import Cuirq 1.0
+
+// Stress scene: the nodecanvas graph (200 nodes, ~370 wires) drawn by the
+// native NodeCanvas item. Driven by: setCanvasNodes/setCanvasEdges once,
+// then moveCanvasNodes with every node at the script rate.
+Window {
+    width: 1280
+    height: 800
+    visible: true
+    title: "stress: native node canvas"
+
+    NodeCanvas {
+        id: canvas
+        name: "graph"
+        anchors.fill: parent
+
+        TapHandler {
+            onTapped: (point) => {
+                const id = canvas.nodeAt(point.position.x, point.position.y)
+                if (id >= 0)
+                    signalForwarder.emitSignal("nodeClicked", [id])
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+(ns cuirq.arrow
+  "List models over Apache Arrow record batches, read in place.
+
+   Batches are handed over through the Arrow C Data Interface: export a
+   VectorSchemaRoot with Arrow Java's org.apache.arrow.c.Data into an
+   ArrowSchema / ArrowArray pair and pass their memory addresses. Each
+   column becomes a QML role; nothing is converted to maps or JSON.
+
+   Ownership of an exported batch always passes to the bridge, which calls
+   its release callback when the rows are replaced or the model destroyed.
+   Arrow is not a dependency of cuirq: bring arrow-c-data yourself."
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn set-batch!
+  "Replace the rows of Arrow model `model` (created on first use) with an
+   exported record batch. Returns false if the batch was rejected."
+  [model schema-address array-address]
+  (Bridge/setArrowModelData (name model) (long schema-address) (long array-address)))
+
+(defn append-batch!
+  "Append an exported record batch with the same columns (rows are
+   inserted, not reset)."
+  [model schema-address array-address]
+  (Bridge/appendArrowModelData (name model) (long schema-address) (long array-address)))
+
+(defn destroy!
+  "Unbind an Arrow model from QML and release its batches."
+  [model]
+  (Bridge/destroyArrowModel (name model)))
+
+(comment
+  ;; With org.apache.arrow/arrow-c-data on the classpath:
+  (import '[org.apache.arrow.c ArrowArray ArrowSchema Data]
+          '[org.apache.arrow.memory RootAllocator])
+
+  (with-open [allocator (RootAllocator.)
+              schema (ArrowSchema/allocateNew allocator)
+              array (ArrowArray/allocateNew allocator)]
+    ;; root: a VectorSchemaRoot with columns symbol (utf8), price (float8), ts (timestamp)
+    (Data/exportVectorSchemaRoot allocator root nil array schema)
+    (set-batch! :trades (.memoryAddress schema) (.memoryAddress array)))
+
+  ;; QML: ListView { model: trades; delegate: Text { text: symbol + " " + price } }
+  (destroy! :trades))
@@ -0,0 +1,78 @@
+(ns cuirq.canvas
+  "Node-editor canvas rendered natively by the NodeCanvas QML item.
+
+   QML:
+     import Cuirq 1.0
+     NodeCanvas { name: \"graph\"; anchors.fill: parent }
+
+   The graph is pushed as flat primitive arrays; moving nodes only
+   re-uploads the geometry of the moved nodes and their edges.
+
+   Hit-testing (node-at, nodes-in-rect, nodes-in-lasso) goes through a
+   native spatial index kept up to date as nodes move."
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn set-nodes!
+  "Replace the canvas nodes.
+
+   Each node: {:id 1 :x 10 :y 20 :w 120 :h 60
+               :color 0xff3b6ea5 :inputs 2 :outputs 1 :label \"Add\"}"
+  [canvas nodes]
+  (let [nodes (vec nodes)]
+    (Bridge/setCanvasNodes
+     (name canvas)
+     (int-array (map :id nodes))
+     (float-array (mapcat (fn [{:keys [x y w h] :or {w 120 h 60}}] [x y w h]) nodes))
+     (int-array (map #(unchecked-int (:color % 0xff3b6ea5)) nodes))
+     (int-array (mapcat (fn [{:keys [inputs outputs] :or {inputs 0 outputs 0}}] [inputs outputs]) nodes))
+     (into-array String (map :label nodes)))))
+
+(defn set-edges!
+  "Replace the canvas edges.
+
+   Each edge: {:from 1 :from-port 0 :to 2 :to-port 1 :color 0xff8c96aa}"
+  [canvas edges]
+  (let [edges (vec edges)]
+    (Bridge/setCanvasEdges
+     (name canvas)
+     (int-array (mapcat (fn [{:keys [from from-port to to-port] :or {from-port 0 to-port 0}}]
+                          [from from-port to to-port])
+                        edges))
+     (int-array (map #(unchecked-int (:color % 0xff8c96aa)) edges)))))
+
+(defn move-nodes!
+  "Move nodes by id: (move-nodes! :graph {1 [x y], 2 [x y]}).
+   Returns the number of ids found."
+  [canvas positions]
+  (Bridge/moveCanvasNodes
+   (name canvas)
+   (int-array (keys positions))
+   (float-array (mapcat identity (vals positions)))))
+
+(defn node-at
+  "Id of the topmost node at [x y], or nil."
+  [canvas [x y]]
+  (let [id (Bridge/queryCanvasPoint (name canvas) (float x) (float y))]
+    (when-not (neg? id) id)))
+
+(defn nodes-in-rect
+  "Ids of the nodes overlapping the rect, in draw order."
+  [canvas {:keys [x y w h]}]
+  (vec (Bridge/queryCanvasRect (name canvas) (float x) (float y) (float w) (float h))))
+
+(defn nodes-in-lasso
+  "Ids of the nodes whose center lies inside the polygon [[x y] ...]."
+  [canvas points]
+  (vec (Bridge/queryCanvasPolygon (name canvas) (float-array (mapcat identity points)))))
+
+(comment
+  (set-nodes! :graph (for [i (range 200)]
+                       {:id i :x (* 140 (mod i 20)) :y (* 90 (quot i 20))
+                        :inputs 1 :outputs 1 :label (str "node " i)}))
+  (set-edges! :graph (for [i (range 199)] {:from i :to (inc i)}))
+  (move-nodes! :graph {0 [300 300]})
+  (node-at :graph [310 310])
+  (nodes-in-rect :graph {:x 0 :y 0 :w 600 :h 300})
+  (nodes-in-lasso :graph [[0 0] [700 0] [0 400]]))
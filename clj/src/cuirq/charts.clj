@@ -0,0 +1,59 @@
+(ns cuirq.charts
+  "Large time series drawn natively by the TimeSeriesChart QML item.
+
+   QML:
+     import Cuirq 1.0
+     TimeSeriesChart { name: \"cpu\"; anchors.fill: parent; timeWindow: 60 }
+
+   Series are stored natively with a min/max pyramid and decimated to the
+   pixel width of the chart, so million-point series stay cheap to draw.
+   Appending only updates the tail of the pyramid."
+  (:import [java.nio DoubleBuffer]
+           [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn- doubles-or-nil
+  ^doubles [xs]
+  (cond
+    (nil? xs) nil
+    (instance? (Class/forName "[D") xs) xs
+    :else (double-array xs)))
+
+(defn set-series!
+  "Replace a series. x may be nil (x = point index); x must be non-decreasing.
+
+   (set-series! :cpu :user xs ys)"
+  [chart series xs ys]
+  (Bridge/setSeriesData (name chart) (name series) (doubles-or-nil xs) (doubles-or-nil ys)))
+
+(defn append!
+  "Append points to a series (created if needed)."
+  [chart series xs ys]
+  (Bridge/appendSeriesData (name chart) (name series) (doubles-or-nil xs) (doubles-or-nil ys)))
+
+(defn append-buffer!
+  "Append `count` points from direct DoubleBuffers (native byte order, read
+   from index 0). x may be nil."
+  [chart series ^DoubleBuffer x ^DoubleBuffer y count]
+  (Bridge/appendSeriesBuffer (name chart) (name series) x y (int count)))
+
+(defn set-color!
+  "Set the ARGB line color of a series."
+  [chart series color]
+  (Bridge/setSeriesColor (name chart) (name series) (unchecked-int color)))
+
+(defn remove-series!
+  [chart series]
+  (Bridge/removeSeries (name chart) (name series)))
+
+(comment
+  ;; A million-point random walk
+  (let [n 1000000
+        ys (double-array (reductions + (repeatedly n #(- (rand) 0.5))))]
+    (set-series! :cpu :walk nil ys))
+
+  ;; Live tail: append a second of samples at a time
+  (append! :cpu :load [1000.0 1000.5] [0.4 0.7])
+  (set-color! :cpu :load 0xffe15759)
+  (remove-series! :cpu :walk))
@@ -0,0 +1,164 @@
+(ns cuirq.columns
+  "List models over append-only column files, memory-mapped by Qt.
+
+   For datasets larger than RAM: the JVM appends rows to a file in segments
+   of Arrow-layout columns, and the model reads cells straight from the
+   mapped pages. Nothing is held per row on either side.
+
+   (def w (create! \"/data/trades.col\" [[:symbol :string] [:price :double] [:ts :timestamp]]))
+   (open! :trades \"/data/trades.col\")
+   (append! w rows)     ;; rows: maps keyed by column
+   (refresh! :trades)
+
+   The file layout is documented in cpp/mappedlistmodel.h."
+  (:import [java.io ByteArrayOutputStream]
+           [java.nio ByteBuffer ByteOrder]
+           [java.nio.channels FileChannel]
+           [java.nio.charset StandardCharsets]
+           [java.nio.file OpenOption Paths StandardOpenOption]
+           [java.util Date]
+           [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(def ^:private types
+  "Column type -> Arrow format string and bytes per value."
+  {:bool      {:format "b"}
+   :int       {:format "i" :width 4}
+   :long      {:format "l" :width 8}
+   :float     {:format "f" :width 4}
+   :double    {:format "g" :width 8}
+   :string    {:format "u"}
+   :timestamp {:format "tsm:" :width 8}})
+
+(defn- pad8 ^long [^long n]
+  (bit-and (+ n 7) -8))
+
+(defn- buffer ^ByteBuffer [^long size]
+  (.order (ByteBuffer/allocate (int size)) ByteOrder/LITTLE_ENDIAN))
+
+(defn- utf8 ^bytes [s]
+  (.getBytes (str s) StandardCharsets/UTF_8))
+
+(defn- write! [path ^ByteBuffer buf append?]
+  (.flip buf)
+  (let [options (if append?
+                  [StandardOpenOption/WRITE StandardOpenOption/APPEND]
+                  [StandardOpenOption/WRITE StandardOpenOption/CREATE StandardOpenOption/TRUNCATE_EXISTING])]
+    (with-open [ch (FileChannel/open (Paths/get (str path) (make-array String 0))
+                                     ^"[Ljava.nio.file.OpenOption;" (into-array OpenOption options))]
+      (while (.hasRemaining buf)
+        (.write ch buf)))))
+
+(defn- bitmap ^bytes [pred values]
+  (let [bits (byte-array (quot (+ (count values) 7) 8))]
+    (doseq [[i v] (map-indexed vector values)
+            :when (pred v)]
+      (aset-byte bits (quot i 8) (unchecked-byte (bit-or (aget bits (quot i 8)) (bit-shift-left 1 (rem i 8))))))
+    bits))
+
+(defn- encode-values ^bytes [type values]
+  (let [n (count values)
+        width (long (:width (types type) 0))
+        buf (buffer (* n width))]
+    (doseq [v values]
+      (case type
+        :int (.putInt buf (int (or v 0)))
+        :long (.putLong buf (long (or v 0)))
+        :float (.putFloat buf (float (or v 0)))
+        :double (.putDouble buf (double (or v 0)))
+        :timestamp (.putLong buf (if (instance? Date v) (.getTime ^Date v) (long (or v 0))))))
+    (.array buf)))
+
+(defn- column-buffers
+  "[validity values data] for one column of a segment; nil for an absent buffer."
+  [type values]
+  (let [validity (when (some nil? values) (bitmap some? values))]
+    (case type
+      :bool [validity (bitmap true? values) nil]
+      :string (let [offsets (buffer (* 4 (inc (count values))))
+                    data (ByteArrayOutputStream.)]
+                (.putInt offsets 0)
+                (doseq [v values]
+                  (when (some? v)
+                    (.write data (utf8 v)))
+                  (.putInt offsets (.size data)))
+                [validity (.array offsets) (.toByteArray data)])
+      [validity (encode-values type values) nil])))
+
+(defn create!
+  "Create (or truncate) a column file and return a writer for append!.
+   columns: [[column type] ...] with type one of :bool :int :long :float
+   :double :string :timestamp (java.util.Date or epoch milliseconds)."
+  [path columns]
+  (let [entries (mapv (fn [[column type]]
+                        (let [format (:format (types type))]
+                          (when-not format
+                            (throw (IllegalArgumentException. (str "Unsupported column type " type))))
+                          [(utf8 (name column)) (utf8 format)]))
+                      columns)
+        size (pad8 (reduce + 16 (map (fn [[^bytes n ^bytes f]] (+ 4 (alength n) (alength f))) entries)))
+        buf (buffer size)]
+    (.put buf (.getBytes "CUIRQCF1" StandardCharsets/US_ASCII))
+    (.putInt buf (count entries))
+    (.putInt buf (int size))
+    (doseq [[^bytes n ^bytes f] entries]
+      (.putShort buf (short (alength n)))
+      (.putShort buf (short (alength f)))
+      (.put buf n)
+      (.put buf f))
+    (.position buf (int size))
+    (write! path buf false)
+    {:path (str path) :columns (vec columns)}))
+
+(defn append!
+  "Append rows (maps keyed by column) to the file as one segment and return
+   the number of rows written. Models show them after refresh!."
+  [{:keys [path columns]} rows]
+  (let [rows (vec rows)
+        parts (vec (for [[column type] columns
+                         part (column-buffers type (mapv #(get % column) rows))]
+                     part))
+        size (reduce + (+ 24 (* 24 (count columns)))
+                     (map (fn [^bytes part] (if part (pad8 (alength part)) 0)) parts))
+        buf (buffer size)]
+    (.put buf (.getBytes "SEG1" StandardCharsets/US_ASCII))
+    (.putInt buf 0)
+    (.putLong buf size)
+    (.putLong buf (count rows))
+    (doseq [^bytes part parts]
+      (.putLong buf (if part (alength part) 0)))
+    (doseq [^bytes part parts
+            :when part]
+      (.put buf part)
+      (.position buf (int (pad8 (.position buf)))))
+    (write! path buf true)
+    (count rows)))
+
+(defn open!
+  "Show a column file in model `model` (created on first use; reopening
+   resets it). Returns false if the file cannot be read."
+  [model path]
+  (Bridge/openMappedModel (name model) (str path)))
+
+(defn refresh!
+  "Show rows appended since the last refresh. With `rows`, show at most
+   that many (the writer's row count). Returns the rows shown."
+  ([model] (refresh! model -1))
+  ([model rows] (Bridge/refreshMappedModel (name model) (long rows))))
+
+(defn destroy!
+  "Unbind a mapped model from QML and unmap its file."
+  [model]
+  (Bridge/destroyMappedModel (name model)))
+
+(comment
+  (def w (create! "/tmp/trades.col" [[:symbol :string] [:price :double] [:size :long] [:ts :timestamp]]))
+  (open! :trades "/tmp/trades.col")
+
+  ;; QML: ListView { model: trades; delegate: Text { text: symbol + " " + price } }
+  (dotimes [_ 100]
+    (append! w (for [i (range 100000)]
+                 {:symbol (str "S" (mod i 500)) :price (rand 100.0) :size i :ts (System/currentTimeMillis)})))
+  (refresh! :trades)
+  (destroy! :trades))
@@ -52,6 +52,15 @@
     (Bridge/registerSignalHandler (name signal-name) java-handler)
     (println (str "[Clojure] Registered signal handler for: " (name signal-name)))))
 
+(defn emit-signal!
+  "Dispatch a signal to its registered handler as if QML had emitted it.
+
+   Example:
+     (emit-signal! :increment)
+     (emit-signal! :itemClicked \"42\")"
+  [signal-name & args]
+  (Bridge/emitSignal (name signal-name) (into-array String (map str args))))
+
 (defn set-auto-reload!
   "Enable or disable automatic QML hot-reload (dev mode).
 
@@ -0,0 +1,54 @@
+(ns cuirq.filters
+  "Filter-as-you-type views over list models, backed by a native trigram
+   index.
+
+   A filter view shows the rows of a source model (list, Arrow or mapped)
+   whose indexed roles contain the query, case-insensitively. The index
+   follows the source as rows change, so nothing is re-sent from the JVM
+   when the query changes.
+
+   QML:
+     TextField { onTextChanged: peopleFilter.query = text }
+     ListView { model: peopleFilter; delegate: Text { text: name } }"
+  (:require [cuirq.core :as core])
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn create!
+  "Create filter view `filter` over `source`, indexing `roles`.
+   Returns false if the name is taken or the source does not exist.
+
+   (create! :peopleFilter :people [:name :city])"
+  [filter source roles]
+  (Bridge/createFilterModel (name filter) (name source) (into-array String (map name roles))))
+
+(defn set-query!
+  "Show the rows matching `query` (empty shows all). Returns the number of
+   matching rows."
+  [filter query]
+  (Bridge/setFilterQuery (name filter) (str query)))
+
+(defn destroy!
+  "Unbind a filter view from QML and drop its index."
+  [filter]
+  (Bridge/destroyFilterModel (name filter)))
+
+(defn on-results!
+  "Call (f filter query count total) when a query runs or source changes
+   move rows in or out of a view."
+  [f]
+  (core/on-signal! :filterResults
+                   (fn [[filter query count total]]
+                     (f (keyword filter) query (parse-long count) (parse-long total)))))
+
+(comment
+  (require '[cuirq.models :as models])
+  (models/create-model! :people)
+  (models/set-data! :people (for [i (range 1000000)] {:name (str "Person " i) :city (rand-nth ["NYC" "SF" "LA"])}))
+
+  (create! :peopleFilter :people [:name :city])
+  (on-results! (fn [filter query n total] (println filter (pr-str query) n "/" total)))
+  (set-query! :peopleFilter "son 42")
+  (set-query! :peopleFilter "")
+  (destroy! :peopleFilter))
@@ -0,0 +1,103 @@
+(ns cuirq.images
+  "Images generated in the JVM, served to QML as image://jvm/<id>.
+
+   Pixels live in direct ByteBuffers that the bridge wraps without copying.
+   A buffer belongs to the bridge once pushed: never write to it again.
+
+   Image files on disk are better served by image://thumbs/<path>, which
+   decodes, scales and caches thumbnails natively (see configure-thumbnails!)."
+  (:require [clojure.data.json :as json])
+  (:import [java.awt.image BufferedImage]
+           [java.nio ByteBuffer ByteOrder]
+           [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(def formats
+  {:argb32-premultiplied Bridge/IMAGE_FORMAT_ARGB32_PREMULTIPLIED
+   :argb32               Bridge/IMAGE_FORMAT_ARGB32
+   :rgb32                Bridge/IMAGE_FORMAT_RGB32
+   :rgba8888             Bridge/IMAGE_FORMAT_RGBA8888
+   :rgb888               Bridge/IMAGE_FORMAT_RGB888
+   :grayscale8           Bridge/IMAGE_FORMAT_GRAYSCALE8})
+
+(defn url
+  "QML source URL for an image id and generation."
+  [id generation]
+  (str "image://jvm/" (name id) "?v=" generation))
+
+(defn put!
+  "Publish pixels from a direct ByteBuffer. Returns the URL to bind in QML,
+   or nil if the bridge rejected the image.
+
+   Example:
+     (put! :preview buf {:width 640 :height 480 :format :rgba8888})"
+  [id ^ByteBuffer pixels {:keys [width height stride format]
+                          :or {stride 0 format :argb32}}]
+  (let [generation (Bridge/putImage (name id) pixels (int width) (int height)
+                                    (int stride) (int (formats format)))]
+    (when-not (neg? generation)
+      (url id generation))))
+
+(defn buffered-image->buffer
+  "Copy a BufferedImage into a new native-order direct ByteBuffer of ARGB ints."
+  ^ByteBuffer [^BufferedImage image]
+  (let [w (.getWidth image)
+        h (.getHeight image)
+        argb (.getRGB image 0 0 w h nil 0 w)
+        buf (-> (ByteBuffer/allocateDirect (* 4 w h))
+                (.order (ByteOrder/nativeOrder)))]
+    (.put (.asIntBuffer buf) argb)
+    buf))
+
+(defn put-buffered-image!
+  "Publish a java.awt BufferedImage (one copy into a direct buffer).
+   Returns the URL to bind in QML."
+  [id ^BufferedImage image]
+  (put! id (buffered-image->buffer image)
+        {:width (.getWidth image) :height (.getHeight image) :format :argb32}))
+
+(defn remove!
+  "Drop an image. Returns true if it was cached."
+  [id]
+  (Bridge/removeImage (name id)))
+
+(defn set-cache-budget!
+  "Byte budget of the image cache; least recently used images are evicted."
+  [bytes]
+  (Bridge/setImageCacheBudget (long bytes)))
+
+(defn configure-thumbnails!
+  "Configure the image://thumbs/ pipeline. Omitted keys keep their value.
+
+   :cache-dir      disk cache directory (\"\" disables the disk cache)
+   :threads        decoder threads
+   :memory-budget  bytes of decoded thumbnails kept in memory"
+  [{:keys [cache-dir threads memory-budget]}]
+  (Bridge/configureThumbnails ^String cache-dir (int (or threads 0)) (long (or memory-budget -1))))
+
+(defn thumbnail-stats
+  "Thumbnail cache hits, misses, cancellations and decode-time percentiles (ns)."
+  []
+  (let [{:keys [counters gauges histograms]} (json/read-str (Bridge/getMetrics) :key-fn keyword)
+        thumbs? (fn [k] (.startsWith (name k) "thumbs."))]
+    (into {} (filter (comp thumbs? key)) (merge counters gauges histograms))))
+
+(comment
+  (import '[java.awt Color])
+  (def img (BufferedImage. 256 256 BufferedImage/TYPE_INT_ARGB))
+  (doto (.createGraphics img)
+    (.setColor Color/ORANGE)
+    (.fillOval 16 16 224 224)
+    (.dispose))
+
+  ;; Bind the returned URL to an Image's source, e.g. through state
+  (put-buffered-image! :logo img)
+  ;; => "image://jvm/logo?v=1"
+
+  (set-cache-budget! (* 64 1024 1024))
+  (remove! :logo)
+
+  ;; Thumbnails: Image { source: "image://thumbs/" + path; sourceSize: Qt.size(160, 160); asynchronous: true }
+  (configure-thumbnails! {:threads 4 :memory-budget (* 32 1024 1024)})
+  (thumbnail-stats))
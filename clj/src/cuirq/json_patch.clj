@@ -0,0 +1,40 @@
+(ns cuirq.json-patch
+  "RFC 6902 JSON Patch documents for models/apply-patch! and state/patch!.
+
+   Operations are maps; :op may be a keyword and :path / :from may be
+   vectors of keys and indices instead of JSON Pointer strings:
+
+     {:op :replace :path [3 :name] :value \"Alice\"}
+     {:op :move :from [0] :path [:-]}"
+  (:require [clojure.data.json :as json]
+            [clojure.string :as str]))
+
+(set! *warn-on-reflection* true)
+
+(defn pointer
+  "JSON Pointer (RFC 6901) for a vector of keys and indices; strings pass through.
+
+   (pointer [:user :tags 0]) ;; => \"/user/tags/0\""
+  [path]
+  (if (string? path)
+    path
+    (apply str (map (fn [token]
+                      (str "/" (-> (if (keyword? token) (name token) (str token))
+                                   (str/replace "~" "~0")
+                                   (str/replace "/" "~1"))))
+                    path))))
+
+(defn write-str
+  "Encode a sequence of operations as a JSON Patch document."
+  [ops]
+  (json/write-str
+   (mapv (fn [{:keys [op path from] :as operation}]
+           (cond-> (assoc operation :op (name op) :path (pointer path))
+             from (assoc :from (pointer from))))
+         ops)))
+
+(comment
+  (write-str [{:op :add :path [:-] :value {:id 9 :name "Ivy"}}
+              {:op :replace :path [0 :name] :value "Alice"}
+              {:op :move :from [5] :path [0]}])
+  )
@@ -0,0 +1,42 @@
+(ns cuirq.log
+  "Log level control for the native bridge.
+
+   Bridge logging is leveled (trace, debug, info, warning, error) and
+   written asynchronously. The default level is :info; hot-path messages
+   live at :debug and :trace."
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn set-level!
+  "Set the log level for all cuirq.* categories.
+
+   Accepts :trace, :debug, :info, :warning or :error (keyword or string).
+   Returns false if the level is unknown.
+
+   Example:
+     (set-level! :debug)"
+  [level]
+  (Bridge/setLogLevel (name level)))
+
+(defn level
+  "Return the current log level as a keyword."
+  []
+  (keyword (Bridge/getLogLevel)))
+
+(defn set-filter-rules!
+  "Apply Qt logging filter rules on top of the level, to open up
+   or silence single categories.
+
+   Categories: cuirq.bridge, cuirq.signal, cuirq.model, cuirq.watcher,
+   cuirq.state.
+
+   Example:
+     (set-filter-rules! \"cuirq.model.debug=true\")"
+  [rules]
+  (Bridge/setLogFilterRules rules))
+
+(comment
+  (set-level! :debug)
+  (level)
+  (set-filter-rules! "cuirq.model.debug=true\ncuirq.signal.info=false"))
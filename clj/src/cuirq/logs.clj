@@ -0,0 +1,77 @@
+(ns cuirq.logs
+  "Large log files shown natively by the LogView QML item.
+
+   QML:
+     import Cuirq 1.0
+     LogView { name: \"server\"; anchors.fill: parent }
+
+   The file is memory-mapped and indexed on a background thread; only the
+   visible lines are ever decoded. The JVM passes a path and gets events
+   back: indexing progress, truncation, and search matches as they are
+   found."
+  (:require [cuirq.core :as core])
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn open!
+  "Show a file in a LogView. With :follow true, appended data is indexed
+   as it arrives and the view sticks to the end (tail -f).
+
+   (open! :server \"/var/log/server.log\" :follow true)"
+  [view path & {:keys [follow] :or {follow false}}]
+  (Bridge/openLogView (name view) (str path) (boolean follow)))
+
+(defn search!
+  "Search the indexed part of the file in the background, cancelling the
+   previous search. Returns the search id (-1 for an invalid regex)."
+  [view pattern & {:keys [regex case-sensitive] :or {regex false case-sensitive true}}]
+  (Bridge/searchLogView (name view) (str pattern) (boolean regex) (boolean case-sensitive)))
+
+(defn cancel-search!
+  [view]
+  (Bridge/cancelLogSearch (name view)))
+
+(defn scroll-to!
+  "Make `line` (0-based) the first visible line."
+  [view line]
+  (Bridge/scrollLogView (name view) (long line)))
+
+(defn on-indexed!
+  "Call (f view lines bytes done?) as indexing progresses (throttled)."
+  [f]
+  (core/on-signal! :logViewIndexed
+                   (fn [[view lines bytes done]]
+                     (f (keyword view) (parse-long lines) (parse-long bytes) (parse-boolean done)))))
+
+(defn on-truncated!
+  "Call (f view) when a followed file is truncated and reloaded."
+  [f]
+  (core/on-signal! :logViewTruncated
+                   (fn [[view]] (f (keyword view)))))
+
+(defn on-matches!
+  "Call (f view search-id matches) for each batch of matches, where
+   matches is a vector of [line column length]."
+  [f]
+  (core/on-signal! :logViewMatches
+                   (fn [[view id & triples]]
+                     (f (keyword view) (parse-long id)
+                        (into [] (comp (map parse-long) (partition-all 3)) triples)))))
+
+(defn on-search-finished!
+  "Call (f view search-id total cancelled?) when a search ends."
+  [f]
+  (core/on-signal! :logViewSearchFinished
+                   (fn [[view id total cancelled]]
+                     (f (keyword view) (parse-long id) (parse-long total) (parse-boolean cancelled)))))
+
+(comment
+  (on-indexed! (fn [view lines bytes done?]
+                 (when done? (println view "indexed" lines "lines," bytes "bytes"))))
+  (on-matches! (fn [view id matches] (println view id (count matches) "matches")))
+
+  (open! :server "/var/log/system.log" :follow true)
+  (search! :server "error|warn" :regex true :case-sensitive false)
+  (cancel-search! :server)
+  (scroll-to! :server 0))
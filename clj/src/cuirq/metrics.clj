@@ -0,0 +1,35 @@
+(ns cuirq.metrics
+  "Runtime metrics of the native bridge.
+
+   Counters, gauges and latency histograms are always on and cheap;
+   read them as a snapshot to inspect from the REPL or export to monitoring."
+  (:refer-clojure :exclude [reset!])
+  (:require [clojure.data.json :as json])
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn snapshot
+  "Return the current metrics as a Clojure map.
+
+   Example:
+     (get-in (snapshot) [:histograms :jni.setModelData.latency_ns :p99])
+     (get-in (snapshot) [:models :todos :resets])"
+  []
+  (json/read-str (Bridge/getMetrics) :key-fn keyword))
+
+(defn reset!
+  "Zero all counters and histograms."
+  []
+  (Bridge/resetMetrics))
+
+(defn hud!
+  "Show or hide the on-screen performance HUD.
+   Returns false if the HUD is compiled out of this build."
+  [visible?]
+  (Bridge/setPerfHudVisible (boolean visible?)))
+
+(comment
+  (snapshot)
+  (reset!)
+  (hud! true))
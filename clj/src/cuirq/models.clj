@@ -1,6 +1,8 @@
 (ns cuirq.models
   "List model API for QML ListView/GridView."
-  (:require [clojure.data.json :as json])
+  (:require [clojure.data.json :as json]
+            [cuirq.core :as core]
+            [cuirq.json-patch :as json-patch])
   (:import [qml Bridge]))
 
 (set! *warn-on-reflection* true)
@@ -47,6 +49,73 @@
   [model-name]
   (Bridge/getModelCount (name model-name)))
 
+(defn set-key!
+  "Index a model's rows by the value of `role`, so patch! finds a row by
+   key however rows are ordered. nil removes the index.
+
+   (set-key! :people :id)"
+  [model-name role]
+  (Bridge/setModelKey (name model-name) (if role (name role) "")))
+
+(defn patch!
+  "Set one field of the row whose key role equals `key`. Only that row and
+   role are updated in QML. Returns false if no row has the key.
+
+   (patch! :people 42 :age 31)"
+  [model-name key role value]
+  (Bridge/patchModel (name model-name) (str key) (name role) (json/write-str value)))
+
+(defn patch-many!
+  "Apply [key role value] patches in one call. Returns the number applied.
+
+   (patch-many! :people [[42 :age 31] [7 :city \"Oslo\"]])"
+  [model-name patches]
+  (Bridge/patchModelMany (name model-name)
+                         (json/write-str (mapv (fn [[key role value]] [(str key) (name role) value]) patches))))
+
+(defn apply-patch!
+  "Apply a JSON Patch (RFC 6902) to a model's rows: [3] is a row ([:-]
+   appends) and [3 :name] a field of it. Inserted, removed and moved rows
+   reach QML as such, not as a reset. All or nothing: returns false and
+   leaves the model unchanged if any operation fails.
+
+   (apply-patch! :people [{:op :add :path [:-] :value {:id 9 :name \"Ivy\"}}
+                          {:op :move :from [5] :path [0]}
+                          {:op :replace :path [0 :status] :value \"online\"}])"
+  [model-name ops]
+  (Bridge/applyModelPatch (name model-name) (json-patch/write-str ops)))
+
+(defn destroy!
+  "Destroy a model and free its rows. QML bindings to it become null.
+   Returns true if the model existed."
+  [model-name]
+  (Bridge/destroyModel (name model-name)))
+
+(defn memory
+  "Approximate heap footprint of a model in bytes, or nil if it does not exist."
+  [model-name]
+  (let [bytes (Bridge/getModelMemory (name model-name))]
+    (when-not (neg? bytes) bytes)))
+
+(defn memory-report
+  "Memory breakdown of every model, keyed by model name:
+   {:items {:total 51234 :rows 20480 :strings 30210 :roles 544 :budget 0}}"
+  []
+  (json/read-str (Bridge/getModelMemoryReport) :key-fn keyword))
+
+(defn set-memory-budget!
+  "Warn when a model grows above `bytes` (nil or 0 removes the budget).
+   See `on-budget-exceeded!`."
+  [model-name bytes]
+  (Bridge/setModelMemoryBudget (name model-name) (long (or bytes 0))))
+
+(defn on-budget-exceeded!
+  "Call (f model-name bytes budget) whenever a model goes over its budget."
+  [f]
+  (core/on-signal! :modelMemoryBudgetExceeded
+                   (fn [[model-name bytes budget]]
+                     (f (keyword model-name) (parse-long bytes) (parse-long budget)))))
+
 (comment
   ;; Usage examples
 
@@ -66,4 +135,19 @@
   (clear! :people)
 
   ;; Check count
-  (count-items :people))
+  (count-items :people)
+
+  ;; Patch single fields by key
+  (set-key! :people :name)
+  (patch! :people "Alice" :age 32)
+  (patch-many! :people [["Alice" :city "Boston"] ["Bob" :age 26]])
+
+  ;; Memory
+  (memory :people)
+  (memory-report)
+  (set-memory-budget! :people (* 10 1024 1024))
+  (on-budget-exceeded! (fn [model bytes budget]
+                         (println model "uses" bytes "bytes, budget" budget)))
+
+  ;; Free it
+  (destroy! :people))
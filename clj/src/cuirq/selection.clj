@@ -0,0 +1,79 @@
+(ns cuirq.selection
+  "Multi-row selection over list models, stored natively as row ranges.
+
+   A selection view passes a model's rows through and adds an `isSelected`
+   role. Selecting, toggling or inverting any number of rows is one range
+   edit and one dataChanged for the touched rows: no `selected` role is
+   pushed through set-data!, and the model is never reset.
+
+   QML:
+     ListView {
+       model: peopleSelection
+       delegate: Rectangle {
+         color: isSelected ? \"lightsteelblue\" : \"white\"
+         TapHandler { onTapped: peopleSelection.toggle(index) }
+       }
+     }
+   Also: select(first, last), deselect(first, last), selectAll(),
+   clearSelection(), invert(), isSelected(row), selectedCount."
+  (:require [cuirq.core :as core])
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(def ^:private ops
+  {:select   Bridge/SELECTION_SELECT
+   :deselect Bridge/SELECTION_DESELECT
+   :toggle   Bridge/SELECTION_TOGGLE
+   :all      Bridge/SELECTION_ALL
+   :clear    Bridge/SELECTION_CLEAR
+   :invert   Bridge/SELECTION_INVERT})
+
+(defn create!
+  "Create selection view `selection` over `source` (any bridge model,
+   including filter views). Returns false if the name is taken or the
+   source does not exist."
+  [selection source]
+  (Bridge/createSelectionModel (name selection) (name source)))
+
+(defn change!
+  "Apply op (:select :deselect :toggle over rows first..last inclusive, or
+   :all :clear :invert). Returns the number of selected rows.
+
+   (change! :peopleSelection :select 100 200099)"
+  ([selection op] (change! selection op 0 -1))
+  ([selection op first last]
+   (Bridge/changeSelection (name selection) (int (ops op)) (int first) (int last))))
+
+(defn select-all! [selection] (change! selection :all))
+(defn clear! [selection] (change! selection :clear))
+(defn invert! [selection] (change! selection :invert))
+
+(defn ranges
+  "Selected rows as sorted inclusive [first last] pairs, read in one call."
+  [selection]
+  (into [] (partition-all 2) (Bridge/getSelectionRanges (name selection))))
+
+(defn destroy!
+  "Unbind a selection view from QML."
+  [selection]
+  (Bridge/destroySelectionModel (name selection)))
+
+(defn on-change!
+  "Call (f selection count) after every edit, including those made in QML."
+  [f]
+  (core/on-signal! :selectionChanged
+                   (fn [[selection n]] (f (keyword selection) (parse-long n)))))
+
+(comment
+  (require '[cuirq.models :as models])
+  (models/create-model! :people)
+  (models/set-data! :people (for [i (range 1000000)] {:name (str "Person " i)}))
+
+  (create! :peopleSelection :people)
+  (on-change! (fn [selection n] (println selection n "selected")))
+  (change! :peopleSelection :select 10 200009)
+  (change! :peopleSelection :toggle 50 60)
+  (invert! :peopleSelection)
+  (ranges :peopleSelection)
+  (destroy! :peopleSelection))
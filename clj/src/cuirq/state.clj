@@ -3,7 +3,9 @@
    This namespace provides a simple atom-based state management system
    that automatically syncs to QML context properties."
   (:require [cuirq.core :as cuirq]
-            [clojure.string :as str]))
+            [cuirq.json-patch :as json-patch]
+            [clojure.string :as str])
+  (:import [qml Bridge]))
 
 (defonce ^:private app-state (atom {}))
 
@@ -59,6 +61,19 @@
   [path f & args]
   (apply update-state! update-in path f args))
 
+(defn patch!
+  "Edit nested QML state in place with a JSON Patch (RFC 6902); each path
+   starts with a property name. Meant for structured values that live only
+   on the QML side (set-state! sends strings), e.g. a document added with
+   {:op :add :path [:doc] :value {...}} and then patched field by field.
+   All or nothing: returns false and changes nothing if any operation fails.
+
+   Example:
+     (patch! [{:op :replace :path [:doc :title] :value \"Draft 2\"}
+              {:op :add :path [:doc :tags :-] :value \"review\"}])"
+  [ops]
+  (Bridge/applyStatePatch (json-patch/write-str ops)))
+
 (defn watch-state!
   "Add a watch function that is called when state changes.
   Example:
@@ -89,6 +104,10 @@
   (assoc-in-state! [:user :name] "Alice")
   (update-in-state! [:user :age] inc)
 
+  ;; Structured state edited in place
+  (patch! [{:op :add :path [:doc] :value {:title "Draft" :tags []}}])
+  (patch! [{:op :add :path [:doc :tags :-] :value "review"}])
+
   ;; Watch state changes
   (watch-state! :logger
     (fn [_ _ old new]
@@ -0,0 +1,55 @@
+(ns cuirq.strokes
+  "Freehand strokes rendered natively by the StrokeCanvas QML item.
+
+   QML:
+     import Cuirq 1.0
+     StrokeCanvas { name: \"sketch\"; anchors.fill: parent; penWidth: 3 }
+
+   Pointer input is handled natively; points generated in the JVM (pen
+   tablets, replays, collaborative edits) are appended in bulk. Only new
+   segments are tessellated per frame, and undo/redo repaints just the
+   tiles a stroke covered."
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn append!
+  "Append [[x y] ...] to the stroke in progress, starting one if needed.
+   Options (used when a stroke starts): :color (ARGB int), :width.
+   :end? finishes the stroke. Returns the number of points added."
+  ([canvas points] (append! canvas points {}))
+  ([canvas points {:keys [color width end?] :or {color 0xff000000 width 3.0 end? false}}]
+   (Bridge/appendStrokePoints (name canvas)
+                              (float-array (mapcat identity points))
+                              (unchecked-int color)
+                              (float width)
+                              (boolean end?))))
+
+(defn stroke!
+  "Draw a complete stroke in one call."
+  ([canvas points] (stroke! canvas points {}))
+  ([canvas points opts] (append! canvas points (assoc opts :end? true))))
+
+(defn undo!
+  "Undo the last stroke (or discard the one in progress)."
+  [canvas]
+  (Bridge/undoStroke (name canvas)))
+
+(defn redo!
+  [canvas]
+  (Bridge/redoStroke (name canvas)))
+
+(defn clear!
+  "Remove all strokes and the undo history."
+  [canvas]
+  (Bridge/clearStrokes (name canvas)))
+
+(comment
+  (stroke! :sketch (for [t (range 0 6.28 0.05)]
+                     [(+ 300 (* 200 (Math/cos t))) (+ 200 (* 120 (Math/sin (* 2 t))))])
+           {:color 0xffd03030 :width 4})
+  (append! :sketch [[10 10] [40 30]])
+  (append! :sketch [[80 20] [120 60]] {:end? true})
+  (undo! :sketch)
+  (redo! :sketch)
+  (clear! :sketch))
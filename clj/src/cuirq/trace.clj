@@ -0,0 +1,66 @@
+(ns cuirq.trace
+  "Cross-language span tracing.
+
+   Spans from Clojure land in the same buffer as spans from the native
+   bridge and QML, so one trace shows where a slow click went: QML JS,
+   JNI marshaling, the Clojure handler or the model reset.
+   Dump the result and open it in https://ui.perfetto.dev"
+  (:import [qml Bridge]))
+
+(set! *warn-on-reflection* true)
+
+(defn enable!
+  "Start recording spans."
+  []
+  (Bridge/setTracingEnabled true))
+
+(defn disable!
+  "Stop recording spans (buffered spans are kept)."
+  []
+  (Bridge/setTracingEnabled false))
+
+(defn enabled?
+  "Check if spans are being recorded."
+  []
+  (Bridge/isTracingEnabled))
+
+(defmacro with-span
+  "Record body as a span named `span-name` (category \"clj\").
+
+   Example:
+     (with-span \"load-todos\"
+       (models/set-data! :todos (fetch-todos)))"
+  [span-name & body]
+  `(if (Bridge/isTracingEnabled)
+     (do
+       (Bridge/traceBegin ~span-name "clj")
+       (try
+         ~@body
+         (finally
+           (Bridge/traceEnd))))
+     (do ~@body)))
+
+(defn name-thread!
+  "Name the calling thread in the trace (e.g. \"nrepl\")."
+  [thread-name]
+  (Bridge/setTraceThreadName thread-name))
+
+(defn dump!
+  "Write buffered spans as Chrome trace JSON. Returns true on success.
+
+   Example:
+     (disable!)
+     (dump! \"/tmp/cuirq-trace.json\")"
+  [path]
+  (Bridge/dumpTrace path))
+
+(defn clear!
+  "Drop all buffered spans."
+  []
+  (Bridge/clearTrace))
+
+(comment
+  (enable!)
+  (with-span "update" (Thread/sleep 5))
+  (disable!)
+  (dump! "/tmp/cuirq-trace.json"))
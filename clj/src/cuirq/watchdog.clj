@@ -0,0 +1,57 @@
+(ns cuirq.watchdog
+  "GUI-thread stall watchdog.
+
+   Reports when the Qt event loop is blocked longer than a threshold,
+   e.g. by a slow signal handler or a huge model update, together with
+   the bridge operation or signal that was running."
+  (:import [qml Bridge Bridge$StallHandler]))
+
+(set! *warn-on-reflection* true)
+
+(defn start!
+  "Start watching the GUI thread.
+
+   Options:
+     :threshold-ms  Stall threshold (default 200)
+     :java-stack?   Capture the Java stack of the GUI thread (default false)"
+  ([] (start! {}))
+  ([{:keys [threshold-ms java-stack?] :or {threshold-ms 200 java-stack? false}}]
+   (Bridge/setStallWatchdog (long threshold-ms) (boolean java-stack?))))
+
+(defn stop!
+  "Stop the watchdog."
+  []
+  (Bridge/setStallWatchdog 0 false))
+
+(defn on-stall!
+  "Register a stall callback (nil to remove).
+
+   handler-fn receives a map:
+     {:operation \"signal\" :detail \"buttonClicked\" :duration-ms 850
+      :recovered? false :java-stack \"\\tat ...\"}
+
+   It is called on the watchdog thread, once when a stall is detected
+   and once when the GUI thread recovers.
+
+   Example:
+     (on-stall! (fn [{:keys [operation detail duration-ms recovered?]}]
+                  (when recovered?
+                    (println \"GUI stalled\" duration-ms \"ms in\" operation detail))))"
+  [handler-fn]
+  (Bridge/setStallHandler
+   (when handler-fn
+     (reify Bridge$StallHandler
+       (onStall [_ operation detail duration-ms recovered java-stack]
+         (try
+           (handler-fn {:operation operation
+                        :detail detail
+                        :duration-ms duration-ms
+                        :recovered? recovered
+                        :java-stack java-stack})
+           (catch Throwable t
+             (println (str "[Clojure] Error in stall handler: " (.getMessage t))))))))))
+
+(comment
+  (on-stall! #(println "stall:" (dissoc % :java-stack)))
+  (start! {:threshold-ms 100 :java-stack? true})
+  (stop!))
@@ -0,0 +1,210 @@
+#include "arrowcolumn.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QString>
+#include <QTimeZone>
+#include <cstring>
+
+namespace {
+
+bool bit(const uchar* bits, qint64 index)
+{
+    return bits[index >> 3] & (1u << (index & 7));
+}
+
+template <typename T>
+T at(const void* values, qint64 index)
+{
+    return static_cast<const T*>(values)[index];
+}
+
+} // namespace
+
+ArrowColumn::Type ArrowColumn::parseFormat(const char* format, qint64* ticksPerSecond)
+{
+    if (!format || !*format) {
+        return Unsupported;
+    }
+    if (format[1] == '\0') {
+        switch (format[0]) {
+        case 'b': return Bool;
+        case 'c': return Int8;
+        case 'C': return UInt8;
+        case 's': return Int16;
+        case 'S': return UInt16;
+        case 'i': return Int32;
+        case 'I': return UInt32;
+        case 'l': return Int64;
+        case 'L': return UInt64;
+        case 'f': return Float32;
+        case 'g': return Float64;
+        case 'u': return Utf8;
+        case 'U': return LargeUtf8;
+        default: return Unsupported;
+        }
+    }
+    if (std::strcmp(format, "tdD") == 0) {
+        return Date32;
+    }
+    if (std::strcmp(format, "tdm") == 0) {
+        return Date64;
+    }
+    // "ts" + unit + ":" + optional timezone (values are UTC either way)
+    if (format[0] == 't' && format[1] == 's' && format[2] != '\0' && format[3] == ':') {
+        qint64 ticks = 0;
+        switch (format[2]) {
+        case 's': ticks = 1; break;
+        case 'm': ticks = 1000; break;
+        case 'u': ticks = 1000000; break;
+        case 'n': ticks = 1000000000; break;
+        default: return Unsupported;
+        }
+        if (ticksPerSecond) {
+            *ticksPerSecond = ticks;
+        }
+        return Timestamp;
+    }
+    return Unsupported;
+}
+
+int ArrowColumn::bufferCount(Type type)
+{
+    switch (type) {
+    case Unsupported: return 0;
+    case Utf8:
+    case LargeUtf8: return 3;
+    default: return 2;
+    }
+}
+
+int ArrowColumn::valueWidth(Type type)
+{
+    switch (type) {
+    case Int8:
+    case UInt8: return 1;
+    case Int16:
+    case UInt16: return 2;
+    case Int32:
+    case UInt32:
+    case Float32:
+    case Utf8:
+    case Date32: return 4;
+    case Int64:
+    case UInt64:
+    case Float64:
+    case LargeUtf8:
+    case Date64:
+    case Timestamp: return 8;
+    case Bool:
+    case Unsupported: return 0;
+    }
+    return 0;
+}
+
+ArrowColumn ArrowColumn::fromArrow(const ArrowSchema* schema, const ArrowArray* array, qint64 parentOffset)
+{
+    ArrowColumn column;
+    if (!schema || !array) {
+        return column;
+    }
+    qint64 ticks = 1;
+    const Type type = parseFormat(schema->format, &ticks);
+    if (type == Unsupported || array->n_buffers < bufferCount(type)) {
+        return column;
+    }
+    if (schema->dictionary) {
+        // Dictionary-encoded: this array holds integer keys
+        if (type == Bool || type >= Float32 || !array->dictionary) {
+            return column;
+        }
+        ArrowColumn values = fromArrow(schema->dictionary, array->dictionary);
+        if (values.type == Unsupported) {
+            return column;
+        }
+        column.dictionary = std::make_shared<const ArrowColumn>(std::move(values));
+    }
+
+    column.type = type;
+    column.offset = array->offset + parentOffset;
+    column.length = array->length - parentOffset;
+    column.ticksPerSecond = ticks;
+    column.validity = array->null_count != 0 ? static_cast<const uchar*>(array->buffers[0]) : nullptr;
+    column.values = array->buffers[1];
+    column.data = bufferCount(type) > 2 ? static_cast<const char*>(array->buffers[2]) : nullptr;
+    return column;
+}
+
+bool ArrowColumn::isNull(qint64 row) const
+{
+    return validity && !bit(validity, offset + row);
+}
+
+qint64 ArrowColumn::integer(qint64 index) const
+{
+    switch (type) {
+    case Int8: return at<qint8>(values, index);
+    case UInt8: return at<quint8>(values, index);
+    case Int16: return at<qint16>(values, index);
+    case UInt16: return at<quint16>(values, index);
+    case Int32: return at<qint32>(values, index);
+    case UInt32: return at<quint32>(values, index);
+    case Int64: return at<qint64>(values, index);
+    case UInt64: return static_cast<qint64>(at<quint64>(values, index));
+    default: return 0;
+    }
+}
+
+QVariant ArrowColumn::value(qint64 row) const
+{
+    if (type == Unsupported || row < 0 || row >= length || !values) {
+        return QVariant();
+    }
+    if (isNull(row)) {
+        return QVariant::fromValue(nullptr);
+    }
+    const qint64 i = offset + row;
+    if (dictionary) {
+        return dictionary->value(integer(i));
+    }
+
+    switch (type) {
+    case Bool:
+        return bit(static_cast<const uchar*>(values), i);
+    case Int8:
+    case UInt8:
+    case Int16:
+    case UInt16:
+    case Int32:
+        return static_cast<int>(integer(i));
+    case UInt32:
+    case Int64:
+        return static_cast<qlonglong>(integer(i));
+    case UInt64:
+        return static_cast<qulonglong>(at<quint64>(values, i));
+    case Float32:
+        return static_cast<double>(at<float>(values, i));
+    case Float64:
+        return at<double>(values, i);
+    case Utf8: {
+        const qint32 begin = at<qint32>(values, i);
+        return QString::fromUtf8(data + begin, at<qint32>(values, i + 1) - begin);
+    }
+    case LargeUtf8: {
+        const qint64 begin = at<qint64>(values, i);
+        return QString::fromUtf8(data + begin, at<qint64>(values, i + 1) - begin);
+    }
+    case Date32:
+        return QDate(1970, 1, 1).addDays(at<qint32>(values, i));
+    case Date64:
+        return QDateTime::fromMSecsSinceEpoch(at<qint64>(values, i), QTimeZone::utc()).date();
+    case Timestamp: {
+        const qint64 ticks = at<qint64>(values, i);
+        const qint64 msecs = ticksPerSecond >= 1000 ? ticks / (ticksPerSecond / 1000) : ticks * 1000;
+        return QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::utc());
+    }
+    case Unsupported:
+        break;
+    }
+    return QVariant();
+}
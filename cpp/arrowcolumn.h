@@ -0,0 +1,118 @@
+#ifndef ARROWCOLUMN_H
+#define ARROWCOLUMN_H
+
+#include <QVariant>
+#include <QtGlobal>
+#include <cstdint>
+#include <memory>
+
+// ---------------------------------------------------------------------------
+// Arrow C Data Interface
+//
+// ABI-stable structures defined by the Arrow specification, which asks
+// consumers to copy them rather than depend on Arrow:
+// https://arrow.apache.org/docs/format/CDataInterface.html
+// ---------------------------------------------------------------------------
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema
+{
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray
+{
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+/**
+ * ArrowColumn - Reads values of one Arrow-layout column in place.
+ *
+ * Points at the validity bitmap and value buffers of a column (from an
+ * exported ArrowArray, or from mapped file pages) and converts a single
+ * cell to a QVariant when asked. Nothing is copied up front; strings are
+ * decoded per cell.
+ *
+ * Supported formats: b, c/C, s/S, i/I, l/L, f, g, u, U, tdD, tdm, ts?:
+ * and dictionary-encoded columns with integer indices. Other formats read
+ * as invalid values. Null cells read as null.
+ */
+struct ArrowColumn
+{
+    enum Type {
+        Unsupported,
+        Bool,
+        Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+        Float32, Float64,
+        Utf8, LargeUtf8,
+        Date32, Date64, Timestamp
+    };
+
+    Type type = Unsupported;
+    qint64 offset = 0;               // Logical offset into every buffer
+    qint64 length = 0;
+    const uchar* validity = nullptr; // Null bitmap, or nullptr if no nulls
+    const void* values = nullptr;    // Values, bits, or string offsets
+    const char* data = nullptr;      // String bytes
+    qint64 ticksPerSecond = 1;       // Timestamp unit
+    std::shared_ptr<const ArrowColumn> dictionary;
+
+    // Type of a format string; sets `ticksPerSecond` for timestamps
+    static Type parseFormat(const char* format, qint64* ticksPerSecond = nullptr);
+
+    // Buffers an array of this type carries (validity included)
+    static int bufferCount(Type type);
+
+    // Bytes per value (per offset for strings); 0 for bit-packed booleans
+    static int valueWidth(Type type);
+
+    // Column over an exported array. `parentOffset` is the offset of the
+    // enclosing struct array. Returns an Unsupported column if the format
+    // or buffers do not match.
+    static ArrowColumn fromArrow(const ArrowSchema* schema, const ArrowArray* array, qint64 parentOffset = 0);
+
+    bool isNull(qint64 row) const;
+    QVariant value(qint64 row) const;
+
+private:
+    qint64 integer(qint64 index) const;  // Integer types (dictionary keys)
+};
+
+#endif // ARROWCOLUMN_H
@@ -0,0 +1,205 @@
+#include "arrowlistmodel.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iterator>
+
+ArrowListModel::ArrowListModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+ArrowListModel::~ArrowListModel()
+{
+    releaseAll(m_batches);
+}
+
+int ArrowListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+QVariant ArrowListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows) {
+        return QVariant();
+    }
+    const int column = role - (Qt::UserRole + 1);
+    if (column < 0 || column >= m_columns.size()) {
+        return QVariant();
+    }
+
+    // Batches are few: binary search on their first row
+    const auto it = std::upper_bound(m_batches.cbegin(), m_batches.cend(), index.row(),
+                                     [](int row, const std::unique_ptr<Batch>& batch) { return row < batch->first; });
+    const Batch& batch = **std::prev(it);
+    return batch.columns[column].value(index.row() - batch.first);
+}
+
+QHash<int, QByteArray> ArrowListModel::roleNames() const
+{
+    return m_roleNames;
+}
+
+void ArrowListModel::release(ArrowSchema* schema, ArrowArray* array)
+{
+    if (array && array->release) {
+        array->release(array);
+    }
+    if (schema && schema->release) {
+        schema->release(schema);
+    }
+}
+
+QVector<QByteArray> ArrowListModel::columnNames(const ArrowSchema& schema)
+{
+    QVector<QByteArray> names;
+    names.reserve(static_cast<int>(schema.n_children));
+    for (int64_t c = 0; c < schema.n_children; ++c) {
+        const char* name = schema.children[c]->name;
+        names.append(name && *name ? QByteArray(name) : QByteArray("column") + QByteArray::number(c));
+    }
+    return names;
+}
+
+std::unique_ptr<ArrowListModel::Batch> ArrowListModel::adopt(ArrowSchema* schema, ArrowArray* array)
+{
+    static Counter& adopted = Metrics::counter("model.arrow_batches");
+
+    if (!schema || !array || !schema->release || !array->release) {
+        qCWarning(lcModel) << "ArrowListModel: Batch is missing or already released";
+        release(schema, array);
+        return nullptr;
+    }
+
+    // Move: the producer's structs are now marked released
+    auto batch = std::make_unique<Batch>();
+    batch->schema = *schema;
+    batch->array = *array;
+    schema->release = nullptr;
+    array->release = nullptr;
+
+    const bool isStruct = batch->schema.format && std::strcmp(batch->schema.format, "+s") == 0;
+    if (!isStruct || batch->schema.n_children != batch->array.n_children) {
+        qCWarning(lcModel) << "ArrowListModel: Expected a record batch (struct array), got format"
+                           << batch->schema.format;
+        release(&batch->schema, &batch->array);
+        return nullptr;
+    }
+
+    batch->columns.reserve(static_cast<int>(batch->array.n_children));
+    for (int64_t c = 0; c < batch->array.n_children; ++c) {
+        const ArrowSchema* field = batch->schema.children[c];
+        ArrowColumn column = ArrowColumn::fromArrow(field, batch->array.children[c], batch->array.offset);
+        if (column.type == ArrowColumn::Unsupported) {
+            qCWarning(lcModel) << "ArrowListModel: Column" << field->name << "has unsupported format"
+                               << field->format << "and reads as undefined";
+        }
+        batch->columns.append(std::move(column));
+    }
+    adopted.add();
+    return batch;
+}
+
+void ArrowListModel::releaseAll(std::vector<std::unique_ptr<Batch>>& batches)
+{
+    for (const std::unique_ptr<Batch>& batch : batches) {
+        release(&batch->schema, &batch->array);
+    }
+    batches.clear();
+}
+
+bool ArrowListModel::setBatch(ArrowSchema* schema, ArrowArray* array)
+{
+    static Counter& resets = Metrics::counter("model.resets");
+    CUIRQ_TRACE_SCOPE("ArrowListModel::setBatch", "model");
+
+    std::unique_ptr<Batch> batch = adopt(schema, array);
+    if (!batch) {
+        return false;
+    }
+    if (batch->array.length > INT_MAX) {
+        qCWarning(lcModel) << "ArrowListModel: Batch of" << batch->array.length << "rows is too large";
+        release(&batch->schema, &batch->array);
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Batch>> old;
+    beginResetModel();
+    old.swap(m_batches);
+    m_columns = columnNames(batch->schema);
+    m_roleNames.clear();
+    for (int c = 0; c < m_columns.size(); ++c) {
+        m_roleNames.insert(Qt::UserRole + 1 + c, m_columns[c]);
+    }
+    batch->first = 0;
+    m_rows = static_cast<int>(batch->array.length);
+    m_batches.push_back(std::move(batch));
+    endResetModel();
+
+    // Views no longer reference the old buffers
+    releaseAll(old);
+    ++m_resets;
+    resets.add();
+    qCDebug(lcModel) << "ArrowListModel" << objectName() << "now has" << m_rows << "rows," << m_columns.size() << "roles";
+    return true;
+}
+
+bool ArrowListModel::appendBatch(ArrowSchema* schema, ArrowArray* array)
+{
+    if (m_batches.empty()) {
+        return setBatch(schema, array);
+    }
+    CUIRQ_TRACE_SCOPE("ArrowListModel::appendBatch", "model");
+
+    std::unique_ptr<Batch> batch = adopt(schema, array);
+    if (!batch) {
+        return false;
+    }
+    if (columnNames(batch->schema) != m_columns) {
+        qCWarning(lcModel) << "ArrowListModel: Appended batch has different columns" << columnNames(batch->schema);
+        release(&batch->schema, &batch->array);
+        return false;
+    }
+    const int64_t rows = batch->array.length;
+    if (rows > INT_MAX - m_rows) {
+        qCWarning(lcModel) << "ArrowListModel: Too many rows";
+        release(&batch->schema, &batch->array);
+        return false;
+    }
+    if (rows == 0) {
+        release(&batch->schema, &batch->array);
+        return true;
+    }
+
+    beginInsertRows(QModelIndex(), m_rows, m_rows + static_cast<int>(rows) - 1);
+    batch->first = m_rows;
+    m_rows += static_cast<int>(rows);
+    m_batches.push_back(std::move(batch));
+    endInsertRows();
+    return true;
+}
+
+void ArrowListModel::clear()
+{
+    std::vector<std::unique_ptr<Batch>> old;
+    beginResetModel();
+    old.swap(m_batches);
+    m_rows = 0;
+    endResetModel();
+    releaseAll(old);
+    ++m_resets;
+}
+
+QJsonObject ArrowListModel::statistics() const
+{
+    return QJsonObject{
+        { "rows", m_rows },
+        { "roles", static_cast<qint64>(m_roleNames.size()) },
+        { "batches", static_cast<qint64>(m_batches.size()) },
+        { "resets", static_cast<qint64>(m_resets) }
+    };
+}
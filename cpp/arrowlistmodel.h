@@ -0,0 +1,78 @@
+#ifndef ARROWLISTMODEL_H
+#define ARROWLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+#include "arrowcolumn.h"
+
+/**
+ * ArrowListModel - QAbstractListModel over Arrow record batches.
+ *
+ * Takes ownership of record batches exported through the Arrow C Data
+ * Interface (a struct ArrowArray and its ArrowSchema, e.g. from Arrow
+ * Java's Data.exportVectorSchemaRoot). Each column becomes a role named
+ * after the field; data() reads the Arrow buffers in place, so rows are
+ * never converted to maps or JSON.
+ *
+ * Batches are moved in as the specification describes: the structs are
+ * copied and the producer's copies marked released. The producer's
+ * release callbacks run when the batches are replaced, cleared, or the
+ * model is destroyed.
+ *
+ * Batches appended after the first must have the same column names.
+ */
+class ArrowListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit ArrowListModel(QObject* parent = nullptr);
+    ~ArrowListModel() override;
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Replace all rows with one batch / add a batch at the end. Ownership
+    // of the batch always passes to the model: on failure (not a struct
+    // array, mismatched columns, too many rows) it is released at once.
+    bool setBatch(ArrowSchema* schema, ArrowArray* array);
+    bool appendBatch(ArrowSchema* schema, ArrowArray* array);
+
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE int count() const { return m_rows; }
+
+    // Runtime statistics: {"rows", "roles", "batches", "resets"}
+    QJsonObject statistics() const;
+
+    // Release an exported batch without adopting it
+    static void release(ArrowSchema* schema, ArrowArray* array);
+
+private:
+    struct Batch
+    {
+        ArrowSchema schema;
+        ArrowArray array;
+        int first;  // Model row of the batch's first row
+        QVector<ArrowColumn> columns;
+    };
+
+    std::unique_ptr<Batch> adopt(ArrowSchema* schema, ArrowArray* array);
+    static QVector<QByteArray> columnNames(const ArrowSchema& schema);
+    void releaseAll(std::vector<std::unique_ptr<Batch>>& batches);
+
+    std::vector<std::unique_ptr<Batch>> m_batches;
+    QVector<QByteArray> m_columns;
+    QHash<int, QByteArray> m_roleNames;
+    int m_rows = 0;
+    quint64 m_resets = 0;
+};
+
+#endif // ARROWLISTMODEL_H
@@ -0,0 +1,273 @@
+#include "filterlistmodel.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <algorithm>
+
+namespace {
+
+// Changes spanning more source rows are applied as one reset
+constexpr int kMaxRowEvents = 1024;
+
+} // namespace
+
+FilterListModel::FilterListModel(QAbstractItemModel* source, const QVector<QByteArray>& roles, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_source(source)
+    , m_roleNames(roles)
+{
+    if (source) {
+        connect(source, &QAbstractItemModel::modelReset, this, &FilterListModel::onSourceReset);
+        connect(source, &QAbstractItemModel::layoutChanged, this, &FilterListModel::onSourceReset);
+        connect(source, &QAbstractItemModel::rowsMoved, this, &FilterListModel::onSourceReset);
+        connect(source, &QAbstractItemModel::rowsInserted, this, &FilterListModel::onRowsInserted);
+        connect(source, &QAbstractItemModel::rowsRemoved, this, &FilterListModel::onRowsRemoved);
+        connect(source, &QAbstractItemModel::dataChanged, this, &FilterListModel::onDataChanged);
+        connect(source, &QObject::destroyed, this, &FilterListModel::onSourceReset);
+    }
+    rebuild();
+}
+
+int FilterListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant FilterListModel::data(const QModelIndex& index, int role) const
+{
+    if (!m_source || !index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+    return m_source->data(m_source->index(m_rows[index.row()], 0), role);
+}
+
+QHash<int, QByteArray> FilterListModel::roleNames() const
+{
+    return m_source ? m_source->roleNames() : QHash<int, QByteArray>();
+}
+
+int FilterListModel::sourceRow(int row) const
+{
+    return row >= 0 && row < m_rows.size() ? m_rows[row] : -1;
+}
+
+void FilterListModel::resolveRoles()
+{
+    const QHash<int, QByteArray> names = m_source ? m_source->roleNames() : QHash<int, QByteArray>();
+    m_roles.clear();
+    for (const QByteArray& name : std::as_const(m_roleNames)) {
+        m_roles.append(names.key(name, -1));
+    }
+}
+
+QString FilterListModel::rowText(int row) const
+{
+    // Fields are joined with a newline so no trigram spans two of them
+    QString text;
+    const QModelIndex index = m_source->index(row, 0);
+    for (int role : m_roles) {
+        if (role < 0) {
+            continue;
+        }
+        if (!text.isEmpty()) {
+            text += QLatin1Char('\n');
+        }
+        text += m_source->data(index, role).toString();
+    }
+    return text;
+}
+
+void FilterListModel::rebuild()
+{
+    CUIRQ_TRACE_SCOPE("FilterListModel::rebuild", "model");
+
+    beginResetModel();
+    resolveRoles();
+    QVector<QString> texts;
+    const int rows = m_source ? m_source->rowCount() : 0;
+    texts.reserve(rows);
+    for (int r = 0; r < rows; ++r) {
+        texts.append(rowText(r));
+    }
+    m_index.build(texts);
+    m_rows = m_index.search(m_folded);
+    endResetModel();
+
+    qCDebug(lcModel) << "FilterListModel" << objectName() << "indexed" << rows << "rows, ~"
+                     << m_index.memoryUsage() << "bytes";
+    reportResults();
+}
+
+void FilterListModel::reportResults()
+{
+    emit countChanged();
+    emit resultsChanged(m_query, m_rows.size(), m_index.rowCount());
+}
+
+void FilterListModel::setQuery(const QString& query)
+{
+    if (query == m_query) {
+        return;
+    }
+    static Histogram& queryTime = Metrics::histogram("filter.query_ns");
+    static Counter& queries = Metrics::counter("filter.queries");
+    CUIRQ_TRACE_SCOPE("FilterListModel::setQuery", "model");
+
+    QVector<int> rows;
+    const QString folded = TrigramIndex::fold(query);
+    {
+        ScopedTimer timer(queryTime);
+        if (!m_folded.isEmpty() && folded.contains(m_folded)) {
+            // Typing on: only current matches can still match
+            for (int row : std::as_const(m_rows)) {
+                if (m_index.matches(row, folded)) {
+                    rows.append(row);
+                }
+            }
+        } else {
+            rows = m_index.search(folded);
+        }
+
+        beginResetModel();
+        m_rows = std::move(rows);
+        m_query = query;
+        m_folded = folded;
+        endResetModel();
+    }
+    ++m_queries;
+    queries.add();
+
+    emit queryChanged();
+    reportResults();
+}
+
+void FilterListModel::onSourceReset()
+{
+    rebuild();
+}
+
+void FilterListModel::onRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    if (std::find(m_roles.cbegin(), m_roles.cend(), -1) != m_roles.cend()) {
+        resolveRoles();  // New rows may bring the first values of a role
+    }
+
+    const int count = last - first + 1;
+    QVector<QString> texts;
+    texts.reserve(count);
+    for (int r = first; r <= last; ++r) {
+        texts.append(rowText(r));
+    }
+    m_index.insertRows(first, texts);
+
+    // Matches after the insertion point keep their view rows but move down in the source
+    const int at = static_cast<int>(std::lower_bound(m_rows.cbegin(), m_rows.cend(), first) - m_rows.cbegin());
+    for (int i = at; i < m_rows.size(); ++i) {
+        m_rows[i] += count;
+    }
+
+    QVector<int> added;
+    for (int r = first; r <= last; ++r) {
+        if (m_index.matches(r, m_folded)) {
+            added.append(r);
+        }
+    }
+    if (!added.isEmpty()) {
+        beginInsertRows(QModelIndex(), at, at + added.size() - 1);
+        m_rows.insert(at, added.size(), 0);
+        std::copy(added.cbegin(), added.cend(), m_rows.begin() + at);
+        endInsertRows();
+    }
+    reportResults();
+}
+
+void FilterListModel::onRowsRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    const int count = last - first + 1;
+    m_index.removeRows(first, count);
+
+    const int from = static_cast<int>(std::lower_bound(m_rows.cbegin(), m_rows.cend(), first) - m_rows.cbegin());
+    const int to = static_cast<int>(std::upper_bound(m_rows.cbegin(), m_rows.cend(), last) - m_rows.cbegin());
+    if (from < to) {
+        beginRemoveRows(QModelIndex(), from, to - 1);
+    }
+    m_rows.remove(from, to - from);
+    for (int i = from; i < m_rows.size(); ++i) {
+        m_rows[i] -= count;
+    }
+    if (from < to) {
+        endRemoveRows();
+    }
+    reportResults();
+}
+
+void FilterListModel::updateRow(int row)
+{
+    m_index.updateRow(row, rowText(row));
+    const bool match = m_index.matches(row, m_folded);
+    const auto it = std::lower_bound(m_rows.begin(), m_rows.end(), row);
+    const int at = static_cast<int>(it - m_rows.begin());
+    const bool shown = it != m_rows.end() && *it == row;
+    if (match && !shown) {
+        beginInsertRows(QModelIndex(), at, at);
+        m_rows.insert(at, row);
+        endInsertRows();
+    } else if (!match && shown) {
+        beginRemoveRows(QModelIndex(), at, at);
+        m_rows.remove(at);
+        endRemoveRows();
+    }
+}
+
+void FilterListModel::onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles)
+{
+    if (!topLeft.isValid() || topLeft.parent().isValid()) {
+        return;
+    }
+    const int first = topLeft.row();
+    const int last = bottomRight.row();
+    const bool indexed = roles.isEmpty()
+        || std::any_of(roles.cbegin(), roles.cend(), [this](int role) { return m_roles.contains(role); });
+
+    if (indexed) {
+        const int before = m_rows.size();
+        if (last - first + 1 > kMaxRowEvents) {
+            beginResetModel();
+            for (int r = first; r <= last; ++r) {
+                m_index.updateRow(r, rowText(r));
+            }
+            m_rows = m_index.search(m_folded);
+            endResetModel();
+            reportResults();
+            return;
+        }
+        for (int r = first; r <= last; ++r) {
+            updateRow(r);
+        }
+        if (m_rows.size() != before) {
+            reportResults();
+        }
+    }
+
+    const int from = static_cast<int>(std::lower_bound(m_rows.cbegin(), m_rows.cend(), first) - m_rows.cbegin());
+    const int to = static_cast<int>(std::upper_bound(m_rows.cbegin(), m_rows.cend(), last) - m_rows.cbegin());
+    if (from < to) {
+        emit dataChanged(index(from), index(to - 1), roles);
+    }
+}
+
+QJsonObject FilterListModel::statistics() const
+{
+    return QJsonObject{
+        { "rows", static_cast<qint64>(m_rows.size()) },
+        { "source_rows", static_cast<qint64>(m_index.rowCount()) },
+        { "index_bytes", m_index.memoryUsage() },
+        { "queries", static_cast<qint64>(m_queries) }
+    };
+}
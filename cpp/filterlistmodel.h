@@ -0,0 +1,86 @@
+#ifndef FILTERLISTMODEL_H
+#define FILTERLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+
+#include "trigramindex.h"
+
+/**
+ * FilterListModel - Filter-as-you-type view of a list model.
+ *
+ * Shows the rows of a source model whose indexed roles contain the query
+ * (case-insensitive substring). The indexed roles of every row are kept in
+ * a TrigramIndex, so a query touches only the rows sharing its trigrams
+ * instead of every row; a query that extends the previous one only
+ * re-checks the current matches.
+ *
+ * The index follows the source: inserted, removed and changed rows are
+ * indexed one by one and move in or out of the view with row-level
+ * notifications; a source reset rebuilds the index (in parallel). Changes
+ * to roles that are not indexed are forwarded as dataChanged.
+ *
+ * Rows keep their source order. data() and roleNames() come from the
+ * source.
+ */
+class FilterListModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int sourceCount READ sourceCount NOTIFY countChanged)
+
+public:
+    FilterListModel(QAbstractItemModel* source, const QVector<QByteArray>& roles, QObject* parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QString query() const { return m_query; }
+    void setQuery(const QString& query);
+
+    int count() const { return m_rows.size(); }
+    int sourceCount() const { return m_index.rowCount(); }
+
+    // Source row of a view row, or -1
+    Q_INVOKABLE int sourceRow(int row) const;
+
+    // Runtime statistics: {"rows", "source_rows", "index_bytes", "queries"}
+    QJsonObject statistics() const;
+
+signals:
+    void queryChanged();
+    void countChanged();
+    // After a query runs or source changes move rows in or out of the view
+    void resultsChanged(const QString& query, int count, int total);
+
+private slots:
+    void onSourceReset();
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    void onRowsRemoved(const QModelIndex& parent, int first, int last);
+    void onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QList<int>& roles);
+
+private:
+    void resolveRoles();
+    QString rowText(int row) const;
+    void rebuild();
+    void reportResults();
+    void updateRow(int row);
+
+    QPointer<QAbstractItemModel> m_source;
+    QVector<QByteArray> m_roleNames;  // Indexed roles, by name
+    QVector<int> m_roles;             // Their ids in the source (-1 until known)
+    TrigramIndex m_index;
+    QString m_query;
+    QString m_folded;
+    QVector<int> m_rows;  // Matching source rows, ascending
+    quint64 m_queries = 0;
+};
+
+#endif // FILTERLISTMODEL_H
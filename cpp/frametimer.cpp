@@ -0,0 +1,115 @@
+#include "frametimer.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+
+FrameTimer::FrameTimer(QQuickWindow* window, int capacity, QObject *parent)
+    : QObject(parent)
+    , m_window(window)
+    , m_capacity(std::max(capacity, 1))
+    , m_next(0)
+    , m_wrapped(false)
+    , m_lastSwapNs(-1)
+    , m_frames(0)
+{
+    m_samples.resize(m_capacity);
+    m_clock.start();
+
+    // frameSwapped fires on the render thread; record there directly
+    connect(window, &QQuickWindow::frameSwapped,
+            this, &FrameTimer::onFrameSwapped, Qt::DirectConnection);
+}
+
+FrameTimer::~FrameTimer()
+{
+    if (m_window) {
+        disconnect(m_window, &QQuickWindow::frameSwapped,
+                   this, &FrameTimer::onFrameSwapped);
+    }
+}
+
+void FrameTimer::reset()
+{
+    QMutexLocker lock(&m_mutex);
+    m_next = 0;
+    m_wrapped = false;
+    m_lastSwapNs = -1;
+    m_frames = 0;
+}
+
+QVector<double> FrameTimer::samples() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    if (!m_wrapped) {
+        return m_samples.mid(0, m_next);
+    }
+
+    QVector<double> ordered;
+    ordered.reserve(m_capacity);
+    ordered.append(m_samples.mid(m_next));
+    ordered.append(m_samples.mid(0, m_next));
+    return ordered;
+}
+
+quint64 FrameTimer::frameCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_frames;
+}
+
+double FrameTimer::lastFrameMs() const
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_next == 0 && !m_wrapped) {
+        return 0.0;
+    }
+    return m_samples.at((m_next + m_capacity - 1) % m_capacity);
+}
+
+double FrameTimer::fps() const
+{
+    QMutexLocker lock(&m_mutex);
+
+    const int available = m_wrapped ? m_capacity : m_next;
+    double elapsedMs = 0.0;
+    int frames = 0;
+
+    // Walk backwards from the newest interval until one second is covered
+    for (int i = 1; i <= available && elapsedMs < 1000.0; ++i) {
+        elapsedMs += m_samples.at((m_next + m_capacity - i) % m_capacity);
+        ++frames;
+    }
+
+    return elapsedMs > 0.0 ? frames * 1000.0 / elapsedMs : 0.0;
+}
+
+double FrameTimer::percentile(QVector<double> values, double p)
+{
+    if (values.isEmpty()) {
+        return 0.0;
+    }
+
+    std::sort(values.begin(), values.end());
+    const double rank = std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * values.size());
+    const int index = std::clamp(static_cast<int>(rank) - 1, 0, static_cast<int>(values.size()) - 1);
+    return values.at(index);
+}
+
+void FrameTimer::onFrameSwapped()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+
+    QMutexLocker lock(&m_mutex);
+    ++m_frames;
+
+    if (m_lastSwapNs >= 0) {
+        m_samples[m_next] = (now - m_lastSwapNs) / 1e6;
+        m_next = (m_next + 1) % m_capacity;
+        if (m_next == 0) {
+            m_wrapped = true;
+        }
+    }
+
+    m_lastSwapNs = now;
+}
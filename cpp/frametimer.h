@@ -0,0 +1,63 @@
+#ifndef FRAMETIMER_H
+#define FRAMETIMER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QVector>
+
+/**
+ * FrameTimer - Records per-frame timings of a QQuickWindow.
+ *
+ * Listens to QQuickWindow::frameSwapped and keeps the intervals between
+ * consecutive swaps in a fixed-size ring (oldest samples are overwritten).
+ *
+ * Thread safety:
+ *   - frameSwapped is emitted on the render thread with the threaded
+ *     render loop, so samples are guarded by a mutex
+ *   - Readers (GUI thread, harnesses) get copies
+ */
+class FrameTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameTimer(QQuickWindow* window, int capacity = 4096, QObject *parent = nullptr);
+    ~FrameTimer() override;
+
+    // Drop all samples (e.g. after warm-up)
+    void reset();
+
+    // Frame intervals in milliseconds, oldest first
+    QVector<double> samples() const;
+
+    // Total frames swapped since construction or reset()
+    quint64 frameCount() const;
+
+    // Interval of the most recent frame in milliseconds (0 if none yet)
+    double lastFrameMs() const;
+
+    // Frames swapped during the last second of recorded intervals
+    double fps() const;
+
+    // Nearest-rank percentile (p in [0, 100]) of the given values
+    static double percentile(QVector<double> values, double p);
+
+private:
+    void onFrameSwapped();
+
+    QPointer<QQuickWindow> m_window;
+    QElapsedTimer m_clock;
+
+    mutable QMutex m_mutex;
+    QVector<double> m_samples;
+    int m_capacity;
+    int m_next;
+    bool m_wrapped;
+    qint64 m_lastSwapNs;
+    quint64 m_frames;
+};
+
+#endif // FRAMETIMER_H
@@ -0,0 +1,68 @@
+#include "guioperation.h"
+#include "trace.h"
+#include <atomic>
+
+namespace {
+
+thread_local bool t_guiThread = false;
+
+// Seqlock: written only by the GUI thread, read by the watchdog
+std::atomic<quint64> g_sequence{0};
+std::atomic<const char*> g_name{nullptr};
+std::atomic<const char*> g_detail{nullptr};
+std::atomic<qint64> g_startNs{0};
+
+// GUI-thread-only copy, used to restore the outer marker
+GuiOperation::Snapshot g_guiCurrent;
+
+} // namespace
+
+void GuiOperation::markGuiThread()
+{
+    t_guiThread = true;
+}
+
+void GuiOperation::publish(const Snapshot& snapshot)
+{
+    g_guiCurrent = snapshot;
+
+    const quint64 seq = g_sequence.load(std::memory_order_relaxed);
+    g_sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    g_name.store(snapshot.name, std::memory_order_relaxed);
+    g_detail.store(snapshot.detail, std::memory_order_relaxed);
+    g_startNs.store(snapshot.startNs, std::memory_order_relaxed);
+    g_sequence.store(seq + 2, std::memory_order_release);
+}
+
+GuiOperation::Snapshot GuiOperation::current()
+{
+    Snapshot snapshot;
+    quint64 before;
+    quint64 after;
+    do {
+        before = g_sequence.load(std::memory_order_acquire);
+        snapshot.name = g_name.load(std::memory_order_relaxed);
+        snapshot.detail = g_detail.load(std::memory_order_relaxed);
+        snapshot.startNs = g_startNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = g_sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+    return snapshot;
+}
+
+GuiOperation::Scope::Scope(const char* name, const char* detail)
+    : m_active(t_guiThread)
+{
+    if (m_active) {
+        m_previous = g_guiCurrent;
+        publish({ name, detail, Trace::nowNs() });
+    }
+}
+
+GuiOperation::Scope::~Scope()
+{
+    if (m_active) {
+        publish(m_previous);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef GUIOPERATION_H
+#define GUIOPERATION_H
+
+#include <QtGlobal>
+
+/**
+ * GuiOperation - What the GUI thread is currently doing.
+ *
+ * Bridge entry points, signal dispatch and hot-reload publish a marker
+ * (name, optional detail, start time) while they run on the GUI thread,
+ * so the stall watchdog can attribute a freeze. Scopes nest; the outer
+ * marker is restored when the inner scope ends.
+ *
+ * Markers are only published from the GUI thread (other threads pay one
+ * thread_local load). Names and details must outlive the scope: use
+ * string literals or Trace::intern().
+ */
+class GuiOperation
+{
+public:
+    struct Snapshot
+    {
+        const char* name = nullptr;     // nullptr: idle in the event loop
+        const char* detail = nullptr;
+        qint64 startNs = 0;
+    };
+
+    // Called once on the GUI thread
+    static void markGuiThread();
+
+    // Consistent copy of the current marker (any thread)
+    static Snapshot current();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name, const char* detail = nullptr);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool m_active;
+        Snapshot m_previous;
+    };
+
+private:
+    static void publish(const Snapshot& snapshot);
+};
+
+#endif // GUIOPERATION_H
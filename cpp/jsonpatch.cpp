@@ -0,0 +1,327 @@
+#include "jsonpatch.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonValue>
+
+namespace JsonPatch {
+
+namespace {
+
+QVariantMap* asMap(QVariant& node)
+{
+    return node.typeId() == QMetaType::QVariantMap ? static_cast<QVariantMap*>(node.data()) : nullptr;
+}
+
+QVariantList* asList(QVariant& node)
+{
+    return node.typeId() == QMetaType::QVariantList ? static_cast<QVariantList*>(node.data()) : nullptr;
+}
+
+// Node at the first `depth` tokens of `path`, or nullptr
+const QVariant* find(const QVariant& document, const QStringList& path, int depth)
+{
+    const QVariant* node = &document;
+    for (int i = 0; i < depth; ++i) {
+        if (node->typeId() == QMetaType::QVariantMap) {
+            const auto& map = *static_cast<const QVariantMap*>(node->constData());
+            const auto it = map.constFind(path.at(i));
+            if (it == map.cend()) {
+                return nullptr;
+            }
+            node = &*it;
+        } else if (node->typeId() == QMetaType::QVariantList) {
+            const auto& list = *static_cast<const QVariantList*>(node->constData());
+            const int index = arrayIndex(path.at(i), list.size(), false);
+            if (index < 0) {
+                return nullptr;
+            }
+            node = &list.at(index);
+        } else {
+            return nullptr;
+        }
+    }
+    return node;
+}
+
+// Mutable version; detaches the containers along the path
+QVariant* resolve(QVariant& document, const QStringList& path, int depth)
+{
+    QVariant* node = &document;
+    for (int i = 0; i < depth; ++i) {
+        if (QVariantMap* map = asMap(*node)) {
+            const auto it = map->find(path.at(i));
+            if (it == map->end()) {
+                return nullptr;
+            }
+            node = &*it;
+        } else if (QVariantList* list = asList(*node)) {
+            const int index = arrayIndex(path.at(i), list->size(), false);
+            if (index < 0) {
+                return nullptr;
+            }
+            node = &(*list)[index];
+        } else {
+            return nullptr;
+        }
+    }
+    return node;
+}
+
+bool fail(QString* error, const QString& reason)
+{
+    if (error) {
+        *error = reason;
+    }
+    return false;
+}
+
+QVariant* parentOf(QVariant& document, const QStringList& path, QString* error)
+{
+    QVariant* parent = resolve(document, path, path.size() - 1);
+    if (!parent) {
+        fail(error, QStringLiteral("parent does not exist"));
+    } else if (parent->typeId() != QMetaType::QVariantMap && parent->typeId() != QMetaType::QVariantList) {
+        fail(error, QStringLiteral("parent is not an object or array"));
+        return nullptr;
+    }
+    return parent;
+}
+
+bool isPrefix(const QStringList& prefix, const QStringList& path)
+{
+    if (prefix.size() > path.size()) {
+        return false;
+    }
+    for (int i = 0; i < prefix.size(); ++i) {
+        if (prefix.at(i) != path.at(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool parse(const QJsonArray& patch, QVector<Operation>* operations, QString* error)
+{
+    static const QHash<QString, Operation::Type> types = {
+        { QStringLiteral("add"), Operation::Add },
+        { QStringLiteral("remove"), Operation::Remove },
+        { QStringLiteral("replace"), Operation::Replace },
+        { QStringLiteral("move"), Operation::Move },
+        { QStringLiteral("copy"), Operation::Copy },
+        { QStringLiteral("test"), Operation::Test }
+    };
+
+    operations->clear();
+    operations->reserve(patch.size());
+    for (int i = 0; i < patch.size(); ++i) {
+        const QJsonObject entry = patch.at(i).toObject();
+        const auto type = types.constFind(entry.value(QLatin1String("op")).toString());
+        if (type == types.cend()) {
+            return fail(error, QStringLiteral("operation %1: unknown or missing \"op\"").arg(i));
+        }
+
+        Operation op;
+        op.type = *type;
+        const QJsonValue path = entry.value(QLatin1String("path"));
+        if (!path.isString() || !parsePointer(path.toString(), &op.path)) {
+            return fail(error, QStringLiteral("operation %1: invalid \"path\"").arg(i));
+        }
+        if (op.type == Operation::Move || op.type == Operation::Copy) {
+            const QJsonValue from = entry.value(QLatin1String("from"));
+            if (!from.isString() || !parsePointer(from.toString(), &op.from)) {
+                return fail(error, QStringLiteral("operation %1: invalid \"from\"").arg(i));
+            }
+            if (op.type == Operation::Move && op.from != op.path && isPrefix(op.from, op.path)) {
+                return fail(error, QStringLiteral("operation %1: cannot move a value into itself").arg(i));
+            }
+        }
+        if (op.type == Operation::Add || op.type == Operation::Replace || op.type == Operation::Test) {
+            if (!entry.contains(QLatin1String("value"))) {
+                return fail(error, QStringLiteral("operation %1: missing \"value\"").arg(i));
+            }
+            op.value = entry.value(QLatin1String("value")).toVariant();
+        }
+        operations->append(op);
+    }
+    return true;
+}
+
+bool parsePointer(const QString& pointer, QStringList* tokens)
+{
+    tokens->clear();
+    if (pointer.isEmpty()) {
+        return true;
+    }
+    if (!pointer.startsWith(QLatin1Char('/'))) {
+        return false;
+    }
+    const QStringList parts = pointer.mid(1).split(QLatin1Char('/'));
+    for (QString token : parts) {
+        for (qsizetype i = token.indexOf(QLatin1Char('~')); i >= 0; i = token.indexOf(QLatin1Char('~'), i + 1)) {
+            const QChar next = i + 1 < token.size() ? token.at(i + 1) : QChar();
+            if (next != QLatin1Char('0') && next != QLatin1Char('1')) {
+                return false;
+            }
+        }
+        token.replace(QLatin1String("~1"), QLatin1String("/"));
+        token.replace(QLatin1String("~0"), QLatin1String("~"));
+        tokens->append(token);
+    }
+    return true;
+}
+
+QString pointer(const QStringList& tokens)
+{
+    QString result;
+    for (QString token : tokens) {
+        token.replace(QLatin1Char('~'), QLatin1String("~0"));
+        token.replace(QLatin1Char('/'), QLatin1String("~1"));
+        result += QLatin1Char('/') + token;
+    }
+    return result;
+}
+
+int arrayIndex(const QString& token, int size, bool allowEnd)
+{
+    if (token == QLatin1String("-")) {
+        return allowEnd ? size : -1;
+    }
+    if (token.isEmpty() || token.size() > 10 || (token.size() > 1 && token.at(0) == QLatin1Char('0'))) {
+        return -1;
+    }
+    for (const QChar c : token) {
+        if (c < QLatin1Char('0') || c > QLatin1Char('9')) {
+            return -1;
+        }
+    }
+    const qint64 index = token.toLongLong();
+    return index < size || (allowEnd && index == size) ? static_cast<int>(index) : -1;
+}
+
+bool equal(const QVariant& a, const QVariant& b)
+{
+    return QJsonValue::fromVariant(a) == QJsonValue::fromVariant(b);
+}
+
+bool get(const QVariant& document, const QStringList& path, QVariant* value)
+{
+    const QVariant* node = find(document, path, path.size());
+    if (!node) {
+        return false;
+    }
+    *value = *node;
+    return true;
+}
+
+bool add(QVariant& document, const QStringList& path, const QVariant& value, QString* error)
+{
+    if (path.isEmpty()) {
+        document = value;
+        return true;
+    }
+    QVariant* parent = parentOf(document, path, error);
+    if (!parent) {
+        return false;
+    }
+    if (QVariantMap* map = asMap(*parent)) {
+        map->insert(path.last(), value);
+        return true;
+    }
+    QVariantList* list = asList(*parent);
+    const int index = arrayIndex(path.last(), list->size(), true);
+    if (index < 0) {
+        return fail(error, QStringLiteral("array index out of range"));
+    }
+    list->insert(index, value);
+    return true;
+}
+
+bool remove(QVariant& document, const QStringList& path, QString* error)
+{
+    if (path.isEmpty()) {
+        return fail(error, QStringLiteral("cannot remove the whole document"));
+    }
+    QVariant* parent = parentOf(document, path, error);
+    if (!parent) {
+        return false;
+    }
+    if (QVariantMap* map = asMap(*parent)) {
+        if (map->remove(path.last()) == 0) {
+            return fail(error, QStringLiteral("member does not exist"));
+        }
+        return true;
+    }
+    QVariantList* list = asList(*parent);
+    const int index = arrayIndex(path.last(), list->size(), false);
+    if (index < 0) {
+        return fail(error, QStringLiteral("array index out of range"));
+    }
+    list->removeAt(index);
+    return true;
+}
+
+bool replace(QVariant& document, const QStringList& path, const QVariant& value, QString* error)
+{
+    QVariant* target = resolve(document, path, path.size());
+    if (!target) {
+        return fail(error, QStringLiteral("target does not exist"));
+    }
+    *target = value;
+    return true;
+}
+
+bool apply(QVariant& document, const Operation& operation, QString* error)
+{
+    switch (operation.type) {
+    case Operation::Add:
+        return add(document, operation.path, operation.value, error);
+    case Operation::Remove:
+        return remove(document, operation.path, error);
+    case Operation::Replace:
+        return replace(document, operation.path, operation.value, error);
+    case Operation::Move:
+    case Operation::Copy: {
+        QVariant value;
+        if (!get(document, operation.from, &value)) {
+            return fail(error, QStringLiteral("\"from\" does not exist"));
+        }
+        if (operation.type == Operation::Copy) {
+            return add(document, operation.path, value, error);
+        }
+        if (operation.from == operation.path) {
+            return true;
+        }
+        // Remove then add on a shallow copy, so a failed add leaves the document as it was
+        QVariant staged = document;
+        if (!remove(staged, operation.from, error) || !add(staged, operation.path, value, error)) {
+            return false;
+        }
+        document = std::move(staged);
+        return true;
+    }
+    case Operation::Test: {
+        QVariant value;
+        if (!get(document, operation.path, &value)) {
+            return fail(error, QStringLiteral("target does not exist"));
+        }
+        if (!equal(value, operation.value)) {
+            return fail(error, QStringLiteral("test failed"));
+        }
+        return true;
+    }
+    }
+    return fail(error, QStringLiteral("unknown operation"));
+}
+
+QString describe(int index, const Operation& operation, const QString& reason)
+{
+    static const char* const names[] = { "add", "remove", "replace", "move", "copy", "test" };
+    return QStringLiteral("operation %1 (%2 \"%3\"): %4")
+        .arg(index)
+        .arg(QLatin1String(names[operation.type]), pointer(operation.path), reason);
+}
+
+} // namespace JsonPatch
@@ -0,0 +1,62 @@
+#ifndef JSONPATCH_H
+#define JSONPATCH_H
+
+#include <QJsonArray>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+/**
+ * JsonPatch - RFC 6902 operations over QVariant trees.
+ *
+ * Documents are what QJsonValue::toVariant() produces: QVariantMap for
+ * objects, QVariantList for arrays, scalars otherwise. Paths are RFC 6901
+ * JSON Pointers, parsed into unescaped tokens up front so callers can
+ * route on the first tokens (a model row, a state property) and apply the
+ * rest to the value underneath.
+ *
+ * Every function reports failure through its return value and an error
+ * message and leaves the document untouched when it fails.
+ */
+namespace JsonPatch {
+
+struct Operation
+{
+    enum Type { Add, Remove, Replace, Move, Copy, Test };
+
+    Type type = Add;
+    QStringList path;
+    QStringList from;  // Move and Copy
+    QVariant value;    // Add, Replace and Test
+};
+
+// Parse a patch document (a JSON array of operation objects)
+bool parse(const QJsonArray& patch, QVector<Operation>* operations, QString* error);
+
+// "/a/b~1c" -> ["a", "b/c"]; "" is the whole document
+bool parsePointer(const QString& pointer, QStringList* tokens);
+QString pointer(const QStringList& tokens);
+
+// Array index token: digits without leading zeros, below `size` (or equal
+// to it when `allowEnd`). "-" means `size` when `allowEnd`.
+int arrayIndex(const QString& token, int size, bool allowEnd);
+
+// JSON equality: numbers compare by value, objects ignore key order
+bool equal(const QVariant& a, const QVariant& b);
+
+// Pointer operations, relative to `document`
+bool get(const QVariant& document, const QStringList& path, QVariant* value);
+bool add(QVariant& document, const QStringList& path, const QVariant& value, QString* error);
+bool remove(QVariant& document, const QStringList& path, QString* error);
+bool replace(QVariant& document, const QStringList& path, const QVariant& value, QString* error);
+
+// One operation, with Move and Copy resolved within `document`
+bool apply(QVariant& document, const Operation& operation, QString* error);
+
+// "operation 2 (replace "/3/name"): target does not exist"
+QString describe(int index, const Operation& operation, const QString& reason);
+
+} // namespace JsonPatch
+
+#endif // JSONPATCH_H
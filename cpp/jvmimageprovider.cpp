@@ -0,0 +1,197 @@
+#include "jvmimageprovider.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QMutexLocker>
+
+namespace {
+
+// Keeps a pushed ByteBuffer alive while a QImage references its memory
+struct PinnedBuffer
+{
+    JavaVM* jvm;
+    jobject buffer;  // Global reference
+};
+
+} // namespace
+
+JvmImageProvider::JvmImageProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image)
+{
+    m_cache.setMaxCost(kDefaultBudgetBytes);
+}
+
+JvmImageProvider::~JvmImageProvider()
+{
+    clear();
+}
+
+QImage JvmImageProvider::requestImage(const QString& id, QSize* size, const QSize& requestedSize)
+{
+    static Counter& hits = Metrics::counter("image.jvm.hits");
+    static Counter& misses = Metrics::counter("image.jvm.misses");
+
+    // "name?v=3" -> "name": the query only exists to give QML a fresh URL
+    const QString key = id.section(QLatin1Char('?'), 0, 0);
+
+    QImage image;
+    {
+        QMutexLocker lock(&m_mutex);
+        Entry* entry = m_cache.object(key);  // Marks the entry most recently used
+        if (entry) {
+            image = entry->image;  // Shares the pixels, no copy
+        }
+    }
+
+    if (image.isNull()) {
+        misses.add();
+        qCDebug(lcBridge) << "JvmImageProvider: No image for id" << key;
+        return image;
+    }
+    hits.add();
+
+    if (size) {
+        *size = image.size();
+    }
+
+    // sourceSize set in QML: scale here (this one does copy)
+    if (requestedSize.isValid() && requestedSize != image.size()) {
+        const QSize target(requestedSize.width() > 0 ? requestedSize.width() : image.width(),
+                           requestedSize.height() > 0 ? requestedSize.height() : image.height());
+        return image.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+qint64 JvmImageProvider::put(JNIEnv* env, const QString& id, jobject buffer,
+                             int width, int height, int stride, int format)
+{
+    const QImage::Format qformat = toQImageFormat(format);
+    if (qformat == QImage::Format_Invalid || width <= 0 || height <= 0) {
+        qCWarning(lcBridge) << "JvmImageProvider: Invalid image" << id << width << "x" << height
+                            << "format" << format;
+        return -1;
+    }
+
+    void* pixels = env->GetDirectBufferAddress(buffer);
+    const jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (pixels == nullptr || capacity < 0) {
+        qCWarning(lcBridge) << "JvmImageProvider: Image" << id << "needs a direct ByteBuffer";
+        return -1;
+    }
+
+    const int rowBytes = width * bytesPerPixel(qformat);
+    if (stride <= 0) {
+        stride = rowBytes;
+    }
+    const qint64 bytes = static_cast<qint64>(stride) * height;
+    if (stride < rowBytes || capacity < bytes) {
+        qCWarning(lcBridge) << "JvmImageProvider: Buffer for" << id << "holds" << capacity
+                            << "bytes, needs" << bytes;
+        return -1;
+    }
+
+    JavaVM* jvm = nullptr;
+    env->GetJavaVM(&jvm);
+    auto* pinned = new PinnedBuffer{ jvm, env->NewGlobalRef(buffer) };
+
+    // Wrap in place; releaseBuffer runs when the last copy of this QImage dies
+    QImage image(static_cast<const uchar*>(pixels), width, height, stride, qformat,
+                 &JvmImageProvider::releaseBuffer, pinned);
+
+    static Counter& puts = Metrics::counter("image.jvm.puts");
+    puts.add();
+
+    QMutexLocker lock(&m_mutex);
+    const qint64 generation = m_nextGeneration++;
+    // QCache evicts least recently used entries to make room; it rejects
+    // (and deletes) entries costing more than the whole budget
+    if (!m_cache.insert(id, new Entry{ image, generation }, bytes)) {
+        qCWarning(lcBridge) << "JvmImageProvider: Image" << id << "(" << bytes
+                            << "bytes) exceeds the cache budget of" << m_cache.maxCost();
+        updateGauge();
+        return -1;
+    }
+    updateGauge();
+    return generation;
+}
+
+bool JvmImageProvider::remove(const QString& id)
+{
+    QMutexLocker lock(&m_mutex);
+    const bool removed = m_cache.remove(id);
+    updateGauge();
+    return removed;
+}
+
+void JvmImageProvider::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_cache.clear();
+    updateGauge();
+}
+
+void JvmImageProvider::setBudget(qint64 bytes)
+{
+    QMutexLocker lock(&m_mutex);
+    m_cache.setMaxCost(qMax<qint64>(0, bytes));
+    updateGauge();
+}
+
+qint64 JvmImageProvider::budget() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_cache.maxCost();
+}
+
+qint64 JvmImageProvider::totalBytes() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_cache.totalCost();
+}
+
+void JvmImageProvider::updateGauge()
+{
+    static Gauge& cached = Metrics::gauge("image.jvm.bytes");
+    cached.set(m_cache.totalCost());
+}
+
+QImage::Format JvmImageProvider::toQImageFormat(int format)
+{
+    switch (format) {
+    case ARGB32Premultiplied: return QImage::Format_ARGB32_Premultiplied;
+    case ARGB32:              return QImage::Format_ARGB32;
+    case RGB32:               return QImage::Format_RGB32;
+    case RGBA8888:            return QImage::Format_RGBA8888;
+    case RGB888:              return QImage::Format_RGB888;
+    case Grayscale8:          return QImage::Format_Grayscale8;
+    }
+    return QImage::Format_Invalid;
+}
+
+int JvmImageProvider::bytesPerPixel(QImage::Format format)
+{
+    switch (format) {
+    case QImage::Format_RGB888:     return 3;
+    case QImage::Format_Grayscale8: return 1;
+    default:                        return 4;
+    }
+}
+
+void JvmImageProvider::releaseBuffer(void* info)
+{
+    auto* pinned = static_cast<PinnedBuffer*>(info);
+
+    // The last reference may be dropped on the render or image loader thread
+    JNIEnv* env = nullptr;
+    jint status = pinned->jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8);
+    if (status == JNI_EDETACHED) {
+        status = pinned->jvm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env), nullptr);
+    }
+    if (status == JNI_OK && env != nullptr) {
+        env->DeleteGlobalRef(pinned->buffer);
+    } else {
+        qCWarning(lcBridge) << "JvmImageProvider: Cannot attach thread to release image buffer";
+    }
+    delete pinned;
+}
@@ -0,0 +1,82 @@
+#ifndef JVMIMAGEPROVIDER_H
+#define JVMIMAGEPROVIDER_H
+
+#include <jni.h>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QQuickImageProvider>
+#include <QString>
+
+/**
+ * JvmImageProvider - Serves images pushed from the JVM to QML.
+ *
+ * The JVM hands over a direct ByteBuffer plus width, height, stride and
+ * format. The pixels are wrapped in a QImage without copying: a global
+ * reference keeps the buffer alive until the last QImage sharing it is
+ * gone, so the JVM must not write to a buffer after pushing it.
+ *
+ * Images are keyed by id and held in an LRU cache bounded by a byte
+ * budget. QML requests them as:
+ *
+ *   Image { source: "image://jvm/" + id + "?v=" + generation }
+ *
+ * Everything after '?' is ignored by the provider. Qt's pixmap cache keys
+ * on the full URL, so an unchanged URL reuses the uploaded texture and
+ * bumping the generation (returned by put()) makes QML fetch new pixels.
+ */
+class JvmImageProvider : public QQuickImageProvider
+{
+public:
+    // Must match Bridge.IMAGE_FORMAT_* constants
+    enum PixelFormat {
+        ARGB32Premultiplied = 0,  // 32-bit native-endian 0xAARRGGBB, premultiplied
+        ARGB32 = 1,               // 32-bit native-endian 0xAARRGGBB (BufferedImage TYPE_INT_ARGB)
+        RGB32 = 2,                // 32-bit native-endian 0xffRRGGBB (TYPE_INT_RGB)
+        RGBA8888 = 3,             // Bytes R, G, B, A
+        RGB888 = 4,               // Bytes R, G, B
+        Grayscale8 = 5            // One byte per pixel
+    };
+
+    static constexpr qint64 kDefaultBudgetBytes = 256ll * 1024 * 1024;
+
+    JvmImageProvider();
+    ~JvmImageProvider() override;
+
+    QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+
+    /**
+     * Store pixels from a direct ByteBuffer under id (replacing any image).
+     *
+     * Returns the new generation for id, or -1 if the buffer is not direct,
+     * too small for the geometry, or larger than the whole budget.
+     */
+    qint64 put(JNIEnv* env, const QString& id, jobject buffer,
+               int width, int height, int stride, int format);
+
+    bool remove(const QString& id);
+    void clear();
+
+    // LRU byte budget; shrinking evicts least recently used images
+    void setBudget(qint64 bytes);
+    qint64 budget() const;
+    qint64 totalBytes() const;
+
+private:
+    struct Entry
+    {
+        QImage image;
+        qint64 generation;
+    };
+
+    static QImage::Format toQImageFormat(int format);
+    static int bytesPerPixel(QImage::Format format);
+    static void releaseBuffer(void* info);
+    void updateGauge();
+
+    mutable QMutex m_mutex;
+    QCache<QString, Entry> m_cache;
+    qint64 m_nextGeneration = 1;
+};
+
+#endif // JVMIMAGEPROVIDER_H
@@ -1,16 +1,119 @@
 #include "jvmlistmodel.h"
-#include <QDebug>
+#include "metrics.h"
+#include "log.h"
+
+#include <QSet>
+#include <QThread>
+#include <memory>
+
+namespace {
+
+// Approximate heap costs on 64-bit Qt 6. These are estimates meant for
+// spotting which model grows, not exact allocator accounting.
+constexpr qint64 kAllocHeader = 16;  // QArrayData header of a string/list payload
+constexpr qint64 kMapData = 64;      // Shared QMap data wrapping the std::map
+constexpr qint64 kMapNode = 32 + sizeof(QString) + sizeof(QVariant);  // Red-black tree node
+constexpr qint64 kHashEntry = 16;    // QHash span slot and bookkeeping per entry
+
+struct Footprint
+{
+  qint64 rows = 0;     // Containers: row vector, maps, lists
+  qint64 strings = 0;  // String payloads (keys and values)
+};
+
+qint64 stringBytes(const QString& s)
+{
+  return s.isEmpty() ? 0 : kAllocHeader + (s.capacity() + 1) * static_cast<qint64>(sizeof(QChar));
+}
+
+qint64 keyBytes(const QString& key)
+{
+  return kHashEntry + sizeof(QString) + sizeof(int) + stringBytes(key);
+}
+
+// Chunk arrays plus the chunk table (handle and first row per chunk)
+qint64 storeBytes(const RowStore& rows)
+{
+  const auto& chunks = rows.chunks();
+  if (chunks.isEmpty())
+    return 0;
+  qint64 bytes = 2 * kAllocHeader + chunks.capacity() * static_cast<qint64>(sizeof(RowStore::Chunk) + sizeof(int));
+  for (const RowStore::Chunk& chunk : chunks)
+    bytes += kAllocHeader + chunk.capacity() * static_cast<qint64>(sizeof(QVariantMap));
+  return bytes;
+}
+
+void addVariant(Footprint& fp, const QVariant& value);
+
+void addMap(Footprint& fp, const QVariantMap& map)
+{
+  fp.rows += kMapData + map.size() * kMapNode;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    fp.strings += stringBytes(it.key());
+    addVariant(fp, it.value());
+  }
+}
+
+void addVariant(Footprint& fp, const QVariant& value)
+{
+  switch (value.typeId()) {
+  case QMetaType::QString:
+    fp.strings += stringBytes(*static_cast<const QString*>(value.constData()));
+    break;
+  case QMetaType::QVariantList: {
+    const auto& list = *static_cast<const QVariantList*>(value.constData());
+    fp.rows += kAllocHeader + list.capacity() * static_cast<qint64>(sizeof(QVariant));
+    for (const QVariant& element : list)
+      addVariant(fp, element);
+    break;
+  }
+  case QMetaType::QVariantMap:
+    addMap(fp, *static_cast<const QVariantMap*>(value.constData()));
+    break;
+  default:
+    break;  // Numbers, bools and null are stored inline in the QVariant
+  }
+}
+
+bool fail(QString* error, const QString& reason)
+{
+  if (error)
+    *error = reason;
+  return false;
+}
+
+// Value at a JSON Pointer into the rows ("" is every row as a list)
+bool rowValue(const RowStore& rows, const QStringList& path, QVariant* value)
+{
+  if (path.isEmpty()) {
+    QVariantList all;
+    all.reserve(rows.size());
+    for (const RowStore::Chunk& chunk : rows.chunks()) {
+      for (const QVariantMap& item : chunk)
+        all.append(item);
+    }
+    *value = all;
+    return true;
+  }
+  const int row = JsonPatch::arrayIndex(path.first(), rows.size(), false);
+  return row >= 0 && JsonPatch::get(QVariant(rows.at(row)), path.mid(1), value);
+}
+
+} // namespace
 
 JvmListModel::JvmListModel(QObject *parent)
   : QAbstractListModel(parent)
   , m_nextRoleId(Qt::UserRole + 1)
 {
-  qDebug() << "[CPP] JvmListModel created";
+  qCDebug(lcModel) << "JvmListModel created";
 }
 
 JvmListModel::~JvmListModel()
 {
-  qDebug() << "[CPP] JvmListModel destroyed";
+  static Gauge& totalBytes = Metrics::gauge("model.bytes");
+  totalBytes.add(-m_bytes.load(std::memory_order_relaxed));
+  delete m_pending.exchange(nullptr, std::memory_order_acquire);
+  qCDebug(lcModel) << "JvmListModel destroyed";
 }
 
 int JvmListModel::rowCount(const QModelIndex &parent) const
@@ -42,26 +145,36 @@ QHash<int, QByteArray> JvmListModel::roleNames() const
 
 void JvmListModel::setJsonData(const QString& jsonData)
 {
-  qDebug() << "[CPP] JvmListModel::setJsonData called";
-  qDebug() << "[CPP] JSON data length:" << jsonData.length();
+  qCDebug(lcModel) << "JvmListModel::setJsonData called";
+  qCDebug(lcModel) << "JSON data length" << jsonData.length();
+
+  static Histogram& parseTime = Metrics::histogram("model.set_json.parse_ns");
+  CUIRQ_TRACE_SCOPE("setJsonData", "model");
 
   // Parse JSON
-  QJsonDocument doc = QJsonDocument::fromJson(jsonData.toUtf8());
+  QJsonDocument doc;
+  {
+    ScopedTimer timer(parseTime);
+    CUIRQ_TRACE_SCOPE("parse", "model");
+    doc = QJsonDocument::fromJson(jsonData.toUtf8());
+  }
   if (!doc.isArray()) {
-    qWarning() << "[CPP] ERROR: JSON data is not an array";
+    qCWarning(lcModel) << "JSON data is not an array";
     return;
   }
 
   QJsonArray jsonArray = doc.array();
-  qDebug() << "[CPP] Parsed" << jsonArray.size() << "items";
+  qCDebug(lcModel) << "Parsed" << jsonArray.size() << "items";
 
-  // Convert to QVariantMap vector
-  QVector<QVariantMap> newItems;
-  newItems.reserve(jsonArray.size());
+  // Build the snapshot on this thread; nothing here touches m_items
+  auto snapshot = std::make_unique<Snapshot>();
+  snapshot->rows.reserve(jsonArray.size());
+  QSet<QString> seen;
+  Footprint footprint;
 
   for (const QJsonValue& value : jsonArray) {
     if (!value.isObject()) {
-      qWarning() << "[CPP] WARNING: Skipping non-object item";
+      qCWarning(lcModel) << "Skipping non-object item";
       continue;
     }
 
@@ -70,29 +183,549 @@ void JvmListModel::setJsonData(const QString& jsonData)
 
     for (auto it = obj.begin(); it != obj.end(); ++it) {
       item.insert(it.key(), it.value().toVariant());
+      // Role names are registered when the snapshot is adopted
+      if (!seen.contains(it.key())) {
+        seen.insert(it.key());
+        snapshot->roles.append(it.key());
+      }
     }
+    addMap(footprint, item);
+
+    snapshot->rows.append(item);
+  }
+
+  snapshot->rowBytes = footprint.rows;
+  snapshot->stringBytes = footprint.strings;
+  publish(snapshot.release());
+}
+
+void JvmListModel::clear()
+{
+  qCDebug(lcModel) << "JvmListModel::clear called";
+  // An empty snapshot: adopting it frees the old rows and their capacity
+  publish(new Snapshot);
+}
+
+bool JvmListModel::isGuiThread() const
+{
+  return QThread::currentThread() == thread();
+}
 
-    // Update role names based on keys in this item
-    updateRoleNames(item);
+void JvmListModel::publish(Snapshot* snapshot)
+{
+  static Counter& coalesced = Metrics::counter("model.snapshots.coalesced");
 
-    newItems.append(item);
+  // Concurrent producers take generations in swap order, so the snapshot
+  // left in the mailbox is always the newest one published
+  Snapshot* previous;
+  {
+    QMutexLocker lock(&m_publishMutex);
+    snapshot->generation = m_published.load(std::memory_order_relaxed) + 1;
+    previous = m_pending.exchange(snapshot, std::memory_order_acq_rel);
+    m_published.store(snapshot->generation, std::memory_order_relaxed);
+  }
+  if (previous) {
+    // Never adopted; the adoption already queued for it picks up this one
+    coalesced.add();
+    delete previous;
   }
 
+  if (isGuiThread())
+    adoptPending();
+  else if (!previous)
+    QMetaObject::invokeMethod(this, [this]() { adoptPending(); }, Qt::QueuedConnection);
+}
+
+void JvmListModel::adoptPending()
+{
+  static Counter& resets = Metrics::counter("model.resets");
+
+  std::unique_ptr<Snapshot> snapshot(m_pending.exchange(nullptr, std::memory_order_acq_rel));
+  if (!snapshot)
+    return;
+
+  // Attribute GUI stalls during the reset to this model
+  if (!m_adoptDetail)
+    m_adoptDetail = Trace::intern(objectName().toUtf8());
+  GuiOperation::Scope operation("adopt", m_adoptDetail);
+
+  for (const QString& role : std::as_const(snapshot->roles))
+    getRoleId(role.toUtf8());
+
   // Replace entire model (Approach A: Full Replacement)
-  beginResetModel();
-  m_items = std::move(newItems);
-  endResetModel();
+  {
+    CUIRQ_TRACE_SCOPE("reset", "model");
+    beginResetModel();
+    m_items = std::move(snapshot->rows);
+    m_adopted = snapshot->generation;
+    m_rowCount.store(m_items.size(), std::memory_order_relaxed);
+    rebuildKeyIndex();
+    endResetModel();
+  }
+  m_resetCount.fetch_add(1, std::memory_order_relaxed);
+  resets.add();
+
+  updateMemoryUsage(snapshot->rowBytes + storeBytes(m_items), snapshot->stringBytes);
 
-  qDebug() << "[CPP] Model updated with" << m_items.size() << "items";
-  qDebug() << "[CPP] Roles:" << m_roleNames;
+  qCDebug(lcModel) << "Model updated with" << m_items.size() << "items";
+  qCTrace(lcModel) << "Roles" << m_roleNames;
 }
 
-void JvmListModel::clear()
+void JvmListModel::queueEdit(std::function<void()> edit, bool droppable)
+{
+  static Counter& superseded = Metrics::counter("model.edits.superseded");
+
+  // Rows the caller saw: everything published so far
+  const quint64 generation = m_published.load(std::memory_order_relaxed);
+  QMetaObject::invokeMethod(this, [this, generation, droppable, edit = std::move(edit)]() {
+    adoptPending();
+    if (droppable && m_adopted > generation) {
+      superseded.add();
+      qCDebug(lcModel) << "Model" << objectName() << "dropped an edit superseded by newer rows";
+      return;
+    }
+    edit();
+  }, Qt::QueuedConnection);
+}
+
+void JvmListModel::setKeyRole(const QString& role)
+{
+  if (!isGuiThread()) {
+    queueEdit([this, role]() { setKeyRole(role); }, false);
+    return;
+  }
+  adoptPending();
+  if (role == m_keyRole)
+    return;
+  m_keyRole = role;
+  rebuildKeyIndex();
+  updateMemoryUsage(m_rowBytes.load(std::memory_order_relaxed), m_stringBytes.load(std::memory_order_relaxed));
+  qCDebug(lcModel) << "Model" << objectName() << "keyed by" << role << "(" << m_keyRows.size() << "keys)";
+}
+
+void JvmListModel::rebuildKeyIndex()
+{
+  QHash<QString, int>().swap(m_keyRows);
+  qint64 bytes = 0;
+  if (!m_keyRole.isEmpty()) {
+    m_keyRows.reserve(m_items.size());
+    int duplicates = 0;
+    int row = 0;
+    for (const RowStore::Chunk& chunk : m_items.chunks()) {
+      for (const QVariantMap& item : chunk) {
+        const int itemRow = row++;
+        const auto it = item.constFind(m_keyRole);
+        if (it == item.cend())
+          continue;
+        const QString key = it->toString();
+        if (m_keyRows.contains(key)) {
+          ++duplicates;
+          continue;
+        }
+        m_keyRows.insert(key, itemRow);
+        bytes += keyBytes(key);
+      }
+    }
+    if (duplicates > 0)
+      qCWarning(lcModel) << "Model" << objectName() << "has" << duplicates << "rows with a duplicate" << m_keyRole
+                         << "(only the first is patchable)";
+  }
+  m_indexBytes.store(bytes, std::memory_order_relaxed);
+}
+
+bool JvmListModel::applyPatch(const QString& key, const QString& role, const QVariant& value,
+                              QMap<int, QList<int>>& changed, qint64& rowTotal, qint64& stringTotal)
+{
+  const int row = m_keyRows.value(key, -1);
+  if (row < 0) {
+    qCDebug(lcModel) << "Model" << objectName() << "has no row with key" << key;
+    return false;
+  }
+
+  const bool rekey = role == m_keyRole && value.toString() != key;
+  const QString newKey = rekey ? value.toString() : QString();
+  if (rekey && m_keyRows.contains(newKey)) {
+    qCWarning(lcModel) << "Model" << objectName() << "already has a row with key" << newKey;
+    return false;
+  }
+
+  // Adjust the footprint by the difference instead of re-measuring every row
+  QVariantMap& item = m_items.edit(row);
+  Footprint before, after;
+  const auto it = item.constFind(role);
+  if (it != item.cend()) {
+    addVariant(before, *it);
+  } else {
+    after.rows += kMapNode;
+    after.strings += stringBytes(role);
+  }
+  addVariant(after, value);
+  item.insert(role, value);
+  rowTotal += after.rows - before.rows;
+  stringTotal += after.strings - before.strings;
+
+  if (rekey) {
+    m_keyRows.remove(key);
+    m_keyRows.insert(newKey, row);
+    m_indexBytes.fetch_add(keyBytes(newKey) - keyBytes(key), std::memory_order_relaxed);
+  }
+
+  // A role no row had before is registered, but views pick it up on the next reset
+  QList<int>& roles = changed[row];
+  const int roleId = getRoleId(role.toUtf8());
+  if (!roles.contains(roleId))
+    roles.append(roleId);
+  return true;
+}
+
+void JvmListModel::flushChanged(QMap<int, QList<int>>& changed)
+{
+  for (auto it = changed.cbegin(); it != changed.cend(); ++it) {
+    const QModelIndex changedIndex = index(it.key());
+    emit dataChanged(changedIndex, changedIndex, it.value());
+  }
+  changed.clear();
+}
+
+void JvmListModel::finishPatches(QMap<int, QList<int>>& changed, int applied, qint64 rowTotal, qint64 stringTotal)
+{
+  static Counter& patches = Metrics::counter("model.patches");
+
+  flushChanged(changed);
+  m_rowOpCount.fetch_add(applied, std::memory_order_relaxed);
+  patches.add(applied);
+  if (applied > 0)
+    updateMemoryUsage(rowTotal, stringTotal);
+}
+
+bool JvmListModel::patch(const QString& key, const QString& role, const QVariant& value)
+{
+  if (!isGuiThread()) {
+    queueEdit([this, key, role, value]() { patch(key, role, value); });
+    return true;
+  }
+  adoptPending();
+
+  QMap<int, QList<int>> changed;
+  qint64 rowTotal = m_rowBytes.load(std::memory_order_relaxed);
+  qint64 stringTotal = m_stringBytes.load(std::memory_order_relaxed);
+  const bool applied = applyPatch(key, role, value, changed, rowTotal, stringTotal);
+  finishPatches(changed, applied ? 1 : 0, rowTotal, stringTotal);
+  return applied;
+}
+
+int JvmListModel::patchMany(const QJsonArray& patches)
+{
+  if (!isGuiThread()) {
+    queueEdit([this, patches]() { patchMany(patches); });
+    return patches.size();
+  }
+  adoptPending();
+
+  CUIRQ_TRACE_SCOPE("patchMany", "model");
+
+  QMap<int, QList<int>> changed;
+  qint64 rowTotal = m_rowBytes.load(std::memory_order_relaxed);
+  qint64 stringTotal = m_stringBytes.load(std::memory_order_relaxed);
+  int applied = 0;
+  for (const QJsonValue& entry : patches) {
+    const QJsonArray triple = entry.toArray();
+    if (triple.size() != 3 || !triple.at(1).isString()) {
+      qCWarning(lcModel) << "Skipping malformed patch" << entry;
+      continue;
+    }
+    if (applyPatch(triple.at(0).toVariant().toString(), triple.at(1).toString(), triple.at(2).toVariant(),
+                   changed, rowTotal, stringTotal))
+      ++applied;
+  }
+  finishPatches(changed, applied, rowTotal, stringTotal);
+  return applied;
+}
+
+bool JvmListModel::applyJsonPatch(const QJsonArray& patch, QString* error)
+{
+  if (!isGuiThread()) {
+    queueEdit([this, patch]() { applyJsonPatch(patch); });
+    return true;
+  }
+  adoptPending();
+
+  CUIRQ_TRACE_SCOPE("applyJsonPatch", "model");
+
+  QVector<JsonPatch::Operation> ops;
+  if (!JsonPatch::parse(patch, &ops, error)) {
+    qCWarning(lcModel) << "Model" << objectName() << "rejected JSON patch:" << (error ? *error : QString());
+    return false;
+  }
+
+  // Dry run on a copy of the store: taking it is O(1), and each edit in it
+  // copies only the chunk it touches
+  {
+    PatchPass dryRun;
+    RowStore staged = m_items;
+    for (int i = 0; i < ops.size(); ++i) {
+      QString reason;
+      if (!applyOperation(staged, ops.at(i), dryRun, &reason)) {
+        const QString message = JsonPatch::describe(i, ops.at(i), reason);
+        qCWarning(lcModel) << "Model" << objectName() << "rejected JSON patch:" << message;
+        return fail(error, message);
+      }
+    }
+  }
+
+  // Every operation is known to apply; replay them on the live rows
+  PatchPass pass;
+  pass.live = true;
+  pass.rowTotal = m_rowBytes.load(std::memory_order_relaxed) - storeBytes(m_items);
+  pass.stringTotal = m_stringBytes.load(std::memory_order_relaxed);
+  for (const JsonPatch::Operation& op : std::as_const(ops))
+    applyOperation(m_items, op, pass, nullptr);
+  if (pass.rekey)
+    rebuildKeyIndex();
+  pass.rowTotal += storeBytes(m_items);
+  m_rowCount.store(m_items.size(), std::memory_order_relaxed);
+  finishPatches(pass.changed, ops.size(), pass.rowTotal, pass.stringTotal);
+  return true;
+}
+
+bool JvmListModel::applyOperation(RowStore& rows, const JsonPatch::Operation& op, PatchPass& pass,
+                                  QString* error)
+{
+  using Op = JsonPatch::Operation;
+  const QStringList& path = op.path;
+
+  // Row to row: one move notification
+  if (op.type == Op::Move && op.from.size() == 1 && path.size() == 1) {
+    const int from = JsonPatch::arrayIndex(op.from.first(), rows.size(), false);
+    if (from < 0)
+      return fail(error, QStringLiteral("\"from\" does not exist"));
+    // The target index counts rows after the moved one is taken out
+    const int to = JsonPatch::arrayIndex(path.first(), rows.size() - 1, true);
+    if (to < 0)
+      return fail(error, QStringLiteral("row index out of range"));
+    if (from == to)
+      return true;
+    if (pass.live) {
+      flushChanged(pass.changed);
+      beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+    }
+    rows.move(from, to);
+    if (pass.live) {
+      endMoveRows();
+      pass.rekey = true;
+    }
+    return true;
+  }
+
+  // Anything else that moves or copies is a read followed by remove/add
+  if (op.type == Op::Move || op.type == Op::Copy) {
+    QVariant value;
+    if (!rowValue(rows, op.from, &value))
+      return fail(error, QStringLiteral("\"from\" does not exist"));
+    if (op.type == Op::Move && op.from == path)
+      return true;
+    if (op.type == Op::Move && !applyOperation(rows, Op{ Op::Remove, op.from, {}, {} }, pass, error))
+      return false;
+    return applyOperation(rows, Op{ Op::Add, path, {}, value }, pass, error);
+  }
+
+  // The whole document: a test, or a new set of rows
+  if (path.isEmpty()) {
+    if (op.type == Op::Test) {
+      QVariant all;
+      rowValue(rows, path, &all);
+      return JsonPatch::equal(all, op.value) || fail(error, QStringLiteral("test failed"));
+    }
+    if (op.type == Op::Remove)
+      return fail(error, QStringLiteral("cannot remove the whole document"));
+    if (op.value.typeId() != QMetaType::QVariantList)
+      return fail(error, QStringLiteral("document must be an array of objects"));
+    const QVariantList list = op.value.toList();
+    RowStore items;
+    for (const QVariant& element : list) {
+      if (element.typeId() != QMetaType::QVariantMap)
+        return fail(error, QStringLiteral("rows must be objects"));
+      items.append(element.toMap());
+    }
+    if (!pass.live) {
+      rows = std::move(items);
+      return true;
+    }
+
+    static Counter& resets = Metrics::counter("model.resets");
+    Footprint footprint;
+    for (const QVariant& element : list) {
+      const QVariantMap item = element.toMap();
+      updateRoleNames(item);
+      addMap(footprint, item);
+    }
+    pass.changed.clear();  // Moot once every row is replaced
+    beginResetModel();
+    rows = std::move(items);
+    endResetModel();
+    m_resetCount.fetch_add(1, std::memory_order_relaxed);
+    resets.add();
+    pass.rowTotal = footprint.rows;
+    pass.stringTotal = footprint.strings;
+    pass.rekey = true;
+    return true;
+  }
+
+  const bool insert = op.type == Op::Add && path.size() == 1;
+  const int row = JsonPatch::arrayIndex(path.first(), rows.size(), insert);
+  if (row < 0)
+    return fail(error, QStringLiteral("row does not exist"));
+
+  // Whole rows
+  if (path.size() == 1) {
+    if (op.type == Op::Test)
+      return JsonPatch::equal(rows.at(row), op.value) || fail(error, QStringLiteral("test failed"));
+    if (op.type != Op::Remove && op.value.typeId() != QMetaType::QVariantMap)
+      return fail(error, QStringLiteral("rows must be objects"));
+
+    if (op.type == Op::Replace) {
+      const QVariantMap item = op.value.toMap();
+      QStringList roles = rows.at(row).keys() + item.keys();
+      roles.removeDuplicates();
+      editRow(rows, row, item, roles, pass);
+      return true;
+    }
+
+    if (pass.live) {
+      flushChanged(pass.changed);
+      Footprint footprint;
+      if (op.type == Op::Add) {
+        updateRoleNames(op.value.toMap());
+        addMap(footprint, op.value.toMap());
+        pass.rowTotal += footprint.rows;
+        pass.stringTotal += footprint.strings;
+        beginInsertRows(QModelIndex(), row, row);
+      } else {
+        addMap(footprint, rows.at(row));
+        pass.rowTotal -= footprint.rows;
+        pass.stringTotal -= footprint.strings;
+        beginRemoveRows(QModelIndex(), row, row);
+      }
+    }
+    if (op.type == Op::Add)
+      rows.insert(row, op.value.toMap());
+    else
+      rows.removeAt(row);
+    if (pass.live) {
+      if (op.type == Op::Add)
+        endInsertRows();
+      else
+        endRemoveRows();
+      pass.rekey = true;
+    }
+    return true;
+  }
+
+  // Inside a row: patch the row's map and announce the role it touched
+  QVariant item(rows.at(row));
+  Op inner = op;
+  inner.path = path.mid(1);
+  if (!JsonPatch::apply(item, inner, error))
+    return false;
+  if (op.type != Op::Test)
+    editRow(rows, row, item.toMap(), { path.at(1) }, pass);
+  return true;
+}
+
+void JvmListModel::editRow(RowStore& rows, int row, const QVariantMap& item, const QStringList& roles,
+                           PatchPass& pass)
+{
+  if (!pass.live) {
+    rows.set(row, item);
+    return;
+  }
+
+  Footprint before, after;
+  addMap(before, rows.at(row));
+  addMap(after, item);
+  pass.rowTotal += after.rows - before.rows;
+  pass.stringTotal += after.strings - before.strings;
+  rows.set(row, item);
+
+  // A role no row had before is registered, but views pick it up on the next reset
+  QList<int>& changed = pass.changed[row];
+  for (const QString& role : roles) {
+    const int roleId = getRoleId(role.toUtf8());
+    if (!changed.contains(roleId))
+      changed.append(roleId);
+    if (role == m_keyRole)
+      pass.rekey = true;
+  }
+}
+
+QJsonObject JvmListModel::statistics() const
+{
+  return QJsonObject{
+    { "rows", count() },
+    { "roles", m_roleCount.load(std::memory_order_relaxed) },
+    { "resets", static_cast<qint64>(m_resetCount.load(std::memory_order_relaxed)) },
+    { "row_ops", static_cast<qint64>(m_rowOpCount.load(std::memory_order_relaxed)) },
+    { "bytes", memoryUsage() }
+  };
+}
+
+QJsonObject JvmListModel::memoryStatistics() const
+{
+  return QJsonObject{
+    { "total", memoryUsage() },
+    { "rows", m_rowBytes.load(std::memory_order_relaxed) },
+    { "strings", m_stringBytes.load(std::memory_order_relaxed) },
+    { "roles", m_roleBytes.load(std::memory_order_relaxed) },
+    { "index", m_indexBytes.load(std::memory_order_relaxed) },
+    { "budget", memoryBudget() }
+  };
+}
+
+void JvmListModel::setMemoryBudget(qint64 bytes)
+{
+  m_budget.store(qMax<qint64>(0, bytes), std::memory_order_relaxed);
+  m_overBudget = false;
+  checkBudget();
+}
+
+void JvmListModel::updateMemoryUsage(qint64 rowBytes, qint64 stringBytes)
+{
+  static Gauge& totalBytes = Metrics::gauge("model.bytes");
+
+  // Role tables only grow, so they are re-measured here rather than tracked per insert
+  qint64 roleBytes = 0;
+  for (auto it = m_roleNames.cbegin(); it != m_roleNames.cend(); ++it)
+    roleBytes += 2 * (kHashEntry + sizeof(int) + sizeof(QByteArray)) + kAllocHeader + it.value().capacity() + 1;
+
+  const qint64 total = rowBytes + stringBytes + roleBytes + m_indexBytes.load(std::memory_order_relaxed);
+  m_rowBytes.store(rowBytes, std::memory_order_relaxed);
+  m_stringBytes.store(stringBytes, std::memory_order_relaxed);
+  m_roleBytes.store(roleBytes, std::memory_order_relaxed);
+  totalBytes.add(total - m_bytes.exchange(total, std::memory_order_relaxed));
+
+  checkBudget();
+}
+
+void JvmListModel::checkBudget()
+{
+  const qint64 budget = memoryBudget();
+  const qint64 bytes = memoryUsage();
+  const bool over = budget > 0 && bytes > budget;
+  if (over && !m_overBudget) {
+    static Counter& exceeded = Metrics::counter("model.budget_exceeded");
+    exceeded.add();
+    qCWarning(lcModel) << "Model" << objectName() << "uses" << bytes << "bytes, over its budget of" << budget;
+    m_overBudget = true;
+    emit memoryBudgetExceeded(bytes, budget);
+  } else if (!over) {
+    m_overBudget = false;
+  }
+}
+
+void JvmListModel::resetStatistics()
 {
-  qDebug() << "[CPP] JvmListModel::clear called";
-  beginResetModel();
-  m_items.clear();
-  endResetModel();
+  m_resetCount.store(0, std::memory_order_relaxed);
+  m_rowOpCount.store(0, std::memory_order_relaxed);
 }
 
 void JvmListModel::updateRoleNames(const QVariantMap& item)
@@ -105,7 +738,8 @@ void JvmListModel::updateRoleNames(const QVariantMap& item)
       int roleId = m_nextRoleId++;
       m_roleIds.insert(roleName, roleId);
       m_roleNames.insert(roleId, roleName);
-      qDebug() << "[CPP] Registered role:" << roleName << "with ID:" << roleId;
+      m_roleCount.store(m_roleNames.size(), std::memory_order_relaxed);
+      qCTrace(lcModel) << "Registered role" << roleName << "with ID" << roleId;
     }
   }
 }
@@ -120,6 +754,7 @@ int JvmListModel::getRoleId(const QByteArray& roleName)
   int roleId = m_nextRoleId++;
   m_roleIds.insert(roleName, roleId);
   m_roleNames.insert(roleId, roleName);
-  qDebug() << "[CPP] Auto-registered role:" << roleName << "with ID:" << roleId;
+  m_roleCount.store(m_roleNames.size(), std::memory_order_relaxed);
+  qCTrace(lcModel) << "Auto-registered role" << roleName << "with ID" << roleId;
   return roleId;
 }
@@ -7,13 +7,54 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QMap>
+#include <QMutex>
 #include <QString>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+
+#include "jsonpatch.h"
+#include "rowstore.h"
 
 /**
  * JvmListModel - QAbstractListModel for JVM data
  *
  * Receives JSON data from JVM and exposes it to QML ListView/GridView.
  * Supports dynamic roles based on JSON keys.
+ *
+ * Tracks an approximate heap footprint (row containers, string payloads,
+ * role tables, key index) that is recomputed whenever the rows are
+ * replaced and adjusted by patches. An optional budget makes the model
+ * emit memoryBudgetExceeded() when the footprint crosses it.
+ *
+ * With a key role declared (e.g. "id"), rows are indexed by the string
+ * form of that role's value, so patch() finds a row in O(1) however rows
+ * are ordered, and only the patched row and role are announced through
+ * dataChanged. Keys should be unique; later duplicates are not indexed.
+ *
+ * applyJsonPatch() takes an RFC 6902 patch over the rows as a JSON array:
+ * "/3" is a row ("/-" appends) and "/3/tags/0" a path inside a role. Row
+ * add/remove/move become row insert/remove/move notifications and edits
+ * inside a row become dataChanged for the roles they touch, so views keep
+ * their state. The whole patch is checked on a copy of the rows before
+ * the model is touched: either every operation is applied or none is.
+ *
+ * Rows are kept in a RowStore (copy-on-write chunks), so an edit costs
+ * O(chunk) rather than O(rows), and rows() hands out an O(1) snapshot
+ * that another thread can sort, search or export while the model keeps
+ * changing.
+ *
+ * Threading: rows live on the GUI thread and data() reads them without a
+ * lock. setJsonData() and clear() may be called from any thread: they
+ * build a Snapshot (rows, role names, footprint) on the caller's thread
+ * and swap it into a one-slot mailbox; the GUI thread takes it out and
+ * adopts it between events with one model reset (RCU style). Snapshots
+ * published faster than the GUI adopts them are coalesced, latest wins.
+ * Edits (patches, key role) called from another thread are queued to the
+ * GUI thread in call order; an edit queued before a snapshot that has
+ * since been adopted is dropped, since the snapshot replaced its rows.
+ * count(), statistics() and the memory figures are safe from any thread.
  */
 class JvmListModel : public QAbstractListModel
 {
@@ -31,16 +72,117 @@ public:
     // Data management
     Q_INVOKABLE void setJsonData(const QString& jsonData);
     Q_INVOKABLE void clear();
-    Q_INVOKABLE int count() const { return m_items.size(); }
+    Q_INVOKABLE int count() const { return m_rowCount.load(std::memory_order_relaxed); }
+
+    // The current rows, shared: O(1), and safe to read from any thread
+    // after it is taken on the GUI thread
+    RowStore rows() const { return m_items; }
+
+    // Key index: rows by the value of `role` (empty disables it)
+    Q_INVOKABLE void setKeyRole(const QString& role);
+    QString keyRole() const { return m_keyRole; }
+    Q_INVOKABLE int rowForKey(const QString& key) const { return m_keyRows.value(key, -1); }
+
+    // Set one role of the row with `key`; returns false if no row has it
+    // (from another thread the patch is queued and true is returned)
+    Q_INVOKABLE bool patch(const QString& key, const QString& role, const QVariant& value);
+
+    // Apply [[key, role, value], ...] with one dataChanged per patched row;
+    // returns the number of patches applied (queued, from another thread)
+    int patchMany(const QJsonArray& patches);
+
+    // Apply an RFC 6902 JSON Patch atomically; on failure nothing changes
+    // and `error` names the operation that failed (from another thread the
+    // patch is queued, true is returned and a failure is only logged)
+    bool applyJsonPatch(const QJsonArray& patch, QString* error = nullptr);
+
+    // Runtime statistics: {"rows", "roles", "resets", "row_ops", "bytes"}
+    QJsonObject statistics() const;
+    void resetStatistics();
+
+    // Approximate heap footprint in bytes (safe to read from any thread)
+    qint64 memoryUsage() const { return m_bytes.load(std::memory_order_relaxed); }
+
+    // Breakdown: {"total", "rows", "strings", "roles", "index", "budget"}
+    QJsonObject memoryStatistics() const;
+
+    // Warn when memoryUsage() exceeds bytes; 0 disables the budget
+    void setMemoryBudget(qint64 bytes);
+    qint64 memoryBudget() const { return m_budget.load(std::memory_order_relaxed); }
+
+signals:
+    // Emitted once each time the footprint goes from within budget to above it
+    void memoryBudgetExceeded(qint64 bytes, qint64 budget);
 
 private:
-    QVector<QVariantMap> m_items;
+    // Rows and what is derived from them, built on any thread
+    struct Snapshot
+    {
+        RowStore rows;
+        QStringList roles;       // Every key, in first-seen order
+        qint64 rowBytes = 0;     // Footprint, without the row store itself
+        qint64 stringBytes = 0;
+        quint64 generation = 0;  // Position in publication order
+    };
+
+    // GUI thread only
+    RowStore m_items;
     QHash<int, QByteArray> m_roleNames;
     QHash<QByteArray, int> m_roleIds;
     int m_nextRoleId;
 
+    // Key role value -> row
+    QString m_keyRole;
+    QHash<QString, int> m_keyRows;
+
+    // Publication: producers swap snapshots in, the GUI thread takes them out
+    std::atomic<Snapshot*> m_pending{nullptr};
+    QMutex m_publishMutex;                 // Orders producers: generation and swap together
+    std::atomic<quint64> m_published{0};  // Generation of the last snapshot published
+    quint64 m_adopted = 0;                 // Generation of m_items (GUI thread)
+    const char* m_adoptDetail = nullptr;   // Interned objectName() for the "adopt" marker
+
+    // Statistics (read from any thread via the bridge)
+    std::atomic<int> m_rowCount{0};
+    std::atomic<int> m_roleCount{0};
+    std::atomic<quint64> m_resetCount{0};
+    std::atomic<quint64> m_rowOpCount{0};
+
+    // Memory accounting (written on the GUI thread, read from any thread)
+    std::atomic<qint64> m_rowBytes{0};
+    std::atomic<qint64> m_stringBytes{0};
+    std::atomic<qint64> m_roleBytes{0};
+    std::atomic<qint64> m_indexBytes{0};
+    std::atomic<qint64> m_bytes{0};
+    std::atomic<qint64> m_budget{0};
+    bool m_overBudget = false;
+
+    bool isGuiThread() const;
+    void publish(Snapshot* snapshot);
+    void adoptPending();
+    void queueEdit(std::function<void()> edit, bool droppable = true);
+
     void updateRoleNames(const QVariantMap& item);
     int getRoleId(const QByteArray& roleName);
+    void updateMemoryUsage(qint64 rowBytes, qint64 stringBytes);
+    void rebuildKeyIndex();
+    bool applyPatch(const QString& key, const QString& role, const QVariant& value,
+                    QMap<int, QList<int>>& changed, qint64& rowTotal, qint64& stringTotal);
+    void finishPatches(QMap<int, QList<int>>& changed, int applied, qint64 rowTotal, qint64 stringTotal);
+    void flushChanged(QMap<int, QList<int>>& changed);
+
+    // One JSON Patch pass: a dry run on a staged copy, then the live run
+    struct PatchPass
+    {
+        bool live = false;               // Rows are m_items: notify and account memory
+        QMap<int, QList<int>> changed;   // Pending dataChanged, flushed before rows shift
+        qint64 rowTotal = 0;
+        qint64 stringTotal = 0;
+        bool rekey = false;              // Rows shifted or a key changed
+    };
+    bool applyOperation(RowStore& rows, const JsonPatch::Operation& op, PatchPass& pass, QString* error);
+    void editRow(RowStore& rows, int row, const QVariantMap& item, const QStringList& roles, PatchPass& pass);
+    void checkBudget();
 };
 
 #endif // JVMLISTMODEL_H
@@ -0,0 +1,280 @@
+#include "log.h"
+#include "metrics.h"
+#include <QByteArray>
+#include <QStringList>
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+Q_LOGGING_CATEGORY(lcBridge, "cuirq.bridge")
+Q_LOGGING_CATEGORY(lcSignal, "cuirq.signal")
+Q_LOGGING_CATEGORY(lcModel, "cuirq.model")
+Q_LOGGING_CATEGORY(lcWatcher, "cuirq.watcher")
+Q_LOGGING_CATEGORY(lcState, "cuirq.state")
+Q_LOGGING_CATEGORY(lcWatchdog, "cuirq.watchdog")
+
+std::atomic<int> Log::s_level{Log::Info};
+
+namespace {
+
+// Messages buffered before producers start dropping
+constexpr quint64 kQueueCapacity = 1 << 12;
+
+/**
+ * Bounded multi-producer queue (Vyukov): each slot carries a sequence
+ * number, so producers claim slots with one CAS and never take a lock.
+ * Only the writer thread consumes.
+ */
+class LogQueue
+{
+public:
+    LogQueue()
+    {
+        for (quint64 i = 0; i < kQueueCapacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(QByteArray&& line)
+    {
+        quint64 pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[pos % kQueueCapacity];
+            const quint64 seq = slot.sequence.load(std::memory_order_acquire);
+            const qint64 diff = static_cast<qint64>(seq) - static_cast<qint64>(pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.line = std::move(line);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(QByteArray& line)
+    {
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[head % kQueueCapacity];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;  // Empty
+        }
+        line = std::move(slot.line);
+        slot.line = QByteArray();
+        slot.sequence.store(head + kQueueCapacity, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Any thread; approximate while producers and the writer run. The head
+    // is read first so the result is never negative (the tail only grows).
+    qint64 depth() const
+    {
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+        return static_cast<qint64>(m_tail.load(std::memory_order_relaxed) - head);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<quint64> sequence{0};
+        QByteArray line;
+    };
+
+    std::array<Slot, kQueueCapacity> m_slots;
+    std::atomic<quint64> m_tail{0};
+    std::atomic<quint64> m_head{0};  // Written by the consumer only
+};
+
+struct LogState
+{
+    LogQueue queue;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<bool> running{false};
+    std::atomic<bool> writerIdle{false};
+    QtMessageHandler previous = nullptr;
+};
+
+LogState& logState()
+{
+    // Intentionally leaked: messages may arrive during static destruction
+    static LogState* instance = new LogState();
+    return *instance;
+}
+
+char levelLetter(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:    return 'D';
+    case QtInfoMsg:     return 'I';
+    case QtWarningMsg:  return 'W';
+    case QtCriticalMsg: return 'E';
+    case QtFatalMsg:    return 'F';
+    }
+    return '?';
+}
+
+QByteArray formatLine(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    const char* category = context.category ? context.category : "default";
+    QByteArray line;
+    line.reserve(message.size() + 32);
+    line.append('[').append(category).append("] ").append(levelLetter(type)).append(": ")
+        .append(message.toUtf8()).append('\n');
+    return line;
+}
+
+// Writer thread: drains the queue in batches, one fflush per batch
+void drain(LogState& st)
+{
+    static Gauge& depth = Metrics::gauge("log.queue_depth");
+
+    QByteArray line;
+    bool wrote = false;
+    while (st.queue.pop(line)) {
+        std::fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stderr);
+        wrote = true;
+    }
+    if (wrote) {
+        std::fflush(stderr);
+    }
+    depth.set(st.queue.depth());
+}
+
+void writerLoop()
+{
+    LogState& st = logState();
+    while (st.running.load(std::memory_order_acquire)) {
+        drain(st);
+
+        std::unique_lock<std::mutex> lock(st.mutex);
+        st.writerIdle.store(true, std::memory_order_release);
+        st.wake.wait_for(lock, std::chrono::milliseconds(50), [&st]() {
+            return st.queue.depth() > 0 || !st.running.load(std::memory_order_acquire);
+        });
+        st.writerIdle.store(false, std::memory_order_release);
+    }
+    drain(st);
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    static Counter& messages = Metrics::counter("log.messages");
+    static Counter& dropped = Metrics::counter("log.dropped");
+    static Gauge& depth = Metrics::gauge("log.queue_depth");
+
+    LogState& st = logState();
+    QByteArray line = formatLine(type, context, message);
+
+    if (type == QtFatalMsg || !st.running.load(std::memory_order_acquire)) {
+        // Fatal: Qt aborts right after this returns, so write through synchronously
+        std::fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stderr);
+        std::fflush(stderr);
+        return;
+    }
+
+    messages.add();
+    if (!st.queue.push(std::move(line))) {
+        dropped.add();
+        return;
+    }
+    depth.set(st.queue.depth());
+
+    if (st.writerIdle.load(std::memory_order_acquire)) {
+        st.wake.notify_one();
+    }
+}
+
+QByteArray filterRules(Log::Level level)
+{
+    // Qt has no trace level: trace rides on debug and is gated by Log::traceEnabled()
+    const bool debug = level <= Log::Debug;
+    const bool info = level <= Log::Info;
+    const bool warning = level <= Log::Warning;
+
+    QByteArray rules;
+    rules.append("cuirq.*.debug=").append(debug ? "true" : "false").append('\n');
+    rules.append("cuirq.*.info=").append(info ? "true" : "false").append('\n');
+    rules.append("cuirq.*.warning=").append(warning ? "true" : "false").append('\n');
+    rules.append("cuirq.*.critical=true\n");
+    return rules;
+}
+
+} // namespace
+
+void Log::install()
+{
+    LogState& st = logState();
+    if (st.running.exchange(true)) {
+        return;
+    }
+
+    setLevel(level());
+    st.writer = std::thread(writerLoop);
+    st.previous = qInstallMessageHandler(messageHandler);
+
+    // Flush whatever is still queued when the process exits normally
+    std::atexit(&Log::shutdown);
+}
+
+void Log::shutdown()
+{
+    LogState& st = logState();
+    if (!st.running.exchange(false)) {
+        return;
+    }
+
+    qInstallMessageHandler(st.previous);
+    {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.wake.notify_one();
+    }
+    if (st.writer.joinable()) {
+        st.writer.join();
+    }
+}
+
+void Log::setLevel(Level level)
+{
+    s_level.store(level, std::memory_order_relaxed);
+    QLoggingCategory::setFilterRules(QString::fromUtf8(filterRules(level)));
+}
+
+bool Log::setLevel(const QString& name)
+{
+    static const QStringList names = { "trace", "debug", "info", "warning", "error" };
+    const int index = names.indexOf(name.trimmed().toLower());
+    if (index < 0) {
+        qCWarning(lcBridge) << "Unknown log level" << name;
+        return false;
+    }
+    setLevel(static_cast<Level>(index));
+    return true;
+}
+
+QString Log::levelName(Level level)
+{
+    switch (level) {
+    case Trace:   return "trace";
+    case Debug:   return "debug";
+    case Info:    return "info";
+    case Warning: return "warning";
+    case Error:   return "error";
+    }
+    return "info";
+}
+
+void Log::setFilterRules(const QString& rules)
+{
+    // Applied on top of the level rules so single categories can be opened up
+    QLoggingCategory::setFilterRules(QString::fromUtf8(filterRules(level())) + rules);
+}
@@ -0,0 +1,85 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <QLoggingCategory>
+#include <QString>
+#include <atomic>
+
+/**
+ * Structured, leveled logging for the bridge.
+ *
+ * Categories (filterable with QT_LOGGING_RULES or Log::setFilterRules):
+ *   cuirq.bridge   JNI entry points and lifecycle
+ *   cuirq.signal   QML → JVM signal forwarding
+ *   cuirq.model    List models
+ *   cuirq.watcher  Hot-reload
+ *   cuirq.state    Reactive state
+ *   cuirq.watchdog GUI-thread stall watchdog
+ *
+ * Levels, lowest first: trace, debug, info, warning, error.
+ *   - qCTrace/qCDebug are for hot paths and are stripped at compile time
+ *     below CUIRQ_LOG_LEVEL (CMake cache variable)
+ *   - The runtime level (default: info) is set with Log::setLevel(),
+ *     e.g. from the JVM via Bridge.setLogLevel("debug")
+ *
+ * Output is asynchronous: the message handler formats the line and pushes
+ * it into a bounded lock-free ring buffer; a single background thread
+ * writes batches to stderr. When the buffer is full the message is dropped
+ * (counted in the "log.dropped" metric) instead of blocking the caller.
+ * Fatal messages are written synchronously.
+ */
+
+Q_DECLARE_LOGGING_CATEGORY(lcBridge)
+Q_DECLARE_LOGGING_CATEGORY(lcSignal)
+Q_DECLARE_LOGGING_CATEGORY(lcModel)
+Q_DECLARE_LOGGING_CATEGORY(lcWatcher)
+Q_DECLARE_LOGGING_CATEGORY(lcState)
+Q_DECLARE_LOGGING_CATEGORY(lcWatchdog)
+
+class Log
+{
+public:
+    enum Level {
+        Trace = 0,
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    // Install the async message handler (idempotent)
+    static void install();
+
+    // Drain pending messages and stop the writer thread
+    static void shutdown();
+
+    // Runtime level for all cuirq.* categories
+    static void setLevel(Level level);
+    static Level level() { return static_cast<Level>(s_level.load(std::memory_order_relaxed)); }
+
+    // Parse "trace" | "debug" | "info" | "warning" | "error"; returns false if unknown
+    static bool setLevel(const QString& name);
+    static QString levelName(Level level);
+
+    // Raw Qt filter rules, e.g. "cuirq.model.debug=true"
+    static void setFilterRules(const QString& rules);
+
+    static bool traceEnabled() { return s_level.load(std::memory_order_relaxed) <= Trace; }
+
+private:
+    static std::atomic<int> s_level;
+};
+
+#ifdef CUIRQ_LOG_TRACE
+// Trace level: per-value / per-row detail, enabled with Log::setLevel(Log::Trace)
+#define qCTrace(category) \
+    for (bool cuirqTraceOn = Log::traceEnabled() && category().isDebugEnabled(); \
+         cuirqTraceOn; cuirqTraceOn = false) \
+        QMessageLogger(QT_MESSAGELOG_FILE, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC, \
+                       category().categoryName()).debug()
+#else
+#define qCTrace(category) \
+    while (false) QMessageLogger().noDebug()
+#endif
+
+#endif // LOG_H
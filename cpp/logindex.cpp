@@ -0,0 +1,251 @@
+#include "logindex.h"
+#include "metrics.h"
+
+#include <QByteArrayMatcher>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <cstring>
+
+namespace {
+
+constexpr int kPollStep = 25;          // ms between interruption checks while idle
+constexpr int kFlushInterval = 100;    // ms, sparse matches still stream
+constexpr int kCancelCheckLines = 4096;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// LogIndexer
+// ---------------------------------------------------------------------------
+
+LogIndexer::LogIndexer(const QString& path, bool follow, qint64 offset, qint64 newlines,
+                       qint64 lastLineStart, QObject* parent)
+    : QThread(parent)
+    , m_path(path)
+    , m_follow(follow)
+    , m_offset(offset)
+    , m_newlines(newlines)
+    , m_lastLineStart(lastLineStart)
+{
+    setObjectName(QStringLiteral("cuirq-logindex"));
+}
+
+LogIndexer::~LogIndexer()
+{
+    requestInterruption();
+    wait();
+}
+
+bool LogIndexer::pause()
+{
+    for (int waited = 0; waited < kPollInterval; waited += kPollStep) {
+        if (isInterruptionRequested()) {
+            return false;
+        }
+        msleep(kPollStep);
+    }
+    return !isInterruptionRequested();
+}
+
+void LogIndexer::run()
+{
+    static Counter& indexedBytes = Metrics::counter("logview.bytes_indexed");
+
+    QFile file(m_path);
+    qint64 scanned = m_offset;
+    qint64 newlines = m_newlines;
+    qint64 lastLineStart = m_lastLineStart;
+    QVector<quint64> checkpoints;
+    if (scanned == 0) {
+        checkpoints.append(0);  // Line 0
+    }
+
+    while (!isInterruptionRequested()) {
+        if (!file.isOpen() && !file.open(QIODevice::ReadOnly)) {
+            if (!m_follow.load(std::memory_order_relaxed)) {
+                emit failed(file.errorString());
+                return;
+            }
+            // Following a file that does not exist yet
+            if (!pause()) {
+                return;
+            }
+            continue;
+        }
+
+        const qint64 size = file.size();
+        if (size < scanned) {
+            file.close();
+            scanned = 0;
+            newlines = 0;
+            lastLineStart = 0;
+            checkpoints = { 0 };
+            emit truncated();
+            continue;
+        }
+
+        if (size > scanned) {
+            CUIRQ_TRACE_SCOPE("LogIndexer::scan", "io");
+            const uchar* map = file.map(scanned, size - scanned);
+            if (!map) {
+                emit failed(file.errorString());
+                return;
+            }
+            const char* base = reinterpret_cast<const char*>(map);
+            const qint64 length = size - scanned;
+            for (qint64 pos = 0; pos < length;) {
+                if (isInterruptionRequested()) {
+                    file.unmap(const_cast<uchar*>(map));
+                    return;
+                }
+                const qint64 end = qMin(length, pos + kScanBlock);
+                const char* p = base + pos;
+                const char* const stop = base + end;
+                while (p < stop) {
+                    const void* newline = std::memchr(p, '\n', static_cast<size_t>(stop - p));
+                    if (!newline) {
+                        break;
+                    }
+                    p = static_cast<const char*>(newline) + 1;
+                    lastLineStart = scanned + (p - base);
+                    if (++newlines % kLinesPerCheckpoint == 0) {
+                        checkpoints.append(static_cast<quint64>(lastLineStart));
+                    }
+                }
+                indexedBytes.add(static_cast<quint64>(end - pos));
+                pos = end;
+                emit progress(checkpoints, newlines, scanned + pos, lastLineStart);
+                checkpoints.clear();
+            }
+            file.unmap(const_cast<uchar*>(map));
+            scanned = size;
+            emit caughtUp();
+        } else if (scanned == 0 && !m_follow.load(std::memory_order_relaxed)) {
+            emit caughtUp();  // Empty file
+        }
+
+        if (!m_follow.load(std::memory_order_relaxed) || !pause()) {
+            return;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// LogSearchJob
+// ---------------------------------------------------------------------------
+
+LogSearchJob::LogSearchJob(const QString& path, qint64 bytes, const QString& pattern, bool regex,
+                           bool caseSensitive, std::shared_ptr<std::atomic<bool>> cancelled)
+    : m_path(path)
+    , m_bytes(bytes)
+    , m_pattern(pattern)
+    , m_regex(regex)
+    , m_caseSensitive(caseSensitive)
+    , m_cancelled(std::move(cancelled))
+{
+}
+
+void LogSearchJob::run()
+{
+    static Histogram& searchTime = Metrics::histogram("logview.search_ns");
+    ScopedTimer timer(searchTime);
+    CUIRQ_TRACE_SCOPE("LogSearchJob::run", "io");
+
+    QFile file(m_path);
+    const uchar* map = file.open(QIODevice::ReadOnly) && m_bytes > 0 ? file.map(0, m_bytes) : nullptr;
+    if (!map) {
+        emit done(0, m_cancelled->load());
+        return;
+    }
+    const char* base = reinterpret_cast<const char*>(map);
+
+    qint64 total = 0;
+    QVector<LogMatch> batch;
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    const auto flush = [&](bool force) {
+        if (!batch.isEmpty() && (force || batch.size() >= kBatch || sinceFlush.elapsed() >= kFlushInterval)) {
+            emit found(batch);
+            batch.clear();
+            sinceFlush.restart();
+        }
+    };
+    const auto record = [&](qint64 line, int column, int length) {
+        if (++total <= kMaxMatches) {
+            batch.append(LogMatch{ line, column, length });
+        }
+        flush(false);
+    };
+    // Mapped pages past a truncation fault: stop early if the file shrank
+    const auto stillValid = [&]() { return !m_cancelled->load() && file.size() >= m_bytes; };
+
+    bool stopped = false;
+    if (!m_regex && m_caseSensitive) {
+        // Raw bytes: no decoding except for the lines that match
+        const QByteArray needle = m_pattern.toUtf8();
+        const QByteArrayMatcher matcher(needle);
+        qint64 line = 0;
+        qint64 lineStart = 0;
+        qint64 counted = 0;  // Newlines counted up to here
+        qint64 nextCheck = 0;
+        for (qint64 from = 0; from + needle.size() <= m_bytes;) {
+            if (from >= nextCheck || m_cancelled->load(std::memory_order_relaxed)) {
+                if (!stillValid()) {
+                    stopped = true;
+                    break;
+                }
+                nextCheck = from + LogIndexer::kScanBlock;
+            }
+            const qint64 limit = qMin(m_bytes, from + LogIndexer::kScanBlock + needle.size() - 1);
+            const qint64 hit = matcher.indexIn(base, limit, from);
+            if (hit < 0) {
+                from = limit - needle.size() + 1;
+                flush(false);
+                continue;
+            }
+            while (const void* newline = std::memchr(base + counted, '\n', static_cast<size_t>(hit - counted))) {
+                counted = static_cast<const char*>(newline) - base + 1;
+                lineStart = counted;
+                ++line;
+            }
+            counted = hit;
+            const int column = QString::fromUtf8(base + lineStart, hit - lineStart).size();
+            record(line, column, m_pattern.size());
+            from = hit + qMax<qint64>(1, needle.size());
+        }
+    } else {
+        const QRegularExpression re(m_regex ? m_pattern : QRegularExpression::escape(m_pattern),
+                                    m_caseSensitive ? QRegularExpression::NoPatternOption
+                                                    : QRegularExpression::CaseInsensitiveOption);
+        qint64 line = 0;
+        for (qint64 start = 0; start < m_bytes; ++line) {
+            if (line % kCancelCheckLines == 0) {
+                if (!stillValid()) {
+                    stopped = true;
+                    break;
+                }
+                flush(false);
+            }
+            const void* newline = std::memchr(base + start, '\n', static_cast<size_t>(m_bytes - start));
+            const qint64 end = newline ? static_cast<const char*>(newline) - base : m_bytes;
+            qint64 length = qMin<qint64>(end - start, kMaxLineBytes);
+            if (length > 0 && base[start + length - 1] == '\r') {
+                --length;
+            }
+            const QString text = QString::fromUtf8(base + start, length);
+            QRegularExpressionMatchIterator it = re.globalMatch(text);
+            while (it.hasNext()) {
+                const QRegularExpressionMatch match = it.next();
+                if (match.capturedLength() > 0) {
+                    record(line, static_cast<int>(match.capturedStart()), static_cast<int>(match.capturedLength()));
+                }
+            }
+            start = end + 1;
+        }
+    }
+
+    file.unmap(const_cast<uchar*>(map));
+    flush(true);
+    emit done(total, stopped);
+}
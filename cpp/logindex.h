@@ -0,0 +1,111 @@
+#ifndef LOGINDEX_H
+#define LOGINDEX_H
+
+#include <QMetaType>
+#include <QObject>
+#include <QRunnable>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+/**
+ * LogIndexer - Background line-offset index of a (growing) text file.
+ *
+ * Memory-maps the file and scans it for newlines with memchr, kScanBlock
+ * bytes at a time, keeping the offset of every kLinesPerCheckpoint-th
+ * line start. 100M lines cost ~12 MB of index; line n is found by
+ * scanning forward from checkpoint n / kLinesPerCheckpoint.
+ *
+ * Progress is reported after every block, so the first screen can be
+ * shown while the rest of the file is still being indexed.
+ *
+ * In follow mode the thread keeps polling the file once caught up:
+ * appended data is indexed incrementally, and a file that shrank
+ * (truncated in place) is indexed again from the start. Rotation by
+ * rename is not detected: the old file keeps being followed.
+ */
+class LogIndexer : public QThread
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kLinesPerCheckpoint = 64;
+    static constexpr qint64 kScanBlock = 8 << 20;
+    static constexpr int kPollInterval = 250;  // ms, follow mode
+
+    // Resumes after `offset` when the first part of the file is indexed
+    LogIndexer(const QString& path, bool follow, qint64 offset = 0, qint64 newlines = 0,
+               qint64 lastLineStart = 0, QObject* parent = nullptr);
+    ~LogIndexer() override;
+
+    void setFollow(bool follow) { m_follow.store(follow, std::memory_order_relaxed); }
+
+signals:
+    // `checkpoints` continue the ones already reported. `newlines` and
+    // `lastLineStart` (offset after the last newline) cover [0, bytes).
+    void progress(const QVector<quint64>& checkpoints, qint64 newlines, qint64 bytes, qint64 lastLineStart);
+    void caughtUp();
+    void truncated();
+    void failed(const QString& error);
+
+protected:
+    void run() override;
+
+private:
+    bool pause();  // false when interrupted
+
+    QString m_path;
+    std::atomic<bool> m_follow;
+    qint64 m_offset;
+    qint64 m_newlines;
+    qint64 m_lastLineStart;
+};
+
+/** A search hit. Columns and lengths are in UTF-16 code units. */
+struct LogMatch
+{
+    qint64 line;
+    int column;
+    int length;
+};
+Q_DECLARE_METATYPE(LogMatch)
+
+/**
+ * LogSearchJob - Searches the first `bytes` of a file on a pool thread.
+ *
+ * Plain case-sensitive patterns are matched on the raw bytes
+ * (QByteArrayMatcher); regexes and case-insensitive searches decode each
+ * line. Hits are streamed in batches through `found` while the scan runs;
+ * past kMaxMatches they are only counted. Regexes only see the first
+ * kMaxLineBytes of a line.
+ */
+class LogSearchJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kBatch = 1024;
+    static constexpr int kMaxMatches = 1 << 20;
+    static constexpr int kMaxLineBytes = 1 << 16;
+
+    LogSearchJob(const QString& path, qint64 bytes, const QString& pattern, bool regex, bool caseSensitive,
+                 std::shared_ptr<std::atomic<bool>> cancelled);
+
+    void run() override;
+
+signals:
+    void found(const QVector<LogMatch>& matches);
+    void done(qint64 total, bool cancelled);
+
+private:
+    QString m_path;
+    qint64 m_bytes;
+    QString m_pattern;
+    bool m_regex;
+    bool m_caseSensitive;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+#endif // LOGINDEX_H
@@ -0,0 +1,703 @@
+#include "logview.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QFontDatabase>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QRegularExpression>
+#include <QSGImageNode>
+#include <QSGRectangleNode>
+#include <QSGTransformNode>
+#include <QTextLayout>
+#include <QThreadPool>
+#include <QUrl>
+#include <QWheelEvent>
+#include <QtMath>
+#include <QtQml>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+// Glyph nodes when available, otherwise each line is rasterized
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+#include <QSGTextNode>
+#define CUIRQ_LOGVIEW_TEXT_NODES
+#endif
+
+namespace {
+
+constexpr qreal kPadding = 4;            // Left margin
+constexpr int kMaxDisplayChars = 4096;   // Longer lines are cut on screen
+constexpr int kWheelUnitsPerLine = 40;   // 3 lines per 120-unit wheel notch
+constexpr int kForwardInterval = 250;    // ms between logViewIndexed events
+
+struct SearchPool : QThreadPool
+{
+    SearchPool()
+    {
+        setMaxThreadCount(2);
+        setObjectName(QStringLiteral("cuirq-logsearch"));
+    }
+};
+
+QThreadPool& searchPool()
+{
+    static SearchPool pool;
+    return pool;
+}
+
+} // namespace
+
+LogView::LogView(QQuickItem* parent)
+    : QQuickItem(parent)
+    , m_font(QFontDatabase::systemFont(QFontDatabase::FixedFont))
+{
+    setFlag(ItemHasContents, true);
+    setClip(true);
+    m_lineHeight = std::ceil(QFontMetricsF(m_font).height());
+}
+
+LogView::~LogView()
+{
+    if (m_searchCancel) {
+        m_searchCancel->store(true);
+    }
+    delete m_indexer;
+    unmap();
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+}
+
+QHash<QString, LogView*>& LogView::registry()
+{
+    static QHash<QString, LogView*> views;
+    return views;
+}
+
+LogView::EventSink& LogView::eventSink()
+{
+    static EventSink sink;
+    return sink;
+}
+
+void LogView::registerType()
+{
+    qmlRegisterType<LogView>("Cuirq", 1, 0, "LogView");
+}
+
+LogView* LogView::find(const QString& name)
+{
+    return registry().value(name, nullptr);
+}
+
+void LogView::setEventSink(EventSink sink)
+{
+    eventSink() = std::move(sink);
+}
+
+void LogView::forward(const QString& event, QVariantList args)
+{
+    if (m_name.isEmpty() || !eventSink()) {
+        return;
+    }
+    args.prepend(m_name);
+    eventSink()(event, args);
+}
+
+void LogView::setName(const QString& name)
+{
+    if (name == m_name) {
+        return;
+    }
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+    m_name = name;
+    if (!m_name.isEmpty()) {
+        registry().insert(m_name, this);
+    }
+    emit nameChanged();
+}
+
+void LogView::setSource(const QString& source)
+{
+    if (source == m_source) {
+        return;
+    }
+    m_source = source;
+    const QUrl url(source);
+    m_path = url.isLocalFile() ? url.toLocalFile() : source;
+    resetIndex();
+    if (!m_path.isEmpty()) {
+        startIndexer(0);
+    }
+    emit sourceChanged();
+}
+
+void LogView::setFollow(bool follow)
+{
+    if (follow == m_follow) {
+        return;
+    }
+    m_follow = follow;
+    if (m_indexer) {
+        // A thread that already stopped is resumed by onIndexerFinished
+        m_indexer->setFollow(follow);
+    } else if (follow && !m_path.isEmpty()) {
+        startIndexer(m_bytes);
+    }
+    if (follow) {
+        setFirstLine(maxFirstLine());
+    }
+    emit followChanged();
+}
+
+void LogView::setFont(const QFont& font)
+{
+    if (font == m_font) {
+        return;
+    }
+    m_font = font;
+    m_lineHeight = std::ceil(QFontMetricsF(m_font).height());
+    m_resetLines = true;
+    emit fontChanged();
+    emit visibleLineCountChanged();
+    update();
+}
+
+void LogView::setColor(const QColor& color)
+{
+    if (color == m_color) {
+        return;
+    }
+    m_color = color;
+    m_resetLines = true;
+    emit colorChanged();
+    update();
+}
+
+void LogView::setMatchColor(const QColor& color)
+{
+    if (color == m_matchColor) {
+        return;
+    }
+    m_matchColor = color;
+    m_resetLines = true;
+    emit colorChanged();
+    update();
+}
+
+void LogView::setFirstLine(qint64 line)
+{
+    line = qBound<qint64>(0, line, maxFirstLine());
+    if (line == m_firstLine) {
+        return;
+    }
+    m_firstLine = line;
+    emit firstLineChanged();
+    update();
+}
+
+int LogView::visibleLineCount() const
+{
+    return m_lineHeight > 0 ? static_cast<int>(std::ceil(height() / m_lineHeight)) : 0;
+}
+
+qint64 LogView::lineCount() const
+{
+    // The last line counts once it has a byte, newline or not
+    return m_newlines + (m_bytes > m_lastLineStart ? 1 : 0);
+}
+
+qint64 LogView::maxFirstLine() const
+{
+    const qint64 full = m_lineHeight > 0 ? qMax<qint64>(1, static_cast<qint64>(height() / m_lineHeight)) : 1;
+    return qMax<qint64>(0, lineCount() - full);
+}
+
+bool LogView::atEnd() const
+{
+    return m_firstLine >= maxFirstLine();
+}
+
+// ---------------------------------------------------------------------------
+// Index
+// ---------------------------------------------------------------------------
+
+void LogView::startIndexer(qint64 offset)
+{
+    delete m_indexer;
+    m_failed = false;
+
+    const int generation = m_indexGeneration;
+    auto* indexer = new LogIndexer(m_path, m_follow, offset, m_newlines, m_lastLineStart, this);
+    // Queued: signals still in flight from a replaced indexer are dropped
+    connect(indexer, &LogIndexer::progress, this,
+            [this, generation](const QVector<quint64>& checkpoints, qint64 newlines, qint64 bytes, qint64 lastLineStart) {
+                if (generation == m_indexGeneration) {
+                    onProgress(checkpoints, newlines, bytes, lastLineStart);
+                }
+            });
+    connect(indexer, &LogIndexer::caughtUp, this, [this, generation]() {
+        if (generation == m_indexGeneration) {
+            onCaughtUp();
+        }
+    });
+    connect(indexer, &LogIndexer::truncated, this, [this, generation]() {
+        if (generation == m_indexGeneration) {
+            onTruncated();
+        }
+    });
+    connect(indexer, &LogIndexer::failed, this, [this, generation](const QString& error) {
+        if (generation == m_indexGeneration) {
+            qCWarning(lcBridge) << "LogView: Cannot index" << m_path << error;
+            m_failed = true;
+            if (m_indexing) {
+                m_indexing = false;
+                emit indexingChanged();
+            }
+            emit loadFailed(error);
+        }
+    });
+    connect(indexer, &QThread::finished, this, [this, generation]() {
+        if (generation == m_indexGeneration) {
+            onIndexerFinished();
+        }
+    });
+
+    m_indexer = indexer;
+    if (!m_indexing) {
+        m_indexing = true;
+        emit indexingChanged();
+    }
+    indexer->start(QThread::LowPriority);
+}
+
+// New file: stop the indexer and forget everything about the old one
+void LogView::resetIndex()
+{
+    ++m_indexGeneration;
+    delete m_indexer;
+    m_failed = false;
+    clearIndex();
+    if (m_indexing) {
+        m_indexing = false;
+        emit indexingChanged();
+    }
+}
+
+void LogView::clearIndex()
+{
+    cancelSearch();
+    if (!m_matches.isEmpty() || m_matchCount > 0) {
+        m_matches.clear();
+        m_matchCount = 0;
+        emit matchesChanged();
+    }
+    unmap();
+    m_file.close();
+    m_checkpoints.clear();
+    m_newlines = 0;
+    m_bytes = 0;
+    m_lastLineStart = 0;
+    m_resetLines = true;
+    if (m_firstLine != 0) {
+        m_firstLine = 0;
+        emit firstLineChanged();
+    }
+    emit lineCountChanged();
+    update();
+}
+
+void LogView::onProgress(const QVector<quint64>& checkpoints, qint64 newlines, qint64 bytes, qint64 lastLineStart)
+{
+    const qint64 before = lineCount();
+    const bool wasAtEnd = atEnd();
+    m_checkpoints += checkpoints;
+    m_newlines = newlines;
+    m_bytes = bytes;
+    m_lastLineStart = lastLineStart;
+
+    // The last line may have grown
+    if (before > 0) {
+        m_staleLines.insert(before - 1);
+    }
+    if (!m_indexing) {
+        m_indexing = true;
+        emit indexingChanged();
+    }
+    emit lineCountChanged();
+    if (m_follow && wasAtEnd) {
+        setFirstLine(maxFirstLine());
+    }
+
+    if (!m_sinceForward.isValid() || m_sinceForward.elapsed() >= kForwardInterval) {
+        forward(QStringLiteral("logViewIndexed"), QVariantList{ lineCount(), m_bytes, false });
+        m_sinceForward.start();
+    }
+    update();
+}
+
+void LogView::onCaughtUp()
+{
+    if (m_indexing) {
+        m_indexing = false;
+        emit indexingChanged();
+    }
+    forward(QStringLiteral("logViewIndexed"), QVariantList{ lineCount(), m_bytes, true });
+    m_sinceForward.start();
+}
+
+void LogView::onTruncated()
+{
+    qCDebug(lcBridge) << "LogView: File truncated, reloading" << m_path;
+    clearIndex();
+    emit truncated();
+    forward(QStringLiteral("logViewTruncated"), QVariantList{});
+}
+
+// Sent after every other signal of the thread: the index is complete here
+void LogView::onIndexerFinished()
+{
+    if (m_indexer) {
+        m_indexer->deleteLater();
+        m_indexer = nullptr;
+    }
+    if (m_follow && !m_failed && !m_path.isEmpty()) {
+        startIndexer(m_bytes);
+    }
+}
+
+void LogView::unmap()
+{
+    if (m_map) {
+        m_file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_map)));
+        m_map = nullptr;
+    }
+    m_mapped = 0;
+}
+
+// Mapped pages past the end of a truncated file fault when read. The
+// indexer notices truncation within kPollInterval; until then nothing
+// is read from the mapping.
+bool LogView::fileShrank()
+{
+    return m_map && m_file.size() < m_mapped;
+}
+
+bool LogView::lineSpan(qint64 line, qint64& start, qint64& end)
+{
+    if (line < 0 || line >= lineCount()) {
+        return false;
+    }
+    if (m_mapped < m_bytes) {
+        // Remapping only reserves address space: nothing is read
+        unmap();
+        if (!m_file.isOpen()) {
+            m_file.setFileName(m_path);
+            if (!m_file.open(QIODevice::ReadOnly)) {
+                return false;
+            }
+        }
+        m_map = reinterpret_cast<const char*>(m_file.map(0, m_bytes));
+        if (!m_map) {
+            return false;
+        }
+        m_mapped = m_bytes;
+    }
+
+    start = static_cast<qint64>(m_checkpoints.value(line / LogIndexer::kLinesPerCheckpoint));
+    for (qint64 skip = line % LogIndexer::kLinesPerCheckpoint; skip > 0; --skip) {
+        const void* newline = std::memchr(m_map + start, '\n', static_cast<size_t>(m_bytes - start));
+        if (!newline) {
+            return false;
+        }
+        start = static_cast<const char*>(newline) - m_map + 1;
+    }
+    const void* newline = std::memchr(m_map + start, '\n', static_cast<size_t>(m_bytes - start));
+    end = newline ? static_cast<const char*>(newline) - m_map : m_bytes;
+    return true;
+}
+
+QString LogView::lineText(qint64 line)
+{
+    qint64 start = 0;
+    qint64 end = 0;
+    if (fileShrank() || !lineSpan(line, start, end)) {
+        return QString();
+    }
+    if (end > start && m_map[end - 1] == '\r') {
+        --end;
+    }
+    return QString::fromUtf8(m_map + start, end - start);
+}
+
+// ---------------------------------------------------------------------------
+// Search
+// ---------------------------------------------------------------------------
+
+int LogView::search(const QString& pattern, bool regex, bool caseSensitive)
+{
+    cancelSearch();
+    if (!m_matches.isEmpty() || m_matchCount > 0) {
+        m_matches.clear();
+        m_matchCount = 0;
+        m_resetLines = true;
+        emit matchesChanged();
+        update();
+    }
+    if (pattern.isEmpty() || m_path.isEmpty()) {
+        return -1;
+    }
+    if (regex) {
+        const QRegularExpression re(pattern);
+        if (!re.isValid()) {
+            qCWarning(lcBridge) << "LogView: Invalid search pattern" << pattern << re.errorString();
+            return -1;
+        }
+    }
+
+    const int id = ++m_searchId;
+    m_searchCancel = std::make_shared<std::atomic<bool>>(false);
+    auto* job = new LogSearchJob(m_path, m_bytes, pattern, regex, caseSensitive, m_searchCancel);
+    connect(job, &LogSearchJob::found, this, [this, id](const QVector<LogMatch>& matches) {
+        onMatches(id, matches);
+    });
+    connect(job, &LogSearchJob::done, this, [this, id](qint64 total, bool stopped) {
+        onSearchDone(id, total, stopped);
+    });
+    m_searching = true;
+    emit searchingChanged();
+    searchPool().start(job);
+    return id;
+}
+
+void LogView::cancelSearch()
+{
+    if (!m_searching) {
+        return;
+    }
+    m_searchCancel->store(true);
+    // Batches still in flight carry the old id and are dropped
+    const int id = m_searchId++;
+    m_searching = false;
+    emit searchingChanged();
+    emit searchFinished(id, m_matchCount);
+    forward(QStringLiteral("logViewSearchFinished"), QVariantList{ id, m_matchCount, true });
+}
+
+void LogView::onMatches(int searchId, const QVector<LogMatch>& matches)
+{
+    if (searchId != m_searchId) {
+        return;
+    }
+    const qint64 first = m_firstLine;
+    const qint64 last = first + visibleLineCount();
+    QVariantList args{ searchId };
+    args.reserve(1 + 3 * matches.size());
+    for (const LogMatch& match : matches) {
+        if (match.line >= first && match.line < last) {
+            m_staleLines.insert(match.line);
+        }
+        args << match.line << match.column << match.length;
+    }
+    m_matches += matches;
+    m_matchCount += matches.size();
+    emit matchesChanged();
+    forward(QStringLiteral("logViewMatches"), args);
+    update();
+}
+
+void LogView::onSearchDone(int searchId, qint64 total, bool stopped)
+{
+    if (searchId != m_searchId) {
+        return;
+    }
+    m_matchCount = total;  // Includes matches past LogSearchJob::kMaxMatches
+    m_searching = false;
+    emit matchesChanged();
+    emit searchingChanged();
+    emit searchFinished(searchId, total);
+    forward(QStringLiteral("logViewSearchFinished"), QVariantList{ searchId, total, stopped });
+}
+
+qint64 LogView::nextMatchLine(qint64 line, bool backwards) const
+{
+    const auto byLine = [](const LogMatch& match, qint64 l) { return match.line < l; };
+    if (backwards) {
+        const auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(), line, byLine);
+        return it == m_matches.cbegin() ? -1 : std::prev(it)->line;
+    }
+    const auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(), line + 1, byLine);
+    return it == m_matches.cend() ? -1 : it->line;
+}
+
+// ---------------------------------------------------------------------------
+// Input and geometry
+// ---------------------------------------------------------------------------
+
+void LogView::wheelEvent(QWheelEvent* event)
+{
+    m_wheelDelta += event->angleDelta().y();
+    const int lines = m_wheelDelta / kWheelUnitsPerLine;
+    m_wheelDelta -= lines * kWheelUnitsPerLine;
+    setFirstLine(m_firstLine - lines);
+    event->accept();
+}
+
+void LogView::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.height() != oldGeometry.height() && m_lineHeight > 0) {
+        const qint64 oldFull = qMax<qint64>(1, static_cast<qint64>(oldGeometry.height() / m_lineHeight));
+        const bool wasAtEnd = m_firstLine >= lineCount() - oldFull;
+        emit visibleLineCountChanged();
+        setFirstLine(m_follow && wasAtEnd ? maxFirstLine() : m_firstLine);  // Clamped
+        update();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Scene graph
+// ---------------------------------------------------------------------------
+
+QSGNode* LogView::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* /* data */)
+{
+    static Histogram& syncTime = Metrics::histogram("logview.sync_ns");
+    static Counter& laidOut = Metrics::counter("logview.lines_laid_out");
+    ScopedTimer timer(syncTime);
+    CUIRQ_TRACE_SCOPE("LogView::updatePaintNode", "render");
+
+    QSGNode* root = oldNode;
+    if (!root) {
+        root = new QSGNode();
+        m_resetLines = true;
+    }
+
+    const bool shrank = fileShrank();
+    if (m_resetLines || shrank) {
+        while (QSGNode* child = root->firstChild()) {
+            root->removeChildNode(child);
+            delete child;
+        }
+        m_lineNodes.clear();
+        m_staleLines.clear();
+        m_resetLines = shrank;  // Redraw once the truncation is handled
+        if (shrank) {
+            return root;
+        }
+    }
+
+    // Lines that changed, or scrolled out
+    const qint64 first = m_firstLine;
+    const qint64 last = qMin(lineCount(), first + visibleLineCount());
+    for (auto it = m_lineNodes.begin(); it != m_lineNodes.end();) {
+        if (it.key() < first || it.key() >= last || m_staleLines.contains(it.key())) {
+            root->removeChildNode(it.value());
+            delete it.value();
+            it = m_lineNodes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_staleLines.clear();
+
+    // Lines that scrolled in are laid out; the others only move
+    for (qint64 line = first; line < last; ++line) {
+        QSGTransformNode*& node = m_lineNodes[line];
+        if (!node) {
+            node = createLine(line);
+            root->appendChildNode(node);
+            laidOut.add();
+        }
+        QMatrix4x4 matrix;
+        matrix.translate(static_cast<float>(kPadding), static_cast<float>((line - first) * m_lineHeight));
+        node->setMatrix(matrix);
+    }
+    return root;
+}
+
+QSGTransformNode* LogView::createLine(qint64 line)
+{
+    QString text = lineText(line);
+    if (text.size() > kMaxDisplayChars) {
+        text.truncate(kMaxDisplayChars);
+    }
+
+    QTextLayout layout(text, m_font);
+    QTextOption option;
+    option.setWrapMode(QTextOption::NoWrap);
+    layout.setTextOption(option);
+    layout.beginLayout();
+    QTextLine textLine = layout.createLine();
+    layout.endLayout();
+
+    QVector<QRectF> highlights;
+    const auto byLine = [](const LogMatch& match, qint64 l) { return match.line < l; };
+    for (auto it = std::lower_bound(m_matches.cbegin(), m_matches.cend(), line, byLine);
+         it != m_matches.cend() && it->line == line; ++it) {
+        if (it->column < text.size()) {
+            const qreal x0 = textLine.cursorToX(it->column);
+            const qreal x1 = textLine.cursorToX(qMin(it->column + it->length, static_cast<int>(text.size())));
+            highlights.append(QRectF(x0, 0, x1 - x0, m_lineHeight));
+        }
+    }
+
+    auto* transform = new QSGTransformNode();
+#ifdef CUIRQ_LOGVIEW_TEXT_NODES
+    for (const QRectF& rect : std::as_const(highlights)) {
+        QSGRectangleNode* highlight = window()->createRectangleNode();
+        highlight->setRect(rect);
+        highlight->setColor(m_matchColor);
+        transform->appendChildNode(highlight);
+    }
+    if (!text.isEmpty()) {
+        QSGTextNode* textNode = window()->createTextNode();
+        textNode->setColor(m_color);
+        textNode->addTextLayout(QPointF(0, 0), &layout);
+        transform->appendChildNode(textNode);
+    }
+#else
+    const qreal width = qMin<qreal>(textLine.naturalTextWidth(), this->width());
+    if (width > 0) {
+        const qreal dpr = window()->effectiveDevicePixelRatio();
+        QImage image(QSize(qCeil(width * dpr) + 1, qCeil(m_lineHeight * dpr)), QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(dpr);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        for (const QRectF& rect : std::as_const(highlights)) {
+            painter.fillRect(rect, m_matchColor);
+        }
+        painter.setPen(m_color);
+        layout.draw(&painter, QPointF(0, 0));
+        painter.end();
+
+        QSGImageNode* node = window()->createImageNode();
+        node->setTexture(window()->createTextureFromImage(image));
+        node->setOwnsTexture(true);
+        node->setRect(QRectF(0, 0, image.width() / dpr, image.height() / dpr));
+        transform->appendChildNode(node);
+    }
+#endif
+    return transform;
+}
+
+void LogView::itemChange(ItemChange change, const ItemChangeData& value)
+{
+    if (change == ItemSceneChange) {
+        m_resetLines = true;
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void LogView::releaseResources()
+{
+    // The scene graph is going away: node pointers die with it
+    m_lineNodes.clear();
+    m_resetLines = true;
+}
@@ -0,0 +1,212 @@
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFont>
+#include <QHash>
+#include <QPointer>
+#include <QQuickItem>
+#include <QSet>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "logindex.h"
+
+class QSGNode;
+class QSGTransformNode;
+
+/**
+ * LogView - Virtualized viewer for very large (and growing) text files.
+ *
+ * The file is memory-mapped, never loaded: a LogIndexer thread builds a
+ * sparse line-offset index in the background and only the lines on
+ * screen are decoded and laid out. Each visible line is one cached
+ * scene-graph node, so scrolling mostly moves existing nodes and lays out
+ * the lines that scrolled in.
+ *
+ * With `follow` set, appended data is indexed as it arrives and the view
+ * sticks to the end of the file while it is scrolled to the end (tail -f).
+ * A file truncated in place is reloaded from the start.
+ *
+ * search() runs on a pool thread and streams match positions back;
+ * matches on visible lines are highlighted as they arrive.
+ *
+ * Events reach the JVM through the sink set with setEventSink (the
+ * bridge forwards them as signals): logViewIndexed, logViewTruncated,
+ * logViewMatches and logViewSearchFinished, each with the view name first.
+ *
+ * QML:
+ *   import Cuirq 1.0
+ *   LogView { name: "server"; anchors.fill: parent; follow: true }
+ *
+ * JVM: Bridge.openLogView("server", "/var/log/server.log", true)
+ */
+class LogView : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(bool follow READ follow WRITE setFollow NOTIFY followChanged)
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor matchColor READ matchColor WRITE setMatchColor NOTIFY colorChanged)
+    Q_PROPERTY(qint64 firstLine READ firstLine WRITE setFirstLine NOTIFY firstLineChanged)
+    Q_PROPERTY(int visibleLineCount READ visibleLineCount NOTIFY visibleLineCountChanged)
+    Q_PROPERTY(qreal lineHeight READ lineHeight NOTIFY fontChanged)
+    Q_PROPERTY(qint64 lineCount READ lineCount NOTIFY lineCountChanged)
+    Q_PROPERTY(qint64 indexedBytes READ indexedBytes NOTIFY lineCountChanged)
+    Q_PROPERTY(bool indexing READ indexing NOTIFY indexingChanged)
+    Q_PROPERTY(qint64 matchCount READ matchCount NOTIFY matchesChanged)
+    Q_PROPERTY(bool searching READ searching NOTIFY searchingChanged)
+
+public:
+    using EventSink = std::function<void(const QString& event, const QVariantList& args)>;
+
+    explicit LogView(QQuickItem* parent = nullptr);
+    ~LogView() override;
+
+    // Register the "Cuirq 1.0 / LogView" QML type
+    static void registerType();
+
+    // View declared in QML with the given name, or nullptr
+    static LogView* find(const QString& name);
+
+    // Receives the events of every named view (GUI thread)
+    static void setEventSink(EventSink sink);
+
+    QString name() const { return m_name; }
+    void setName(const QString& name);
+
+    // Local file path (file: URLs are accepted)
+    QString source() const { return m_source; }
+    void setSource(const QString& source);
+
+    bool follow() const { return m_follow; }
+    void setFollow(bool follow);
+
+    QFont font() const { return m_font; }
+    void setFont(const QFont& font);
+    QColor color() const { return m_color; }
+    void setColor(const QColor& color);
+    QColor matchColor() const { return m_matchColor; }
+    void setMatchColor(const QColor& color);
+
+    qint64 firstLine() const { return m_firstLine; }
+    void setFirstLine(qint64 line);
+    int visibleLineCount() const;
+    qreal lineHeight() const { return m_lineHeight; }
+
+    qint64 lineCount() const;
+    qint64 indexedBytes() const { return m_bytes; }
+    bool indexing() const { return m_indexing; }
+    qint64 matchCount() const { return m_matchCount; }
+    bool searching() const { return m_searching; }
+
+    // Text of a line (without the line break), empty past the end
+    Q_INVOKABLE QString lineText(qint64 line);
+
+    // Starts a background search of the part indexed so far (cancelling
+    // the previous search) and returns its id, or -1 if there is nothing
+    // to search
+    Q_INVOKABLE int search(const QString& pattern, bool regex = false, bool caseSensitive = true);
+    Q_INVOKABLE void cancelSearch();
+
+    // Line of the first match after (or before) `line`, or -1
+    Q_INVOKABLE qint64 nextMatchLine(qint64 line, bool backwards = false) const;
+
+signals:
+    void nameChanged();
+    void sourceChanged();
+    void followChanged();
+    void fontChanged();
+    void colorChanged();
+    void firstLineChanged();
+    void visibleLineCountChanged();
+    void lineCountChanged();
+    void indexingChanged();
+    void matchesChanged();
+    void searchingChanged();
+    void searchFinished(int searchId, qint64 matchCount);
+    void truncated();
+    void loadFailed(const QString& error);
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData& value) override;
+    void releaseResources() override;
+    void wheelEvent(QWheelEvent* event) override;
+
+private:
+    static QHash<QString, LogView*>& registry();
+    static EventSink& eventSink();
+
+    void forward(const QString& event, QVariantList args);
+
+    void startIndexer(qint64 offset);
+    void resetIndex();
+    void clearIndex();
+    void onProgress(const QVector<quint64>& checkpoints, qint64 newlines, qint64 bytes, qint64 lastLineStart);
+    void onCaughtUp();
+    void onTruncated();
+    void onIndexerFinished();
+    void onMatches(int searchId, const QVector<LogMatch>& matches);
+    void onSearchDone(int searchId, qint64 total, bool stopped);
+
+    qint64 maxFirstLine() const;
+    bool atEnd() const;
+    bool lineSpan(qint64 line, qint64& start, qint64& end);
+    bool fileShrank();
+    void unmap();
+
+    QSGTransformNode* createLine(qint64 line);
+
+    QString m_name;
+    QString m_source;
+    QString m_path;
+    bool m_follow = false;
+    QFont m_font;
+    qreal m_lineHeight = 0;
+    QColor m_color = Qt::black;
+    QColor m_matchColor = QColor(255, 200, 0, 160);
+    qint64 m_firstLine = 0;
+    int m_wheelDelta = 0;  // Leftover of partial wheel steps
+
+    // Index, as reported by the indexer (GUI thread)
+    QPointer<LogIndexer> m_indexer;
+    int m_indexGeneration = 0;
+    QVector<quint64> m_checkpoints;
+    qint64 m_newlines = 0;
+    qint64 m_bytes = 0;
+    qint64 m_lastLineStart = 0;
+    bool m_indexing = false;
+    bool m_failed = false;
+    QElapsedTimer m_sinceForward;  // Throttles logViewIndexed
+
+    // GUI-side mapping, grown lazily to m_bytes
+    QFile m_file;
+    const char* m_map = nullptr;
+    qint64 m_mapped = 0;
+
+    // Search
+    int m_searchId = 0;
+    std::shared_ptr<std::atomic<bool>> m_searchCancel;
+    QVector<LogMatch> m_matches;  // Ordered by line
+    qint64 m_matchCount = 0;
+    bool m_searching = false;
+
+    // Pending changes, consumed by updatePaintNode
+    bool m_resetLines = true;
+    QSet<qint64> m_staleLines;
+
+    // Scene-graph state (only touched in updatePaintNode)
+    QHash<qint64, QSGTransformNode*> m_lineNodes;
+};
+
+#endif // LOGVIEW_H
@@ -0,0 +1,340 @@
+#include "mappedlistmodel.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QtEndian>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+constexpr char kMagic[8] = { 'C', 'U', 'I', 'R', 'Q', 'C', 'F', '1' };
+constexpr char kSegmentMagic[4] = { 'S', 'E', 'G', '1' };
+constexpr qint64 kFileHeader = 16;
+constexpr qint64 kSegmentHeader = 24;
+constexpr qint64 kColumnHeader = 24;  // Three buffer lengths
+
+qint64 pad8(qint64 n)
+{
+    return (n + 7) & ~qint64(7);
+}
+
+// String offsets must start at 0 or more, never decrease and stay within
+// the data buffer; anything else would read outside the mapping
+template <typename T>
+bool validOffsets(const void* offsets, qint64 rows, qint64 dataBytes)
+{
+    const T* o = static_cast<const T*>(offsets);
+    if (o[0] < 0) {
+        return false;
+    }
+    for (qint64 i = 0; i < rows; ++i) {
+        if (o[i + 1] < o[i]) {
+            return false;
+        }
+    }
+    return o[rows] <= dataBytes;
+}
+
+} // namespace
+
+MappedListModel::MappedListModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+MappedListModel::~MappedListModel()
+{
+    close();
+}
+
+int MappedListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+QVariant MappedListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows) {
+        return QVariant();
+    }
+    const int column = role - (Qt::UserRole + 1);
+    if (column < 0 || column >= m_types.size()) {
+        return QVariant();
+    }
+
+    const auto it = std::upper_bound(m_segments.cbegin(), m_segments.cend(), qint64(index.row()),
+                                     [](qint64 row, const Segment& segment) { return row < segment.first; });
+    const Segment& segment = *std::prev(it);
+    return segment.columns[column].value(index.row() - segment.first);
+}
+
+QHash<int, QByteArray> MappedListModel::roleNames() const
+{
+    return m_roleNames;
+}
+
+void MappedListModel::close()
+{
+    for (uchar* map : std::as_const(m_maps)) {
+        m_file.unmap(map);
+    }
+    m_maps.clear();
+    m_segments.clear();
+    m_file.close();
+    m_end = 0;
+    m_available = 0;
+    m_corrupt = false;
+}
+
+bool MappedListModel::readHeader()
+{
+    const QByteArray fixed = m_file.read(kFileHeader);
+    if (fixed.size() != kFileHeader || std::memcmp(fixed.constData(), kMagic, sizeof(kMagic)) != 0) {
+        qCWarning(lcModel) << "MappedListModel:" << m_file.fileName() << "is not a cuirq column file";
+        return false;
+    }
+    const auto* p = reinterpret_cast<const uchar*>(fixed.constData());
+    const quint32 columns = qFromLittleEndian<quint32>(p + 8);
+    const quint32 headerSize = qFromLittleEndian<quint32>(p + 12);
+    if (headerSize < kFileHeader || headerSize % 8 != 0 || headerSize > m_file.size()) {
+        qCWarning(lcModel) << "MappedListModel: Bad header size" << headerSize << "in" << m_file.fileName();
+        return false;
+    }
+
+    const QByteArray header = m_file.read(headerSize - kFileHeader);
+    const auto* begin = reinterpret_cast<const uchar*>(header.constData());
+    const uchar* end = begin + header.size();
+    const uchar* q = begin;
+    for (quint32 c = 0; c < columns; ++c) {
+        if (end - q < 4) {
+            qCWarning(lcModel) << "MappedListModel: Truncated column list in" << m_file.fileName();
+            return false;
+        }
+        const quint16 nameLength = qFromLittleEndian<quint16>(q);
+        const quint16 formatLength = qFromLittleEndian<quint16>(q + 2);
+        q += 4;
+        if (end - q < nameLength + formatLength) {
+            qCWarning(lcModel) << "MappedListModel: Truncated column list in" << m_file.fileName();
+            return false;
+        }
+        const QByteArray name(reinterpret_cast<const char*>(q), nameLength);
+        const QByteArray format(reinterpret_cast<const char*>(q + nameLength), formatLength);
+        q += nameLength + formatLength;
+
+        qint64 ticks = 1;
+        const ArrowColumn::Type type = ArrowColumn::parseFormat(format.constData(), &ticks);
+        if (type == ArrowColumn::Unsupported) {
+            qCWarning(lcModel) << "MappedListModel: Column" << name << "has unsupported format" << format
+                               << "and reads as undefined";
+        }
+        m_types.append(type);
+        m_ticks.append(ticks);
+        m_roleNames.insert(Qt::UserRole + 1 + static_cast<int>(c),
+                           name.isEmpty() ? QByteArray("column") + QByteArray::number(c) : name);
+    }
+    m_end = headerSize;
+    return true;
+}
+
+bool MappedListModel::parseSegment(const uchar* segment, qint64 size, qint64 rows, Segment& out) const
+{
+    const int columns = m_types.size();
+    qint64 pos = kSegmentHeader + columns * kColumnHeader;
+    // Bound the row count by what the segment could hold before any size
+    // arithmetic on it: a forged count would otherwise overflow below
+    if (rows < 0 || rows > 8 * size || pos > size) {
+        return false;
+    }
+    const qint64 bitmapBytes = (rows + 7) / 8;
+
+    out.columns.reserve(columns);
+    for (int c = 0; c < columns; ++c) {
+        const uchar* lengths = segment + kSegmentHeader + c * kColumnHeader;
+        const qint64 validityBytes = qFromLittleEndian<qint64>(lengths);
+        const qint64 valueBytes = qFromLittleEndian<qint64>(lengths + 8);
+        const qint64 dataBytes = qFromLittleEndian<qint64>(lengths + 16);
+        if (validityBytes < 0 || valueBytes < 0 || dataBytes < 0
+            || validityBytes > size || valueBytes > size || dataBytes > size) {
+            return false;
+        }
+
+        const uchar* validity = segment + pos;
+        pos += pad8(validityBytes);
+        const uchar* values = segment + pos;
+        pos += pad8(valueBytes);
+        const uchar* bytes = segment + pos;
+        pos += pad8(dataBytes);
+        if (pos > size) {
+            return false;
+        }
+
+        ArrowColumn column;
+        const ArrowColumn::Type type = m_types[c];
+        if (type != ArrowColumn::Unsupported && rows > 0) {
+            if (validityBytes != 0 && validityBytes < bitmapBytes) {
+                return false;
+            }
+            const int width = ArrowColumn::valueWidth(type);
+            if (type != ArrowColumn::Bool && rows > size / width) {
+                return false;
+            }
+            const qint64 needed = type == ArrowColumn::Bool ? bitmapBytes
+                                : ArrowColumn::bufferCount(type) > 2 ? (rows + 1) * width
+                                : rows * width;
+            if (valueBytes < needed) {
+                return false;
+            }
+            if (type == ArrowColumn::Utf8 && !validOffsets<qint32>(values, rows, dataBytes)) {
+                return false;
+            }
+            if (type == ArrowColumn::LargeUtf8 && !validOffsets<qint64>(values, rows, dataBytes)) {
+                return false;
+            }
+            column.type = type;
+            column.length = rows;
+            column.ticksPerSecond = m_ticks[c];
+            column.validity = validityBytes != 0 ? validity : nullptr;
+            column.values = values;
+            column.data = reinterpret_cast<const char*>(bytes);
+        }
+        out.columns.append(std::move(column));
+    }
+    return true;
+}
+
+void MappedListModel::mapSegments()
+{
+    static Counter& mapped = Metrics::counter("model.mapped_segments");
+
+    const qint64 available = m_file.size() - m_end;
+    if (m_corrupt || available < kSegmentHeader) {
+        return;
+    }
+    uchar* map = m_file.map(m_end, available);
+    if (!map) {
+        qCWarning(lcModel) << "MappedListModel: Cannot map" << m_file.fileName() << m_file.errorString();
+        return;
+    }
+
+    qint64 pos = 0;
+    while (available - pos >= kSegmentHeader) {
+        const uchar* segment = map + pos;
+        const qint64 size = qFromLittleEndian<qint64>(segment + 8);
+        const qint64 rows = qFromLittleEndian<qint64>(segment + 16);
+        if (std::memcmp(segment, kSegmentMagic, sizeof(kSegmentMagic)) != 0 || size < kSegmentHeader || size % 8 != 0) {
+            qCWarning(lcModel) << "MappedListModel: Bad segment at offset" << m_end + pos << "in" << m_file.fileName();
+            m_corrupt = true;
+            break;
+        }
+        if (size > available - pos) {
+            break;  // Still being written
+        }
+        Segment parsed;
+        if (!parseSegment(segment, size, rows, parsed)) {
+            qCWarning(lcModel) << "MappedListModel: Segment at offset" << m_end + pos << "in" << m_file.fileName()
+                               << "does not match its buffer lengths";
+            m_corrupt = true;
+            break;
+        }
+        if (rows > 0) {
+            parsed.first = m_available;
+            m_available += rows;
+            m_segments.append(std::move(parsed));
+        }
+        pos += size;
+        mapped.add();
+    }
+
+    if (pos == 0) {
+        // Nothing complete yet: map the same region again next time
+        m_file.unmap(map);
+        return;
+    }
+    m_maps.append(map);
+    m_end += pos;
+}
+
+bool MappedListModel::open(const QString& path)
+{
+    static Counter& resets = Metrics::counter("model.resets");
+    CUIRQ_TRACE_SCOPE("MappedListModel::open", "model");
+
+    beginResetModel();
+    close();
+    m_types.clear();
+    m_ticks.clear();
+    m_roleNames.clear();
+    m_rows = 0;
+    m_file.setFileName(path);
+    const bool ok = m_file.open(QIODevice::ReadOnly) && readHeader();
+    if (ok) {
+        mapSegments();
+        m_rows = static_cast<int>(std::min<qint64>(m_available, INT_MAX));
+    } else {
+        if (m_file.isOpen()) {
+            m_file.close();
+        } else {
+            qCWarning(lcModel) << "MappedListModel: Cannot open" << path << m_file.errorString();
+        }
+        m_types.clear();
+        m_ticks.clear();
+        m_roleNames.clear();
+    }
+    endResetModel();
+
+    ++m_resets;
+    resets.add();
+    qCDebug(lcModel) << "MappedListModel" << objectName() << "now has" << m_rows << "rows," << m_types.size() << "roles";
+    return ok;
+}
+
+int MappedListModel::refresh(qint64 rows)
+{
+    CUIRQ_TRACE_SCOPE("MappedListModel::refresh", "model");
+
+    if (!m_file.isOpen()) {
+        return -1;
+    }
+    if (m_file.size() < m_end) {
+        // Views may still reference the old pages: reload before anything reads them
+        qCWarning(lcModel) << "MappedListModel:" << m_file.fileName() << "shrank, reloading";
+        open(m_file.fileName());
+        return m_rows;
+    }
+
+    mapSegments();
+    qint64 target = rows < 0 ? m_available : std::min(rows, m_available);
+    target = std::min<qint64>(target, INT_MAX);
+    if (target > m_rows) {
+        beginInsertRows(QModelIndex(), m_rows, static_cast<int>(target) - 1);
+        m_rows = static_cast<int>(target);
+        endInsertRows();
+    }
+    return m_rows;
+}
+
+void MappedListModel::clear()
+{
+    beginResetModel();
+    close();
+    m_types.clear();
+    m_ticks.clear();
+    m_roleNames.clear();
+    m_rows = 0;
+    endResetModel();
+    ++m_resets;
+}
+
+QJsonObject MappedListModel::statistics() const
+{
+    return QJsonObject{
+        { "rows", m_rows },
+        { "roles", static_cast<qint64>(m_roleNames.size()) },
+        { "segments", static_cast<qint64>(m_segments.size()) },
+        { "mapped_bytes", m_end },
+        { "resets", static_cast<qint64>(m_resets) }
+    };
+}
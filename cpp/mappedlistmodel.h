@@ -0,0 +1,100 @@
+#ifndef MAPPEDLISTMODEL_H
+#define MAPPEDLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+#include "arrowcolumn.h"
+
+/**
+ * MappedListModel - QAbstractListModel over a memory-mapped columnar file.
+ *
+ * Rows live in an append-only file that the JVM writes; the model maps it
+ * read-only and data() reads cells straight from the mapped pages, so the
+ * dataset may be far larger than RAM and no per-row objects are built.
+ * The OS pages data in as views scroll and drops clean pages under memory
+ * pressure.
+ *
+ * File layout (little-endian, every section 8-byte aligned):
+ *
+ *   Header
+ *     char[8]  "CUIRQCF1"
+ *     u32      column count N
+ *     u32      header size H, including these 16 bytes
+ *     N x      u16 name length, u16 format length, UTF-8 name, format
+ *              (an Arrow C Data Interface format string, e.g. "l", "g",
+ *              "u", "tsm:"), then zero padding up to H
+ *
+ *   Segments, back to back from offset H
+ *     char[4]  "SEG1"
+ *     u32      reserved (0)
+ *     i64      segment size S, including this header
+ *     i64      row count R
+ *     N x      i64 byte lengths of the column's validity, values and data
+ *              buffers (validity 0: no nulls; data 0: not a string column)
+ *     buffers  column by column, each padded to 8 bytes, in Arrow layout
+ *
+ * A segment is read once the file holds all S bytes of it, so the writer
+ * appends whole segments and then calls refresh(). Files only grow: if
+ * one shrinks the model reloads it from the start.
+ */
+class MappedListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit MappedListModel(QObject* parent = nullptr);
+    ~MappedListModel() override;
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Map a file and show every complete segment (model reset)
+    bool open(const QString& path);
+
+    // Map segments appended since the last call and insert their rows.
+    // `rows` caps the row count shown (the JVM's count after its last
+    // append); -1 shows every complete segment. Returns the row count, or
+    // -1 if no file is open.
+    int refresh(qint64 rows = -1);
+
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE int count() const { return m_rows; }
+    QString path() const { return m_file.fileName(); }
+
+    // Runtime statistics: {"rows", "roles", "segments", "mapped_bytes", "resets"}
+    QJsonObject statistics() const;
+
+private:
+    struct Segment
+    {
+        qint64 first;  // Model row of the segment's first row
+        QVector<ArrowColumn> columns;
+    };
+
+    bool readHeader();
+    void mapSegments();
+    bool parseSegment(const uchar* segment, qint64 size, qint64 rows, Segment& out) const;
+    void close();
+
+    QFile m_file;
+    QVector<uchar*> m_maps;
+    QVector<Segment> m_segments;
+    QVector<ArrowColumn::Type> m_types;
+    QVector<qint64> m_ticks;
+    QHash<int, QByteArray> m_roleNames;
+    qint64 m_end = 0;        // File offset up to which segments are parsed
+    qint64 m_available = 0;  // Rows in parsed segments
+    int m_rows = 0;          // Rows shown
+    bool m_corrupt = false;
+    quint64 m_resets = 0;
+};
+
+#endif // MAPPEDLISTMODEL_H
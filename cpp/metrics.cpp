@@ -0,0 +1,198 @@
+#include "metrics.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace {
+
+// Registry storage: node-based maps keep metric addresses stable
+struct Registry
+{
+    QMutex mutex;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+};
+
+Registry& registry()
+{
+    // Intentionally leaked: metrics may be touched during static destruction
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+template <typename T>
+T& lookup(std::map<std::string, std::unique_ptr<T>>& map, const char* name)
+{
+    QMutexLocker lock(&registry().mutex);
+    std::unique_ptr<T>& slot = map[name];
+    if (!slot) {
+        slot = std::make_unique<T>();
+    }
+    return *slot;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Histogram
+// ---------------------------------------------------------------------------
+
+int Histogram::bucketIndex(quint64 value)
+{
+    if (value < static_cast<quint64>(kSubBuckets)) {
+        return static_cast<int>(value);
+    }
+
+    const int msb = 63 - __builtin_clzll(value);
+    const int shift = msb - kSubBucketBits;
+    const int mantissa = static_cast<int>((value >> shift) & (kSubBuckets - 1));
+    return kSubBuckets + shift * kSubBuckets + mantissa;
+}
+
+quint64 Histogram::bucketUpperBound(int index)
+{
+    if (index < kSubBuckets) {
+        return static_cast<quint64>(index);
+    }
+
+    const int shift = (index - kSubBuckets) / kSubBuckets;
+    const quint64 mantissa = static_cast<quint64>((index - kSubBuckets) % kSubBuckets);
+    const quint64 lower = (quint64(1) << (shift + kSubBucketBits)) | (mantissa << shift);
+    return lower + ((quint64(1) << shift) - 1);
+}
+
+void Histogram::record(quint64 value)
+{
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    quint64 max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+void Histogram::reset()
+{
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+quint64 Histogram::percentile(double p) const
+{
+    const quint64 total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    const double clamped = p < 0.0 ? 0.0 : (p > 100.0 ? 100.0 : p);
+    quint64 rank = static_cast<quint64>(clamped / 100.0 * total + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    quint64 seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // Never report more than the largest value actually recorded
+            return qMin(bucketUpperBound(i), m_max.load(std::memory_order_relaxed));
+        }
+    }
+
+    return m_max.load(std::memory_order_relaxed);
+}
+
+QJsonObject Histogram::toJson() const
+{
+    const quint64 total = count();
+    const quint64 sum = m_sum.load(std::memory_order_relaxed);
+
+    return QJsonObject{
+        { "count", static_cast<qint64>(total) },
+        { "sum", static_cast<qint64>(sum) },
+        { "mean", total ? static_cast<double>(sum) / total : 0.0 },
+        { "max", static_cast<qint64>(m_max.load(std::memory_order_relaxed)) },
+        { "p50", static_cast<qint64>(percentile(50.0)) },
+        { "p90", static_cast<qint64>(percentile(90.0)) },
+        { "p99", static_cast<qint64>(percentile(99.0)) },
+        { "p999", static_cast<qint64>(percentile(99.9)) }
+    };
+}
+
+// ---------------------------------------------------------------------------
+// Registry
+// ---------------------------------------------------------------------------
+
+Counter& Metrics::counter(const char* name)
+{
+    return lookup(registry().counters, name);
+}
+
+Gauge& Metrics::gauge(const char* name)
+{
+    return lookup(registry().gauges, name);
+}
+
+Histogram& Metrics::histogram(const char* name)
+{
+    return lookup(registry().histograms, name);
+}
+
+QJsonObject Metrics::snapshot()
+{
+    Registry& reg = registry();
+    QMutexLocker lock(&reg.mutex);
+
+    QJsonObject counters;
+    for (const auto& [name, counter] : reg.counters) {
+        counters.insert(QString::fromStdString(name), static_cast<qint64>(counter->value()));
+    }
+
+    QJsonObject gauges;
+    for (const auto& [name, gauge] : reg.gauges) {
+        gauges.insert(QString::fromStdString(name), static_cast<qint64>(gauge->value()));
+    }
+
+    QJsonObject histograms;
+    for (const auto& [name, histogram] : reg.histograms) {
+        histograms.insert(QString::fromStdString(name), histogram->toJson());
+    }
+
+    return QJsonObject{
+        { "counters", counters },
+        { "gauges", gauges },
+        { "histograms", histograms }
+    };
+}
+
+void Metrics::reset()
+{
+    Registry& reg = registry();
+    QMutexLocker lock(&reg.mutex);
+
+    for (auto& entry : reg.counters) {
+        entry.second->reset();
+    }
+    for (auto& entry : reg.histograms) {
+        entry.second->reset();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// JniCallMetrics
+// ---------------------------------------------------------------------------
+
+JniCallMetrics::JniCallMetrics(const char* native)
+    : m_calls(Metrics::counter((std::string("jni.") + native + ".calls").c_str()))
+    , m_total(Metrics::counter("jni.calls"))
+    , m_latency(Metrics::histogram((std::string("jni.") + native + ".latency_ns").c_str()))
+{
+}
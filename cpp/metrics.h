@@ -0,0 +1,171 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "trace.h"
+#include "guioperation.h"
+
+#include <QJsonObject>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+/**
+ * Runtime metrics for the bridge.
+ *
+ * Counters, gauges and latency histograms that are cheap enough to stay
+ * on in production: every update is a relaxed atomic operation, and the
+ * registry lock is only taken when a metric is first looked up.
+ *
+ * Usage:
+ *   static Counter& resets = Metrics::counter("model.resets");
+ *   resets.add();
+ *
+ *   static Histogram& parse = Metrics::histogram("model.set_json.parse_ns");
+ *   ScopedTimer timer(parse);
+ *
+ * Metric objects live for the lifetime of the process, so caching the
+ * returned reference in a function-local static is safe.
+ */
+
+class Counter
+{
+public:
+    void add(quint64 n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    quint64 value() const { return m_value.load(std::memory_order_relaxed); }
+    void reset() { m_value.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> m_value{0};
+};
+
+class Gauge
+{
+public:
+    void set(qint64 value) { m_value.store(value, std::memory_order_relaxed); }
+    void add(qint64 delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    qint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<qint64> m_value{0};
+};
+
+/**
+ * HDR-style histogram with log-linear buckets.
+ *
+ * Values below 16 get exact buckets; above that, every power of two is
+ * split into 16 linear sub-buckets, so any recorded value is reported
+ * within ~6% of its true value across the full 64-bit range.
+ */
+class Histogram
+{
+public:
+    void record(quint64 value);
+    void reset();
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+
+    // Value at percentile p (0-100), reported as the bucket's upper bound
+    quint64 percentile(double p) const;
+
+    // {count, sum, mean, max, p50, p90, p99, p999}
+    QJsonObject toJson() const;
+
+private:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = kSubBuckets + (64 - kSubBucketBits) * kSubBuckets;
+
+    static int bucketIndex(quint64 value);
+    static quint64 bucketUpperBound(int index);
+
+    std::array<std::atomic<quint64>, kBucketCount> m_buckets{};
+    std::atomic<quint64> m_count{0};
+    std::atomic<quint64> m_sum{0};
+    std::atomic<quint64> m_max{0};
+};
+
+/**
+ * Records the lifetime of the scope (in nanoseconds) into a histogram.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : m_histogram(histogram)
+        , m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        m_histogram.record(elapsedNs());
+    }
+
+    quint64 elapsedNs() const
+    {
+        return static_cast<quint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Process-wide metric registry.
+ */
+class Metrics
+{
+public:
+    static Counter& counter(const char* name);
+    static Gauge& gauge(const char* name);
+    static Histogram& histogram(const char* name);
+
+    // {"counters": {...}, "gauges": {...}, "histograms": {...}}
+    static QJsonObject snapshot();
+
+    // Zero all counters and histograms (gauges reflect live state and are kept)
+    static void reset();
+};
+
+/**
+ * Per-native JNI call metrics: "jni.<native>.calls" and "jni.<native>.latency_ns",
+ * plus the "jni.calls" total across all natives.
+ */
+class JniCallMetrics
+{
+public:
+    explicit JniCallMetrics(const char* native);
+
+    class Scope
+    {
+    public:
+        explicit Scope(JniCallMetrics& metrics)
+            : m_timer((metrics.m_calls.add(), metrics.m_total.add(), metrics.m_latency))
+        {
+        }
+
+    private:
+        ScopedTimer m_timer;
+    };
+
+private:
+    Counter& m_calls;
+    Counter& m_total;
+    Histogram& m_latency;
+};
+
+// Count, time and trace a JNI native until the end of the enclosing scope
+// (and mark it as the GUI thread's current operation for the stall watchdog)
+#define CUIRQ_JNI_CALL(native) \
+    static JniCallMetrics cuirqJniMetrics_(native); \
+    JniCallMetrics::Scope cuirqJniScope_(cuirqJniMetrics_); \
+    GuiOperation::Scope cuirqGuiOperation_(native); \
+    CUIRQ_TRACE_SCOPE(native, "jni")
+
+#endif // METRICS_H
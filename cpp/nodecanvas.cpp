@@ -0,0 +1,712 @@
+#include "nodecanvas.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QFont>
+#include <QImage>
+#include <QMatrix4x4>
+#include <QPainter>
+#include <QPainterPath>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGRectangleNode>
+#include <QSGRendererInterface>
+#include <QSGTransformNode>
+#include <QSGVertexColorMaterial>
+#include <QTextLayout>
+#include <QtQml>
+#include <algorithm>
+#include <cmath>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+#include <QSGTextNode>
+#define CUIRQ_CANVAS_LABELS
+#endif
+
+namespace {
+
+constexpr qreal kHeaderHeight = 20.0;
+constexpr qreal kPortSize = 8.0;
+constexpr qreal kEdgeWidth = 2.0;
+constexpr int kQuadVertices = 6;
+constexpr int kEdgeVertices = NodeCanvas::kEdgeSegments * kQuadVertices;
+constexpr int kMaxEdgeImageSize = 8192;
+
+using Vertex = QSGGeometry::ColoredPoint2D;
+
+// Vertex colors are premultiplied
+void setVertex(Vertex& v, QPointF p, QRgb color)
+{
+    const int a = qAlpha(color);
+    v.set(static_cast<float>(p.x()), static_cast<float>(p.y()),
+          static_cast<uchar>(qRed(color) * a / 255), static_cast<uchar>(qGreen(color) * a / 255),
+          static_cast<uchar>(qBlue(color) * a / 255), static_cast<uchar>(a));
+}
+
+// Two triangles: (a, b, c), (b, d, c)
+void writeQuad(Vertex*& v, QPointF a, QPointF b, QPointF c, QPointF d, QRgb color)
+{
+    setVertex(v[0], a, color);
+    setVertex(v[1], b, color);
+    setVertex(v[2], c, color);
+    setVertex(v[3], b, color);
+    setVertex(v[4], d, color);
+    setVertex(v[5], c, color);
+    v += kQuadVertices;
+}
+
+void writeRect(Vertex*& v, const QRectF& r, QRgb color)
+{
+    writeQuad(v, r.topLeft(), r.topRight(), r.bottomLeft(), r.bottomRight(), color);
+}
+
+QRgb headerColor(QRgb body)
+{
+    return QColor::fromRgba(body).darker(140).rgba();
+}
+
+QRectF portRect(QPointF center)
+{
+    return QRectF(center.x() - kPortSize / 2, center.y() - kPortSize / 2, kPortSize, kPortSize);
+}
+
+QPointF cubic(QPointF p0, QPointF c0, QPointF c1, QPointF p1, qreal t)
+{
+    const qreal u = 1 - t;
+    return u * u * u * p0 + 3 * u * u * t * c0 + 3 * u * t * t * c1 + t * t * t * p1;
+}
+
+QSGGeometryNode* createChunk(int vertexCount)
+{
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), vertexCount);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+
+    auto* node = new QSGGeometryNode();
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGVertexColorMaterial());
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+} // namespace
+
+NodeCanvas::NodeCanvas(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    // Keeps clipRect() in sync with an enclosing Flickable
+    setFlag(ItemObservesViewport, true);
+#endif
+}
+
+NodeCanvas::~NodeCanvas()
+{
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+}
+
+QHash<QString, NodeCanvas*>& NodeCanvas::registry()
+{
+    static QHash<QString, NodeCanvas*> canvases;
+    return canvases;
+}
+
+void NodeCanvas::registerType()
+{
+    qmlRegisterType<NodeCanvas>("Cuirq", 1, 0, "NodeCanvas");
+}
+
+NodeCanvas* NodeCanvas::find(const QString& name)
+{
+    return registry().value(name, nullptr);
+}
+
+void NodeCanvas::setName(const QString& name)
+{
+    if (name == m_name) {
+        return;
+    }
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+    m_name = name;
+    if (!m_name.isEmpty()) {
+        registry().insert(m_name, this);
+    }
+    emit nameChanged();
+}
+
+void NodeCanvas::setViewport(const QRectF& viewport)
+{
+    if (viewport == m_viewport) {
+        return;
+    }
+    m_viewport = viewport;
+    emit viewportChanged();
+    update();
+}
+
+void NodeCanvas::setCullMargin(qreal margin)
+{
+    margin = qMax<qreal>(0, margin);
+    if (qFuzzyCompare(margin, m_cullMargin)) {
+        return;
+    }
+    m_cullMargin = margin;
+    emit cullMarginChanged();
+    update();
+}
+
+// ---------------------------------------------------------------------------
+// Graph data
+// ---------------------------------------------------------------------------
+
+void NodeCanvas::setNodes(QVector<Node> nodes)
+{
+    QVector<int> edgeTable;
+    QVector<QRgb> edgeColors;
+    for (const Edge& e : std::as_const(m_edges)) {
+        edgeTable << m_nodes[e.from].id << e.fromPort << m_nodes[e.to].id << e.toPort;
+        edgeColors << e.color;
+    }
+
+    m_nodes = std::move(nodes);
+    m_indexById.clear();
+    m_indexById.reserve(m_nodes.size());
+    m_index.clear();
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        m_indexById.insert(m_nodes[i].id, i);
+        m_index.insert(i, nodeBounds(i));
+    }
+
+    // Keep existing edges whose endpoints survived
+    setEdges(edgeTable, edgeColors);
+}
+
+void NodeCanvas::setEdges(const QVector<int>& table, const QVector<QRgb>& colors)
+{
+    m_edges.clear();
+    m_edges.reserve(table.size() / 4);
+    for (int row = 0; row + 3 < table.size(); row += 4) {
+        const int from = m_indexById.value(table[row], -1);
+        const int to = m_indexById.value(table[row + 2], -1);
+        if (from < 0 || to < 0) {
+            continue;
+        }
+        const QRgb color = colors.value(row / 4, qRgba(140, 150, 170, 255));
+        m_edges.append(Edge{ from, table[row + 1], to, table[row + 3], color });
+    }
+    rebuildEdgeIndex();
+
+    m_structureDirty = true;
+    m_dirtyNodes.clear();
+    m_deferredNodes.clear();
+    m_deferredEdges.clear();
+    emit graphChanged();
+    update();
+}
+
+void NodeCanvas::rebuildEdgeIndex()
+{
+    m_edgesOfNode = QVector<QVector<int>>(m_nodes.size());
+    for (int e = 0; e < m_edges.size(); ++e) {
+        m_edgesOfNode[m_edges[e].from].append(e);
+        if (m_edges[e].to != m_edges[e].from) {
+            m_edgesOfNode[m_edges[e].to].append(e);
+        }
+    }
+}
+
+int NodeCanvas::moveNodes(const int* ids, const float* positions, int count)
+{
+    int moved = 0;
+    for (int i = 0; i < count; ++i) {
+        const int index = m_indexById.value(ids[i], -1);
+        if (index < 0) {
+            continue;
+        }
+        m_nodes[index].rect.moveTo(positions[2 * i], positions[2 * i + 1]);
+        m_index.insert(index, nodeBounds(index));
+        markNodeDirty(index);
+        ++moved;
+    }
+    if (moved > 0) {
+        update();
+    }
+    return moved;
+}
+
+bool NodeCanvas::moveNode(int id, qreal x, qreal y)
+{
+    const float position[2] = { static_cast<float>(x), static_cast<float>(y) };
+    return moveNodes(&id, position, 1) == 1;
+}
+
+int NodeCanvas::nodeAt(qreal x, qreal y) const
+{
+    // Later nodes are drawn on top; index bounds include the ports
+    int top = -1;
+    m_index.forEachIntersecting(QRectF(x, y, 0, 0), [&](int index) {
+        if (index > top && m_nodes[index].rect.contains(x, y)) {
+            top = index;
+        }
+    });
+    return top < 0 ? -1 : m_nodes[top].id;
+}
+
+QRectF NodeCanvas::nodeRect(int id) const
+{
+    const int index = m_indexById.value(id, -1);
+    return index < 0 ? QRectF() : m_nodes[index].rect;
+}
+
+QList<int> NodeCanvas::nodesInRect(qreal x, qreal y, qreal width, qreal height) const
+{
+    return idsOf(m_index.intersecting(QRectF(x, y, width, height)));
+}
+
+QList<int> NodeCanvas::nodesInPolygon(const QVariantList& points) const
+{
+    QPolygonF polygon;
+    polygon.reserve(points.size());
+    for (const QVariant& point : points) {
+        polygon.append(point.toPointF());
+    }
+    return nodesInPolygon(polygon);
+}
+
+QList<int> NodeCanvas::nodesInPolygon(const QPolygonF& polygon) const
+{
+    return idsOf(m_index.insidePolygon(polygon));
+}
+
+QList<int> NodeCanvas::idsOf(QVector<int> indexes) const
+{
+    std::sort(indexes.begin(), indexes.end());
+    QList<int> ids;
+    ids.reserve(indexes.size());
+    for (int index : std::as_const(indexes)) {
+        ids.append(m_nodes[index].id);
+    }
+    return ids;
+}
+
+void NodeCanvas::markNodeDirty(int index)
+{
+    if (!m_structureDirty) {
+        m_dirtyNodes.insert(index);
+    }
+}
+
+QPointF NodeCanvas::portPosition(const Node& node, bool output, int port) const
+{
+    const int count = output ? node.outputs : node.inputs;
+    const qreal x = output ? node.rect.right() : node.rect.left();
+    const qreal top = node.rect.top() + kHeaderHeight;
+    const qreal height = qMax<qreal>(0, node.rect.height() - kHeaderHeight);
+    if (count <= 0) {
+        return QPointF(x, top + height / 2);
+    }
+    return QPointF(x, top + height * (qBound(0, port, count - 1) + 0.5) / count);
+}
+
+int NodeCanvas::nodeVertexCount(const Node& node) const
+{
+    return (2 + node.inputs + node.outputs) * kQuadVertices;
+}
+
+// Everything a node draws: ports stick out of the sides
+QRectF NodeCanvas::nodeBounds(int index) const
+{
+    return m_nodes[index].rect.adjusted(-kPortSize / 2, 0, kPortSize / 2, 0);
+}
+
+// A cubic bezier lies inside the hull of its control points
+QRectF NodeCanvas::edgeBounds(int index) const
+{
+    const Edge& edge = m_edges[index];
+    const QPointF p0 = portPosition(m_nodes[edge.from], true, edge.fromPort);
+    const QPointF p1 = portPosition(m_nodes[edge.to], false, edge.toPort);
+    const qreal reach = qMax<qreal>(40.0, std::abs(p1.x() - p0.x()) / 2);
+    const qreal left = qMin(qMin(p0.x(), p1.x()), p1.x() - reach);
+    const qreal right = qMax(qMax(p0.x(), p1.x()), p0.x() + reach);
+    const qreal top = qMin(p0.y(), p1.y());
+    const qreal bottom = qMax(p0.y(), p1.y());
+    return QRectF(QPointF(left, top), QPointF(right, bottom)).adjusted(-kEdgeWidth, -kEdgeWidth, kEdgeWidth, kEdgeWidth);
+}
+
+QRectF NodeCanvas::cullRect() const
+{
+    const QRectF visible = m_viewport.isEmpty() ? clipRect() : m_viewport;
+    return visible.adjusted(-m_cullMargin, -m_cullMargin, m_cullMargin, m_cullMargin);
+}
+
+void NodeCanvas::takeVisible(const QRectF& cull, bool cullMoved, QSet<int>& nodes, QSet<int>& edges)
+{
+    // An item must be rewritten if it is on screen now or was when last
+    // written: moving it out of view has to erase what is drawn there
+    const auto takeNode = [&](int index) {
+        const QRectF bounds = nodeBounds(index);
+        if (!bounds.intersects(cull) && !m_drawnNodeBounds.value(index).intersects(cull)) {
+            return false;
+        }
+        nodes.insert(index);
+        m_drawnNodeBounds[index] = bounds;
+        return true;
+    };
+
+    QSet<int> candidateEdges;
+    for (int index : std::as_const(m_dirtyNodes)) {
+        if (takeNode(index)) {
+            m_deferredNodes.remove(index);
+        } else {
+            m_deferredNodes.insert(index);
+        }
+        // An edge may cross the viewport even when this end is off screen
+        for (int e : std::as_const(m_edgesOfNode[index])) {
+            candidateEdges.insert(e);
+        }
+    }
+
+    if (cullMoved) {
+        for (auto it = m_deferredNodes.begin(); it != m_deferredNodes.end();) {
+            if (takeNode(*it)) {
+                it = m_deferredNodes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        candidateEdges.unite(m_deferredEdges);
+        m_deferredEdges.clear();
+    }
+
+    for (int e : std::as_const(candidateEdges)) {
+        const QRectF bounds = edgeBounds(e);
+        if (bounds.intersects(cull) || m_drawnEdgeBounds.value(e).intersects(cull)) {
+            edges.insert(e);
+            m_drawnEdgeBounds[e] = bounds;
+            m_deferredEdges.remove(e);
+        } else {
+            m_deferredEdges.insert(e);
+        }
+    }
+}
+
+// After a full rebuild every item is written where it is now
+void NodeCanvas::recordDrawnBounds()
+{
+    m_drawnNodeBounds.resize(m_nodes.size());
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        m_drawnNodeBounds[i] = nodeBounds(i);
+    }
+    m_drawnEdgeBounds.resize(m_edges.size());
+    for (int e = 0; e < m_edges.size(); ++e) {
+        m_drawnEdgeBounds[e] = edgeBounds(e);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Scene graph
+// ---------------------------------------------------------------------------
+
+QSGNode* NodeCanvas::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* /* data */)
+{
+    static Histogram& syncTime = Metrics::histogram("canvas.sync_ns");
+    ScopedTimer timer(syncTime);
+    CUIRQ_TRACE_SCOPE("NodeCanvas::updatePaintNode", "render");
+
+    QSGNode* root = oldNode;
+    if (!root) {
+        root = new QSGNode();
+        m_structureDirty = true;
+    }
+
+    const bool software = window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+    const QRectF cull = cullRect();
+    const bool cullMoved = cull != m_lastCull;
+    m_lastCull = cull;
+
+    if (m_structureDirty || software != m_software) {
+        while (QSGNode* child = root->firstChild()) {
+            root->removeChildNode(child);
+            delete child;
+        }
+        m_software = software;
+        if (m_software) {
+            buildSoftware(root);
+        } else {
+            buildGeometry(root);
+        }
+        buildLabels(root);
+        m_structureDirty = false;
+        m_deferredNodes.clear();
+        m_deferredEdges.clear();
+        recordDrawnBounds();
+    } else if (!m_dirtyNodes.isEmpty() || cullMoved) {
+        QSet<int> nodes;
+        QSet<int> edges;
+        takeVisible(cull, cullMoved, nodes, edges);
+        if (m_software) {
+            for (int index : std::as_const(nodes)) {
+                writeRects(index);
+            }
+            // The edge image only covers the cull rect
+            if (!edges.isEmpty() || cullMoved) {
+                paintEdges(cull);
+            }
+        } else {
+            updateGeometry(nodes, edges);
+        }
+        for (int index : std::as_const(nodes)) {
+            placeLabel(index);
+        }
+    }
+    m_dirtyNodes.clear();
+    return root;
+}
+
+void NodeCanvas::itemChange(ItemChange change, const ItemChangeData& value)
+{
+    if (change == ItemSceneChange) {
+        m_structureDirty = true;
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void NodeCanvas::releaseResources()
+{
+    // The scene graph is going away: node pointers die with it
+    m_nodeChunks.clear();
+    m_edgeChunks.clear();
+    m_labels.clear();
+    m_rects.clear();
+    m_edgeImage = nullptr;
+    m_structureDirty = true;
+}
+
+void NodeCanvas::buildGeometry(QSGNode* root)
+{
+    m_rects.clear();
+    m_edgeImage = nullptr;
+
+    // Edges first so nodes draw over them
+    m_edgeChunks.clear();
+    for (int first = 0; first < m_edges.size(); first += kEdgesPerChunk) {
+        const int count = qMin(kEdgesPerChunk, static_cast<int>(m_edges.size()) - first);
+        QSGGeometryNode* chunk = createChunk(count * kEdgeVertices);
+        m_edgeChunks.append(chunk);
+        root->appendChildNode(chunk);
+        for (int e = first; e < first + count; ++e) {
+            writeEdge(e);
+        }
+    }
+
+    m_nodeChunks.clear();
+    m_nodeVertexOffset.resize(m_nodes.size());
+    for (int first = 0; first < m_nodes.size(); first += kNodesPerChunk) {
+        const int last = qMin(first + kNodesPerChunk, static_cast<int>(m_nodes.size()));
+        int vertices = 0;
+        for (int i = first; i < last; ++i) {
+            m_nodeVertexOffset[i] = vertices;
+            vertices += nodeVertexCount(m_nodes[i]);
+        }
+        QSGGeometryNode* chunk = createChunk(vertices);
+        m_nodeChunks.append(chunk);
+        root->appendChildNode(chunk);
+        for (int i = first; i < last; ++i) {
+            writeNode(i);
+        }
+    }
+}
+
+void NodeCanvas::updateGeometry(const QSet<int>& nodes, const QSet<int>& edges)
+{
+    QSet<int> nodeChunks;
+    for (int index : nodes) {
+        writeNode(index);
+        nodeChunks.insert(index / kNodesPerChunk);
+    }
+
+    QSet<int> edgeChunks;
+    for (int e : edges) {
+        writeEdge(e);
+        edgeChunks.insert(e / kEdgesPerChunk);
+    }
+
+    // Only the touched chunks are re-uploaded
+    for (int chunk : std::as_const(nodeChunks)) {
+        m_nodeChunks[chunk]->markDirty(QSGNode::DirtyGeometry);
+    }
+    for (int chunk : std::as_const(edgeChunks)) {
+        m_edgeChunks[chunk]->markDirty(QSGNode::DirtyGeometry);
+    }
+}
+
+void NodeCanvas::writeNode(int index)
+{
+    const Node& node = m_nodes[index];
+    QSGGeometry* geometry = m_nodeChunks[index / kNodesPerChunk]->geometry();
+    Vertex* v = geometry->vertexDataAsColoredPoint2D() + m_nodeVertexOffset[index];
+
+    const QRectF header(node.rect.left(), node.rect.top(), node.rect.width(),
+                        qMin(kHeaderHeight, node.rect.height()));
+    writeRect(v, node.rect, node.color);
+    writeRect(v, header, headerColor(node.color));
+
+    const QRgb portColor = qRgba(230, 230, 235, 255);
+    for (int p = 0; p < node.inputs; ++p) {
+        writeRect(v, portRect(portPosition(node, false, p)), portColor);
+    }
+    for (int p = 0; p < node.outputs; ++p) {
+        writeRect(v, portRect(portPosition(node, true, p)), portColor);
+    }
+}
+
+void NodeCanvas::writeEdge(int index)
+{
+    const Edge& edge = m_edges[index];
+    QSGGeometry* geometry = m_edgeChunks[index / kEdgesPerChunk]->geometry();
+    Vertex* v = geometry->vertexDataAsColoredPoint2D() + (index % kEdgesPerChunk) * kEdgeVertices;
+
+    const QPointF p0 = portPosition(m_nodes[edge.from], true, edge.fromPort);
+    const QPointF p1 = portPosition(m_nodes[edge.to], false, edge.toPort);
+    const qreal reach = qMax<qreal>(40.0, std::abs(p1.x() - p0.x()) / 2);
+    const QPointF c0(p0.x() + reach, p0.y());
+    const QPointF c1(p1.x() - reach, p1.y());
+
+    // Each segment is a quad extruded along its normal
+    QPointF prev = p0;
+    for (int s = 1; s <= kEdgeSegments; ++s) {
+        const QPointF next = cubic(p0, c0, c1, p1, static_cast<qreal>(s) / kEdgeSegments);
+        const QPointF d = next - prev;
+        const qreal length = std::hypot(d.x(), d.y());
+        const QPointF n = length > 0 ? QPointF(-d.y(), d.x()) * (kEdgeWidth / 2 / length) : QPointF();
+        writeQuad(v, prev + n, prev - n, next + n, next - n, edge.color);
+        prev = next;
+    }
+}
+
+void NodeCanvas::buildSoftware(QSGNode* root)
+{
+    m_nodeChunks.clear();
+    m_edgeChunks.clear();
+
+    m_edgeImage = window()->createImageNode();
+    m_edgeImage->setOwnsTexture(true);
+    root->appendChildNode(m_edgeImage);
+
+    m_rects.clear();
+    m_rectOffset.resize(m_nodes.size());
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        m_rectOffset[i] = m_rects.size();
+        const int count = 2 + m_nodes[i].inputs + m_nodes[i].outputs;
+        for (int r = 0; r < count; ++r) {
+            QSGRectangleNode* rect = window()->createRectangleNode();
+            m_rects.append(rect);
+            root->appendChildNode(rect);
+        }
+    }
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        writeRects(i);
+    }
+    paintEdges(m_lastCull);
+}
+
+void NodeCanvas::writeRects(int index)
+{
+    const Node& node = m_nodes[index];
+    QSGRectangleNode** rect = m_rects.data() + m_rectOffset[index];
+
+    (*rect)->setRect(node.rect);
+    (*rect++)->setColor(QColor::fromRgba(node.color));
+    (*rect)->setRect(QRectF(node.rect.left(), node.rect.top(), node.rect.width(),
+                            qMin(kHeaderHeight, node.rect.height())));
+    (*rect++)->setColor(QColor::fromRgba(headerColor(node.color)));
+    for (int p = 0; p < node.inputs + node.outputs; ++p) {
+        const bool output = p >= node.inputs;
+        (*rect)->setRect(portRect(portPosition(node, output, output ? p - node.inputs : p)));
+        (*rect++)->setColor(QColor(230, 230, 235));
+    }
+}
+
+void NodeCanvas::paintEdges(const QRectF& cull)
+{
+    QRectF bounds;
+    for (const Node& node : std::as_const(m_nodes)) {
+        bounds = bounds.united(node.rect);
+    }
+    bounds = bounds.adjusted(-kPortSize, -kPortSize, kPortSize, kPortSize).intersected(cull);
+    const QSize size(qBound(1, static_cast<int>(std::ceil(bounds.width())), kMaxEdgeImageSize),
+                     qBound(1, static_cast<int>(std::ceil(bounds.height())), kMaxEdgeImageSize));
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.translate(-bounds.topLeft());
+        for (int e = 0; e < m_edges.size(); ++e) {
+            if (!edgeBounds(e).intersects(bounds)) {
+                continue;
+            }
+            const Edge& edge = m_edges[e];
+            const QPointF p0 = portPosition(m_nodes[edge.from], true, edge.fromPort);
+            const QPointF p1 = portPosition(m_nodes[edge.to], false, edge.toPort);
+            const qreal reach = qMax<qreal>(40.0, std::abs(p1.x() - p0.x()) / 2);
+            QPainterPath path(p0);
+            path.cubicTo(QPointF(p0.x() + reach, p0.y()), QPointF(p1.x() - reach, p1.y()), p1);
+            painter.setPen(QPen(QColor::fromRgba(edge.color), kEdgeWidth));
+            painter.drawPath(path);
+        }
+    }
+
+    m_edgeImage->setTexture(window()->createTextureFromImage(image));
+    m_edgeImage->setRect(QRectF(bounds.topLeft(), QSizeF(size)));
+}
+
+void NodeCanvas::buildLabels(QSGNode* root)
+{
+    m_labels.clear();
+#ifdef CUIRQ_CANVAS_LABELS
+    QFont font;
+    font.setPixelSize(12);
+    m_labels.resize(m_nodes.size());
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].label.isEmpty()) {
+            m_labels[i] = nullptr;
+            continue;
+        }
+        QTextLayout layout(m_nodes[i].label, font);
+        layout.beginLayout();
+        QTextLine line = layout.createLine();
+        line.setLineWidth(qMax<qreal>(0, m_nodes[i].rect.width() - 8));
+        layout.endLayout();
+
+        QSGTextNode* text = window()->createTextNode();
+        text->setColor(Qt::white);
+        text->addTextLayout(QPointF(0, 0), &layout);
+
+        auto* transform = new QSGTransformNode();
+        transform->appendChildNode(text);
+        root->appendChildNode(transform);
+        m_labels[i] = transform;
+        placeLabel(i);
+    }
+#endif
+}
+
+void NodeCanvas::placeLabel(int index)
+{
+    QSGTransformNode* transform = m_labels.value(index, nullptr);
+    if (!transform) {
+        return;
+    }
+    QMatrix4x4 matrix;
+    matrix.translate(static_cast<float>(m_nodes[index].rect.left() + 4),
+                     static_cast<float>(m_nodes[index].rect.top() + 3));
+    transform->setMatrix(matrix);
+}
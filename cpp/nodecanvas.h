@@ -0,0 +1,201 @@
+#ifndef NODECANVAS_H
+#define NODECANVAS_H
+
+#include <QColor>
+#include <QHash>
+#include <QList>
+#include <QPolygonF>
+#include <QQuickItem>
+#include <QRectF>
+#include <QSet>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+
+#include "spatialindex.h"
+
+class QSGGeometryNode;
+class QSGImageNode;
+class QSGNode;
+class QSGRectangleNode;
+class QSGTransformNode;
+
+/**
+ * NodeCanvas - Scene-graph item for node editors.
+ *
+ * Draws nodes (body, header, input/output ports, label) and bezier edges
+ * straight into the scene graph from a compact table pushed by the JVM,
+ * instead of one Rectangle + Text + MouseArea delegate per node.
+ *
+ * Geometry is batched: nodes and edges are split into chunks of
+ * kNodesPerChunk / kEdgesPerChunk, each one QSGGeometryNode with vertex
+ * colors, so the whole graph is a handful of draw calls. Every node and
+ * edge owns a fixed vertex range; moving nodes rewrites only their ranges
+ * and those of the edges attached to them, and only the chunks touched
+ * are marked dirty and re-uploaded.
+ *
+ * With the software backend (which cannot draw custom geometry) nodes and
+ * ports become rectangle nodes updated in place and edges are painted
+ * into a single image.
+ *
+ * Node rects are kept in a SpatialIndex, updated as nodes move, which
+ * backs point/rect/lasso hit-testing. Scene-graph updates are culled to
+ * the viewport plus cullMargin: changes to nodes and edges outside it are
+ * deferred until they scroll into range. The viewport defaults to the
+ * item's clipRect(); inside a Flickable, bind it to the visible content
+ * area.
+ *
+ * QML:
+ *   import Cuirq 1.0
+ *   NodeCanvas { name: "graph"; anchors.fill: parent }
+ *
+ * JVM: Bridge.setCanvasNodes / setCanvasEdges / moveCanvasNodes("graph", ...),
+ *      Bridge.queryCanvasPoint / queryCanvasRect / queryCanvasPolygon
+ */
+class NodeCanvas : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(int nodeCount READ nodeCount NOTIFY graphChanged)
+    Q_PROPERTY(int edgeCount READ edgeCount NOTIFY graphChanged)
+    Q_PROPERTY(QRectF viewport READ viewport WRITE setViewport NOTIFY viewportChanged)
+    Q_PROPERTY(qreal cullMargin READ cullMargin WRITE setCullMargin NOTIFY cullMarginChanged)
+
+public:
+    struct Node
+    {
+        int id;
+        QRectF rect;
+        QRgb color;
+        int inputs;
+        int outputs;
+        QString label;
+    };
+
+    struct Edge
+    {
+        int from;      // Node index
+        int fromPort;  // Output port of `from`
+        int to;        // Node index
+        int toPort;    // Input port of `to`
+        QRgb color;
+    };
+
+    static constexpr int kNodesPerChunk = 256;
+    static constexpr int kEdgesPerChunk = 256;
+    static constexpr int kEdgeSegments = 24;
+
+    explicit NodeCanvas(QQuickItem* parent = nullptr);
+    ~NodeCanvas() override;
+
+    // Register the "Cuirq 1.0 / NodeCanvas" QML type
+    static void registerType();
+
+    // Canvas declared in QML with the given name, or nullptr
+    static NodeCanvas* find(const QString& name);
+
+    QString name() const { return m_name; }
+    void setName(const QString& name);
+
+    int nodeCount() const { return m_nodes.size(); }
+    int edgeCount() const { return m_edges.size(); }
+
+    // Visible area in item coordinates; empty means clipRect()
+    QRectF viewport() const { return m_viewport; }
+    void setViewport(const QRectF& viewport);
+
+    qreal cullMargin() const { return m_cullMargin; }
+    void setCullMargin(qreal margin);
+
+    // Replace the graph. Edges are (fromId, fromPort, toId, toPort) rows;
+    // edges that reference unknown ids are dropped.
+    void setNodes(QVector<Node> nodes);
+    void setEdges(const QVector<int>& table, const QVector<QRgb>& colors);
+
+    // Move nodes by id to (x, y) pairs; returns how many ids were found
+    int moveNodes(const int* ids, const float* positions, int count);
+
+    Q_INVOKABLE bool moveNode(int id, qreal x, qreal y);
+    Q_INVOKABLE int nodeAt(qreal x, qreal y) const;
+    Q_INVOKABLE QRectF nodeRect(int id) const;
+
+    // Ids in draw order of nodes overlapping the rect / centered in the lasso
+    Q_INVOKABLE QList<int> nodesInRect(qreal x, qreal y, qreal width, qreal height) const;
+    Q_INVOKABLE QList<int> nodesInPolygon(const QVariantList& points) const;
+    QList<int> nodesInPolygon(const QPolygonF& polygon) const;
+
+signals:
+    void nameChanged();
+    void graphChanged();
+    void viewportChanged();
+    void cullMarginChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void itemChange(ItemChange change, const ItemChangeData& value) override;
+    void releaseResources() override;
+
+private:
+    static QHash<QString, NodeCanvas*>& registry();
+
+    QPointF portPosition(const Node& node, bool output, int port) const;
+    int nodeVertexCount(const Node& node) const;
+    QRectF nodeBounds(int index) const;
+    QRectF edgeBounds(int index) const;
+    QList<int> idsOf(QVector<int> indexes) const;
+
+    void markNodeDirty(int index);
+    void rebuildEdgeIndex();
+
+    // Split pending changes into what to write now (drawn or to be drawn
+    // inside cull) and what to defer; re-checks deferred items when the
+    // cull rect moved
+    QRectF cullRect() const;
+    void takeVisible(const QRectF& cull, bool cullMoved, QSet<int>& nodes, QSet<int>& edges);
+    void recordDrawnBounds();
+
+    // Hardware path
+    void buildGeometry(QSGNode* root);
+    void updateGeometry(const QSet<int>& nodes, const QSet<int>& edges);
+    void writeNode(int index);
+    void writeEdge(int index);
+
+    // Software path
+    void buildSoftware(QSGNode* root);
+    void writeRects(int index);
+    void paintEdges(const QRectF& cull);
+
+    void buildLabels(QSGNode* root);
+    void placeLabel(int index);
+
+    QString m_name;
+    QVector<Node> m_nodes;
+    QHash<int, int> m_indexById;
+    QVector<Edge> m_edges;
+    QVector<QVector<int>> m_edgesOfNode;
+    SpatialIndex m_index;  // Keyed by node index
+
+    QRectF m_viewport;
+    qreal m_cullMargin = 256.0;
+
+    // Pending changes, consumed by updatePaintNode
+    bool m_structureDirty = true;
+    QSet<int> m_dirtyNodes;
+    QSet<int> m_deferredNodes;  // Changed while outside the cull rect
+    QSet<int> m_deferredEdges;
+
+    // Scene-graph state (only touched in updatePaintNode)
+    bool m_software = false;
+    QRectF m_lastCull;
+    QVector<QRectF> m_drawnNodeBounds;  // Bounds as last written, per node
+    QVector<QRectF> m_drawnEdgeBounds;
+    QVector<QSGGeometryNode*> m_nodeChunks;
+    QVector<QSGGeometryNode*> m_edgeChunks;
+    QVector<int> m_nodeVertexOffset;
+    QVector<QSGTransformNode*> m_labels;
+    QVector<QSGRectangleNode*> m_rects;      // Software: body, header, ports per node
+    QVector<int> m_rectOffset;
+    QSGImageNode* m_edgeImage = nullptr;
+};
+
+#endif // NODECANVAS_H
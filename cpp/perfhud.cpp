@@ -0,0 +1,180 @@
+#include "perfhud.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QFont>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QtQml>
+#include <algorithm>
+
+namespace {
+
+constexpr int kRefreshMs = 250;
+constexpr int kGraphFrames = 120;
+constexpr double kGraphCeilingMs = 50.0;
+constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+
+} // namespace
+
+PerfHud::PerfHud(QQuickItem* parent)
+    : QQuickPaintedItem(parent)
+{
+    setImplicitSize(240, 150);
+    setOpaquePainting(false);
+
+    m_refresh.setInterval(kRefreshMs);
+    connect(&m_refresh, &QTimer::timeout, this, &PerfHud::refresh);
+
+    instances().append(this);
+}
+
+PerfHud::~PerfHud()
+{
+    instances().removeOne(this);
+}
+
+QList<PerfHud*>& PerfHud::instances()
+{
+    static QList<PerfHud*> list;
+    return list;
+}
+
+void PerfHud::registerType()
+{
+    qmlRegisterType<PerfHud>("Cuirq", 1, 0, "PerfHud");
+}
+
+void PerfHud::setOverlayVisible(const QList<QQuickWindow*>& windows, bool visible)
+{
+    if (visible && instances().isEmpty()) {
+        for (QQuickWindow* window : windows) {
+            QQuickItem* content = window->contentItem();
+            auto* hud = new PerfHud(content);
+            hud->setSize(QSizeF(hud->implicitWidth(), hud->implicitHeight()));
+            hud->setZ(1e6);
+
+            // Keep it in the top-right corner as the window resizes
+            auto place = [hud, content]() {
+                hud->setPosition(QPointF(content->width() - hud->width() - 8, 8));
+            };
+            connect(content, &QQuickItem::widthChanged, hud, place);
+            place();
+        }
+    }
+
+    for (PerfHud* hud : instances()) {
+        hud->setVisible(visible);
+    }
+
+    qCInfo(lcBridge) << "PerfHud" << (visible ? "shown" : "hidden") << "on" << instances().size() << "item(s)";
+}
+
+void PerfHud::itemChange(ItemChange change, const ItemChangeData& value)
+{
+    if (change == ItemSceneChange) {
+        attachToWindow(value.window);
+    } else if (change == ItemVisibleHasChanged) {
+        // A hidden HUD costs nothing: no timer, no repaints
+        if (value.boolValue) {
+            m_sampleClock.invalidate();
+            m_refresh.start();
+            refresh();
+        } else {
+            m_refresh.stop();
+        }
+    }
+    QQuickPaintedItem::itemChange(change, value);
+}
+
+void PerfHud::attachToWindow(QQuickWindow* window)
+{
+    m_frames.reset();
+    if (window) {
+        m_frames = std::make_unique<FrameTimer>(window, kGraphFrames);
+        if (isVisible()) {
+            m_refresh.start();
+        }
+    } else {
+        m_refresh.stop();
+    }
+}
+
+void PerfHud::refresh()
+{
+    static Counter& jniCalls = Metrics::counter("jni.calls");
+    static Gauge& logQueue = Metrics::gauge("log.queue_depth");
+    static Counter& modelResets = Metrics::counter("model.resets");
+    static Counter& stalls = Metrics::counter("watchdog.stalls");
+    static Gauge& lastReload = Metrics::gauge("watcher.last_reload_us");
+
+    const quint64 calls = jniCalls.value();
+    if (m_sampleClock.isValid() && m_sampleClock.elapsed() > 0 && calls >= m_lastJniCalls) {
+        m_jniCallsPerSec = (calls - m_lastJniCalls) * 1000.0 / m_sampleClock.elapsed();
+    }
+    m_lastJniCalls = calls;
+    m_sampleClock.restart();
+
+    if (m_frames) {
+        m_frameSamples = m_frames->samples();
+        m_fps = m_frames->fps();
+        m_frameP95Ms = FrameTimer::percentile(m_frameSamples, 95);
+    }
+    m_logQueueDepth = logQueue.value();
+    m_modelResets = modelResets.value();
+    m_stalls = stalls.value();
+    m_lastReloadMs = lastReload.value() > 0 ? lastReload.value() / 1000.0 : -1.0;
+
+    update();
+}
+
+void PerfHud::paint(QPainter* painter)
+{
+    const QRectF area = boundingRect();
+    painter->setRenderHint(QPainter::Antialiasing, false);
+    painter->fillRect(area, QColor(0, 0, 0, 180));
+
+    QFont font = painter->font();
+    font.setFamily(QStringLiteral("monospace"));
+    font.setPixelSize(11);
+    painter->setFont(font);
+    painter->setPen(Qt::white);
+
+    const QStringList lines{
+        QStringLiteral("FPS %1   p95 %2 ms").arg(m_fps, 0, 'f', 1).arg(m_frameP95Ms, 0, 'f', 1),
+        QStringLiteral("JNI %1 calls/s").arg(m_jniCallsPerSec, 0, 'f', 0),
+        QStringLiteral("log queue %1   stalls %2").arg(m_logQueueDepth).arg(m_stalls),
+        QStringLiteral("model resets %1").arg(m_modelResets),
+        m_lastReloadMs >= 0 ? QStringLiteral("last reload %1 ms").arg(m_lastReloadMs, 0, 'f', 1)
+                            : QStringLiteral("last reload -")
+    };
+
+    const qreal lineHeight = 14;
+    qreal y = 4;
+    for (const QString& line : lines) {
+        painter->drawText(QRectF(6, y, area.width() - 12, lineHeight), Qt::AlignLeft | Qt::AlignVCenter, line);
+        y += lineHeight;
+    }
+
+    // Frame-time graph: one bar per frame, budget line at 16.7 ms
+    const QRectF graph(6, y + 4, area.width() - 12, area.height() - y - 10);
+    if (graph.height() <= 0 || m_frameSamples.isEmpty()) {
+        return;
+    }
+
+    const qreal barWidth = graph.width() / kGraphFrames;
+    const int first = std::max(0, static_cast<int>(m_frameSamples.size()) - kGraphFrames);
+    for (int i = first; i < m_frameSamples.size(); ++i) {
+        const double ms = m_frameSamples.at(i);
+        const qreal height = std::min(ms, kGraphCeilingMs) / kGraphCeilingMs * graph.height();
+        const QColor color = ms <= kFrameBudgetMs * 1.1 ? QColor(80, 200, 120)
+                           : ms <= kFrameBudgetMs * 2 ? QColor(230, 190, 60)
+                                                      : QColor(230, 70, 60);
+        painter->fillRect(QRectF(graph.left() + (i - first) * barWidth, graph.bottom() - height,
+                                 std::max<qreal>(barWidth - 1, 1), height), color);
+    }
+
+    const qreal budgetY = graph.bottom() - kFrameBudgetMs / kGraphCeilingMs * graph.height();
+    painter->setPen(QColor(255, 255, 255, 120));
+    painter->drawLine(QPointF(graph.left(), budgetY), QPointF(graph.right(), budgetY));
+}
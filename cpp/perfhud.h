@@ -0,0 +1,74 @@
+#ifndef PERFHUD_H
+#define PERFHUD_H
+
+#include "frametimer.h"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QQuickPaintedItem>
+#include <QTimer>
+#include <memory>
+
+class QQuickWindow;
+
+/**
+ * PerfHud - On-screen overlay with live bridge health.
+ *
+ * Shows FPS and a frame-time graph of its window, JNI calls per second,
+ * log queue depth, model resets, GUI stalls and the duration of the last
+ * hot-reload. Values come straight from the native metrics registry on a
+ * 4 Hz timer, so there are no QML bindings or JS polling involved.
+ *
+ * Usage:
+ *   - From QML:  import Cuirq 1.0;  PerfHud { anchors.right: parent.right }
+ *   - From the REPL: Bridge.setPerfHudVisible(true) overlays a HUD on every
+ *     window (and shows/hides HUDs declared in QML)
+ *
+ * Compiled only with -DCUIRQ_ENABLE_PERF_HUD=ON (default outside Release
+ * builds). When compiled out, "PerfHud" is registered as an empty item so
+ * scenes that declare one still load.
+ */
+class PerfHud : public QQuickPaintedItem
+{
+    Q_OBJECT
+
+public:
+    explicit PerfHud(QQuickItem* parent = nullptr);
+    ~PerfHud() override;
+
+    void paint(QPainter* painter) override;
+
+    // Register the "Cuirq 1.0 / PerfHud" QML type
+    static void registerType();
+
+    // Show or hide all HUDs; showing with none declared overlays one per window
+    static void setOverlayVisible(const QList<QQuickWindow*>& windows, bool visible);
+
+protected:
+    void itemChange(ItemChange change, const ItemChangeData& value) override;
+
+private:
+    void attachToWindow(QQuickWindow* window);
+    void refresh();
+
+    static QList<PerfHud*>& instances();
+
+    QTimer m_refresh;
+    std::unique_ptr<FrameTimer> m_frames;
+
+    // Rates are computed from counter deltas between refreshes
+    QElapsedTimer m_sampleClock;
+    quint64 m_lastJniCalls = 0;
+    double m_jniCallsPerSec = 0.0;
+
+    // Snapshot painted by paint()
+    QVector<double> m_frameSamples;
+    double m_fps = 0.0;
+    double m_frameP95Ms = 0.0;
+    qint64 m_logQueueDepth = 0;
+    quint64 m_modelResets = 0;
+    quint64 m_stalls = 0;
+    double m_lastReloadMs = -1.0;
+};
+
+#endif // PERFHUD_H
@@ -31,6 +31,14 @@ JNIEXPORT jboolean JNICALL Java_qml_Bridge_loadQml
 JNIEXPORT void JNICALL Java_qml_Bridge_setContextProperty
   (JNIEnv *, jclass, jstring, jstring);
 
+/*
+ * Class:     qml_Bridge
+ * Method:    applyStatePatch
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_applyStatePatch
+  (JNIEnv *, jclass, jstring);
+
 /*
  * Class:     qml_Bridge
  * Method:    exec
@@ -55,6 +63,14 @@ JNIEXPORT void JNICALL Java_qml_Bridge_quit
 JNIEXPORT void JNICALL Java_qml_Bridge_registerSignalHandler
   (JNIEnv *, jclass, jstring, jobject);
 
+/*
+ * Class:     qml_Bridge
+ * Method:    emitSignal
+ * Signature: (Ljava/lang/String;[Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_emitSignal
+  (JNIEnv *, jclass, jstring, jobjectArray);
+
 /*
  * Class:     qml_Bridge
  * Method:    createModel
@@ -87,6 +103,358 @@ JNIEXPORT void JNICALL Java_qml_Bridge_clearModel
 JNIEXPORT jint JNICALL Java_qml_Bridge_getModelCount
   (JNIEnv *, jclass, jstring);
 
+/*
+ * Class:     qml_Bridge
+ * Method:    destroyModel
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyModel
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    getModelMemory
+ * Signature: (Ljava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_qml_Bridge_getModelMemory
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    getModelMemoryReport
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getModelMemoryReport
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setModelMemoryBudget
+ * Signature: (Ljava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setModelMemoryBudget
+  (JNIEnv *, jclass, jstring, jlong);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setModelKey
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setModelKey
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    patchModel
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_patchModel
+  (JNIEnv *, jclass, jstring, jstring, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    patchModelMany
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_patchModelMany
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    applyModelPatch
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_applyModelPatch
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setArrowModelData
+ * Signature: (Ljava/lang/String;JJ)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setArrowModelData
+  (JNIEnv *, jclass, jstring, jlong, jlong);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    appendArrowModelData
+ * Signature: (Ljava/lang/String;JJ)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendArrowModelData
+  (JNIEnv *, jclass, jstring, jlong, jlong);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    destroyArrowModel
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyArrowModel
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    openMappedModel
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_openMappedModel
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    refreshMappedModel
+ * Signature: (Ljava/lang/String;J)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_refreshMappedModel
+  (JNIEnv *, jclass, jstring, jlong);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    destroyMappedModel
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyMappedModel
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    createFilterModel
+ * Signature: (Ljava/lang/String;Ljava/lang/String;[Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_createFilterModel
+  (JNIEnv *, jclass, jstring, jstring, jobjectArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setFilterQuery
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_setFilterQuery
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    destroyFilterModel
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyFilterModel
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    createSelectionModel
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_createSelectionModel
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    changeSelection
+ * Signature: (Ljava/lang/String;III)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_changeSelection
+  (JNIEnv *, jclass, jstring, jint, jint, jint);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    getSelectionRanges
+ * Signature: (Ljava/lang/String;)[I
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_getSelectionRanges
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    destroySelectionModel
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroySelectionModel
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    putImage
+ * Signature: (Ljava/lang/String;Ljava/nio/ByteBuffer;IIII)J
+ */
+JNIEXPORT jlong JNICALL Java_qml_Bridge_putImage
+  (JNIEnv *, jclass, jstring, jobject, jint, jint, jint, jint);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    removeImage
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_removeImage
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setImageCacheBudget
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setImageCacheBudget
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    configureThumbnails
+ * Signature: (Ljava/lang/String;IJ)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_configureThumbnails
+  (JNIEnv *, jclass, jstring, jint, jlong);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setCanvasNodes
+ * Signature: (Ljava/lang/String;[I[F[I[I[Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setCanvasNodes
+  (JNIEnv *, jclass, jstring, jintArray, jfloatArray, jintArray, jintArray, jobjectArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setCanvasEdges
+ * Signature: (Ljava/lang/String;[I[I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setCanvasEdges
+  (JNIEnv *, jclass, jstring, jintArray, jintArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    moveCanvasNodes
+ * Signature: (Ljava/lang/String;[I[F)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_moveCanvasNodes
+  (JNIEnv *, jclass, jstring, jintArray, jfloatArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    queryCanvasPoint
+ * Signature: (Ljava/lang/String;FF)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_queryCanvasPoint
+  (JNIEnv *, jclass, jstring, jfloat, jfloat);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    queryCanvasRect
+ * Signature: (Ljava/lang/String;FFFF)[I
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_queryCanvasRect
+  (JNIEnv *, jclass, jstring, jfloat, jfloat, jfloat, jfloat);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    queryCanvasPolygon
+ * Signature: (Ljava/lang/String;[F)[I
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_queryCanvasPolygon
+  (JNIEnv *, jclass, jstring, jfloatArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    appendStrokePoints
+ * Signature: (Ljava/lang/String;[FIFZ)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_appendStrokePoints
+  (JNIEnv *, jclass, jstring, jfloatArray, jint, jfloat, jboolean);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    undoStroke
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_undoStroke
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    redoStroke
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_redoStroke
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    clearStrokes
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_clearStrokes
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setSeriesData
+ * Signature: (Ljava/lang/String;Ljava/lang/String;[D[D)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setSeriesData
+  (JNIEnv *, jclass, jstring, jstring, jdoubleArray, jdoubleArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    appendSeriesData
+ * Signature: (Ljava/lang/String;Ljava/lang/String;[D[D)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendSeriesData
+  (JNIEnv *, jclass, jstring, jstring, jdoubleArray, jdoubleArray);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    appendSeriesBuffer
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Ljava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendSeriesBuffer
+  (JNIEnv *, jclass, jstring, jstring, jobject, jobject, jint);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setSeriesColor
+ * Signature: (Ljava/lang/String;Ljava/lang/String;I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setSeriesColor
+  (JNIEnv *, jclass, jstring, jstring, jint);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    removeSeries
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_removeSeries
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    openLogView
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Z)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_openLogView
+  (JNIEnv *, jclass, jstring, jstring, jboolean);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    searchLogView
+ * Signature: (Ljava/lang/String;Ljava/lang/String;ZZ)I
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_searchLogView
+  (JNIEnv *, jclass, jstring, jstring, jboolean, jboolean);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    cancelLogSearch
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_cancelLogSearch
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    scrollLogView
+ * Signature: (Ljava/lang/String;J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_scrollLogView
+  (JNIEnv *, jclass, jstring, jlong);
+
 /*
  * Class:     qml_Bridge
  * Method:    setAutoReload
@@ -103,6 +471,150 @@ JNIEXPORT void JNICALL Java_qml_Bridge_setAutoReload
 JNIEXPORT jboolean JNICALL Java_qml_Bridge_isAutoReloadEnabled
   (JNIEnv *, jclass);
 
+/*
+ * Class:     qml_Bridge
+ * Method:    getMetrics
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getMetrics
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    resetMetrics
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_resetMetrics
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setTracingEnabled
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setTracingEnabled
+  (JNIEnv *, jclass, jboolean);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    isTracingEnabled
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isTracingEnabled
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    traceBegin
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_traceBegin
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    traceEnd
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_traceEnd
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setTraceThreadName
+ * Signature: (Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setTraceThreadName
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    dumpTrace
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_dumpTrace
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    clearTrace
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_clearTrace
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setLogLevel
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setLogLevel
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    getLogLevel
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getLogLevel
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setLogFilterRules
+ * Signature: (Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setLogFilterRules
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setStallWatchdog
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setStallWatchdog
+  (JNIEnv *, jclass, jlong, jboolean);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setStallHandler
+ * Signature: (Lqml/Bridge/StallHandler;)V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setStallHandler
+  (JNIEnv *, jclass, jobject);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    startRecording
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_startRecording
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    stopRecording
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_stopRecording
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    isRecording
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isRecording
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     qml_Bridge
+ * Method:    setPerfHudVisible
+ * Signature: (Z)Z
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setPerfHudVisible
+  (JNIEnv *, jclass, jboolean);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,16 +1,42 @@
 #include "qmlbridge.h"
 #include "signalforwarder.h"
 #include "jvmlistmodel.h"
+#include "arrowlistmodel.h"
+#include "mappedlistmodel.h"
+#include "filterlistmodel.h"
+#include "selectionlistmodel.h"
+#include "jvmimageprovider.h"
+#include "thumbnailprovider.h"
+#include "nodecanvas.h"
+#include "strokecanvas.h"
+#include "timeserieschart.h"
+#include "logview.h"
 #include "qmlwatcher.h"
 #include "stateobject.h"
+#include "stallwatchdog.h"
+#include "recorder.h"
+#ifdef CUIRQ_PERF_HUD
+#include "perfhud.h"
+#endif
+#include "metrics.h"
+#include "trace.h"
+#include "log.h"
 
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QThread>
+#include <QtQml>
 #include <QString>
 #include <QUrl>
 #include <QHash>
-#include <iostream>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <climits>
+#include <type_traits>
 #include <vector>
 #include <memory>
 
@@ -20,13 +46,28 @@
 static QGuiApplication* g_app = nullptr;
 static QQmlApplicationEngine* g_engine = nullptr;
 static SignalForwarder* g_signalForwarder = nullptr;
+static JvmImageProvider* g_imageProvider = nullptr;  // Owned by g_engine
+static ThumbnailProvider* g_thumbnailProvider = nullptr;  // Owned by g_engine
 static QmlWatcher* g_qmlWatcher = nullptr;
 static StateObject* g_state = nullptr;
+static StallWatchdog* g_watchdog = nullptr;
 
 // List models registry
 // Maps model name to JvmListModel instance
 static QHash<QString, JvmListModel*> g_models;
 
+// Arrow-backed models (buffers owned by the JVM's exported batches)
+static QHash<QString, ArrowListModel*> g_arrowModels;
+
+// Models over memory-mapped column files written by the JVM
+static QHash<QString, MappedListModel*> g_mappedModels;
+
+// Filter-as-you-type views over the models above
+static QHash<QString, FilterListModel*> g_filterModels;
+
+// Selections (row ranges plus an isSelected role) over the models above
+static QHash<QString, SelectionListModel*> g_selectionModels;
+
 // JavaVM pointer - needed for JNI callbacks from Qt
 // JavaVM is thread-safe and persistent (unlike JNIEnv which is thread-local)
 static JavaVM* g_jvm = nullptr;
@@ -57,12 +98,52 @@ std::string jstringToStdString(JNIEnv* env, jstring jstr) {
     // Copy to std::string (so we can safely release JNI resources)
     std::string result(chars);
 
+    static Counter& bytesIn = Metrics::counter("jni.bytes_in");
+    bytesIn.add(result.size());
+
     // Release JNI resources
     env->ReleaseStringUTFChars(jstr, chars);
 
     return result;
 }
 
+static jintArray toIntArray(JNIEnv* env, const QList<int>& values)
+{
+    jintArray array = env->NewIntArray(values.size());
+    if (array != nullptr && !values.isEmpty()) {
+        env->SetIntArrayRegion(array, 0, values.size(), reinterpret_cast<const jint*>(values.constData()));
+    }
+    return array;
+}
+
+/**
+ * Run `fn` on the GUI thread and return its result.
+ *
+ * Natives are called on JVM threads (a REPL or worker while Bridge.exec
+ * owns the GUI thread), but QQuickItems and item models may only be
+ * touched on the thread they live on. Blocks until `fn` has run; `name`
+ * attributes that time to the stall watchdog. Read every JNI argument
+ * before calling: the caller's JNIEnv is not valid inside `fn`.
+ */
+template <typename Fn>
+static auto onGuiThread(const char* name, Fn fn) -> decltype(fn())
+{
+    if (!g_engine || QThread::currentThread() == g_engine->thread()) {
+        return fn();
+    }
+    const auto run = [name, &fn]() {
+        GuiOperation::Scope operation(name);
+        return fn();
+    };
+    if constexpr (std::is_void_v<decltype(fn())>) {
+        QMetaObject::invokeMethod(g_engine, run, Qt::BlockingQueuedConnection);
+    } else {
+        decltype(fn()) result{};
+        QMetaObject::invokeMethod(g_engine, [&result, &run]() { result = run(); }, Qt::BlockingQueuedConnection);
+        return result;
+    }
+}
+
 extern "C" {
 
 /**
@@ -74,15 +155,20 @@ extern "C" {
 JNIEXPORT void JNICALL Java_qml_Bridge_initialize
   (JNIEnv* env, jclass /* cls */, jobjectArray args)
 {
-    std::cout << "[CPP] Initializing Qt application..." << std::endl;
+    CUIRQ_JNI_CALL("initialize");
+
+    // Route all Qt and bridge logging through the async writer
+    Log::install();
+
+    qCInfo(lcBridge) << "Initializing Qt application...";
 
     // Get and cache JavaVM pointer for callbacks
     // JavaVM is thread-safe and persists across JNI calls
     if (env->GetJavaVM(&g_jvm) != JNI_OK) {
-        std::cerr << "[CPP] ERROR: Failed to get JavaVM pointer!" << std::endl;
+        qCCritical(lcBridge) << "Failed to get JavaVM pointer!";
         return;
     }
-    std::cout << "[CPP] JavaVM pointer cached" << std::endl;
+    qCDebug(lcBridge) << "JavaVM pointer cached";
 
     // Convert Java String[] to argc/argv format required by Qt
     g_argc = env->GetArrayLength(args);
@@ -108,12 +194,32 @@ JNIEXPORT void JNICALL Java_qml_Bridge_initialize
     // We pass g_argc by value since we don't need Qt to modify it
     g_app = new QGuiApplication(g_argc, g_argv_storage.data());
 
-    std::cout << "[CPP] QGuiApplication created" << std::endl;
+    qCDebug(lcBridge) << "QGuiApplication created";
+
+    // Register QML types provided by the bridge (import Cuirq 1.0)
+    NodeCanvas::registerType();
+    StrokeCanvas::registerType();
+    TimeSeriesChart::registerType();
+    LogView::registerType();
+#ifdef CUIRQ_PERF_HUD
+    PerfHud::registerType();
+#else
+    // Compiled out: keep scenes that declare a PerfHud loadable
+    qmlRegisterType<QQuickItem>("Cuirq", 1, 0, "PerfHud");
+#endif
 
     // Create QML engine
     g_engine = new QQmlApplicationEngine();
 
-    std::cout << "[CPP] QQmlApplicationEngine created" << std::endl;
+    qCDebug(lcBridge) << "QQmlApplicationEngine created";
+
+    // Images pushed from the JVM: image://jvm/<id>
+    g_imageProvider = new JvmImageProvider();
+    g_engine->addImageProvider(QStringLiteral("jvm"), g_imageProvider);
+
+    // Decoded and cached natively: image://thumbs/<path>
+    g_thumbnailProvider = new ThumbnailProvider();
+    g_engine->addImageProvider(QStringLiteral("thumbs"), g_thumbnailProvider);
 
     // Create SignalForwarder (for QML → JVM callbacks)
     g_signalForwarder = new SignalForwarder(g_jvm);
@@ -123,16 +229,30 @@ JNIEXPORT void JNICALL Java_qml_Bridge_initialize
     QQmlContext* rootContext = g_engine->rootContext();
     rootContext->setContextProperty("signalForwarder", g_signalForwarder);
 
-    std::cout << "[CPP] SignalForwarder exposed to QML" << std::endl;
+    qCDebug(lcBridge) << "SignalForwarder exposed to QML";
+
+    // LogView progress and search results reach the JVM as signals
+    LogView::setEventSink([](const QString& event, const QVariantList& args) {
+        if (g_signalForwarder) {
+            g_signalForwarder->emitSignal(event, args);
+        }
+    });
 
     // Create QmlWatcher for hot-reload (dev mode only)
     g_qmlWatcher = new QmlWatcher(g_engine, g_engine);
-    std::cout << "[CPP] QmlWatcher created (hot-reload enabled)" << std::endl;
+    qCDebug(lcBridge) << "QmlWatcher created (hot-reload enabled)";
 
     // Create StateObject for reactive state management
     g_state = new StateObject(g_engine);
     rootContext->setContextProperty("state", g_state);
-    std::cout << "[CPP] StateObject created and exposed as 'state'" << std::endl;
+    qCDebug(lcBridge) << "StateObject created and exposed as 'state'";
+
+    // Expose tracer so QML JavaScript can add spans to the trace
+    rootContext->setContextProperty("tracer", new QmlTracer(g_engine));
+    Trace::setThreadName(QStringLiteral("qt-main"));
+
+    // Stall watchdog (idle until Bridge.setStallWatchdog is called)
+    g_watchdog = new StallWatchdog(g_jvm, g_engine);
 }
 
 /**
@@ -144,13 +264,17 @@ JNIEXPORT void JNICALL Java_qml_Bridge_initialize
 JNIEXPORT jboolean JNICALL Java_qml_Bridge_loadQml
   (JNIEnv* env, jclass /* cls */, jstring path)
 {
+    CUIRQ_JNI_CALL("loadQml");
+
     if (g_engine == nullptr) {
-        std::cerr << "[CPP] ERROR: Engine not initialized. Call initialize() first." << std::endl;
+        qCWarning(lcBridge) << "Engine not initialized. Call initialize() first.";
         return JNI_FALSE;
     }
 
     std::string qmlPath = jstringToStdString(env, path);
-    std::cout << "[CPP] Loading QML from: " << qmlPath << std::endl;
+    qCInfo(lcBridge) << "Loading QML from" << qmlPath.c_str();
+
+    CUIRQ_RECORD(Recorder::LoadQml, QString::fromStdString(qmlPath));
 
     // Convert to QUrl (handles both file paths and qrc:/ URLs)
     QUrl qmlUrl = QUrl::fromLocalFile(QString::fromStdString(qmlPath));
@@ -161,11 +285,11 @@ JNIEXPORT jboolean JNICALL Java_qml_Bridge_loadQml
     // Check if loading succeeded
     // QQmlApplicationEngine creates root objects if QML loaded successfully
     if (g_engine->rootObjects().isEmpty()) {
-        std::cerr << "[CPP] ERROR: Failed to load QML file: " << qmlPath << std::endl;
+        qCWarning(lcBridge) << "Failed to load QML file" << qmlPath.c_str();
         return JNI_FALSE;
     }
 
-    std::cout << "[CPP] QML loaded successfully" << std::endl;
+    qCInfo(lcBridge) << "QML loaded successfully";
 
     // Start watching the QML file for changes (dev mode)
     if (g_qmlWatcher) {
@@ -188,20 +312,48 @@ JNIEXPORT jboolean JNICALL Java_qml_Bridge_loadQml
 JNIEXPORT void JNICALL Java_qml_Bridge_setContextProperty
   (JNIEnv* env, jclass /* cls */, jstring name, jstring value)
 {
+    CUIRQ_JNI_CALL("setContextProperty");
+
     if (g_engine == nullptr) {
-        std::cerr << "[CPP] ERROR: Engine not initialized. Call initialize() first." << std::endl;
+        qCWarning(lcBridge) << "Engine not initialized. Call initialize() first.";
         return;
     }
 
     std::string propName = jstringToStdString(env, name);
     std::string propValue = jstringToStdString(env, value);
 
-    std::cout << "[CPP] Setting state property: " << propName << " = \"" << propValue << "\"" << std::endl;
+    qCDebug(lcBridge) << "Setting state property" << propName.c_str();
+    qCTrace(lcBridge) << "  value:" << propValue.c_str();
 
     // Set property in StateObject (will emit signal and update QML)
+    CUIRQ_RECORD(Recorder::SetProperty, QString::fromStdString(propName), QString::fromStdString(propValue));
+
     g_state->setProp(QString::fromStdString(propName), QString::fromStdString(propValue));
 }
 
+/**
+ * Apply an RFC 6902 JSON Patch to the state object.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_applyStatePatch
+  (JNIEnv* env, jclass /* cls */, jstring jsonPatch)
+{
+    CUIRQ_JNI_CALL("applyStatePatch");
+
+    if (g_state == nullptr) {
+        qCWarning(lcBridge) << "Engine not initialized. Call initialize() first.";
+        return JNI_FALSE;
+    }
+
+    const QString json = QString::fromStdString(jstringToStdString(env, jsonPatch));
+    const QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+    if (!doc.isArray()) {
+        qCWarning(lcBridge) << "State patch is not a JSON array";
+        return JNI_FALSE;
+    }
+    CUIRQ_RECORD(Recorder::ApplyStatePatch, json);
+    return g_state->applyJsonPatch(doc.array()) ? JNI_TRUE : JNI_FALSE;
+}
+
 /**
  * Run Qt event loop (blocking).
  *
@@ -216,16 +368,21 @@ JNIEXPORT jint JNICALL Java_qml_Bridge_exec
   (JNIEnv* /* env */, jclass /* cls */)
 {
     if (g_app == nullptr) {
-        std::cerr << "[CPP] ERROR: Application not initialized. Call initialize() first." << std::endl;
+        qCWarning(lcBridge) << "Application not initialized. Call initialize() first.";
         return -1;
     }
 
-    std::cout << "[CPP] Starting Qt event loop..." << std::endl;
+    qCInfo(lcBridge) << "Starting Qt event loop...";
 
     // Run event loop (blocks until quit)
     int exitCode = g_app->exec();
 
-    std::cout << "[CPP] Qt event loop exited with code: " << exitCode << std::endl;
+    // No more heartbeats once the event loop is gone
+    if (g_watchdog) {
+        g_watchdog->stop();
+    }
+
+    qCInfo(lcBridge) << "Qt event loop exited with code" << exitCode;
 
     return exitCode;
 }
@@ -239,12 +396,14 @@ JNIEXPORT jint JNICALL Java_qml_Bridge_exec
 JNIEXPORT void JNICALL Java_qml_Bridge_quit
   (JNIEnv* /* env */, jclass /* cls */)
 {
+    CUIRQ_JNI_CALL("quit");
+
     if (g_app == nullptr) {
-        std::cerr << "[CPP] ERROR: Application not initialized." << std::endl;
+        qCWarning(lcBridge) << "Application not initialized.";
         return;
     }
 
-    std::cout << "[CPP] Requesting Qt event loop to quit..." << std::endl;
+    qCInfo(lcBridge) << "Requesting Qt event loop to quit...";
 
     // Queue quit event
     QGuiApplication::quit();
@@ -265,13 +424,15 @@ JNIEXPORT void JNICALL Java_qml_Bridge_quit
 JNIEXPORT void JNICALL Java_qml_Bridge_registerSignalHandler
   (JNIEnv* env, jclass /* cls */, jstring signalName, jobject handler)
 {
+    CUIRQ_JNI_CALL("registerSignalHandler");
+
     if (g_signalForwarder == nullptr) {
-        std::cerr << "[CPP] ERROR: SignalForwarder not initialized. Call initialize() first." << std::endl;
+        qCWarning(lcBridge) << "SignalForwarder not initialized. Call initialize() first.";
         return;
     }
 
     if (handler == nullptr) {
-        std::cerr << "[CPP] ERROR: Cannot register null handler" << std::endl;
+        qCWarning(lcBridge) << "Cannot register null handler";
         return;
     }
 
@@ -282,12 +443,52 @@ JNIEXPORT void JNICALL Java_qml_Bridge_registerSignalHandler
     bool success = g_signalForwarder->registerHandler(signal, env, handler);
 
     if (success) {
-        std::cout << "[CPP] Signal handler registered successfully: "
-                  << signal.toStdString() << std::endl;
+        qCInfo(lcBridge) << "Signal handler registered successfully" << signal;
     } else {
-        std::cerr << "[CPP] ERROR: Failed to register signal handler: "
-                  << signal.toStdString() << std::endl;
+        qCWarning(lcBridge) << "Failed to register signal handler" << signal;
+    }
+}
+
+/**
+ * Emit a signal from the JVM side.
+ *
+ * Goes through the same SignalForwarder path as a QML emitSignal() call,
+ * which makes handlers testable from the REPL and benchmarkable without
+ * a QML scene.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_emitSignal
+  (JNIEnv* env, jclass /* cls */, jstring signalName, jobjectArray args)
+{
+    CUIRQ_JNI_CALL("emitSignal");
+
+    if (g_signalForwarder == nullptr) {
+        qCWarning(lcBridge) << "SignalForwarder not initialized. Call initialize() first.";
+        return;
+    }
+
+    QString signal = QString::fromStdString(jstringToStdString(env, signalName));
+
+    QVariantList signalArgs;
+    jsize argCount = args ? env->GetArrayLength(args) : 0;
+    signalArgs.reserve(argCount);
+
+    for (jsize i = 0; i < argCount; ++i) {
+        jstring jarg = (jstring)env->GetObjectArrayElement(args, i);
+        signalArgs.append(QString::fromStdString(jstringToStdString(env, jarg)));
+        env->DeleteLocalRef(jarg);
     }
+
+    g_signalForwarder->emitSignal(signal, signalArgs);
+}
+
+/**
+ * Whether a model of a different kind already uses `name` (all model kinds
+ * share the QML context property namespace).
+ */
+static bool modelNameInUse(const QString& name)
+{
+    return g_models.contains(name) || g_arrowModels.contains(name) || g_mappedModels.contains(name)
+        || g_filterModels.contains(name) || g_selectionModels.contains(name);
 }
 
 /**
@@ -296,28 +497,43 @@ JNIEXPORT void JNICALL Java_qml_Bridge_registerSignalHandler
 JNIEXPORT void JNICALL Java_qml_Bridge_createModel
   (JNIEnv* env, jclass /* cls */, jstring modelName)
 {
+    CUIRQ_JNI_CALL("createModel");
+
     QString name = QString::fromStdString(jstringToStdString(env, modelName));
-    std::cout << "[CPP] Creating list model: " << name.toStdString() << std::endl;
+    qCDebug(lcBridge) << "Creating list model" << name;
 
     if (!g_engine) {
-        std::cerr << "[CPP] ERROR: Qt not initialized!" << std::endl;
+        qCWarning(lcBridge) << "Qt not initialized!";
         return;
     }
 
     // Check if model already exists
     if (g_models.contains(name)) {
-        std::cout << "[CPP] Model already exists: " << name.toStdString() << std::endl;
+        qCDebug(lcBridge) << "Model already exists" << name;
+        return;
+    }
+    if (modelNameInUse(name)) {
+        qCWarning(lcBridge) << "A model named" << name << "already exists";
         return;
     }
 
     // Create model (Qt will manage memory via parent-child relationship)
     JvmListModel* model = new JvmListModel(g_engine);
+    model->setObjectName(name);
     g_models.insert(name, model);
+    CUIRQ_RECORD(Recorder::CreateModel, name);
+
+    // Budget warnings reach the JVM as a regular signal
+    QObject::connect(model, &JvmListModel::memoryBudgetExceeded, model, [name](qint64 bytes, qint64 budget) {
+        if (g_signalForwarder) {
+            g_signalForwarder->emitSignal("modelMemoryBudgetExceeded", QVariantList{ name, bytes, budget });
+        }
+    });
 
     // Register as context property
     g_engine->rootContext()->setContextProperty(name, model);
 
-    std::cout << "[CPP] Model created and registered: " << name.toStdString() << std::endl;
+    qCInfo(lcBridge) << "Model created and registered" << name;
 }
 
 /**
@@ -326,19 +542,22 @@ JNIEXPORT void JNICALL Java_qml_Bridge_createModel
 JNIEXPORT void JNICALL Java_qml_Bridge_setModelData
   (JNIEnv* env, jclass /* cls */, jstring modelName, jstring jsonData)
 {
+    CUIRQ_JNI_CALL("setModelData");
+
     QString name = QString::fromStdString(jstringToStdString(env, modelName));
     QString json = QString::fromStdString(jstringToStdString(env, jsonData));
 
-    std::cout << "[CPP] Setting model data: " << name.toStdString() << std::endl;
+    qCDebug(lcBridge) << "Setting model data" << name;
 
     // Find model
     JvmListModel* model = g_models.value(name, nullptr);
     if (!model) {
-        std::cerr << "[CPP] ERROR: Model not found: " << name.toStdString() << std::endl;
+        qCWarning(lcBridge) << "Model not found" << name;
         return;
     }
 
     // Set data
+    CUIRQ_RECORD(Recorder::SetModelData, name, json);
     model->setJsonData(json);
 }
 
@@ -348,15 +567,18 @@ JNIEXPORT void JNICALL Java_qml_Bridge_setModelData
 JNIEXPORT void JNICALL Java_qml_Bridge_clearModel
   (JNIEnv* env, jclass /* cls */, jstring modelName)
 {
+    CUIRQ_JNI_CALL("clearModel");
+
     QString name = QString::fromStdString(jstringToStdString(env, modelName));
-    std::cout << "[CPP] Clearing model: " << name.toStdString() << std::endl;
+    qCDebug(lcBridge) << "Clearing model" << name;
 
     JvmListModel* model = g_models.value(name, nullptr);
     if (!model) {
-        std::cerr << "[CPP] ERROR: Model not found: " << name.toStdString() << std::endl;
+        qCWarning(lcBridge) << "Model not found" << name;
         return;
     }
 
+    CUIRQ_RECORD(Recorder::ClearModel, name);
     model->clear();
 }
 
@@ -366,11 +588,13 @@ JNIEXPORT void JNICALL Java_qml_Bridge_clearModel
 JNIEXPORT jint JNICALL Java_qml_Bridge_getModelCount
   (JNIEnv* env, jclass /* cls */, jstring modelName)
 {
+    CUIRQ_JNI_CALL("getModelCount");
+
     QString name = QString::fromStdString(jstringToStdString(env, modelName));
 
     JvmListModel* model = g_models.value(name, nullptr);
     if (!model) {
-        std::cerr << "[CPP] ERROR: Model not found: " << name.toStdString() << std::endl;
+        qCWarning(lcBridge) << "Model not found" << name;
         return 0;
     }
 
@@ -378,29 +602,1462 @@ JNIEXPORT jint JNICALL Java_qml_Bridge_getModelCount
 }
 
 /**
- * Enable or disable automatic QML hot-reload.
+ * Destroy a list model and release its storage.
+ *
+ * The context property is set to null first so bindings drop the model,
+ * then the model is deleted on the next event-loop iteration.
  */
-JNIEXPORT void JNICALL Java_qml_Bridge_setAutoReload
-  (JNIEnv* /* env */, jclass /* cls */, jboolean enabled)
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyModel
+  (JNIEnv* env, jclass /* cls */, jstring modelName)
 {
-    if (g_qmlWatcher) {
-        g_qmlWatcher->setAutoReload(enabled);
-        std::cout << "[CPP] Auto-reload " << (enabled ? "enabled" : "disabled") << std::endl;
-    } else {
-        std::cout << "[CPP] QmlWatcher not available (production mode?)" << std::endl;
+    CUIRQ_JNI_CALL("destroyModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+
+    JvmListModel* model = g_models.take(name);
+    if (!model) {
+        qCWarning(lcBridge) << "Model not found" << name;
+        return JNI_FALSE;
     }
+
+    CUIRQ_RECORD(Recorder::DestroyModel, name);
+    const qint64 bytes = model->memoryUsage();
+    if (g_engine) {
+        g_engine->rootContext()->setContextProperty(name, QVariant::fromValue<QObject*>(nullptr));
+    }
+    model->clear();
+    model->deleteLater();
+
+    qCInfo(lcBridge) << "Model destroyed" << name << "released ~" << bytes << "bytes";
+    return JNI_TRUE;
 }
 
 /**
- * Check if auto-reload is enabled.
+ * Approximate heap footprint of a list model in bytes, or -1 if unknown.
  */
-JNIEXPORT jboolean JNICALL Java_qml_Bridge_isAutoReloadEnabled
-  (JNIEnv* /* env */, jclass /* cls */)
+JNIEXPORT jlong JNICALL Java_qml_Bridge_getModelMemory
+  (JNIEnv* env, jclass /* cls */, jstring modelName)
 {
-    if (g_qmlWatcher) {
-        return g_qmlWatcher->isAutoReloadEnabled() ? JNI_TRUE : JNI_FALSE;
+    CUIRQ_JNI_CALL("getModelMemory");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+
+    JvmListModel* model = g_models.value(name, nullptr);
+    return model ? static_cast<jlong>(model->memoryUsage()) : -1;
+}
+
+/**
+ * Per-model memory breakdown as JSON: {name: {total, rows, strings, roles, budget}}.
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getModelMemoryReport
+  (JNIEnv* env, jclass /* cls */)
+{
+    CUIRQ_JNI_CALL("getModelMemoryReport");
+
+    QJsonObject report;
+    for (auto it = g_models.constBegin(); it != g_models.constEnd(); ++it) {
+        report.insert(it.key(), it.value()->memoryStatistics());
+    }
+
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Compact);
+    return env->NewStringUTF(json.constData());
+}
+
+/**
+ * Set a model's memory budget in bytes (0 disables it).
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setModelMemoryBudget
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jlong bytes)
+{
+    CUIRQ_JNI_CALL("setModelMemoryBudget");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+
+    JvmListModel* model = g_models.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Model not found" << name;
+        return;
+    }
+
+    model->setMemoryBudget(static_cast<qint64>(bytes));
+}
+
+/**
+ * Index a list model's rows by the value of `role` for patchModel.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setModelKey
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jstring role)
+{
+    CUIRQ_JNI_CALL("setModelKey");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    JvmListModel* model = g_models.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Model not found" << name;
+        return JNI_FALSE;
+    }
+
+    QString keyRole = QString::fromStdString(jstringToStdString(env, role));
+    CUIRQ_RECORD(Recorder::SetModelKey, name, keyRole);
+    model->setKeyRole(keyRole);
+    return JNI_TRUE;
+}
+
+/**
+ * Set one role of the row with `key` to a JSON value.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_patchModel
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jstring key, jstring role, jstring jsonValue)
+{
+    CUIRQ_JNI_CALL("patchModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    JvmListModel* model = g_models.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Model not found" << name;
+        return JNI_FALSE;
+    }
+
+    // Scalars are not JSON documents on their own: parse inside an array
+    const QByteArray value = QByteArray::fromStdString(jstringToStdString(env, jsonValue));
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson("[" + value + "]", &error);
+    if (error.error != QJsonParseError::NoError) {
+        qCWarning(lcBridge) << "Invalid patch value for model" << name << error.errorString();
+        return JNI_FALSE;
+    }
+
+    const QString keyString = QString::fromStdString(jstringToStdString(env, key));
+    const QString roleString = QString::fromStdString(jstringToStdString(env, role));
+    if (Recorder::isRecording()) {
+        const QJsonArray patch{ QJsonArray{ keyString, roleString, doc.array().at(0) } };
+        CUIRQ_RECORD(Recorder::PatchModel, name, QString::fromUtf8(QJsonDocument(patch).toJson(QJsonDocument::Compact)));
+    }
+    return model->patch(keyString, roleString, doc.array().at(0).toVariant()) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Apply a JSON array of [key, role, value] patches. Returns the number
+ * applied, or -1 if the model does not exist or the JSON is invalid.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_patchModelMany
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jstring jsonPatches)
+{
+    CUIRQ_JNI_CALL("patchModelMany");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    JvmListModel* model = g_models.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Model not found" << name;
+        return -1;
+    }
+
+    const QString json = QString::fromStdString(jstringToStdString(env, jsonPatches));
+    const QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+    if (!doc.isArray()) {
+        qCWarning(lcBridge) << "Patches for model" << name << "are not a JSON array";
+        return -1;
+    }
+    CUIRQ_RECORD(Recorder::PatchModel, name, json);
+    return model->patchMany(doc.array());
+}
+
+/**
+ * Apply an RFC 6902 JSON Patch to a list model's rows.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_applyModelPatch
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jstring jsonPatch)
+{
+    CUIRQ_JNI_CALL("applyModelPatch");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    JvmListModel* model = g_models.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Model not found" << name;
+        return JNI_FALSE;
+    }
+
+    const QString json = QString::fromStdString(jstringToStdString(env, jsonPatch));
+    const QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
+    if (!doc.isArray()) {
+        qCWarning(lcBridge) << "JSON patch for model" << name << "is not an array";
+        return JNI_FALSE;
+    }
+    CUIRQ_RECORD(Recorder::ApplyModelPatch, name, json);
+    return model->applyJsonPatch(doc.array()) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Find an Arrow-backed model, creating and registering it if needed.
+ * The registry stays on the calling thread; the model lives on the GUI thread.
+ */
+static ArrowListModel* arrowModel(const QString& name, const char* native)
+{
+    if (ArrowListModel* model = g_arrowModels.value(name, nullptr)) {
+        return model;
+    }
+    if (!g_engine) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return nullptr;
+    }
+    if (modelNameInUse(name)) {
+        qCWarning(lcBridge) << "A model named" << name << "already exists";
+        return nullptr;
+    }
+
+    auto* model = onGuiThread(native, [&]() {
+        auto* created = new ArrowListModel(g_engine);
+        created->setObjectName(name);
+        g_engine->rootContext()->setContextProperty(name, created);
+        return created;
+    });
+    g_arrowModels.insert(name, model);
+    qCInfo(lcBridge) << "Arrow model created and registered" << name;
+    return model;
+}
+
+/**
+ * Adopt an exported Arrow record batch into a model. Ownership passes to
+ * the bridge in every case, so a rejected batch is released here.
+ */
+static jboolean putArrowBatch(JNIEnv* env, jstring modelName, jlong schemaAddress, jlong arrayAddress, bool append)
+{
+    auto* schema = reinterpret_cast<ArrowSchema*>(schemaAddress);
+    auto* array = reinterpret_cast<ArrowArray*>(arrayAddress);
+    const char* native = append ? "appendArrowModelData" : "setArrowModelData";
+    ArrowListModel* model = arrowModel(QString::fromStdString(jstringToStdString(env, modelName)), native);
+    if (!model) {
+        ArrowListModel::release(schema, array);
+        return JNI_FALSE;
+    }
+    return onGuiThread(native, [&]() -> jboolean {
+        const bool ok = append ? model->appendBatch(schema, array) : model->setBatch(schema, array);
+        return ok ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+/**
+ * Replace an Arrow-backed model's rows with an exported record batch.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setArrowModelData
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jlong schemaAddress, jlong arrayAddress)
+{
+    CUIRQ_JNI_CALL("setArrowModelData");
+    return putArrowBatch(env, modelName, schemaAddress, arrayAddress, false);
+}
+
+/**
+ * Append an exported record batch to an Arrow-backed model.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendArrowModelData
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jlong schemaAddress, jlong arrayAddress)
+{
+    CUIRQ_JNI_CALL("appendArrowModelData");
+    return putArrowBatch(env, modelName, schemaAddress, arrayAddress, true);
+}
+
+/**
+ * Destroy an Arrow-backed model; its batches are released right away.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyArrowModel
+  (JNIEnv* env, jclass /* cls */, jstring modelName)
+{
+    CUIRQ_JNI_CALL("destroyArrowModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    ArrowListModel* model = g_arrowModels.take(name);
+    if (!model) {
+        qCWarning(lcBridge) << "Arrow model not found" << name;
+        return JNI_FALSE;
+    }
+
+    onGuiThread("destroyArrowModel", [&]() {
+        if (g_engine) {
+            g_engine->rootContext()->setContextProperty(name, QVariant::fromValue<QObject*>(nullptr));
+        }
+        model->clear();
+        model->deleteLater();
+    });
+    qCInfo(lcBridge) << "Arrow model destroyed" << name;
+    return JNI_TRUE;
+}
+
+/**
+ * Open a column file in a mapped model, creating and registering the model
+ * if needed. Reopening replaces the rows (model reset).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_openMappedModel
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jstring path)
+{
+    CUIRQ_JNI_CALL("openMappedModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    MappedListModel* model = g_mappedModels.value(name, nullptr);
+    if (!model) {
+        if (!g_engine) {
+            qCWarning(lcBridge) << "Qt not initialized!";
+            return JNI_FALSE;
+        }
+        if (modelNameInUse(name)) {
+            qCWarning(lcBridge) << "A model named" << name << "already exists";
+            return JNI_FALSE;
+        }
+        model = onGuiThread("openMappedModel", [&]() {
+            auto* created = new MappedListModel(g_engine);
+            created->setObjectName(name);
+            g_engine->rootContext()->setContextProperty(name, created);
+            return created;
+        });
+        g_mappedModels.insert(name, model);
+        qCInfo(lcBridge) << "Mapped model created and registered" << name;
+    }
+    const QString file = QString::fromStdString(jstringToStdString(env, path));
+    return onGuiThread("openMappedModel", [&]() -> jboolean {
+        return model->open(file) ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+/**
+ * Pick up segments appended to a mapped model's file. `rows` caps the
+ * rows shown (-1: all complete segments). Returns the row count, or -1.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_refreshMappedModel
+  (JNIEnv* env, jclass /* cls */, jstring modelName, jlong rows)
+{
+    CUIRQ_JNI_CALL("refreshMappedModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    MappedListModel* model = g_mappedModels.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Mapped model not found" << name;
+        return -1;
     }
+    return onGuiThread("refreshMappedModel", [&]() -> jint {
+        return model->refresh(static_cast<qint64>(rows));
+    });
+}
+
+/**
+ * Destroy a mapped model and unmap its file.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyMappedModel
+  (JNIEnv* env, jclass /* cls */, jstring modelName)
+{
+    CUIRQ_JNI_CALL("destroyMappedModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, modelName));
+    MappedListModel* model = g_mappedModels.take(name);
+    if (!model) {
+        qCWarning(lcBridge) << "Mapped model not found" << name;
+        return JNI_FALSE;
+    }
+
+    onGuiThread("destroyMappedModel", [&]() {
+        if (g_engine) {
+            g_engine->rootContext()->setContextProperty(name, QVariant::fromValue<QObject*>(nullptr));
+        }
+        model->clear();
+        model->deleteLater();
+    });
+    qCInfo(lcBridge) << "Mapped model destroyed" << name;
+    return JNI_TRUE;
+}
+
+/**
+ * Source for a filter or selection view: any model created through the
+ * bridge, views included (e.g. a selection over a filtered list).
+ */
+static QAbstractItemModel* findSourceModel(const QString& name)
+{
+    if (JvmListModel* model = g_models.value(name, nullptr)) {
+        return model;
+    }
+    if (ArrowListModel* model = g_arrowModels.value(name, nullptr)) {
+        return model;
+    }
+    if (MappedListModel* model = g_mappedModels.value(name, nullptr)) {
+        return model;
+    }
+    if (FilterListModel* model = g_filterModels.value(name, nullptr)) {
+        return model;
+    }
+    return g_selectionModels.value(name, nullptr);
+}
+
+/**
+ * Create a filter-as-you-type view of a model, indexing the given roles.
+ * Result counts reach the JVM as filterResults(name, query, count, total).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_createFilterModel
+  (JNIEnv* env, jclass /* cls */, jstring filterName, jstring sourceName, jobjectArray roles)
+{
+    CUIRQ_JNI_CALL("createFilterModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, filterName));
+    QString source = QString::fromStdString(jstringToStdString(env, sourceName));
+    if (!g_engine) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return JNI_FALSE;
+    }
+    if (modelNameInUse(name)) {
+        qCWarning(lcBridge) << "A model named" << name << "already exists";
+        return JNI_FALSE;
+    }
+    QAbstractItemModel* sourceModel = findSourceModel(source);
+    if (!sourceModel) {
+        qCWarning(lcBridge) << "Source model not found" << source;
+        return JNI_FALSE;
+    }
+
+    QVector<QByteArray> roleNames;
+    const jsize roleCount = roles ? env->GetArrayLength(roles) : 0;
+    for (jsize i = 0; i < roleCount; ++i) {
+        auto role = static_cast<jstring>(env->GetObjectArrayElement(roles, i));
+        if (role) {
+            roleNames.append(QByteArray::fromStdString(jstringToStdString(env, role)));
+            env->DeleteLocalRef(role);
+        }
+    }
+    if (roleNames.isEmpty()) {
+        qCWarning(lcBridge) << "Filter model" << name << "needs at least one role to index";
+        return JNI_FALSE;
+    }
+
+    auto* model = onGuiThread("createFilterModel", [&]() {
+        auto* created = new FilterListModel(sourceModel, roleNames, g_engine);
+        created->setObjectName(name);
+        QObject::connect(created, &FilterListModel::resultsChanged, created, [name](const QString& query, int count, int total) {
+            if (g_signalForwarder) {
+                g_signalForwarder->emitSignal("filterResults", QVariantList{ name, query, count, total });
+            }
+        });
+        g_engine->rootContext()->setContextProperty(name, created);
+        return created;
+    });
+    g_filterModels.insert(name, model);
+    qCInfo(lcBridge) << "Filter model created and registered" << name << "over" << source << roleNames;
+    return JNI_TRUE;
+}
+
+/**
+ * Set a filter model's query. Returns the number of matching rows, or -1.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_setFilterQuery
+  (JNIEnv* env, jclass /* cls */, jstring filterName, jstring query)
+{
+    CUIRQ_JNI_CALL("setFilterQuery");
+
+    QString name = QString::fromStdString(jstringToStdString(env, filterName));
+    FilterListModel* model = g_filterModels.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Filter model not found" << name;
+        return -1;
+    }
+    const QString text = QString::fromStdString(jstringToStdString(env, query));
+    return onGuiThread("setFilterQuery", [&]() -> jint {
+        model->setQuery(text);
+        return model->count();
+    });
+}
+
+/**
+ * Destroy a filter model and its index. The source model is untouched.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyFilterModel
+  (JNIEnv* env, jclass /* cls */, jstring filterName)
+{
+    CUIRQ_JNI_CALL("destroyFilterModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, filterName));
+    FilterListModel* model = g_filterModels.take(name);
+    if (!model) {
+        qCWarning(lcBridge) << "Filter model not found" << name;
+        return JNI_FALSE;
+    }
+
+    onGuiThread("destroyFilterModel", [&]() {
+        if (g_engine) {
+            g_engine->rootContext()->setContextProperty(name, QVariant::fromValue<QObject*>(nullptr));
+        }
+        model->deleteLater();
+    });
+    qCInfo(lcBridge) << "Filter model destroyed" << name;
+    return JNI_TRUE;
+}
+
+/**
+ * Create a selection view of a model: its rows plus an isSelected role.
+ * Selection edits reach the JVM as selectionChanged(name, count).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_createSelectionModel
+  (JNIEnv* env, jclass /* cls */, jstring selectionName, jstring sourceName)
+{
+    CUIRQ_JNI_CALL("createSelectionModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, selectionName));
+    QString source = QString::fromStdString(jstringToStdString(env, sourceName));
+    if (!g_engine) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return JNI_FALSE;
+    }
+    if (modelNameInUse(name)) {
+        qCWarning(lcBridge) << "A model named" << name << "already exists";
+        return JNI_FALSE;
+    }
+    QAbstractItemModel* sourceModel = findSourceModel(source);
+    if (!sourceModel) {
+        qCWarning(lcBridge) << "Source model not found" << source;
+        return JNI_FALSE;
+    }
+
+    auto* model = onGuiThread("createSelectionModel", [&]() {
+        auto* created = new SelectionListModel(sourceModel, g_engine);
+        created->setObjectName(name);
+        QObject::connect(created, &SelectionListModel::selectionChanged, created, [name, created]() {
+            if (g_signalForwarder) {
+                g_signalForwarder->emitSignal("selectionChanged", QVariantList{ name, created->selectedCount() });
+            }
+        });
+        g_engine->rootContext()->setContextProperty(name, created);
+        return created;
+    });
+    g_selectionModels.insert(name, model);
+    qCInfo(lcBridge) << "Selection model created and registered" << name << "over" << source;
+    return JNI_TRUE;
+}
+
+/**
+ * Edit a selection (op: SelectionListModel::Operation) over rows
+ * [first, last]. Returns the number of selected rows, or -1.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_changeSelection
+  (JNIEnv* env, jclass /* cls */, jstring selectionName, jint op, jint first, jint last)
+{
+    CUIRQ_JNI_CALL("changeSelection");
+
+    QString name = QString::fromStdString(jstringToStdString(env, selectionName));
+    SelectionListModel* model = g_selectionModels.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Selection model not found" << name;
+        return -1;
+    }
+    return onGuiThread("changeSelection", [&]() -> jint {
+        if (!model->apply(static_cast<SelectionListModel::Operation>(op), first, last)) {
+            qCWarning(lcBridge) << "Unknown selection operation" << op;
+            return -1;
+        }
+        return model->selectedCount();
+    });
+}
+
+/**
+ * Selected rows as [first0, last0, first1, last1, ...] (inclusive, sorted).
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_getSelectionRanges
+  (JNIEnv* env, jclass /* cls */, jstring selectionName)
+{
+    CUIRQ_JNI_CALL("getSelectionRanges");
+
+    QString name = QString::fromStdString(jstringToStdString(env, selectionName));
+    SelectionListModel* model = g_selectionModels.value(name, nullptr);
+    if (!model) {
+        qCWarning(lcBridge) << "Selection model not found" << name;
+        return toIntArray(env, QList<int>());
+    }
+
+    const QList<int> bounds = onGuiThread("getSelectionRanges", [&]() {
+        QList<int> result;
+        result.reserve(2 * model->selection().ranges().size());
+        for (const RangeSet::Range& r : model->selection().ranges()) {
+            result.append(r.begin);
+            result.append(r.end - 1);
+        }
+        return result;
+    });
+    return toIntArray(env, bounds);
+}
+
+/**
+ * Destroy a selection view. The source model is untouched.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroySelectionModel
+  (JNIEnv* env, jclass /* cls */, jstring selectionName)
+{
+    CUIRQ_JNI_CALL("destroySelectionModel");
+
+    QString name = QString::fromStdString(jstringToStdString(env, selectionName));
+    SelectionListModel* model = g_selectionModels.take(name);
+    if (!model) {
+        qCWarning(lcBridge) << "Selection model not found" << name;
+        return JNI_FALSE;
+    }
+
+    onGuiThread("destroySelectionModel", [&]() {
+        if (g_engine) {
+            g_engine->rootContext()->setContextProperty(name, QVariant::fromValue<QObject*>(nullptr));
+        }
+        model->deleteLater();
+    });
+    qCInfo(lcBridge) << "Selection model destroyed" << name;
+    return JNI_TRUE;
+}
+
+/**
+ * Publish pixels from a direct ByteBuffer as image://jvm/<id>.
+ *
+ * The buffer is wrapped, not copied, and kept alive until the image is
+ * evicted and no longer rendered. Returns the image generation (use it
+ * in the URL query to make QML reload) or -1 on failure.
+ */
+JNIEXPORT jlong JNICALL Java_qml_Bridge_putImage
+  (JNIEnv* env, jclass /* cls */, jstring id, jobject pixels, jint width, jint height,
+   jint stride, jint format)
+{
+    CUIRQ_JNI_CALL("putImage");
+
+    if (!g_imageProvider) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return -1;
+    }
+
+    QString imageId = QString::fromStdString(jstringToStdString(env, id));
+    return static_cast<jlong>(g_imageProvider->put(env, imageId, pixels, width, height, stride, format));
+}
+
+/**
+ * Drop an image pushed with putImage.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_removeImage
+  (JNIEnv* env, jclass /* cls */, jstring id)
+{
+    CUIRQ_JNI_CALL("removeImage");
+
+    if (!g_imageProvider) {
+        return JNI_FALSE;
+    }
+
+    QString imageId = QString::fromStdString(jstringToStdString(env, id));
+    return g_imageProvider->remove(imageId) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Set the byte budget of the JVM image cache (least recently used images are evicted).
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setImageCacheBudget
+  (JNIEnv* /* env */, jclass /* cls */, jlong bytes)
+{
+    CUIRQ_JNI_CALL("setImageCacheBudget");
+
+    if (g_imageProvider) {
+        g_imageProvider->setBudget(static_cast<qint64>(bytes));
+    }
+}
+
+/**
+ * Configure the image://thumbs/ pipeline.
+ *
+ * cacheDir: disk cache directory ("" disables it, null keeps the current one);
+ * threads: decoder threads (<= 0 keeps the current count);
+ * memoryBudget: bytes of decoded thumbnails kept in memory (< 0 keeps it).
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_configureThumbnails
+  (JNIEnv* env, jclass /* cls */, jstring cacheDir, jint threads, jlong memoryBudget)
+{
+    CUIRQ_JNI_CALL("configureThumbnails");
+
+    if (!g_thumbnailProvider) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return;
+    }
+
+    if (cacheDir != nullptr) {
+        g_thumbnailProvider->setCacheDir(QString::fromStdString(jstringToStdString(env, cacheDir)));
+    }
+    if (threads > 0) {
+        g_thumbnailProvider->setMaxThreads(threads);
+    }
+    if (memoryBudget >= 0) {
+        g_thumbnailProvider->setMemoryBudget(static_cast<qint64>(memoryBudget));
+    }
+    qCInfo(lcBridge) << "Thumbnails: cache dir" << g_thumbnailProvider->cacheDir();
+}
+
+/**
+ * Look up a NodeCanvas declared in QML by its name property (GUI thread).
+ */
+static NodeCanvas* findCanvas(const QString& name)
+{
+    NodeCanvas* canvas = NodeCanvas::find(name);
+    if (!canvas) {
+        qCWarning(lcBridge) << "NodeCanvas not found" << name;
+    }
+    return canvas;
+}
+
+
+template <typename T, typename JArray>
+static QVector<T> copyArray(JNIEnv* env, JArray array, void (JNIEnv::*get)(JArray, jsize, jsize, T*))
+{
+    QVector<T> values;
+    if (array != nullptr) {
+        values.resize(env->GetArrayLength(array));
+        (env->*get)(array, 0, values.size(), values.data());
+    }
+    return values;
+}
+
+/**
+ * Replace the nodes of a NodeCanvas.
+ *
+ * Per node i: ids[i], rects[4i..4i+3] = x, y, width, height, colors[i]
+ * (ARGB), ports[2i..2i+1] = input and output counts, labels[i] (may be null).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setCanvasNodes
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jintArray ids, jfloatArray rects,
+   jintArray colors, jintArray ports, jobjectArray labels)
+{
+    CUIRQ_JNI_CALL("setCanvasNodes");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    const QVector<jint> idValues = copyArray<jint>(env, ids, &JNIEnv::GetIntArrayRegion);
+    const QVector<jfloat> rectValues = copyArray<jfloat>(env, rects, &JNIEnv::GetFloatArrayRegion);
+    const QVector<jint> colorValues = copyArray<jint>(env, colors, &JNIEnv::GetIntArrayRegion);
+    const QVector<jint> portValues = copyArray<jint>(env, ports, &JNIEnv::GetIntArrayRegion);
+    const jsize labelCount = labels ? env->GetArrayLength(labels) : 0;
+
+    if (rectValues.size() < idValues.size() * 4) {
+        qCWarning(lcBridge) << "setCanvasNodes: rects needs 4 floats per node";
+        return JNI_FALSE;
+    }
+
+    QVector<NodeCanvas::Node> nodes;
+    nodes.reserve(idValues.size());
+    for (int i = 0; i < idValues.size(); ++i) {
+        NodeCanvas::Node node;
+        node.id = idValues[i];
+        node.rect = QRectF(rectValues[4 * i], rectValues[4 * i + 1], rectValues[4 * i + 2], rectValues[4 * i + 3]);
+        node.color = static_cast<QRgb>(colorValues.value(i, static_cast<jint>(0xff3b6ea5)));
+        node.inputs = qMax(0, portValues.value(2 * i, 0));
+        node.outputs = qMax(0, portValues.value(2 * i + 1, 0));
+        if (i < labelCount) {
+            auto label = static_cast<jstring>(env->GetObjectArrayElement(labels, i));
+            if (label) {
+                node.label = QString::fromStdString(jstringToStdString(env, label));
+                env->DeleteLocalRef(label);
+            }
+        }
+        nodes.append(node);
+    }
+
+    return onGuiThread("setCanvasNodes", [&]() -> jboolean {
+        NodeCanvas* canvas = findCanvas(name);
+        if (!canvas) {
+            return JNI_FALSE;
+        }
+        canvas->setNodes(std::move(nodes));
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Replace the edges of a NodeCanvas.
+ *
+ * Per edge i: edges[4i..4i+3] = fromId, fromPort, toId, toPort and
+ * colors[i] (ARGB, optional).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setCanvasEdges
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jintArray edges, jintArray colors)
+{
+    CUIRQ_JNI_CALL("setCanvasEdges");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    const QVector<jint> table = copyArray<jint>(env, edges, &JNIEnv::GetIntArrayRegion);
+    const QVector<jint> colorValues = copyArray<jint>(env, colors, &JNIEnv::GetIntArrayRegion);
+
+    QVector<QRgb> edgeColors;
+    edgeColors.reserve(colorValues.size());
+    for (jint color : colorValues) {
+        edgeColors.append(static_cast<QRgb>(color));
+    }
+
+    return onGuiThread("setCanvasEdges", [&]() -> jboolean {
+        NodeCanvas* canvas = findCanvas(name);
+        if (!canvas) {
+            return JNI_FALSE;
+        }
+        canvas->setEdges(QVector<int>(table.begin(), table.end()), edgeColors);
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Move NodeCanvas nodes by id: positions[2i..2i+1] = x, y of ids[i].
+ *
+ * Returns how many ids were found.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_moveCanvasNodes
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jintArray ids, jfloatArray positions)
+{
+    CUIRQ_JNI_CALL("moveCanvasNodes");
+
+    if (ids == nullptr || positions == nullptr) {
+        return 0;
+    }
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+
+    // Copied first: moving updates the quadtree and schedules a repaint,
+    // which must not run inside a JNI critical region
+    const QVector<jint> idValues = copyArray<jint>(env, ids, &JNIEnv::GetIntArrayRegion);
+    const QVector<jfloat> positionValues = copyArray<jfloat>(env, positions, &JNIEnv::GetFloatArrayRegion);
+    const int count = qMin(idValues.size(), positionValues.size() / 2);
+    return onGuiThread("moveCanvasNodes", [&]() -> jint {
+        NodeCanvas* canvas = findCanvas(name);
+        return canvas ? canvas->moveNodes(idValues.constData(), positionValues.constData(), count) : 0;
+    });
+}
+
+/**
+ * Id of the topmost NodeCanvas node at (x, y), or -1.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_queryCanvasPoint
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jfloat x, jfloat y)
+{
+    CUIRQ_JNI_CALL("queryCanvasPoint");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    return onGuiThread("queryCanvasPoint", [&]() -> jint {
+        NodeCanvas* canvas = findCanvas(name);
+        return canvas ? canvas->nodeAt(x, y) : -1;
+    });
+}
+
+/**
+ * Ids of the NodeCanvas nodes overlapping a rect, in draw order.
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_queryCanvasRect
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jfloat x, jfloat y, jfloat width, jfloat height)
+{
+    CUIRQ_JNI_CALL("queryCanvasRect");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    const QList<int> found = onGuiThread("queryCanvasRect", [&]() {
+        NodeCanvas* canvas = findCanvas(name);
+        return canvas ? canvas->nodesInRect(x, y, width, height) : QList<int>();
+    });
+    return toIntArray(env, found);
+}
+
+/**
+ * Ids of the NodeCanvas nodes whose center lies inside a lasso polygon,
+ * given as x, y pairs.
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_queryCanvasPolygon
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jfloatArray points)
+{
+    CUIRQ_JNI_CALL("queryCanvasPolygon");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    const QVector<jfloat> xy = copyArray<jfloat>(env, points, &JNIEnv::GetFloatArrayRegion);
+
+    QPolygonF polygon;
+    polygon.reserve(xy.size() / 2);
+    for (int i = 0; i + 1 < xy.size(); i += 2) {
+        polygon.append(QPointF(xy[i], xy[i + 1]));
+    }
+    const QList<int> found = onGuiThread("queryCanvasPolygon", [&]() {
+        NodeCanvas* canvas = findCanvas(name);
+        return canvas ? canvas->nodesInPolygon(polygon) : QList<int>();
+    });
+    return toIntArray(env, found);
+}
+
+/**
+ * Look up a StrokeCanvas declared in QML by its name property (GUI thread).
+ */
+static StrokeCanvas* findStrokeCanvas(const QString& name)
+{
+    StrokeCanvas* canvas = StrokeCanvas::find(name);
+    if (!canvas) {
+        qCWarning(lcBridge) << "StrokeCanvas not found" << name;
+    }
+    return canvas;
+}
+
+/**
+ * Append points (x, y pairs) to the current stroke of a StrokeCanvas,
+ * starting one with color/width if none is in progress; `end` finishes it.
+ *
+ * Returns the number of points added.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_appendStrokePoints
+  (JNIEnv* env, jclass /* cls */, jstring canvasName, jfloatArray points, jint color, jfloat width, jboolean end)
+{
+    CUIRQ_JNI_CALL("appendStrokePoints");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    // Copied, not read in place: finishing a stroke rasterizes and runs QML
+    // handlers, which must not happen inside a JNI critical region
+    const QVector<jfloat> xy = copyArray<jfloat>(env, points, &JNIEnv::GetFloatArrayRegion);
+    return onGuiThread("appendStrokePoints", [&]() -> jint {
+        StrokeCanvas* canvas = findStrokeCanvas(name);
+        return canvas ? canvas->appendPoints(xy.constData(), xy.size() / 2, static_cast<QRgb>(color), width, end) : 0;
+    });
+}
+
+/**
+ * Undo the last stroke of a StrokeCanvas (or discard the one in progress).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_undoStroke
+  (JNIEnv* env, jclass /* cls */, jstring canvasName)
+{
+    CUIRQ_JNI_CALL("undoStroke");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    return onGuiThread("undoStroke", [&]() -> jboolean {
+        StrokeCanvas* canvas = findStrokeCanvas(name);
+        return canvas && canvas->undo() ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+/**
+ * Redo the last undone stroke of a StrokeCanvas.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_redoStroke
+  (JNIEnv* env, jclass /* cls */, jstring canvasName)
+{
+    CUIRQ_JNI_CALL("redoStroke");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    return onGuiThread("redoStroke", [&]() -> jboolean {
+        StrokeCanvas* canvas = findStrokeCanvas(name);
+        return canvas && canvas->redo() ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+/**
+ * Remove every stroke (and the undo history) from a StrokeCanvas.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_clearStrokes
+  (JNIEnv* env, jclass /* cls */, jstring canvasName)
+{
+    CUIRQ_JNI_CALL("clearStrokes");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, canvasName));
+    return onGuiThread("clearStrokes", [&]() -> jboolean {
+        StrokeCanvas* canvas = findStrokeCanvas(name);
+        if (!canvas) {
+            return JNI_FALSE;
+        }
+        canvas->clear();
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Look up a TimeSeriesChart declared in QML by its name property (GUI thread).
+ */
+static TimeSeriesChart* findChart(const QString& name)
+{
+    TimeSeriesChart* chart = TimeSeriesChart::find(name);
+    if (!chart) {
+        qCWarning(lcBridge) << "TimeSeriesChart not found" << name;
+    }
+    return chart;
+}
+
+/**
+ * Replace or extend a chart series from double arrays.
+ * x may be null (x = point index); extra elements of the longer array
+ * are ignored.
+ */
+static jboolean putSeriesArrays(JNIEnv* env, jstring chartName, jstring seriesId,
+                                jdoubleArray xs, jdoubleArray ys, bool append)
+{
+    if (ys == nullptr) {
+        return JNI_FALSE;
+    }
+    const QString name = QString::fromStdString(jstringToStdString(env, chartName));
+    const QString id = QString::fromStdString(jstringToStdString(env, seriesId));
+
+    // Copied first: building the pyramid is O(n) and emits into QML, too
+    // long and too reentrant for a JNI critical region
+    const QVector<jdouble> x = copyArray<jdouble>(env, xs, &JNIEnv::GetDoubleArrayRegion);
+    const QVector<jdouble> y = copyArray<jdouble>(env, ys, &JNIEnv::GetDoubleArrayRegion);
+    const int count = xs ? qMin(x.size(), y.size()) : y.size();
+    const jdouble* xData = xs ? x.constData() : nullptr;
+    return onGuiThread(append ? "appendSeriesData" : "setSeriesData", [&]() -> jboolean {
+        TimeSeriesChart* chart = findChart(name);
+        if (!chart) {
+            return JNI_FALSE;
+        }
+        if (append) {
+            chart->appendSeries(id, xData, y.constData(), count);
+        } else {
+            chart->setSeries(id, xData, y.constData(), count);
+        }
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Replace a TimeSeriesChart series.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setSeriesData
+  (JNIEnv* env, jclass /* cls */, jstring chartName, jstring seriesId, jdoubleArray x, jdoubleArray y)
+{
+    CUIRQ_JNI_CALL("setSeriesData");
+    return putSeriesArrays(env, chartName, seriesId, x, y, false);
+}
+
+/**
+ * Append points to a TimeSeriesChart series; only the tail of its
+ * min/max pyramid is updated.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendSeriesData
+  (JNIEnv* env, jclass /* cls */, jstring chartName, jstring seriesId, jdoubleArray x, jdoubleArray y)
+{
+    CUIRQ_JNI_CALL("appendSeriesData");
+    return putSeriesArrays(env, chartName, seriesId, x, y, true);
+}
+
+/**
+ * Append `count` points from direct DoubleBuffers (native byte order,
+ * read from index 0). x may be null.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendSeriesBuffer
+  (JNIEnv* env, jclass /* cls */, jstring chartName, jstring seriesId, jobject xBuffer, jobject yBuffer, jint count)
+{
+    CUIRQ_JNI_CALL("appendSeriesBuffer");
+
+    if (yBuffer == nullptr) {
+        return JNI_FALSE;
+    }
+
+    auto* y = static_cast<const double*>(env->GetDirectBufferAddress(yBuffer));
+    auto* x = xBuffer ? static_cast<const double*>(env->GetDirectBufferAddress(xBuffer)) : nullptr;
+    if (!y || (xBuffer && !x)) {
+        qCWarning(lcBridge) << "appendSeriesBuffer: buffers must be direct";
+        return JNI_FALSE;
+    }
+    // Capacity of a DoubleBuffer is in elements
+    jlong available = env->GetDirectBufferCapacity(yBuffer);
+    if (xBuffer) {
+        available = qMin(available, env->GetDirectBufferCapacity(xBuffer));
+    }
+    if (count < 0 || count > available) {
+        qCWarning(lcBridge) << "appendSeriesBuffer: count" << count << "exceeds buffer capacity" << available;
+        return JNI_FALSE;
+    }
+
+    const QString name = QString::fromStdString(jstringToStdString(env, chartName));
+    const QString id = QString::fromStdString(jstringToStdString(env, seriesId));
+    // The buffers stay valid while the JVM side waits for this call
+    return onGuiThread("appendSeriesBuffer", [&]() -> jboolean {
+        TimeSeriesChart* chart = findChart(name);
+        if (!chart) {
+            return JNI_FALSE;
+        }
+        chart->appendSeries(id, x, y, count);
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Set the ARGB line color of a TimeSeriesChart series.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setSeriesColor
+  (JNIEnv* env, jclass /* cls */, jstring chartName, jstring seriesId, jint color)
+{
+    CUIRQ_JNI_CALL("setSeriesColor");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, chartName));
+    const QString id = QString::fromStdString(jstringToStdString(env, seriesId));
+    return onGuiThread("setSeriesColor", [&]() -> jboolean {
+        TimeSeriesChart* chart = findChart(name);
+        if (!chart) {
+            return JNI_FALSE;
+        }
+        chart->setSeriesColor(id, static_cast<QRgb>(color));
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Remove a TimeSeriesChart series and free its points.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_removeSeries
+  (JNIEnv* env, jclass /* cls */, jstring chartName, jstring seriesId)
+{
+    CUIRQ_JNI_CALL("removeSeries");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, chartName));
+    const QString id = QString::fromStdString(jstringToStdString(env, seriesId));
+    return onGuiThread("removeSeries", [&]() -> jboolean {
+        TimeSeriesChart* chart = findChart(name);
+        return chart && chart->removeSeries(id) ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+/**
+ * Look up a LogView declared in QML by its name property (GUI thread).
+ */
+static LogView* findLogView(const QString& name)
+{
+    LogView* view = LogView::find(name);
+    if (!view) {
+        qCWarning(lcBridge) << "LogView not found" << name;
+    }
+    return view;
+}
+
+/**
+ * Show a file in a LogView; indexing starts on a background thread.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_openLogView
+  (JNIEnv* env, jclass /* cls */, jstring viewName, jstring path, jboolean follow)
+{
+    CUIRQ_JNI_CALL("openLogView");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, viewName));
+    const QString source = QString::fromStdString(jstringToStdString(env, path));
+    return onGuiThread("openLogView", [&]() -> jboolean {
+        LogView* view = findLogView(name);
+        if (!view) {
+            return JNI_FALSE;
+        }
+        view->setSource(source);
+        view->setFollow(follow);
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Start a background search in a LogView; results arrive as signals.
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_searchLogView
+  (JNIEnv* env, jclass /* cls */, jstring viewName, jstring pattern, jboolean regex, jboolean caseSensitive)
+{
+    CUIRQ_JNI_CALL("searchLogView");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, viewName));
+    const QString text = QString::fromStdString(jstringToStdString(env, pattern));
+    return onGuiThread("searchLogView", [&]() -> jint {
+        LogView* view = findLogView(name);
+        return view ? view->search(text, regex, caseSensitive) : -1;
+    });
+}
+
+/**
+ * Cancel the running search of a LogView.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_cancelLogSearch
+  (JNIEnv* env, jclass /* cls */, jstring viewName)
+{
+    CUIRQ_JNI_CALL("cancelLogSearch");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, viewName));
+    return onGuiThread("cancelLogSearch", [&]() -> jboolean {
+        LogView* view = findLogView(name);
+        if (!view) {
+            return JNI_FALSE;
+        }
+        view->cancelSearch();
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Scroll a LogView to a line (clamped).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_scrollLogView
+  (JNIEnv* env, jclass /* cls */, jstring viewName, jlong line)
+{
+    CUIRQ_JNI_CALL("scrollLogView");
+
+    const QString name = QString::fromStdString(jstringToStdString(env, viewName));
+    return onGuiThread("scrollLogView", [&]() -> jboolean {
+        LogView* view = findLogView(name);
+        if (!view) {
+            return JNI_FALSE;
+        }
+        view->setFirstLine(line);
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Enable or disable automatic QML hot-reload.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setAutoReload
+  (JNIEnv* /* env */, jclass /* cls */, jboolean enabled)
+{
+    CUIRQ_JNI_CALL("setAutoReload");
+
+    if (g_qmlWatcher) {
+        g_qmlWatcher->setAutoReload(enabled);
+        qCInfo(lcBridge) << "Auto-reload" << (enabled ? "enabled" : "disabled");
+    } else {
+        qCInfo(lcBridge) << "QmlWatcher not available (production mode?)";
+    }
+}
+
+/**
+ * Check if auto-reload is enabled.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isAutoReloadEnabled
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    CUIRQ_JNI_CALL("isAutoReloadEnabled");
+
+    if (g_qmlWatcher) {
+        return g_qmlWatcher->isAutoReloadEnabled() ? JNI_TRUE : JNI_FALSE;
+    }
+    return JNI_FALSE;
+}
+
+/**
+ * Snapshot of runtime metrics as JSON.
+ *
+ * Contains the global registry (counters, gauges, latency histograms in
+ * nanoseconds) plus per-model statistics under "models".
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getMetrics
+  (JNIEnv* env, jclass /* cls */)
+{
+    QJsonObject snapshot = Metrics::snapshot();
+
+    QJsonObject models;
+    for (auto it = g_models.constBegin(); it != g_models.constEnd(); ++it) {
+        models.insert(it.key(), it.value()->statistics());
+    }
+    for (auto it = g_arrowModels.constBegin(); it != g_arrowModels.constEnd(); ++it) {
+        models.insert(it.key(), it.value()->statistics());
+    }
+    for (auto it = g_mappedModels.constBegin(); it != g_mappedModels.constEnd(); ++it) {
+        models.insert(it.key(), it.value()->statistics());
+    }
+    for (auto it = g_filterModels.constBegin(); it != g_filterModels.constEnd(); ++it) {
+        models.insert(it.key(), it.value()->statistics());
+    }
+    for (auto it = g_selectionModels.constBegin(); it != g_selectionModels.constEnd(); ++it) {
+        models.insert(it.key(), it.value()->statistics());
+    }
+    snapshot.insert("models", models);
+
+    QByteArray json = QJsonDocument(snapshot).toJson(QJsonDocument::Compact);
+    return env->NewStringUTF(json.constData());
+}
+
+/**
+ * Reset counters and histograms (gauges keep their live values).
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_resetMetrics
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    Metrics::reset();
+    for (JvmListModel* model : std::as_const(g_models)) {
+        model->resetStatistics();
+    }
+}
+
+/**
+ * Enable or disable span recording.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setTracingEnabled
+  (JNIEnv* /* env */, jclass /* cls */, jboolean enabled)
+{
+    Trace::setEnabled(enabled == JNI_TRUE);
+}
+
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isTracingEnabled
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    return Trace::enabled() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Open a span on the calling JVM thread.
+ *
+ * Names are interned, so keep them low-cardinality (no ids in names).
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_traceBegin
+  (JNIEnv* env, jclass /* cls */, jstring name, jstring category)
+{
+    if (!Trace::enabled()) {
+        return;
+    }
+
+    const char* spanName = Trace::intern(QByteArray::fromStdString(jstringToStdString(env, name)));
+    const char* spanCategory = category
+        ? Trace::intern(QByteArray::fromStdString(jstringToStdString(env, category)))
+        : "jvm";
+    Trace::begin(spanName, spanCategory);
+}
+
+/**
+ * Close the innermost span opened with traceBegin on the calling thread.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_traceEnd
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    Trace::end();
+}
+
+/**
+ * Name the calling JVM thread in the trace.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setTraceThreadName
+  (JNIEnv* env, jclass /* cls */, jstring name)
+{
+    Trace::setThreadName(QString::fromStdString(jstringToStdString(env, name)));
+}
+
+/**
+ * Write buffered spans as Chrome trace JSON (open in ui.perfetto.dev).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_dumpTrace
+  (JNIEnv* env, jclass /* cls */, jstring path)
+{
+    QString tracePath = QString::fromStdString(jstringToStdString(env, path));
+    return Trace::writeChromeTrace(tracePath) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Drop all buffered spans.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_clearTrace
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    Trace::clear();
+}
+
+/**
+ * Set the runtime log level ("trace", "debug", "info", "warning", "error").
+ *
+ * May be called before initialize().
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setLogLevel
+  (JNIEnv* env, jclass /* cls */, jstring level)
+{
+    QString levelName = QString::fromStdString(jstringToStdString(env, level));
+    return Log::setLevel(levelName) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Get the runtime log level.
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getLogLevel
+  (JNIEnv* env, jclass /* cls */)
+{
+    return env->NewStringUTF(Log::levelName(Log::level()).toUtf8().constData());
+}
+
+/**
+ * Apply QLoggingCategory filter rules on top of the log level.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setLogFilterRules
+  (JNIEnv* env, jclass /* cls */, jstring rules)
+{
+    Log::setFilterRules(QString::fromStdString(jstringToStdString(env, rules)));
+}
+
+/**
+ * Start (thresholdMs > 0) or stop (thresholdMs <= 0) the GUI stall watchdog.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setStallWatchdog
+  (JNIEnv* /* env */, jclass /* cls */, jlong thresholdMs, jboolean captureJavaStack)
+{
+    CUIRQ_JNI_CALL("setStallWatchdog");
+
+    if (!g_watchdog) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return;
+    }
+
+    g_watchdog->start(static_cast<int>(qBound<jlong>(0, thresholdMs, INT_MAX)), captureJavaStack);
+}
+
+/**
+ * Register the JVM callback for stall reports (null to remove).
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setStallHandler
+  (JNIEnv* env, jclass /* cls */, jobject handler)
+{
+    CUIRQ_JNI_CALL("setStallHandler");
+
+    if (!g_watchdog) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return;
+    }
+
+    g_watchdog->setHandler(env, handler);
+}
+
+/**
+ * Start recording bridge traffic to a binary log (replay with cuirq_replay).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_startRecording
+  (JNIEnv* env, jclass /* cls */, jstring path)
+{
+    QString logPath = QString::fromStdString(jstringToStdString(env, path));
+    return Recorder::start(logPath) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Stop recording and close the log.
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_stopRecording
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    Recorder::stop();
+}
+
+/**
+ * Check if bridge traffic is being recorded.
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isRecording
+  (JNIEnv* /* env */, jclass /* cls */)
+{
+    return Recorder::isRecording() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Show or hide the performance HUD overlay.
+ *
+ * Returns false if the HUD is compiled out (CUIRQ_ENABLE_PERF_HUD=OFF).
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setPerfHudVisible
+  (JNIEnv* /* env */, jclass /* cls */, jboolean visible)
+{
+    CUIRQ_JNI_CALL("setPerfHudVisible");
+
+#ifdef CUIRQ_PERF_HUD
+    if (!g_engine) {
+        qCWarning(lcBridge) << "Qt not initialized!";
+        return JNI_FALSE;
+    }
+
+    // The overlay is a QML item in the windows' scenes: only touch them on the GUI thread
+    const auto apply = [visible]() {
+        QList<QQuickWindow*> windows;
+        for (QObject* root : g_engine->rootObjects()) {
+            if (auto* window = qobject_cast<QQuickWindow*>(root)) {
+                windows.append(window);
+            }
+        }
+        PerfHud::setOverlayVisible(windows, visible);
+    };
+    if (QThread::currentThread() == g_engine->thread()) {
+        apply();
+    } else {
+        QMetaObject::invokeMethod(g_engine, apply, Qt::BlockingQueuedConnection);
+    }
+    return JNI_TRUE;
+#else
+    Q_UNUSED(visible);
+    qCWarning(lcBridge) << "PerfHud not compiled in (build with -DCUIRQ_ENABLE_PERF_HUD=ON)";
     return JNI_FALSE;
+#endif
 }
 
 } // extern "C"
@@ -2,6 +2,14 @@
 #define QMLBRIDGE_H
 
 #include <jni.h>
+#include <string>
+
+/**
+ * Convert Java String to C++ std::string (UTF-8).
+ *
+ * Exported for the benchmark and tooling targets that link the bridge.
+ */
+std::string jstringToStdString(JNIEnv* env, jstring jstr);
 
 // JNI function declarations
 // These match the native methods in qml.Bridge Java class
@@ -34,6 +42,18 @@ JNIEXPORT jboolean JNICALL Java_qml_Bridge_loadQml
 JNIEXPORT void JNICALL Java_qml_Bridge_setContextProperty
   (JNIEnv* env, jclass cls, jstring name, jstring value);
 
+/**
+ * Apply an RFC 6902 JSON Patch to the state object; the first path
+ * token is a property ("/user/name"). Each written property is stored
+ * once, after every operation has succeeded; returns false and changes
+ * nothing otherwise.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean applyStatePatch(String jsonPatch)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_applyStatePatch
+  (JNIEnv* env, jclass cls, jstring jsonPatch);
+
 /**
  * Run Qt event loop (blocking).
  *
@@ -61,6 +81,15 @@ JNIEXPORT void JNICALL Java_qml_Bridge_quit
 JNIEXPORT void JNICALL Java_qml_Bridge_registerSignalHandler
   (JNIEnv* env, jclass cls, jstring signalName, jobject handler);
 
+/**
+ * Dispatch a signal to its registered handler as if QML had emitted it.
+ *
+ * JNI signature: (Ljava/lang/String;[Ljava/lang/String;)V
+ * Java: public static native void emitSignal(String signalName, String[] args)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_emitSignal
+  (JNIEnv* env, jclass cls, jstring signalName, jobjectArray args);
+
 JNIEXPORT void JNICALL Java_qml_Bridge_createModel
   (JNIEnv* env, jclass cls, jstring modelName);
 
@@ -73,12 +102,607 @@ JNIEXPORT void JNICALL Java_qml_Bridge_clearModel
 JNIEXPORT jint JNICALL Java_qml_Bridge_getModelCount
   (JNIEnv* env, jclass cls, jstring modelName);
 
+/**
+ * Destroy a list model, unbind its context property and free its rows.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean destroyModel(String modelName)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyModel
+  (JNIEnv* env, jclass cls, jstring modelName);
+
+/**
+ * Approximate heap footprint of a list model in bytes (-1 if not found).
+ *
+ * JNI signature: (Ljava/lang/String;)J
+ * Java: public static native long getModelMemory(String modelName)
+ */
+JNIEXPORT jlong JNICALL Java_qml_Bridge_getModelMemory
+  (JNIEnv* env, jclass cls, jstring modelName);
+
+/**
+ * Per-model memory breakdown as JSON.
+ *
+ * JNI signature: ()Ljava/lang/String;
+ * Java: public static native String getModelMemoryReport()
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getModelMemoryReport
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Set a list model's memory budget; exceeding it emits the
+ * "modelMemoryBudgetExceeded" signal. 0 disables the budget.
+ *
+ * JNI signature: (Ljava/lang/String;J)V
+ * Java: public static native void setModelMemoryBudget(String modelName, long bytes)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setModelMemoryBudget
+  (JNIEnv* env, jclass cls, jstring modelName, jlong bytes);
+
+/**
+ * Index a list model's rows by the value of `role` (e.g. "id"), so
+ * patchModel finds rows in O(1). The index follows data changes; an
+ * empty role removes it.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ * Java: public static native boolean setModelKey(String modelName, String role)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setModelKey
+  (JNIEnv* env, jclass cls, jstring modelName, jstring role);
+
+/**
+ * Set one role of the row whose key is `key`. Emits dataChanged for
+ * that row and role only.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)Z
+ * Java: public static native boolean patchModel(String modelName, String key, String role, String jsonValue)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_patchModel
+  (JNIEnv* env, jclass cls, jstring modelName, jstring key, jstring role, jstring jsonValue);
+
+/**
+ * Apply a JSON array of [key, role, value] patches, with one
+ * dataChanged per patched row for the patched roles.
+ * Returns the number applied, or -1.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)I
+ * Java: public static native int patchModelMany(String modelName, String jsonPatches)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_patchModelMany
+  (JNIEnv* env, jclass cls, jstring modelName, jstring jsonPatches);
+
+/**
+ * Apply an RFC 6902 JSON Patch to a list model's rows ("/3" is a row,
+ * "/3/name" a role). Row add/remove/move are announced as row inserts,
+ * removals and moves; other edits as dataChanged for the touched roles.
+ * All or nothing: returns false and leaves the model as it was if any
+ * operation fails.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ * Java: public static native boolean applyModelPatch(String modelName, String jsonPatch)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_applyModelPatch
+  (JNIEnv* env, jclass cls, jstring modelName, jstring jsonPatch);
+
+/**
+ * Replace the rows of an Arrow-backed list model (created on first use)
+ * with a record batch exported through the Arrow C Data Interface.
+ *
+ * JNI signature: (Ljava/lang/String;JJ)Z
+ * Java: public static native boolean setArrowModelData(String modelName, long schemaAddress, long arrayAddress)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setArrowModelData
+  (JNIEnv* env, jclass cls, jstring modelName, jlong schemaAddress, jlong arrayAddress);
+
+/**
+ * Append an exported Arrow record batch to an Arrow-backed list model.
+ *
+ * JNI signature: (Ljava/lang/String;JJ)Z
+ * Java: public static native boolean appendArrowModelData(String modelName, long schemaAddress, long arrayAddress)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendArrowModelData
+  (JNIEnv* env, jclass cls, jstring modelName, jlong schemaAddress, jlong arrayAddress);
+
+/**
+ * Destroy an Arrow-backed list model, releasing its batches.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean destroyArrowModel(String modelName)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyArrowModel
+  (JNIEnv* env, jclass cls, jstring modelName);
+
+/**
+ * Open a column file as a memory-mapped list model.
+ *
+ * Creates the model (exposed to QML under `modelName`) on first use;
+ * reopening replaces its rows. Cells are read from the mapped pages.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ * Java: public static native boolean openMappedModel(String modelName, String path)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_openMappedModel
+  (JNIEnv* env, jclass cls, jstring modelName, jstring path);
+
+/**
+ * Show segments appended to a mapped model's file since the last refresh.
+ *
+ * `rows` caps the rows shown (-1: every complete segment).
+ * Returns the model's row count, or -1 if the model does not exist.
+ *
+ * JNI signature: (Ljava/lang/String;J)I
+ * Java: public static native int refreshMappedModel(String modelName, long rows)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_refreshMappedModel
+  (JNIEnv* env, jclass cls, jstring modelName, jlong rows);
+
+/**
+ * Destroy a mapped model and unmap its file.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean destroyMappedModel(String modelName)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyMappedModel
+  (JNIEnv* env, jclass cls, jstring modelName);
+
+/**
+ * Create a filter-as-you-type view of a list, Arrow or mapped model.
+ *
+ * The given roles of every source row are kept in a trigram index that
+ * follows source changes. The view is a QML context property whose
+ * `query` can be set from QML; result counts are emitted as
+ * filterResults(name, query, count, total).
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;[Ljava/lang/String;)Z
+ * Java: public static native boolean createFilterModel(String filterName, String sourceName, String[] roles)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_createFilterModel
+  (JNIEnv* env, jclass cls, jstring filterName, jstring sourceName, jobjectArray roles);
+
+/**
+ * Show the source rows whose indexed roles contain `query`
+ * (case-insensitive). Returns the number of matches, or -1.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)I
+ * Java: public static native int setFilterQuery(String filterName, String query)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_setFilterQuery
+  (JNIEnv* env, jclass cls, jstring filterName, jstring query);
+
+/**
+ * Destroy a filter view and its index; the source model is untouched.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean destroyFilterModel(String filterName)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroyFilterModel
+  (JNIEnv* env, jclass cls, jstring filterName);
+
+/**
+ * Create a selection view of a model: the source rows plus an
+ * `isSelected` role, with the selection stored as row ranges.
+ * Edits (from QML or changeSelection) are emitted as
+ * selectionChanged(name, count).
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ * Java: public static native boolean createSelectionModel(String selectionName, String sourceName)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_createSelectionModel
+  (JNIEnv* env, jclass cls, jstring selectionName, jstring sourceName);
+
+/**
+ * Select, deselect or toggle rows [first, last], or select all,
+ * clear or invert (rows ignored). Cost grows with the number of
+ * selected ranges, not rows. Returns the selected row count, or -1.
+ *
+ * JNI signature: (Ljava/lang/String;III)I
+ * Java: public static native int changeSelection(String selectionName, int op, int first, int last)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_changeSelection
+  (JNIEnv* env, jclass cls, jstring selectionName, jint op, jint first, jint last);
+
+/**
+ * Selected rows as sorted inclusive ranges, flattened:
+ * [first0, last0, first1, last1, ...].
+ *
+ * JNI signature: (Ljava/lang/String;)[I
+ * Java: public static native int[] getSelectionRanges(String selectionName)
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_getSelectionRanges
+  (JNIEnv* env, jclass cls, jstring selectionName);
+
+/**
+ * Destroy a selection view; the source model is untouched.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean destroySelectionModel(String selectionName)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_destroySelectionModel
+  (JNIEnv* env, jclass cls, jstring selectionName);
+
+/**
+ * Publish pixels from a direct ByteBuffer as image://jvm/<id> (zero-copy).
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/nio/ByteBuffer;IIII)J
+ * Java: public static native long putImage(String id, ByteBuffer pixels, int width,
+ *                                          int height, int stride, int format)
+ */
+JNIEXPORT jlong JNICALL Java_qml_Bridge_putImage
+  (JNIEnv* env, jclass cls, jstring id, jobject pixels, jint width, jint height,
+   jint stride, jint format);
+
+/**
+ * Drop an image pushed with putImage.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean removeImage(String id)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_removeImage
+  (JNIEnv* env, jclass cls, jstring id);
+
+/**
+ * Byte budget of the LRU cache behind image://jvm/.
+ *
+ * JNI signature: (J)V
+ * Java: public static native void setImageCacheBudget(long bytes)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setImageCacheBudget
+  (JNIEnv* env, jclass cls, jlong bytes);
+
+/**
+ * Configure the image://thumbs/ pipeline (disk cache dir, decoder threads,
+ * memory cache budget).
+ *
+ * JNI signature: (Ljava/lang/String;IJ)V
+ * Java: public static native void configureThumbnails(String cacheDir, int threads, long memoryBudget)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_configureThumbnails
+  (JNIEnv* env, jclass cls, jstring cacheDir, jint threads, jlong memoryBudget);
+
+/**
+ * Replace the nodes of a NodeCanvas (declared in QML with the given name).
+ *
+ * JNI signature: (Ljava/lang/String;[I[F[I[I[Ljava/lang/String;)Z
+ * Java: public static native boolean setCanvasNodes(String canvas, int[] ids, float[] rects,
+ *                                                   int[] colors, int[] ports, String[] labels)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setCanvasNodes
+  (JNIEnv* env, jclass cls, jstring canvasName, jintArray ids, jfloatArray rects,
+   jintArray colors, jintArray ports, jobjectArray labels);
+
+/**
+ * Replace the edges of a NodeCanvas.
+ *
+ * JNI signature: (Ljava/lang/String;[I[I)Z
+ * Java: public static native boolean setCanvasEdges(String canvas, int[] edges, int[] colors)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setCanvasEdges
+  (JNIEnv* env, jclass cls, jstring canvasName, jintArray edges, jintArray colors);
+
+/**
+ * Move NodeCanvas nodes by id in bulk.
+ *
+ * JNI signature: (Ljava/lang/String;[I[F)I
+ * Java: public static native int moveCanvasNodes(String canvas, int[] ids, float[] positions)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_moveCanvasNodes
+  (JNIEnv* env, jclass cls, jstring canvasName, jintArray ids, jfloatArray positions);
+
+/**
+ * Hit-test a NodeCanvas: id of the topmost node at a point, or -1.
+ *
+ * JNI signature: (Ljava/lang/String;FF)I
+ * Java: public static native int queryCanvasPoint(String canvas, float x, float y)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_queryCanvasPoint
+  (JNIEnv* env, jclass cls, jstring canvasName, jfloat x, jfloat y);
+
+/**
+ * Ids of the NodeCanvas nodes overlapping a rect (rubber-band selection).
+ *
+ * JNI signature: (Ljava/lang/String;FFFF)[I
+ * Java: public static native int[] queryCanvasRect(String canvas, float x, float y, float width, float height)
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_queryCanvasRect
+  (JNIEnv* env, jclass cls, jstring canvasName, jfloat x, jfloat y, jfloat width, jfloat height);
+
+/**
+ * Ids of the NodeCanvas nodes centered inside a lasso polygon.
+ *
+ * JNI signature: (Ljava/lang/String;[F)[I
+ * Java: public static native int[] queryCanvasPolygon(String canvas, float[] points)
+ */
+JNIEXPORT jintArray JNICALL Java_qml_Bridge_queryCanvasPolygon
+  (JNIEnv* env, jclass cls, jstring canvasName, jfloatArray points);
+
+/**
+ * Append points to the current stroke of a StrokeCanvas (starting one with
+ * the given ARGB color and width if needed), finishing it if `end`.
+ *
+ * JNI signature: (Ljava/lang/String;[FIFZ)I
+ * Java: public static native int appendStrokePoints(String canvas, float[] points, int color,
+ *                                                   float width, boolean end)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_appendStrokePoints
+  (JNIEnv* env, jclass cls, jstring canvasName, jfloatArray points, jint color, jfloat width, jboolean end);
+
+/**
+ * Undo the last stroke of a StrokeCanvas.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean undoStroke(String canvas)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_undoStroke
+  (JNIEnv* env, jclass cls, jstring canvasName);
+
+/**
+ * Redo the last undone stroke of a StrokeCanvas.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean redoStroke(String canvas)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_redoStroke
+  (JNIEnv* env, jclass cls, jstring canvasName);
+
+/**
+ * Remove all strokes from a StrokeCanvas.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean clearStrokes(String canvas)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_clearStrokes
+  (JNIEnv* env, jclass cls, jstring canvasName);
+
+/**
+ * Replace a TimeSeriesChart series (created if needed). x may be null.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;[D[D)Z
+ * Java: public static native boolean setSeriesData(String chart, String series, double[] x, double[] y)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setSeriesData
+  (JNIEnv* env, jclass cls, jstring chartName, jstring seriesId, jdoubleArray x, jdoubleArray y);
+
+/**
+ * Append points to a TimeSeriesChart series. x may be null.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;[D[D)Z
+ * Java: public static native boolean appendSeriesData(String chart, String series, double[] x, double[] y)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendSeriesData
+  (JNIEnv* env, jclass cls, jstring chartName, jstring seriesId, jdoubleArray x, jdoubleArray y);
+
+/**
+ * Append points to a TimeSeriesChart series from direct DoubleBuffers.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;Ljava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;I)Z
+ * Java: public static native boolean appendSeriesBuffer(String chart, String series,
+ *                                                       DoubleBuffer x, DoubleBuffer y, int count)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_appendSeriesBuffer
+  (JNIEnv* env, jclass cls, jstring chartName, jstring seriesId, jobject xBuffer, jobject yBuffer, jint count);
+
+/**
+ * Set the line color of a TimeSeriesChart series.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;I)Z
+ * Java: public static native boolean setSeriesColor(String chart, String series, int color)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setSeriesColor
+  (JNIEnv* env, jclass cls, jstring chartName, jstring seriesId, jint color);
+
+/**
+ * Remove a TimeSeriesChart series.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ * Java: public static native boolean removeSeries(String chart, String series)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_removeSeries
+  (JNIEnv* env, jclass cls, jstring chartName, jstring seriesId);
+
+/**
+ * Open a file in a LogView (memory-mapped, indexed in the background).
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;Z)Z
+ * Java: public static native boolean openLogView(String view, String path, boolean follow)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_openLogView
+  (JNIEnv* env, jclass cls, jstring viewName, jstring path, jboolean follow);
+
+/**
+ * Start a background search in a LogView; returns the search id or -1.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;ZZ)I
+ * Java: public static native int searchLogView(String view, String pattern, boolean regex, boolean caseSensitive)
+ */
+JNIEXPORT jint JNICALL Java_qml_Bridge_searchLogView
+  (JNIEnv* env, jclass cls, jstring viewName, jstring pattern, jboolean regex, jboolean caseSensitive);
+
+/**
+ * Cancel the running search of a LogView.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean cancelLogSearch(String view)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_cancelLogSearch
+  (JNIEnv* env, jclass cls, jstring viewName);
+
+/**
+ * Scroll a LogView so `line` is the first visible line.
+ *
+ * JNI signature: (Ljava/lang/String;J)Z
+ * Java: public static native boolean scrollLogView(String view, long line)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_scrollLogView
+  (JNIEnv* env, jclass cls, jstring viewName, jlong line);
+
 JNIEXPORT void JNICALL Java_qml_Bridge_setAutoReload
   (JNIEnv* env, jclass cls, jboolean enabled);
 
 JNIEXPORT jboolean JNICALL Java_qml_Bridge_isAutoReloadEnabled
   (JNIEnv* env, jclass cls);
 
+/**
+ * Snapshot of runtime metrics (counters, gauges, latency histograms) as JSON.
+ *
+ * JNI signature: ()Ljava/lang/String;
+ * Java: public static native String getMetrics()
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getMetrics
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Reset counters and histograms.
+ *
+ * JNI signature: ()V
+ * Java: public static native void resetMetrics()
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_resetMetrics
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Enable or disable span tracing.
+ *
+ * JNI signature: (Z)V
+ * Java: public static native void setTracingEnabled(boolean enabled)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setTracingEnabled
+  (JNIEnv* env, jclass cls, jboolean enabled);
+
+/**
+ * Check if span tracing is enabled.
+ *
+ * JNI signature: ()Z
+ * Java: public static native boolean isTracingEnabled()
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isTracingEnabled
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Open a span on the calling thread.
+ *
+ * JNI signature: (Ljava/lang/String;Ljava/lang/String;)V
+ * Java: public static native void traceBegin(String name, String category)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_traceBegin
+  (JNIEnv* env, jclass cls, jstring name, jstring category);
+
+/**
+ * Close the innermost span on the calling thread.
+ *
+ * JNI signature: ()V
+ * Java: public static native void traceEnd()
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_traceEnd
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Name the calling thread in the trace.
+ *
+ * JNI signature: (Ljava/lang/String;)V
+ * Java: public static native void setTraceThreadName(String name)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setTraceThreadName
+  (JNIEnv* env, jclass cls, jstring name);
+
+/**
+ * Write buffered spans as Chrome trace JSON.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean dumpTrace(String path)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_dumpTrace
+  (JNIEnv* env, jclass cls, jstring path);
+
+/**
+ * Drop all buffered spans.
+ *
+ * JNI signature: ()V
+ * Java: public static native void clearTrace()
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_clearTrace
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Set the runtime log level for all cuirq.* categories.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean setLogLevel(String level)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setLogLevel
+  (JNIEnv* env, jclass cls, jstring level);
+
+/**
+ * Get the runtime log level.
+ *
+ * JNI signature: ()Ljava/lang/String;
+ * Java: public static native String getLogLevel()
+ */
+JNIEXPORT jstring JNICALL Java_qml_Bridge_getLogLevel
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Apply QLoggingCategory filter rules on top of the log level.
+ *
+ * JNI signature: (Ljava/lang/String;)V
+ * Java: public static native void setLogFilterRules(String rules)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setLogFilterRules
+  (JNIEnv* env, jclass cls, jstring rules);
+
+/**
+ * Start or stop the GUI-thread stall watchdog.
+ *
+ * JNI signature: (JZ)V
+ * Java: public static native void setStallWatchdog(long thresholdMs, boolean captureJavaStack)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setStallWatchdog
+  (JNIEnv* env, jclass cls, jlong thresholdMs, jboolean captureJavaStack);
+
+/**
+ * Register the stall report callback.
+ *
+ * JNI signature: (Lqml/Bridge$StallHandler;)V
+ * Java: public static native void setStallHandler(StallHandler handler)
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_setStallHandler
+  (JNIEnv* env, jclass cls, jobject handler);
+
+/**
+ * Start recording bridge traffic to a binary log.
+ *
+ * JNI signature: (Ljava/lang/String;)Z
+ * Java: public static native boolean startRecording(String path)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_startRecording
+  (JNIEnv* env, jclass cls, jstring path);
+
+/**
+ * Stop recording.
+ *
+ * JNI signature: ()V
+ * Java: public static native void stopRecording()
+ */
+JNIEXPORT void JNICALL Java_qml_Bridge_stopRecording
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Check if recording is active.
+ *
+ * JNI signature: ()Z
+ * Java: public static native boolean isRecording()
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_isRecording
+  (JNIEnv* env, jclass cls);
+
+/**
+ * Show or hide the performance HUD overlay.
+ *
+ * JNI signature: (Z)Z
+ * Java: public static native boolean setPerfHudVisible(boolean visible)
+ */
+JNIEXPORT jboolean JNICALL Java_qml_Bridge_setPerfHudVisible
+  (JNIEnv* env, jclass cls, jboolean visible);
+
 } // extern "C"
 
 #endif // QMLBRIDGE_H
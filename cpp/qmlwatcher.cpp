@@ -1,5 +1,7 @@
 #include "qmlwatcher.h"
-#include <QDebug>
+#include "metrics.h"
+#include "log.h"
+#include "recorder.h"
 #include <QUrl>
 #include <QQmlContext>
 #include <QTimer>
@@ -10,7 +12,7 @@ QmlWatcher::QmlWatcher(QQmlApplicationEngine* engine, QObject *parent)
     , m_watcher(new QFileSystemWatcher(this))
     , m_autoReload(true)
 {
-    qDebug() << "[CPP] QmlWatcher created";
+    qCDebug(lcWatcher) << "QmlWatcher created";
 
     // Connect file change signal
     connect(m_watcher, &QFileSystemWatcher::fileChanged,
@@ -19,52 +21,62 @@ QmlWatcher::QmlWatcher(QQmlApplicationEngine* engine, QObject *parent)
 
 QmlWatcher::~QmlWatcher()
 {
-    qDebug() << "[CPP] QmlWatcher destroyed";
+    qCDebug(lcWatcher) << "QmlWatcher destroyed";
 }
 
 void QmlWatcher::watchFile(const QString& filePath)
 {
-    qDebug() << "[CPP] QmlWatcher: Starting to watch" << filePath;
+    qCDebug(lcWatcher) << "Starting to watch" << filePath;
 
     if (m_watcher->files().contains(filePath)) {
-        qDebug() << "[CPP] QmlWatcher: Already watching" << filePath;
+        qCDebug(lcWatcher) << "Already watching" << filePath;
         return;
     }
 
     if (!m_watcher->addPath(filePath)) {
-        qWarning() << "[CPP] QmlWatcher: Failed to watch" << filePath;
+        qCWarning(lcWatcher) << "Failed to watch" << filePath;
         return;
     }
 
     m_currentQmlPath = filePath;
-    qDebug() << "[CPP] QmlWatcher: Now watching" << filePath;
+    qCDebug(lcWatcher) << "Now watching" << filePath;
 }
 
 void QmlWatcher::unwatchFile(const QString& filePath)
 {
-    qDebug() << "[CPP] QmlWatcher: Stopping watch on" << filePath;
+    qCDebug(lcWatcher) << "Stopping watch on" << filePath;
     m_watcher->removePath(filePath);
 }
 
 void QmlWatcher::setAutoReload(bool enabled)
 {
     m_autoReload = enabled;
-    qDebug() << "[CPP] QmlWatcher: Auto-reload" << (enabled ? "enabled" : "disabled");
+    qCInfo(lcWatcher) << "Auto-reload" << (enabled ? "enabled" : "disabled");
+}
+
+void QmlWatcher::reload()
+{
+    if (m_currentQmlPath.isEmpty()) {
+        qCWarning(lcWatcher) << "Nothing to reload (no file watched yet)";
+        return;
+    }
+
+    reloadQml(m_currentQmlPath);
 }
 
 void QmlWatcher::onFileChanged(const QString& path)
 {
-    qDebug() << "[CPP] QmlWatcher: File changed:" << path;
+    qCInfo(lcWatcher) << "File changed" << path;
 
     if (!m_autoReload) {
-        qDebug() << "[CPP] QmlWatcher: Auto-reload disabled, ignoring change";
+        qCDebug(lcWatcher) << "Auto-reload disabled, ignoring change";
         return;
     }
 
     // QFileSystemWatcher sometimes stops watching after a change
     // Re-add the path to continue watching
     if (!m_watcher->files().contains(path)) {
-        qDebug() << "[CPP] QmlWatcher: Re-adding watch for" << path;
+        qCDebug(lcWatcher) << "Re-adding watch for" << path;
         m_watcher->addPath(path);
     }
 
@@ -78,47 +90,62 @@ void QmlWatcher::onFileChanged(const QString& path)
 void QmlWatcher::reloadQml(const QString& path)
 {
     if (!m_engine) {
-        qWarning() << "[CPP] QmlWatcher: No engine available for reload";
+        qCWarning(lcWatcher) << "No engine available for reload";
         return;
     }
 
-    qDebug() << "[CPP] QmlWatcher: ========================================";
-    qDebug() << "[CPP] QmlWatcher: RELOADING QML";
-    qDebug() << "[CPP] QmlWatcher: ========================================";
+    static Counter& reloads = Metrics::counter("watcher.reloads");
+    static Counter& failures = Metrics::counter("watcher.reload_failures");
+    static Histogram& reloadTime = Metrics::histogram("watcher.reload_ns");
+    static Gauge& lastReload = Metrics::gauge("watcher.last_reload_us");
+    reloads.add();
+    ScopedTimer timer(reloadTime);
+    CUIRQ_TRACE_SCOPE("reload", "watcher");
+    if (!m_reloadDetail || path != m_reloadPath) {
+        m_reloadPath = path;
+        m_reloadDetail = Trace::intern(path.toUtf8());
+    }
+    GuiOperation::Scope operation("reload", m_reloadDetail);
+    CUIRQ_RECORD(Recorder::ReloadQml, path);
+
+    qCInfo(lcWatcher) << "Reloading QML" << path;
 
     // Step 1: Save current context properties (to preserve state)
-    qDebug() << "[CPP] QmlWatcher: [1/5] Saving context properties...";
+    qCDebug(lcWatcher) << "[1/5] Saving context properties...";
     saveContextProperties();
 
     // Step 2: Delete old root objects (to close existing windows)
-    qDebug() << "[CPP] QmlWatcher: [2/5] Closing old windows...";
+    qCDebug(lcWatcher) << "[2/5] Closing old windows...";
     QList<QObject*> oldRoots = m_engine->rootObjects();
     for (QObject* obj : oldRoots) {
-        qDebug() << "[CPP] QmlWatcher: Deleting old root object:" << obj;
+        qCDebug(lcWatcher) << "Deleting old root object" << obj;
         obj->deleteLater();
     }
 
     // Step 3: Clear component cache
-    qDebug() << "[CPP] QmlWatcher: [3/5] Clearing component cache...";
+    qCDebug(lcWatcher) << "[3/5] Clearing component cache...";
     m_engine->clearComponentCache();
 
     // Step 4: Reload QML
-    qDebug() << "[CPP] QmlWatcher: [4/5] Reloading QML from:" << path;
-    m_engine->load(QUrl::fromLocalFile(path));
+    qCDebug(lcWatcher) << "[4/5] Reloading QML from" << path;
+    {
+        CUIRQ_TRACE_SCOPE("load", "watcher");
+        m_engine->load(QUrl::fromLocalFile(path));
+    }
 
     if (m_engine->rootObjects().isEmpty()) {
-        qWarning() << "[CPP] QmlWatcher: Failed to reload QML!";
-        qWarning() << "[CPP] QmlWatcher: Check QML file for syntax errors";
+        qCWarning(lcWatcher) << "Failed to reload QML! Check QML file for syntax errors";
+        failures.add();
+        lastReload.set(static_cast<qint64>(timer.elapsedNs() / 1000));
         return;
     }
 
     // Step 5: Restore context properties (they persist automatically in Qt)
-    qDebug() << "[CPP] QmlWatcher: [5/5] Context properties restored";
+    qCDebug(lcWatcher) << "[5/5] Context properties restored";
     restoreContextProperties();
 
-    qDebug() << "[CPP] QmlWatcher: ========================================";
-    qDebug() << "[CPP] QmlWatcher: RELOAD COMPLETE";
-    qDebug() << "[CPP] QmlWatcher: ========================================";
+    lastReload.set(static_cast<qint64>(timer.elapsedNs() / 1000));
+    qCInfo(lcWatcher) << "Reload complete";
 }
 
 void QmlWatcher::saveContextProperties()
@@ -130,12 +157,12 @@ void QmlWatcher::saveContextProperties()
 
     // For now, this is a placeholder. In practice, context properties
     // set via setContextProperty() persist across load() calls.
-    qDebug() << "[CPP] QmlWatcher: Context properties preserved (Qt handles this)";
+    qCDebug(lcWatcher) << "Context properties preserved (Qt handles this)";
 }
 
 void QmlWatcher::restoreContextProperties()
 {
     // Context properties are automatically preserved by Qt
     // when we call load() without destroying the engine.
-    qDebug() << "[CPP] QmlWatcher: Context properties restored automatically";
+    qCDebug(lcWatcher) << "Context properties restored automatically";
 }
@@ -31,6 +31,9 @@ public:
     void setAutoReload(bool enabled);
     bool isAutoReloadEnabled() const { return m_autoReload; }
 
+    // Reload the most recently watched QML file immediately
+    void reload();
+
 private slots:
     void onFileChanged(const QString& path);
 
@@ -39,6 +42,8 @@ private:
     QFileSystemWatcher* m_watcher;
     bool m_autoReload;
     QString m_currentQmlPath;
+    QString m_reloadPath;                       // Last reloaded path, and its
+    const char* m_reloadDetail = nullptr;       // interned GuiOperation detail
     QMap<QString, QVariant> m_savedProperties; // For preserving state during reload
 
     void reloadQml(const QString& path);
@@ -0,0 +1,165 @@
+#include "rangeset.h"
+
+#include <algorithm>
+
+void RangeSet::append(QVector<Range>& out, int begin, int end)
+{
+    if (begin >= end) {
+        return;
+    }
+    // Ranges arrive sorted by begin; merge overlapping and touching ones
+    if (!out.isEmpty() && begin <= out.last().end) {
+        out.last().end = std::max(out.last().end, end);
+    } else {
+        out.append(Range{ begin, end });
+    }
+}
+
+void RangeSet::assign(QVector<Range>&& ranges)
+{
+    m_ranges = std::move(ranges);
+    m_count = 0;
+    for (const Range& r : std::as_const(m_ranges)) {
+        m_count += r.end - r.begin;
+    }
+}
+
+void RangeSet::insert(int begin, int end)
+{
+    if (begin >= end) {
+        return;
+    }
+    QVector<Range> out;
+    out.reserve(m_ranges.size() + 1);
+    bool placed = false;
+    for (const Range& r : std::as_const(m_ranges)) {
+        if (!placed && begin <= r.begin) {
+            append(out, begin, end);
+            placed = true;
+        }
+        append(out, r.begin, r.end);
+    }
+    if (!placed) {
+        append(out, begin, end);
+    }
+    assign(std::move(out));
+}
+
+void RangeSet::remove(int begin, int end)
+{
+    if (begin >= end) {
+        return;
+    }
+    QVector<Range> out;
+    out.reserve(m_ranges.size() + 1);
+    for (const Range& r : std::as_const(m_ranges)) {
+        if (r.end <= begin || r.begin >= end) {
+            out.append(r);
+            continue;
+        }
+        if (r.begin < begin) {
+            out.append(Range{ r.begin, begin });
+        }
+        if (r.end > end) {
+            out.append(Range{ end, r.end });
+        }
+    }
+    assign(std::move(out));
+}
+
+void RangeSet::toggle(int begin, int end)
+{
+    if (begin >= end) {
+        return;
+    }
+    // Inside [begin, end) the gaps between ranges become the new ranges
+    QVector<Range> out;
+    out.reserve(m_ranges.size() + 2);
+    int cursor = begin;
+    for (const Range& r : std::as_const(m_ranges)) {
+        if (r.end <= begin) {
+            append(out, r.begin, r.end);
+            continue;
+        }
+        if (r.begin >= end) {
+            append(out, cursor, end);
+            cursor = end;
+            append(out, r.begin, r.end);
+            continue;
+        }
+        append(out, r.begin, begin);
+        append(out, cursor, std::max(r.begin, begin));
+        cursor = std::max(cursor, std::min(r.end, end));
+        append(out, end, r.end);
+    }
+    append(out, cursor, end);
+    assign(std::move(out));
+}
+
+bool RangeSet::contains(int row) const
+{
+    const auto it = std::upper_bound(m_ranges.cbegin(), m_ranges.cend(), row,
+                                     [](int value, const Range& r) { return value < r.begin; });
+    return it != m_ranges.cbegin() && row < std::prev(it)->end;
+}
+
+void RangeSet::insertRows(int at, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    QVector<Range> out;
+    out.reserve(m_ranges.size() + 1);
+    for (const Range& r : std::as_const(m_ranges)) {
+        if (r.end <= at) {
+            out.append(r);
+        } else if (r.begin >= at) {
+            out.append(Range{ r.begin + count, r.end + count });
+        } else {
+            // The new rows split this range
+            out.append(Range{ r.begin, at });
+            out.append(Range{ at + count, r.end + count });
+        }
+    }
+    m_ranges = std::move(out);
+}
+
+void RangeSet::removeRows(int at, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    remove(at, at + count);
+    QVector<Range> out;
+    out.reserve(m_ranges.size());
+    for (const Range& r : std::as_const(m_ranges)) {
+        if (r.begin >= at + count) {
+            append(out, r.begin - count, r.end - count);
+        } else {
+            append(out, r.begin, r.end);
+        }
+    }
+    m_ranges = std::move(out);
+}
+
+void RangeSet::moveRows(int from, int count, int to)
+{
+    if (count <= 0 || (to >= from && to <= from + count)) {
+        return;
+    }
+    // Ranges of the moved block, relative to its first row
+    QVector<Range> moved;
+    for (const Range& r : std::as_const(m_ranges)) {
+        const int begin = std::max(r.begin, from);
+        const int end = std::min(r.end, from + count);
+        if (begin < end) {
+            moved.append(Range{ begin - from, end - from });
+        }
+    }
+    removeRows(from, count);
+    const int at = to > from ? to - count : to;
+    insertRows(at, count);
+    for (const Range& r : std::as_const(moved)) {
+        insert(at + r.begin, at + r.end);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef RANGESET_H
+#define RANGESET_H
+
+#include <QVector>
+
+/**
+ * RangeSet - Set of rows stored as sorted, disjoint, non-adjacent ranges.
+ *
+ * Memory and the cost of every edit grow with the number of ranges, not
+ * with the number of rows: selecting 200k contiguous rows is one range.
+ * Edits rebuild the range list in one pass; membership is a binary search.
+ *
+ * Row inserts and removals shift the ranges after them, so the set can
+ * follow the rows of a model.
+ */
+class RangeSet
+{
+public:
+    struct Range
+    {
+        int begin;  // First row
+        int end;    // One past the last row
+    };
+
+    void clear() { m_ranges.clear(); m_count = 0; }
+
+    // Add, remove or flip the rows in [begin, end)
+    void insert(int begin, int end);
+    void remove(int begin, int end);
+    void toggle(int begin, int end);
+
+    bool contains(int row) const;
+    bool isEmpty() const { return m_ranges.isEmpty(); }
+    int count() const { return m_count; }  // Rows in the set
+    const QVector<Range>& ranges() const { return m_ranges; }
+
+    // Follow model rows: open a gap of unselected rows / close one / move
+    // `count` rows from `from` to before row `to` (Qt's beginMoveRows terms)
+    void insertRows(int at, int count);
+    void removeRows(int at, int count);
+    void moveRows(int from, int count, int to);
+
+private:
+    static void append(QVector<Range>& out, int begin, int end);
+    void assign(QVector<Range>&& ranges);
+
+    QVector<Range> m_ranges;
+    int m_count = 0;
+};
+
+#endif // RANGESET_H
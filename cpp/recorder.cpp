@@ -0,0 +1,269 @@
+#include "recorder.h"
+#include "log.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <chrono>
+#include <memory>
+
+std::atomic<bool> Recorder::s_recording{false};
+
+namespace {
+
+constexpr char kMagic[8] = { 'C', 'U', 'I', 'R', 'Q', 'R', 'E', 'C' };
+
+struct RecorderState
+{
+    QMutex mutex;
+    std::unique_ptr<QFile> file;
+    std::chrono::steady_clock::time_point lastRecord;
+    quint64 records = 0;
+};
+
+RecorderState& state()
+{
+    static RecorderState* instance = new RecorderState();
+    return *instance;
+}
+
+void appendVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+void appendString(QByteArray& out, const QString& value)
+{
+    const QByteArray utf8 = value.toUtf8();
+    appendVarint(out, static_cast<quint64>(utf8.size()));
+    out.append(utf8);
+}
+
+void writeRecord(Recorder::RecordType type, const QByteArray& payload)
+{
+    RecorderState& st = state();
+    QMutexLocker lock(&st.mutex);
+    if (!st.file) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(now - st.lastRecord).count();
+    st.lastRecord = now;
+
+    QByteArray header;
+    header.append(static_cast<char>(type));
+    appendVarint(header, static_cast<quint64>(qMax<qint64>(0, deltaUs)));
+    appendVarint(header, static_cast<quint64>(payload.size()));
+
+    st.file->write(header);
+    st.file->write(payload);
+    ++st.records;
+}
+
+} // namespace
+
+bool Recorder::start(const QString& path)
+{
+    RecorderState& st = state();
+    QMutexLocker lock(&st.mutex);
+
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(lcBridge) << "Recorder: Cannot write" << path;
+        return false;
+    }
+
+    const quint32 version = kVersion;
+    QByteArray header(kMagic, sizeof(kMagic));
+    for (int i = 0; i < 4; ++i) {
+        header.append(static_cast<char>((version >> (8 * i)) & 0xff));
+    }
+    file->write(header);
+
+    if (st.file) {
+        st.file->close();
+    }
+    st.file = std::move(file);
+    st.lastRecord = std::chrono::steady_clock::now();
+    st.records = 0;
+    s_recording.store(true, std::memory_order_relaxed);
+
+    qCInfo(lcBridge) << "Recorder: Recording bridge calls to" << path;
+    return true;
+}
+
+void Recorder::stop()
+{
+    RecorderState& st = state();
+    QMutexLocker lock(&st.mutex);
+
+    s_recording.store(false, std::memory_order_relaxed);
+    if (!st.file) {
+        return;
+    }
+
+    st.file->close();
+    qCInfo(lcBridge) << "Recorder: Wrote" << st.records << "records to" << st.file->fileName();
+    st.file.reset();
+}
+
+void Recorder::record(RecordType type, const QStringList& fields)
+{
+    QByteArray payload;
+    for (const QString& field : fields) {
+        appendString(payload, field);
+    }
+    writeRecord(type, payload);
+}
+
+void Recorder::recordSignal(const QString& signalName, const QStringList& args)
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    QByteArray payload;
+    appendString(payload, signalName);
+    appendVarint(payload, static_cast<quint64>(args.size()));
+    for (const QString& arg : args) {
+        appendString(payload, arg);
+    }
+    writeRecord(EmitSignal, payload);
+}
+
+// ---------------------------------------------------------------------------
+// RecordingReader
+// ---------------------------------------------------------------------------
+
+bool RecordingReader::open(const QString& path)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QStringLiteral("cannot open ") + path;
+        return false;
+    }
+
+    const QByteArray header = m_file.read(sizeof(kMagic) + 4);
+    if (header.size() != sizeof(kMagic) + 4 || !header.startsWith(QByteArray(kMagic, sizeof(kMagic)))) {
+        m_error = QStringLiteral("not a cuirq recording");
+        return false;
+    }
+
+    quint32 version = 0;
+    for (int i = 0; i < 4; ++i) {
+        version |= static_cast<quint32>(static_cast<quint8>(header[sizeof(kMagic) + i])) << (8 * i);
+    }
+    if (version != Recorder::kVersion) {
+        m_error = QStringLiteral("unsupported recording version %1").arg(version);
+        return false;
+    }
+
+    m_timestampUs = 0;
+    return true;
+}
+
+bool RecordingReader::readVarint(quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        char byte;
+        if (!m_file.getChar(&byte)) {
+            return false;
+        }
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RecordingReader::readVarint(const QByteArray& payload, int& pos, quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= payload.size()) {
+            return false;
+        }
+        const char byte = payload[pos++];
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RecordingReader::readString(const QByteArray& payload, int& pos, QString& value)
+{
+    quint64 size = 0;
+    if (!readVarint(payload, pos, size) || size > static_cast<quint64>(payload.size() - pos)) {
+        return false;
+    }
+    value = QString::fromUtf8(payload.constData() + pos, static_cast<int>(size));
+    pos += static_cast<int>(size);
+    return true;
+}
+
+bool RecordingReader::next(RecordedCall& call)
+{
+    for (;;) {
+        char type;
+        if (!m_file.getChar(&type)) {
+            return false;  // Clean end of file
+        }
+
+        quint64 deltaUs = 0;
+        quint64 size = 0;
+        if (!readVarint(deltaUs) || !readVarint(size)) {
+            m_error = QStringLiteral("truncated record header");
+            return false;
+        }
+        const QByteArray payload = m_file.read(static_cast<qint64>(size));
+        if (static_cast<quint64>(payload.size()) != size) {
+            m_error = QStringLiteral("truncated record payload");
+            return false;
+        }
+        m_timestampUs += static_cast<qint64>(deltaUs);
+
+        const auto recordType = static_cast<Recorder::RecordType>(static_cast<quint8>(type));
+        if (recordType < Recorder::SetProperty || recordType > Recorder::ApplyStatePatch) {
+            continue;  // Written by a newer bridge: skip
+        }
+
+        call.type = recordType;
+        call.timestampUs = m_timestampUs;
+        call.fields.clear();
+        call.args.clear();
+
+        int pos = 0;
+        QString value;
+        if (recordType == Recorder::EmitSignal) {
+            quint64 count = 0;
+            if (!readString(payload, pos, value) || !readVarint(payload, pos, count)) {
+                m_error = QStringLiteral("corrupt signal record");
+                return false;
+            }
+            call.fields << value;
+            for (quint64 i = 0; i < count; ++i) {
+                if (!readString(payload, pos, value)) {
+                    m_error = QStringLiteral("corrupt signal record");
+                    return false;
+                }
+                call.args << value;
+            }
+        } else {
+            while (pos < payload.size()) {
+                if (!readString(payload, pos, value)) {
+                    m_error = QStringLiteral("corrupt record");
+                    return false;
+                }
+                call.fields << value;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * Recorder - Captures bridge traffic into a compact binary log.
+ *
+ * While recording, every state set/patch, model create/data/clear/patch/destroy,
+ * signal emit, QML load and hot-reload is appended with its timestamp. The log can be
+ * fed back into StateObject/JvmListModel and a QML scene by cuirq_replay
+ * (no JVM needed) to turn a captured session into a repeatable benchmark.
+ *
+ * File format (all integers little-endian / LEB128 varints):
+ *   header:  "CUIRQREC" | u32 version
+ *   record:  u8 type | varint deltaUs (since previous record)
+ *            | varint payloadSize | payload
+ *   payload: sequence of strings (varint byte length + UTF-8 bytes);
+ *            string lists are a varint count followed by the strings
+ *
+ * Readers skip records with unknown types using payloadSize, so new
+ * record types can be added without bumping the version.
+ *
+ * Cost when not recording is one relaxed atomic load per call site.
+ */
+class Recorder
+{
+public:
+    enum RecordType : quint8 {
+        SetProperty = 1,       // name, value
+        CreateModel = 2,       // model
+        SetModelData = 3,      // model, json
+        ClearModel = 4,        // model
+        EmitSignal = 5,        // signal, args[]
+        LoadQml = 6,           // path
+        ReloadQml = 7,         // path
+        DestroyModel = 8,      // model
+        SetModelKey = 9,       // model, role
+        PatchModel = 10,       // model, json [[key, role, value], ...]
+        ApplyModelPatch = 11,  // model, json (RFC 6902)
+        ApplyStatePatch = 12   // json (RFC 6902)
+    };
+
+    static constexpr quint32 kVersion = 1;
+
+    static bool isRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+    // Start writing to path (truncates); returns false if the file cannot be opened
+    static bool start(const QString& path);
+
+    // Flush and close the log
+    static void stop();
+
+    // Append a record (no-op unless recording)
+    static void record(RecordType type, const QStringList& fields);
+    static void recordSignal(const QString& signalName, const QStringList& args);
+
+private:
+    static std::atomic<bool> s_recording;
+};
+
+/**
+ * One decoded record.
+ */
+struct RecordedCall
+{
+    Recorder::RecordType type;
+    qint64 timestampUs;        // Since the start of the recording
+    QStringList fields;        // Per-type fields, see RecordType
+    QStringList args;          // EmitSignal arguments
+};
+
+/**
+ * Sequential reader for recordings written by Recorder.
+ */
+class RecordingReader
+{
+public:
+    bool open(const QString& path);
+
+    // Next known record; false at end of file or on a truncated/corrupt record
+    bool next(RecordedCall& call);
+
+    QString errorString() const { return m_error; }
+
+private:
+    bool readVarint(quint64& value);
+    static bool readVarint(const QByteArray& payload, int& pos, quint64& value);
+    static bool readString(const QByteArray& payload, int& pos, QString& value);
+
+    QFile m_file;
+    qint64 m_timestampUs = 0;
+    QString m_error;
+};
+
+// Record a bridge call when recording is on; fields are only built then
+#define CUIRQ_RECORD(type, ...) \
+    do { \
+        if (Recorder::isRecording()) { \
+            Recorder::record(type, QStringList{ __VA_ARGS__ }); \
+        } \
+    } while (0)
+
+#endif // RECORDER_H
@@ -0,0 +1,107 @@
+#include "rowstore.h"
+
+#include <algorithm>
+
+int RowStore::chunkOf(int row) const
+{
+    const auto it = std::upper_bound(m_starts.cbegin(), m_starts.cend(), row);
+    return static_cast<int>(it - m_starts.cbegin()) - 1;
+}
+
+void RowStore::reindex(int fromChunk)
+{
+    m_starts.resize(m_chunks.size());
+    for (int c = std::max(fromChunk, 0); c < m_chunks.size(); ++c) {
+        m_starts[c] = c == 0 ? 0 : m_starts.at(c - 1) + m_chunks.at(c - 1).size();
+    }
+}
+
+const QVariantMap& RowStore::at(int row) const
+{
+    const int c = chunkOf(row);
+    return m_chunks.at(c).at(row - m_starts.at(c));
+}
+
+QVariantMap& RowStore::edit(int row)
+{
+    const int c = chunkOf(row);
+    return m_chunks[c][row - m_starts.at(c)];
+}
+
+void RowStore::reserve(int rows)
+{
+    const int chunks = (std::max(rows, 0) + kChunkRows - 1) / kChunkRows;
+    m_chunks.reserve(chunks);
+    m_starts.reserve(chunks);
+}
+
+void RowStore::append(const QVariantMap& item)
+{
+    if (m_chunks.isEmpty() || m_chunks.constLast().size() >= kChunkRows) {
+        m_chunks.append(Chunk());
+        m_starts.append(m_size);
+    }
+    m_chunks.last().append(item);
+    ++m_size;
+}
+
+void RowStore::insert(int row, const QVariantMap& item)
+{
+    if (row == m_size) {
+        append(item);
+        return;
+    }
+
+    const int c = chunkOf(row);
+    Chunk& chunk = m_chunks[c];
+    chunk.insert(row - m_starts.at(c), item);
+    ++m_size;
+
+    if (chunk.size() > 2 * kChunkRows) {
+        const int half = chunk.size() / 2;
+        const Chunk tail = chunk.mid(half);
+        chunk.resize(half);
+        chunk.squeeze();
+        m_chunks.insert(c + 1, tail);
+    }
+    reindex(c + 1);
+}
+
+void RowStore::removeAt(int row)
+{
+    const int c = chunkOf(row);
+    Chunk& chunk = m_chunks[c];
+    chunk.removeAt(row - m_starts.at(c));
+    --m_size;
+
+    // Fold a small chunk into a neighbour so the table stays short
+    if (chunk.isEmpty()) {
+        m_chunks.removeAt(c);
+    } else if (chunk.size() < kChunkRows / 4) {
+        if (c + 1 < m_chunks.size() && chunk.size() + m_chunks.at(c + 1).size() <= kChunkRows) {
+            chunk.append(m_chunks.at(c + 1));
+            m_chunks.removeAt(c + 1);
+        } else if (c > 0 && m_chunks.at(c - 1).size() + chunk.size() <= kChunkRows) {
+            m_chunks[c - 1].append(chunk);
+            m_chunks.removeAt(c);
+        }
+    }
+    reindex(c - 1);
+}
+
+void RowStore::move(int from, int to)
+{
+    if (from == to) {
+        return;
+    }
+    const QVariantMap item = at(from);
+    removeAt(from);
+    insert(to, item);
+}
+
+void RowStore::clear()
+{
+    QVector<Chunk>().swap(m_chunks);
+    QVector<int>().swap(m_starts);
+    m_size = 0;
+}
@@ -0,0 +1,63 @@
+#ifndef ROWSTORE_H
+#define ROWSTORE_H
+
+#include <QVariantMap>
+#include <QVector>
+
+/**
+ * RowStore - Chunked, copy-on-write list of model rows.
+ *
+ * Rows live in chunks of about kChunkRows, each an implicitly shared
+ * QVector, plus a table of the first row of every chunk. Copying a store
+ * shares everything and is O(1); the copy is an immutable snapshot as far
+ * as the original is concerned, and can be read from another thread while
+ * the original keeps changing. An edit detaches only what it touches: the
+ * chunk table (one pointer per chunk) and the one chunk holding the row,
+ * so it costs O(chunk + rows / chunk) when a snapshot is out and O(chunk)
+ * at most otherwise. Unchanged chunks stay shared between versions.
+ *
+ * Chunks split when they grow past twice the target and are merged into a
+ * neighbour when removals shrink them, so lookups stay a binary search
+ * over the chunk table.
+ */
+class RowStore
+{
+public:
+    static constexpr int kChunkRows = 1024;
+
+    using Chunk = QVector<QVariantMap>;
+
+    RowStore() = default;
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    const QVariantMap& at(int row) const;
+
+    // Mutable access to one row; detaches its chunk if it is shared
+    QVariantMap& edit(int row);
+    void set(int row, const QVariantMap& item) { edit(row) = item; }
+
+    // Size the chunk table for `rows` rows; chunks still grow as filled
+    void reserve(int rows);
+
+    void append(const QVariantMap& item);
+    void insert(int row, const QVariantMap& item);
+    void removeAt(int row);
+    // QList::move semantics: the row ends up at index `to`
+    void move(int from, int to);
+    void clear();
+
+    // For whole-store passes (key index, footprint, export)
+    const QVector<Chunk>& chunks() const { return m_chunks; }
+
+private:
+    int chunkOf(int row) const;
+    void reindex(int fromChunk);
+
+    QVector<Chunk> m_chunks;
+    QVector<int> m_starts;  // First row of each chunk
+    int m_size = 0;
+};
+
+#endif // ROWSTORE_H
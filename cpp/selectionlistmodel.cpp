@@ -0,0 +1,145 @@
+#include "selectionlistmodel.h"
+#include "metrics.h"
+
+#include <QJsonObject>
+#include <algorithm>
+
+SelectionListModel::SelectionListModel(QAbstractItemModel* source, QObject* parent)
+    : QIdentityProxyModel(parent)
+{
+    setSourceModel(source);
+    if (source) {
+        // Connected after the proxy's own handlers; the selection shifts
+        // before views see the change and query isSelected
+        connect(source, &QAbstractItemModel::rowsAboutToBeInserted, this, &SelectionListModel::onRowsAboutToBeInserted);
+        connect(source, &QAbstractItemModel::rowsAboutToBeRemoved, this, &SelectionListModel::onRowsAboutToBeRemoved);
+        connect(source, &QAbstractItemModel::rowsAboutToBeMoved, this, &SelectionListModel::onRowsAboutToBeMoved);
+        connect(source, &QAbstractItemModel::modelAboutToBeReset, this, &SelectionListModel::onSourceInvalidated);
+        connect(source, &QAbstractItemModel::layoutAboutToBeChanged, this, &SelectionListModel::onSourceInvalidated);
+    }
+}
+
+QVariant SelectionListModel::data(const QModelIndex& index, int role) const
+{
+    if (role == SelectedRole) {
+        return index.isValid() && m_selection.contains(index.row());
+    }
+    return QIdentityProxyModel::data(index, role);
+}
+
+QHash<int, QByteArray> SelectionListModel::roleNames() const
+{
+    QHash<int, QByteArray> names = QIdentityProxyModel::roleNames();
+    names.insert(SelectedRole, QByteArrayLiteral("isSelected"));
+    return names;
+}
+
+bool SelectionListModel::apply(Operation op, int first, int last)
+{
+    static Counter& edits = Metrics::counter("selection.edits");
+
+    const int rows = rowCount();
+    if (last < first) {
+        last = first;
+    }
+    const int begin = std::clamp(first, 0, rows);
+    const int end = std::clamp(last + 1, begin, rows);
+
+    switch (op) {
+    case Select:
+        m_selection.insert(begin, end);
+        notify(begin, end);
+        break;
+    case Deselect:
+        m_selection.remove(begin, end);
+        notify(begin, end);
+        break;
+    case Toggle:
+        m_selection.toggle(begin, end);
+        notify(begin, end);
+        break;
+    case SelectAll:
+        m_selection.clear();
+        m_selection.insert(0, rows);
+        notify(0, rows);
+        break;
+    case Clear:
+        if (!m_selection.isEmpty()) {
+            const int changedBegin = m_selection.ranges().first().begin;
+            const int changedEnd = m_selection.ranges().last().end;
+            m_selection.clear();
+            notify(changedBegin, changedEnd);
+        }
+        break;
+    case Invert:
+        m_selection.toggle(0, rows);
+        notify(0, rows);
+        break;
+    default:
+        return false;
+    }
+    edits.add();
+    return true;
+}
+
+void SelectionListModel::notify(int begin, int end)
+{
+    if (begin < end) {
+        emit dataChanged(index(begin, 0), index(end - 1, 0), { SelectedRole });
+    }
+    emit selectionChanged();
+}
+
+QVariantList SelectionListModel::selectedRanges() const
+{
+    QVariantList ranges;
+    ranges.reserve(m_selection.ranges().size());
+    for (const RangeSet::Range& r : m_selection.ranges()) {
+        ranges.append(QVariant(QVariantList{ r.begin, r.end - 1 }));
+    }
+    return ranges;
+}
+
+void SelectionListModel::onRowsAboutToBeInserted(const QModelIndex& parent, int first, int last)
+{
+    if (!parent.isValid()) {
+        m_selection.insertRows(first, last - first + 1);
+    }
+}
+
+void SelectionListModel::onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    const int before = m_selection.count();
+    m_selection.removeRows(first, last - first + 1);
+    if (m_selection.count() != before) {
+        emit selectionChanged();
+    }
+}
+
+void SelectionListModel::onRowsAboutToBeMoved(const QModelIndex& parent, int first, int last,
+                                              const QModelIndex& destination, int row)
+{
+    if (!parent.isValid() && !destination.isValid()) {
+        m_selection.moveRows(first, last - first + 1, row);
+    }
+}
+
+void SelectionListModel::onSourceInvalidated()
+{
+    if (!m_selection.isEmpty()) {
+        m_selection.clear();
+        emit selectionChanged();
+    }
+}
+
+QJsonObject SelectionListModel::statistics() const
+{
+    return QJsonObject{
+        { "rows", rowCount() },
+        { "selected", m_selection.count() },
+        { "ranges", static_cast<qint64>(m_selection.ranges().size()) }
+    };
+}
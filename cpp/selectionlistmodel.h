@@ -0,0 +1,85 @@
+#ifndef SELECTIONLISTMODEL_H
+#define SELECTIONLISTMODEL_H
+
+#include <QIdentityProxyModel>
+#include <QJsonObject>
+#include <QVariantList>
+
+#include "rangeset.h"
+
+/**
+ * SelectionListModel - A model's rows plus an `isSelected` role.
+ *
+ * Passes the source model through unchanged and keeps the selection as a
+ * RangeSet, so selecting, toggling or inverting any number of rows costs
+ * O(ranges) and answers `isSelected` without per-row storage. Each edit
+ * emits one dataChanged over the rows it touched, for the `isSelected`
+ * role only; the source is never reset.
+ *
+ * The selection follows source row inserts, removals and moves. A source
+ * reset or layout change (e.g. re-sorting) clears it, since rows no longer
+ * mean the same items.
+ *
+ * Row arguments are inclusive [first, last]; last < first means just first.
+ */
+class SelectionListModel : public QIdentityProxyModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int selectedCount READ selectedCount NOTIFY selectionChanged)
+
+public:
+    // Keep in sync with the SELECTION_* constants in Bridge.java
+    enum Operation {
+        Select,
+        Deselect,
+        Toggle,
+        SelectAll,
+        Clear,
+        Invert
+    };
+    Q_ENUM(Operation)
+
+    static constexpr int SelectedRole = Qt::UserRole + 0x10000;
+
+    explicit SelectionListModel(QAbstractItemModel* source, QObject* parent = nullptr);
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Returns false for an unknown operation
+    bool apply(Operation op, int first = 0, int last = -1);
+
+    Q_INVOKABLE bool isSelected(int row) const { return m_selection.contains(row); }
+    Q_INVOKABLE void select(int first, int last = -1) { apply(Select, first, last); }
+    Q_INVOKABLE void deselect(int first, int last = -1) { apply(Deselect, first, last); }
+    Q_INVOKABLE void toggle(int first, int last = -1) { apply(Toggle, first, last); }
+    Q_INVOKABLE void selectAll() { apply(SelectAll); }
+    Q_INVOKABLE void clearSelection() { apply(Clear); }
+    Q_INVOKABLE void invert() { apply(Invert); }
+
+    // [[first, last], ...] for QML
+    Q_INVOKABLE QVariantList selectedRanges() const;
+
+    int selectedCount() const { return m_selection.count(); }
+    const RangeSet& selection() const { return m_selection; }
+
+    // Runtime statistics: {"rows", "selected", "ranges"}
+    QJsonObject statistics() const;
+
+signals:
+    void selectionChanged();
+
+private slots:
+    void onRowsAboutToBeInserted(const QModelIndex& parent, int first, int last);
+    void onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void onRowsAboutToBeMoved(const QModelIndex& parent, int first, int last,
+                              const QModelIndex& destination, int row);
+    void onSourceInvalidated();
+
+private:
+    void notify(int begin, int end);
+
+    RangeSet m_selection;
+};
+
+#endif // SELECTIONLISTMODEL_H
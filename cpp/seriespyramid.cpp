@@ -0,0 +1,295 @@
+#include "seriespyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// Above this many points LTTB runs on min/max columns instead of raw points
+constexpr int kLttbRawLimit = 1 << 16;
+
+// Largest-Triangle-Three-Buckets over n points read through `at`
+template <typename At>
+QVector<QPointF> lttb(int n, int threshold, At at)
+{
+    QVector<QPointF> out;
+    if (threshold >= n || threshold < 3) {
+        out.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            out.append(at(i));
+        }
+        return out;
+    }
+
+    out.reserve(threshold);
+    out.append(at(0));
+    const double every = static_cast<double>(n - 2) / (threshold - 2);
+    int a = 0;
+    for (int bucket = 0; bucket < threshold - 2; ++bucket) {
+        // Average of the next bucket is the third triangle vertex
+        const int nextFirst = static_cast<int>(std::floor((bucket + 1) * every)) + 1;
+        const int nextLast = qMin(static_cast<int>(std::floor((bucket + 2) * every)) + 1, n);
+        double avgX = 0;
+        double avgY = 0;
+        for (int i = nextFirst; i < nextLast; ++i) {
+            const QPointF p = at(i);
+            avgX += p.x();
+            avgY += p.y();
+        }
+        const int span = qMax(1, nextLast - nextFirst);
+        avgX /= span;
+        avgY /= span;
+
+        const int first = static_cast<int>(std::floor(bucket * every)) + 1;
+        const int last = static_cast<int>(std::floor((bucket + 1) * every)) + 1;
+        const QPointF pa = at(a);
+        double maxArea = -1;
+        int chosen = first;
+        for (int i = first; i < last; ++i) {
+            const QPointF p = at(i);
+            const double area = std::abs((pa.x() - avgX) * (p.y() - pa.y()) - (pa.x() - p.x()) * (avgY - pa.y()));
+            if (area > maxArea) {
+                maxArea = area;
+                chosen = i;
+            }
+        }
+        out.append(at(chosen));
+        a = chosen;
+    }
+    out.append(at(n - 1));
+    return out;
+}
+
+} // namespace
+
+int SeriesPyramid::bucketSize(int level)
+{
+    // kBaseBucket and kFanout are powers of two
+    static_assert((kBaseBucket & (kBaseBucket - 1)) == 0 && (kFanout & (kFanout - 1)) == 0);
+    constexpr int kFanoutShift = kFanout == 2 ? 1 : kFanout == 4 ? 2 : kFanout == 8 ? 3 : 4;
+    return level == 0 ? 1 : kBaseBucket << (kFanoutShift * (level - 1));
+}
+
+void SeriesPyramid::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_levels.clear();
+}
+
+void SeriesPyramid::reserve(int count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+}
+
+template <typename Summary>
+void SeriesPyramid::mergePoint(Summary& summary, double y, int index)
+{
+    // NaN fails both comparisons and is skipped. Written as selects: on
+    // noisy data these branches would mispredict half the time.
+    const bool lower = y < summary.min;
+    const bool higher = y > summary.max;
+    summary.min = lower ? y : summary.min;
+    summary.minIndex = lower ? index : summary.minIndex;
+    summary.max = higher ? y : summary.max;
+    summary.maxIndex = higher ? index : summary.maxIndex;
+}
+
+// Empty buckets hold +inf / -inf and never win
+void SeriesPyramid::merge(Extent& extent, const Bucket& bucket)
+{
+    const bool lower = bucket.min < extent.min;
+    const bool higher = bucket.max > extent.max;
+    extent.min = lower ? bucket.min : extent.min;
+    extent.minIndex = lower ? bucket.minIndex : extent.minIndex;
+    extent.max = higher ? bucket.max : extent.max;
+    extent.maxIndex = higher ? bucket.maxIndex : extent.maxIndex;
+}
+
+void SeriesPyramid::append(const double* x, const double* y, int count)
+{
+    m_x.reserve(m_x.size() + count);
+    m_y.reserve(m_y.size() + count);
+    for (int i = 0; i < count; ++i) {
+        const int index = m_y.size();
+        m_x.append(x ? x[i] : static_cast<double>(index));
+        m_y.append(y[i]);
+
+        // Only the tail bucket of each level changes
+        for (int l = 0; l < m_levels.size(); ++l) {
+            QVector<Bucket>& level = m_levels[l];
+            const int bucket = index / bucketSize(l + 1);
+            if (bucket == level.size()) {
+                level.append(Bucket{ kInf, -kInf, -1, -1 });
+            }
+            mergePoint(level[bucket], y[i], index);
+        }
+        if (m_y.size() >= bucketSize(m_levels.size() + 1)) {
+            addLevel();
+        }
+    }
+}
+
+// Build the next level from the one below (or from raw points)
+void SeriesPyramid::addLevel()
+{
+    const int level = m_levels.size() + 1;
+    const int size = bucketSize(level);
+    QVector<Bucket> buckets((m_y.size() + size - 1) / size, Bucket{ kInf, -kInf, -1, -1 });
+    if (level == 1) {
+        for (int i = 0; i < m_y.size(); ++i) {
+            mergePoint(buckets[i / size], m_y[i], i);
+        }
+    } else {
+        const QVector<Bucket>& below = m_levels.last();
+        for (int b = 0; b < below.size(); ++b) {
+            const Bucket& child = below[b];
+            Bucket& parent = buckets[b / kFanout];
+            if (child.minIndex >= 0 && child.min < parent.min) {
+                parent.min = child.min;
+                parent.minIndex = child.minIndex;
+            }
+            if (child.maxIndex >= 0 && child.max > parent.max) {
+                parent.max = child.max;
+                parent.maxIndex = child.maxIndex;
+            }
+        }
+    }
+    m_levels.append(std::move(buckets));
+}
+
+int SeriesPyramid::lowerBound(double value) const
+{
+    return static_cast<int>(std::lower_bound(m_x.cbegin(), m_x.cend(), value) - m_x.cbegin());
+}
+
+// Galloping search from `from`: column edges are close to each other
+int SeriesPyramid::lowerBound(double value, int from, int to) const
+{
+    int step = 1;
+    int hi = from;
+    while (hi < to && m_x[hi] < value) {
+        from = hi + 1;
+        hi = qMin(to, hi + step);
+        step *= 2;
+    }
+    return static_cast<int>(std::lower_bound(m_x.cbegin() + from, m_x.cbegin() + hi, value) - m_x.cbegin());
+}
+
+SeriesPyramid::Extent SeriesPyramid::extent(int first, int last) const
+{
+    Extent result{ kInf, -kInf, -1, -1 };
+    first = qMax(0, first);
+    last = qMin(last, static_cast<int>(m_y.size()));
+
+    // Peel the unaligned ends off at each level, then continue with the
+    // aligned middle one level up: at most 2 * (kFanout - 1) units per level
+    const auto take = [&](int level, int from, int to) {
+        const int size = bucketSize(level);
+        for (int unit = from / size; unit < to / size; ++unit) {
+            if (level == 0) {
+                mergePoint(result, m_y[unit], unit);
+            } else {
+                merge(result, m_levels[level - 1][unit]);
+            }
+        }
+    };
+
+    int level = 0;
+    while (first < last) {
+        if (level == m_levels.size()) {
+            take(level, first, last);
+            break;
+        }
+        const int next = bucketSize(level + 1);
+        const int alignedFirst = (first + next - 1) & ~(next - 1);
+        const int alignedLast = last & ~(next - 1);
+        if (alignedFirst >= alignedLast) {
+            take(level, first, last);
+            break;
+        }
+        take(level, first, alignedFirst);
+        take(level, alignedLast, last);
+        first = alignedFirst;
+        last = alignedLast;
+        ++level;
+    }
+    return result;
+}
+
+QVector<QPointF> SeriesPyramid::minMaxColumns(int first, int last, double x0, double x1, int columns) const
+{
+    QVector<QPointF> out;
+    out.reserve(4 * columns + 2);
+    if (first < last) {
+        out.append(QPointF(m_x[first], m_y[first]));
+    }
+
+    // Column boundaries follow x, so irregular sampling is handled. They
+    // are snapped to buckets well below a column's width (at most 1/8 of
+    // it), so extent() mostly reads buckets instead of raw points.
+    const int perColumn = (last - first) / columns;
+    int grain = 1;
+    for (int level = 1; level <= m_levels.size() && bucketSize(level) * 8 <= perColumn; ++level) {
+        grain = bucketSize(level);
+    }
+
+    const double step = (x1 - x0) / columns;
+    int a = first + 1;
+    for (int c = 0; c < columns && a < last - 1; ++c) {
+        const int b = c == columns - 1 ? last - 1 : lowerBound(x0 + (c + 1) * step, a, last - 1) & ~(grain - 1);
+        if (b <= a) {
+            continue;
+        }
+        const Extent e = extent(a, b);
+        if (e.minIndex >= 0) {
+            const int lo = qMin(e.minIndex, e.maxIndex);
+            const int hi = qMax(e.minIndex, e.maxIndex);
+            out.append(QPointF(m_x[lo], m_y[lo]));
+            if (hi != lo) {
+                out.append(QPointF(m_x[hi], m_y[hi]));
+            }
+        }
+        a = b;
+    }
+
+    if (last - 1 > first) {
+        out.append(QPointF(m_x[last - 1], m_y[last - 1]));
+    }
+    return out;
+}
+
+QVector<QPointF> SeriesPyramid::decimateMinMax(double x0, double x1, int columns) const
+{
+    const int first = qMax(0, lowerBound(x0) - 1);
+    const int last = qMin(static_cast<int>(m_y.size()), lowerBound(x1) + 1);
+    columns = qMax(1, columns);
+
+    if (last - first <= 4 * columns) {
+        QVector<QPointF> out;
+        out.reserve(last - first);
+        for (int i = first; i < last; ++i) {
+            out.append(QPointF(m_x[i], m_y[i]));
+        }
+        return out;
+    }
+    return minMaxColumns(first, last, x0, x1, columns);
+}
+
+QVector<QPointF> SeriesPyramid::decimateLttb(double x0, double x1, int threshold) const
+{
+    const int first = qMax(0, lowerBound(x0) - 1);
+    const int last = qMin(static_cast<int>(m_y.size()), lowerBound(x1) + 1);
+    const int n = last - first;
+
+    if (n <= kLttbRawLimit) {
+        return lttb(n, threshold, [this, first](int i) { return QPointF(m_x[first + i], m_y[first + i]); });
+    }
+    // Too many points to scan per frame: keep every column's extremes first
+    const QVector<QPointF> reduced = minMaxColumns(first, last, x0, x1, qMax(1, threshold));
+    return lttb(reduced.size(), threshold, [&reduced](int i) { return reduced[i]; });
+}
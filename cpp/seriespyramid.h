@@ -0,0 +1,87 @@
+#ifndef SERIESPYRAMID_H
+#define SERIESPYRAMID_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+ * SeriesPyramid - Time series with a multi-resolution min/max pyramid.
+ *
+ * Level 1 summarizes kBaseBucket raw points per bucket, each level above
+ * summarizes kFanout buckets of the level below. A bucket keeps the min
+ * and max y and where they occur, so any index range is reduced to
+ * min/max in O(kFanout * levels) by combining the largest aligned buckets
+ * that fit inside it.
+ *
+ * Appends only touch the last bucket of each level (and add a level when
+ * the series outgrows the top one); the rest of the pyramid is untouched.
+ *
+ * x must be non-decreasing (time); NaN y values are skipped by min/max.
+ *
+ * Decimation for a plot of `columns` pixels:
+ *   - decimateMinMax: per pixel column, the min and max point in index
+ *     order (M4-style), which preserves every spike.
+ *   - decimateLttb: Largest-Triangle-Three-Buckets down to `threshold`
+ *     points; large ranges are first reduced with decimateMinMax so the
+ *     cost stays proportional to the pixel width.
+ */
+class SeriesPyramid
+{
+public:
+    static constexpr int kBaseBucket = 16;
+    static constexpr int kFanout = 4;
+
+    struct Extent
+    {
+        double min;
+        double max;
+        int minIndex;  // -1 if the range has no finite value
+        int maxIndex;
+    };
+
+    void clear();
+    void reserve(int count);
+
+    // x may be null: x is then the point index
+    void append(const double* x, const double* y, int count);
+
+    int size() const { return m_y.size(); }
+    bool isEmpty() const { return m_y.isEmpty(); }
+    double x(int index) const { return m_x[index]; }
+    double y(int index) const { return m_y[index]; }
+    int levelCount() const { return m_levels.size(); }
+
+    // First index with x >= value
+    int lowerBound(double value) const;
+
+    // Min/max of y over [first, last)
+    Extent extent(int first, int last) const;
+
+    // Points covering [x0, x1] plus one neighbour on each side
+    QVector<QPointF> decimateMinMax(double x0, double x1, int columns) const;
+    QVector<QPointF> decimateLttb(double x0, double x1, int threshold) const;
+
+private:
+    struct Bucket
+    {
+        double min;
+        double max;
+        int minIndex;
+        int maxIndex;
+    };
+
+    static int bucketSize(int level);  // level 0 = raw points
+    static void merge(Extent& extent, const Bucket& bucket);
+    template <typename Summary>  // Bucket or Extent
+    static void mergePoint(Summary& summary, double y, int index);
+
+    int lowerBound(double value, int from, int to) const;  // Within [from, to]
+    void addLevel();
+    QVector<QPointF> minMaxColumns(int first, int last, double x0, double x1, int columns) const;
+
+    QVector<double> m_x;
+    QVector<double> m_y;
+    QVector<QVector<Bucket>> m_levels;  // m_levels[i] is level i + 1
+};
+
+#endif // SERIESPYRAMID_H
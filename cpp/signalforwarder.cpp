@@ -1,6 +1,7 @@
 #include "signalforwarder.h"
-#include <QDebug>
-#include <iostream>
+#include "metrics.h"
+#include "log.h"
+#include "recorder.h"
 
 /**
  * Constructor.
@@ -14,12 +15,18 @@ SignalForwarder::SignalForwarder(JavaVM* jvm, QObject* parent)
     , m_handlerClass(nullptr)
     , m_handleMethod(nullptr)
 {
-    std::cout << "[CPP] SignalForwarder created" << std::endl;
+    qCDebug(lcSignal) << "SignalForwarder created";
+
+    // No JVM (e.g. cuirq_replay): signals are dispatched but never reach Java
+    if (m_jvm == nullptr) {
+        qCDebug(lcSignal) << "No JavaVM, Java handlers disabled";
+        return;
+    }
 
     // Get JNIEnv for current thread
     JNIEnv* env = nullptr;
     if (m_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) != JNI_OK) {
-        std::cerr << "[CPP] ERROR: Failed to get JNIEnv in SignalForwarder constructor" << std::endl;
+        qCWarning(lcSignal) << "Failed to get JNIEnv in SignalForwarder constructor";
         return;
     }
 
@@ -27,7 +34,7 @@ SignalForwarder::SignalForwarder(JavaVM* jvm, QObject* parent)
     // This is a nested interface: qml.Bridge$SignalHandler
     jclass localClass = env->FindClass("qml/Bridge$SignalHandler");
     if (localClass == nullptr) {
-        std::cerr << "[CPP] ERROR: Could not find qml.Bridge$SignalHandler class" << std::endl;
+        qCWarning(lcSignal) << "Could not find qml.Bridge$SignalHandler class";
         env->ExceptionDescribe();
         return;
     }
@@ -40,12 +47,12 @@ SignalForwarder::SignalForwarder(JavaVM* jvm, QObject* parent)
     // JNI signature: ([Ljava/lang/String;)V
     m_handleMethod = env->GetMethodID(m_handlerClass, "handle", "([Ljava/lang/String;)V");
     if (m_handleMethod == nullptr) {
-        std::cerr << "[CPP] ERROR: Could not find handle method on SignalHandler" << std::endl;
+        qCWarning(lcSignal) << "Could not find handle method on SignalHandler";
         env->ExceptionDescribe();
         return;
     }
 
-    std::cout << "[CPP] SignalForwarder initialized successfully" << std::endl;
+    qCDebug(lcSignal) << "SignalForwarder initialized successfully";
 }
 
 /**
@@ -56,18 +63,22 @@ SignalForwarder::SignalForwarder(JavaVM* jvm, QObject* parent)
  */
 SignalForwarder::~SignalForwarder()
 {
-    std::cout << "[CPP] SignalForwarder destructor called" << std::endl;
+    qCDebug(lcSignal) << "SignalForwarder destructor called";
+
+    if (m_jvm == nullptr) {
+        return;
+    }
 
     // Get JNIEnv for cleanup
     JNIEnv* env = nullptr;
     if (m_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) != JNI_OK) {
-        std::cerr << "[CPP] WARNING: Could not get JNIEnv in destructor for cleanup" << std::endl;
+        qCWarning(lcSignal) << "Could not get JNIEnv in destructor for cleanup";
         return;
     }
 
     // Delete all handler GlobalRefs
     for (auto& pair : m_handlers) {
-        env->DeleteGlobalRef(pair.second);
+        env->DeleteGlobalRef(pair.second.ref);
     }
     m_handlers.clear();
 
@@ -76,7 +87,7 @@ SignalForwarder::~SignalForwarder()
         env->DeleteGlobalRef(m_handlerClass);
     }
 
-    std::cout << "[CPP] SignalForwarder cleanup complete" << std::endl;
+    qCDebug(lcSignal) << "SignalForwarder cleanup complete";
 }
 
 /**
@@ -88,32 +99,32 @@ SignalForwarder::~SignalForwarder()
 bool SignalForwarder::registerHandler(const QString& signalName, JNIEnv* env, jobject handler)
 {
     if (handler == nullptr) {
-        std::cerr << "[CPP] ERROR: Cannot register null handler" << std::endl;
+        qCWarning(lcSignal) << "Cannot register null handler";
         return false;
     }
 
     std::string sigName = signalName.toStdString();
-    std::cout << "[CPP] Registering signal handler: " << sigName << std::endl;
+    qCDebug(lcSignal) << "Registering signal handler" << signalName;
 
     // If a handler already exists, delete the old GlobalRef first
     auto it = m_handlers.find(sigName);
     if (it != m_handlers.end()) {
-        std::cout << "[CPP] Replacing existing handler for: " << sigName << std::endl;
-        env->DeleteGlobalRef(it->second);
+        qCDebug(lcSignal) << "Replacing existing handler for" << signalName;
+        env->DeleteGlobalRef(it->second.ref);
     }
 
     // Create GlobalRef to prevent garbage collection
     // CRITICAL: Without GlobalRef, Java object may be GC'd before callback!
     jobject globalHandler = env->NewGlobalRef(handler);
     if (globalHandler == nullptr) {
-        std::cerr << "[CPP] ERROR: Failed to create GlobalRef for handler" << std::endl;
+        qCWarning(lcSignal) << "Failed to create GlobalRef for handler";
         return false;
     }
 
     // Store the GlobalRef
-    m_handlers[sigName] = globalHandler;
+    m_handlers[sigName] = Handler{ globalHandler, Trace::intern(QByteArray::fromStdString(sigName)) };
 
-    std::cout << "[CPP] Handler registered successfully: " << sigName << std::endl;
+    qCDebug(lcSignal) << "Handler registered successfully" << signalName;
     return true;
 }
 
@@ -128,17 +139,17 @@ void SignalForwarder::unregisterHandler(const QString& signalName, JNIEnv* env)
     auto it = m_handlers.find(sigName);
 
     if (it == m_handlers.end()) {
-        std::cout << "[CPP] No handler registered for: " << sigName << std::endl;
+        qCDebug(lcSignal) << "No handler registered for" << signalName;
         return;
     }
 
-    std::cout << "[CPP] Unregistering signal handler: " << sigName << std::endl;
+    qCDebug(lcSignal) << "Unregistering signal handler" << signalName;
 
     // Delete GlobalRef
-    env->DeleteGlobalRef(it->second);
+    env->DeleteGlobalRef(it->second.ref);
     m_handlers.erase(it);
 
-    std::cout << "[CPP] Handler unregistered: " << sigName << std::endl;
+    qCDebug(lcSignal) << "Handler unregistered" << signalName;
 }
 
 /**
@@ -154,11 +165,17 @@ void SignalForwarder::unregisterHandler(const QString& signalName, JNIEnv* env)
  */
 void SignalForwarder::emitSignal(const QString& signalName, const QVariantList& args)
 {
-    std::cout << "[CPP] Signal emitted: " << signalName.toStdString()
-              << " with " << args.size() << " arguments" << std::endl;
+    static Counter& emitted = Metrics::counter("signal.emitted");
+    static Histogram& dispatchTime = Metrics::histogram("signal.dispatch_ns");
+    emitted.add();
+    ScopedTimer timer(dispatchTime);
+    CUIRQ_TRACE_SCOPE_DETAIL("emitSignal", "signal", signalName.toUtf8());
+
+    qCDebug(lcSignal) << "Signal emitted" << signalName << "with" << args.size() << "arguments";
 
     // Convert QVariantList to QStringList for simplicity
     QStringList stringArgs = variantsToStrings(args);
+    Recorder::recordSignal(signalName, stringArgs);
 
     // Forward to Java handler
     callJavaHandler(signalName, stringArgs);
@@ -178,10 +195,13 @@ void SignalForwarder::callJavaHandler(const QString& signalName, const QStringLi
     // Check if handler is registered
     auto it = m_handlers.find(sigName);
     if (it == m_handlers.end()) {
-        std::cout << "[CPP] No handler registered for signal: " << sigName << std::endl;
+        qCDebug(lcSignal) << "No handler registered for signal" << signalName;
         return;
     }
 
+    // Attribute GUI stalls inside the handler to this signal
+    GuiOperation::Scope operation("signal", it->second.operation);
+
     // Get JNIEnv for current thread
     // Note: JavaVM is thread-safe; JNIEnv is thread-local
     JNIEnv* env = nullptr;
@@ -190,38 +210,49 @@ void SignalForwarder::callJavaHandler(const QString& signalName, const QStringLi
     if (result == JNI_EDETACHED) {
         // Thread not attached to JVM - attach it
         // This can happen if Qt calls us from a non-JVM thread
-        std::cout << "[CPP] Attaching thread to JVM..." << std::endl;
+        qCDebug(lcSignal) << "Attaching thread to JVM...";
         result = m_jvm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr);
         if (result != JNI_OK) {
-            std::cerr << "[CPP] ERROR: Failed to attach thread to JVM" << std::endl;
+            qCWarning(lcSignal) << "Failed to attach thread to JVM";
             return;
         }
     } else if (result != JNI_OK) {
-        std::cerr << "[CPP] ERROR: Failed to get JNIEnv" << std::endl;
+        qCWarning(lcSignal) << "Failed to get JNIEnv";
         return;
     }
 
+    static Counter& bytesOut = Metrics::counter("jni.bytes_out");
+    static Counter& handlerErrors = Metrics::counter("signal.handler_errors");
+    static Histogram& handlerTime = Metrics::histogram("signal.handler_ns");
+
     // Convert QStringList to Java String[]
     jclass stringClass = env->FindClass("java/lang/String");
     jobjectArray javaArgs = env->NewObjectArray(args.size(), stringClass, nullptr);
 
     for (int i = 0; i < args.size(); ++i) {
-        jstring jstr = env->NewStringUTF(args[i].toUtf8().constData());
+        QByteArray utf8 = args[i].toUtf8();
+        bytesOut.add(utf8.size());
+        jstring jstr = env->NewStringUTF(utf8.constData());
         env->SetObjectArrayElement(javaArgs, i, jstr);
         env->DeleteLocalRef(jstr);  // Clean up local reference
     }
 
     // Call handler.handle(String[] args)
-    std::cout << "[CPP] Calling Java handler for: " << sigName << std::endl;
-    env->CallVoidMethod(it->second, m_handleMethod, javaArgs);
+    qCTrace(lcSignal) << "Calling Java handler for" << signalName;
+    {
+        ScopedTimer timer(handlerTime);
+        CUIRQ_TRACE_SCOPE("javaHandler", "jvm");
+        env->CallVoidMethod(it->second.ref, m_handleMethod, javaArgs);
+    }
 
     // Check for Java exceptions
     if (env->ExceptionCheck()) {
-        std::cerr << "[CPP] ERROR: Exception occurred in Java handler!" << std::endl;
+        handlerErrors.add();
+        qCWarning(lcSignal) << "Exception occurred in Java handler!";
         env->ExceptionDescribe();
         env->ExceptionClear();
     } else {
-        std::cout << "[CPP] Java handler completed successfully" << std::endl;
+        qCTrace(lcSignal) << "Java handler completed successfully";
     }
 
     // Clean up
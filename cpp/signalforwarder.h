@@ -101,9 +101,17 @@ private:
     // JavaVM is thread-safe and persistent; JNIEnv is thread-local
     JavaVM* m_jvm;
 
-    // Map of signal name → Java handler (GlobalRef)
+    // Java handler (GlobalRef) plus the signal name interned for the
+    // GuiOperation marker, so dispatch doesn't intern per signal
+    struct Handler
+    {
+        jobject ref;
+        const char* operation;
+    };
+
+    // Map of signal name → Java handler
     // GlobalRef keeps Java objects alive across JNI calls
-    std::unordered_map<std::string, jobject> m_handlers;
+    std::unordered_map<std::string, Handler> m_handlers;
 
     // Cached method IDs for performance
     // Method lookup is expensive; cache once and reuse
@@ -0,0 +1,211 @@
+#include "spatialindex.h"
+
+namespace {
+
+constexpr qreal kInitialRootSize = 1024.0;
+constexpr int kMaxLevels = 96;  // Bounded by the query stack in forEachIntersecting
+
+} // namespace
+
+SpatialIndex::SpatialIndex(int leafCapacity, int maxDepth)
+    : m_leafCapacity(qMax(1, leafCapacity))
+    , m_maxDepth(qBound(1, maxDepth, kMaxLevels / 2))
+{
+}
+
+void SpatialIndex::clear()
+{
+    m_nodes.clear();
+    m_items.clear();
+    m_root = -1;
+}
+
+// Inclusive edges: unlike QRectF::contains, zero-sized rects are fine
+bool SpatialIndex::covers(const QRectF& outer, const QRectF& inner)
+{
+    return outer.left() <= inner.left() && inner.right() <= outer.right()
+        && outer.top() <= inner.top() && inner.bottom() <= outer.bottom();
+}
+
+bool SpatialIndex::overlaps(const QRectF& a, const QRectF& b)
+{
+    return a.left() <= b.right() && b.left() <= a.right()
+        && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+QRectF SpatialIndex::rect(int id) const
+{
+    if (!m_items.contains(id)) {
+        return QRectF();
+    }
+    const Location location = m_items.value(id);
+    return m_nodes[location.node].entries[location.slot].rect;
+}
+
+void SpatialIndex::insert(int id, const QRectF& rect)
+{
+    const QRectF r = rect.normalized();
+    if (m_items.contains(id)) {
+        // Still belongs to the same quadrant: update in place
+        const Location location = m_items.value(id);
+        Node& node = m_nodes[location.node];
+        if (covers(node.bounds, r) && (node.isLeaf() || childFor(node, r) < 0)) {
+            node.entries[location.slot].rect = r;
+            return;
+        }
+        unlink(id);
+    }
+    place(id, r);
+}
+
+bool SpatialIndex::remove(int id)
+{
+    if (!m_items.contains(id)) {
+        return false;
+    }
+    unlink(id);
+    return true;
+}
+
+QVector<int> SpatialIndex::at(const QPointF& point) const
+{
+    QVector<int> result;
+    forEachIntersecting(QRectF(point, QSizeF(0, 0)), [&result](int id) { result.append(id); });
+    return result;
+}
+
+QVector<int> SpatialIndex::intersecting(const QRectF& area) const
+{
+    QVector<int> result;
+    forEachIntersecting(area.normalized(), [&result](int id) { result.append(id); });
+    return result;
+}
+
+QVector<int> SpatialIndex::insidePolygon(const QPolygonF& lasso) const
+{
+    QVector<int> result;
+    if (lasso.size() < 3) {
+        return result;
+    }
+    forEachIntersecting(lasso.boundingRect(), [&](int id) {
+        const Location location = m_items.value(id);
+        const QPointF center = m_nodes[location.node].entries[location.slot].rect.center();
+        if (lasso.containsPoint(center, Qt::OddEvenFill)) {
+            result.append(id);
+        }
+    });
+    return result;
+}
+
+int SpatialIndex::childFor(const Node& node, const QRectF& rect) const
+{
+    for (int child : node.children) {
+        if (covers(m_nodes[child].bounds, rect)) {
+            return child;
+        }
+    }
+    return -1;
+}
+
+void SpatialIndex::growToCover(const QRectF& rect)
+{
+    if (m_root < 0) {
+        const QPointF center = rect.center();
+        const qreal size = qMax(kInitialRootSize, qMax(rect.width(), rect.height()) * 2);
+        m_nodes.emplace_back(QRectF(center.x() - size / 2, center.y() - size / 2, size, size), 0);
+        m_root = 0;
+        return;
+    }
+
+    // Double the root towards the rect until it fits; the old root becomes a quadrant
+    while (!covers(m_nodes[m_root].bounds, rect) && m_nodes[m_root].depth > m_maxDepth - kMaxLevels + 1) {
+        const QRectF old = m_nodes[m_root].bounds;
+        const bool growLeft = rect.left() < old.left();
+        const bool growUp = rect.top() < old.top();
+        const QRectF grown(growLeft ? old.left() - old.width() : old.left(),
+                           growUp ? old.top() - old.height() : old.top(),
+                           old.width() * 2, old.height() * 2);
+
+        const int oldRoot = m_root;
+        const int depth = m_nodes[oldRoot].depth - 1;
+        m_nodes.emplace_back(grown, depth);
+        const int newRoot = static_cast<int>(m_nodes.size()) - 1;
+
+        // Quadrants: 0 top-left, 1 top-right, 2 bottom-left, 3 bottom-right
+        const int oldQuadrant = (growLeft ? 1 : 0) + (growUp ? 2 : 0);
+        for (int q = 0; q < 4; ++q) {
+            if (q == oldQuadrant) {
+                m_nodes[newRoot].children[q] = oldRoot;
+                continue;
+            }
+            const QRectF bounds(grown.left() + (q & 1) * old.width(), grown.top() + (q >> 1) * old.height(),
+                                old.width(), old.height());
+            m_nodes.emplace_back(bounds, depth + 1);
+            m_nodes[newRoot].children[q] = static_cast<int>(m_nodes.size()) - 1;
+        }
+        m_root = newRoot;
+    }
+}
+
+void SpatialIndex::place(int id, const QRectF& rect)
+{
+    growToCover(rect);
+
+    int index = m_root;
+    for (;;) {
+        Node& node = m_nodes[index];
+        if (node.isLeaf()) {
+            if (static_cast<int>(node.entries.size()) < m_leafCapacity || node.depth >= m_maxDepth) {
+                break;
+            }
+            split(index);
+        }
+        const int child = childFor(m_nodes[index], rect);
+        if (child < 0) {
+            break;  // Straddles a split line (or lies outside a capped root)
+        }
+        index = child;
+    }
+    link(id, rect, index);
+}
+
+void SpatialIndex::split(int nodeIndex)
+{
+    const QRectF b = m_nodes[nodeIndex].bounds;
+    const qreal w = b.width() / 2;
+    const qreal h = b.height() / 2;
+    const int depth = m_nodes[nodeIndex].depth + 1;
+    for (int q = 0; q < 4; ++q) {
+        m_nodes.emplace_back(QRectF(b.left() + (q & 1) * w, b.top() + (q >> 1) * h, w, h), depth);
+        m_nodes[nodeIndex].children[q] = static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    // Push down every entry that fits a quadrant
+    const QVector<Entry> entries = std::move(m_nodes[nodeIndex].entries);
+    m_nodes[nodeIndex].entries.clear();
+    for (const Entry& entry : entries) {
+        const int child = childFor(m_nodes[nodeIndex], entry.rect);
+        link(entry.id, entry.rect, child < 0 ? nodeIndex : child);
+    }
+}
+
+void SpatialIndex::link(int id, const QRectF& rect, int nodeIndex)
+{
+    QVector<Entry>& entries = m_nodes[nodeIndex].entries;
+    m_items.insert(id, Location{ nodeIndex, static_cast<int>(entries.size()) });
+    entries.append(Entry{ rect, id });
+}
+
+void SpatialIndex::unlink(int id)
+{
+    const Location location = m_items.take(id);
+    QVector<Entry>& entries = m_nodes[location.node].entries;
+
+    // Swap-remove, then fix the slot of the entry that moved
+    const int last = static_cast<int>(entries.size()) - 1;
+    if (location.slot != last) {
+        entries[location.slot] = entries[last];
+        m_items[entries[location.slot].id].slot = location.slot;
+    }
+    entries.removeLast();
+}
@@ -0,0 +1,123 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QHash>
+#include <QPolygonF>
+#include <QRectF>
+#include <QVector>
+#include <vector>
+
+/**
+ * SpatialIndex - Incremental quadtree over item bounding rects.
+ *
+ * Each item lives in the deepest quadrant that fully contains its rect
+ * (items straddling a split line stay in the parent), so updates never
+ * duplicate entries. Leaves split once they hold more than leafCapacity
+ * items; the root grows outward when an item lands outside it.
+ *
+ * Moves are cheap: an item whose new rect still belongs to the same
+ * quadrant is updated in place, otherwise it is unlinked (swap-remove)
+ * and re-inserted from the root.
+ *
+ * Point and rectangle queries visit only quadrants overlapping the query;
+ * polygon (lasso) queries filter the candidates of the polygon's bounding
+ * rect by item center.
+ *
+ * Not thread-safe: owned and used by one thread (the GUI thread for
+ * NodeCanvas).
+ */
+class SpatialIndex
+{
+public:
+    explicit SpatialIndex(int leafCapacity = 16, int maxDepth = 16);
+
+    void clear();
+
+    // Insert id, or move it if already present
+    void insert(int id, const QRectF& rect);
+    bool remove(int id);
+
+    bool contains(int id) const { return m_items.contains(id); }
+    QRectF rect(int id) const;
+    int size() const { return m_items.size(); }
+
+    // Ids whose rect contains point / overlaps area / has its center in lasso
+    QVector<int> at(const QPointF& point) const;
+    QVector<int> intersecting(const QRectF& area) const;
+    QVector<int> insidePolygon(const QPolygonF& lasso) const;
+
+    // Visit ids overlapping area without building a result vector
+    template <typename Visitor>
+    void forEachIntersecting(const QRectF& area, Visitor&& visit) const;
+
+private:
+    // Rects are stored next to their ids so queries scan contiguous memory
+    struct Entry
+    {
+        QRectF rect;
+        int id;
+    };
+
+    struct Node
+    {
+        QRectF bounds;
+        int depth;
+        int children[4] = { -1, -1, -1, -1 };
+        QVector<Entry> entries;
+
+        Node(const QRectF& b, int d) : bounds(b), depth(d) {}
+        bool isLeaf() const { return children[0] < 0; }
+    };
+
+    // Where an id is stored
+    struct Location
+    {
+        int node;
+        int slot;  // Position in m_nodes[node].entries
+    };
+
+    static bool covers(const QRectF& outer, const QRectF& inner);
+    static bool overlaps(const QRectF& a, const QRectF& b);
+
+    int childFor(const Node& node, const QRectF& rect) const;
+    void growToCover(const QRectF& rect);
+    void place(int id, const QRectF& rect);
+    void split(int nodeIndex);
+    void link(int id, const QRectF& rect, int nodeIndex);
+    void unlink(int id);
+
+    int m_leafCapacity;
+    int m_maxDepth;
+    int m_root = -1;
+    std::vector<Node> m_nodes;
+    QHash<int, Location> m_items;
+};
+
+template <typename Visitor>
+void SpatialIndex::forEachIntersecting(const QRectF& area, Visitor&& visit) const
+{
+    if (m_root < 0) {
+        return;
+    }
+    // Depth-first: at most three pending siblings per level
+    int stack[3 * 96 + 1];
+    int top = 0;
+    stack[top++] = m_root;
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        for (const Entry& entry : node.entries) {
+            if (overlaps(entry.rect, area)) {
+                visit(entry.id);
+            }
+        }
+        if (!node.isLeaf()) {
+            for (int child : node.children) {
+                if (overlaps(m_nodes[child].bounds, area)) {
+                    stack[top++] = child;
+                }
+            }
+        }
+    }
+}
+
+#endif // SPATIALINDEX_H
@@ -0,0 +1,304 @@
+#include "stallwatchdog.h"
+#include "metrics.h"
+#include "trace.h"
+#include "log.h"
+#include <QMetaObject>
+#include <QString>
+#include <chrono>
+#include <string>
+
+StallWatchdog::StallWatchdog(JavaVM* jvm, QObject* parent)
+    : QObject(parent)
+    , m_jvm(jvm)
+    , m_heartbeat(new QTimer(this))
+{
+    // Constructed on the GUI thread (from Bridge.initialize)
+    GuiOperation::markGuiThread();
+    connect(m_heartbeat, &QTimer::timeout, this, &StallWatchdog::beat);
+
+    // Keep the GUI thread's java.lang.Thread for stack capture
+    JNIEnv* env = nullptr;
+    if (m_jvm && m_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) == JNI_OK) {
+        jclass threadClass = env->FindClass("java/lang/Thread");
+        jmethodID currentThread = threadClass
+            ? env->GetStaticMethodID(threadClass, "currentThread", "()Ljava/lang/Thread;")
+            : nullptr;
+        if (currentThread) {
+            jobject thread = env->CallStaticObjectMethod(threadClass, currentThread);
+            m_guiJavaThread = env->NewGlobalRef(thread);
+            env->DeleteLocalRef(thread);
+        }
+        if (env->ExceptionCheck()) {
+            env->ExceptionClear();
+        }
+        env->DeleteLocalRef(threadClass);
+    }
+
+    qCDebug(lcWatchdog) << "StallWatchdog created";
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    stop();
+
+    JNIEnv* env = nullptr;
+    if (m_jvm && m_jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) == JNI_OK) {
+        if (m_handler) {
+            env->DeleteGlobalRef(m_handler);
+        }
+        if (m_guiJavaThread) {
+            env->DeleteGlobalRef(m_guiJavaThread);
+        }
+    }
+}
+
+void StallWatchdog::start(int thresholdMs, bool captureJavaStack)
+{
+    if (thresholdMs <= 0) {
+        stop();
+        return;
+    }
+
+    m_thresholdMs.store(thresholdMs, std::memory_order_relaxed);
+    m_captureStack.store(captureJavaStack, std::memory_order_relaxed);
+
+    // A few heartbeats per threshold, so timer jitter never looks like a stall
+    const int interval = qBound(5, thresholdMs / 4, 250);
+    QMetaObject::invokeMethod(this, [this, interval]() {
+        m_heartbeat->start(interval);
+    });
+
+    if (m_running.exchange(true, std::memory_order_acq_rel)) {
+        qCInfo(lcWatchdog) << "Threshold changed to" << thresholdMs << "ms";
+        return;
+    }
+
+    // Not armed until the event loop delivers the first heartbeat
+    m_lastBeatNs.store(0, std::memory_order_release);
+    m_lastStallNs.store(0, std::memory_order_relaxed);
+    m_thread = std::thread(&StallWatchdog::watchLoop, this);
+
+    qCInfo(lcWatchdog) << "Watching GUI thread, threshold" << thresholdMs << "ms"
+                       << (captureJavaStack ? "(with Java stacks)" : "");
+}
+
+void StallWatchdog::stop()
+{
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_all();
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    QMetaObject::invokeMethod(this, [this]() {
+        m_heartbeat->stop();
+    });
+
+    qCInfo(lcWatchdog) << "Stopped";
+}
+
+void StallWatchdog::setHandler(JNIEnv* env, jobject handler)
+{
+    jmethodID onStall = nullptr;
+    if (handler) {
+        jclass handlerClass = env->FindClass("qml/Bridge$StallHandler");
+        if (handlerClass == nullptr) {
+            qCWarning(lcWatchdog) << "Could not find qml.Bridge$StallHandler class";
+            env->ExceptionDescribe();
+            return;
+        }
+        onStall = env->GetMethodID(handlerClass, "onStall",
+                                   "(Ljava/lang/String;Ljava/lang/String;JZLjava/lang/String;)V");
+        env->DeleteLocalRef(handlerClass);
+        if (onStall == nullptr) {
+            qCWarning(lcWatchdog) << "Could not find onStall method on StallHandler";
+            env->ExceptionDescribe();
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_handler) {
+        env->DeleteGlobalRef(m_handler);
+    }
+    m_handler = handler ? env->NewGlobalRef(handler) : nullptr;
+    m_onStallMethod = onStall;
+}
+
+/**
+ * Heartbeat (GUI thread).
+ *
+ * Also measures the gap since the previous beat, which is the precise
+ * length of a stall once the event loop gets control back.
+ */
+void StallWatchdog::beat()
+{
+    const qint64 now = Trace::nowNs();
+    const qint64 previous = m_lastBeatNs.exchange(now, std::memory_order_acq_rel);
+    const qint64 thresholdNs = static_cast<qint64>(m_thresholdMs.load(std::memory_order_relaxed)) * 1000000;
+
+    if (previous != 0 && now - previous > thresholdNs) {
+        qint64 longest = m_lastStallNs.load(std::memory_order_relaxed);
+        while (now - previous > longest
+               && !m_lastStallNs.compare_exchange_weak(longest, now - previous, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+void StallWatchdog::watchLoop()
+{
+    static Counter& stalls = Metrics::counter("watchdog.stalls");
+    static Histogram& stallTime = Metrics::histogram("watchdog.stall_ns");
+
+    JNIEnv* env = nullptr;
+    if (m_jvm) {
+        JavaVMAttachArgs args{ JNI_VERSION_1_8, const_cast<char*>("cuirq-watchdog"), nullptr };
+        if (m_jvm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env), &args) != JNI_OK) {
+            qCWarning(lcWatchdog) << "Failed to attach watchdog thread to JVM; stalls are only logged";
+            env = nullptr;
+        }
+    }
+    Trace::setThreadName(QStringLiteral("cuirq-watchdog"));
+
+    bool stalled = false;
+    GuiOperation::Snapshot stalledOp;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running.load(std::memory_order_acquire)) {
+        const int thresholdMs = m_thresholdMs.load(std::memory_order_relaxed);
+        m_wake.wait_for(lock, std::chrono::milliseconds(qBound(5, thresholdMs / 4, 250)), [this]() {
+            return !m_running.load(std::memory_order_acquire);
+        });
+        if (!m_running.load(std::memory_order_acquire)) {
+            break;
+        }
+        lock.unlock();
+
+        const qint64 lastBeat = m_lastBeatNs.load(std::memory_order_acquire);
+        const qint64 gap = Trace::nowNs() - lastBeat;
+        const qint64 thresholdNs = static_cast<qint64>(thresholdMs) * 1000000;
+
+        if (lastBeat != 0 && !stalled && gap > thresholdNs) {
+            // Stall in progress: attribute it while the operation is still running
+            stalled = true;
+            stalledOp = GuiOperation::current();
+            stalls.add();
+            if (stalledOp.name) {
+                Metrics::counter((std::string("watchdog.stalls.") + stalledOp.name).c_str()).add();
+            }
+            Trace::instant("stall", "watchdog", stalledOp.name);
+
+            qCWarning(lcWatchdog) << "GUI thread stalled for" << gap / 1000000 << "ms in"
+                                  << (stalledOp.name ? stalledOp.name : "event loop")
+                                  << (stalledOp.detail ? stalledOp.detail : "");
+
+            if (env && env->PushLocalFrame(16) == JNI_OK) {
+                jstring stack = m_captureStack.load(std::memory_order_relaxed) ? captureGuiStack(env) : nullptr;
+                report(env, stalledOp, gap, false, stack);
+                env->PopLocalFrame(nullptr);
+            }
+        } else if (stalled && gap <= thresholdNs) {
+            // Heartbeats resumed: the GUI thread measured the exact gap
+            stalled = false;
+            const qint64 duration = qMax(m_lastStallNs.exchange(0, std::memory_order_relaxed), thresholdNs);
+            stallTime.record(static_cast<quint64>(duration));
+
+            qCWarning(lcWatchdog) << "GUI thread recovered after" << duration / 1000000 << "ms in"
+                                  << (stalledOp.name ? stalledOp.name : "event loop");
+
+            if (env && env->PushLocalFrame(16) == JNI_OK) {
+                report(env, stalledOp, duration, true, nullptr);
+                env->PopLocalFrame(nullptr);
+            }
+        }
+
+        lock.lock();
+    }
+    lock.unlock();
+
+    if (env) {
+        m_jvm->DetachCurrentThread();
+    }
+}
+
+void StallWatchdog::report(JNIEnv* env, const GuiOperation::Snapshot& op, qint64 durationNs,
+                           bool recovered, jstring stack)
+{
+    jobject handler = nullptr;
+    jmethodID onStall = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_handler) {
+            handler = env->NewLocalRef(m_handler);
+            onStall = m_onStallMethod;
+        }
+    }
+    if (handler == nullptr) {
+        return;
+    }
+
+    jstring operation = env->NewStringUTF(op.name ? op.name : "event-loop");
+    jstring detail = op.detail ? env->NewStringUTF(op.detail) : nullptr;
+
+    env->CallVoidMethod(handler, onStall, operation, detail,
+                        static_cast<jlong>(durationNs / 1000000),
+                        recovered ? JNI_TRUE : JNI_FALSE, stack);
+
+    if (env->ExceptionCheck()) {
+        qCWarning(lcWatchdog) << "Exception occurred in Java stall handler!";
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+    }
+}
+
+/**
+ * Java stack of the GUI thread, one frame per line (nullptr if unavailable).
+ *
+ * If the GUI thread is blocked in a Clojure handler this shows the
+ * handler's frames; if it is in native code, the innermost frame is the
+ * Bridge native that was called.
+ */
+jstring StallWatchdog::captureGuiStack(JNIEnv* env)
+{
+    if (m_guiJavaThread == nullptr) {
+        return nullptr;
+    }
+
+    jclass threadClass = env->FindClass("java/lang/Thread");
+    jclass frameClass = env->FindClass("java/lang/StackTraceElement");
+    if (threadClass == nullptr || frameClass == nullptr) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+    jmethodID getStackTrace = env->GetMethodID(threadClass, "getStackTrace",
+                                               "()[Ljava/lang/StackTraceElement;");
+    jmethodID toString = env->GetMethodID(frameClass, "toString", "()Ljava/lang/String;");
+
+    jobjectArray frames = static_cast<jobjectArray>(env->CallObjectMethod(m_guiJavaThread, getStackTrace));
+    if (env->ExceptionCheck() || frames == nullptr) {
+        env->ExceptionClear();
+        return nullptr;
+    }
+
+    std::string text;
+    const jsize count = env->GetArrayLength(frames);
+    for (jsize i = 0; i < count; ++i) {
+        jobject frame = env->GetObjectArrayElement(frames, i);
+        jstring line = static_cast<jstring>(env->CallObjectMethod(frame, toString));
+        if (line) {
+            const char* chars = env->GetStringUTFChars(line, nullptr);
+            text.append("\tat ").append(chars).append("\n");
+            env->ReleaseStringUTFChars(line, chars);
+            env->DeleteLocalRef(line);
+        }
+        env->DeleteLocalRef(frame);
+    }
+
+    return env->NewStringUTF(text.c_str());
+}
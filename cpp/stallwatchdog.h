@@ -0,0 +1,73 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include "guioperation.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QtGlobal>
+#include <jni.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * StallWatchdog - Detects GUI-thread stalls and reports what caused them.
+ *
+ * A QTimer on the GUI thread stamps a heartbeat; a background thread
+ * checks it. When no heartbeat arrives within the threshold, the watchdog:
+ *   - Reads the GuiOperation marker (e.g. "setModelData" or "signal" +
+ *     signal name)
+ *   - Optionally captures the Java stack of the GUI thread
+ *   - Logs a warning, counts "watchdog.stalls" (and per operation), and
+ *     calls the JVM StallHandler with recovered=false
+ * When heartbeats resume, the total stall time is recorded in
+ * "watchdog.stall_ns" and the handler is called again with recovered=true.
+ *
+ * The handler is invoked on the watchdog thread, never on the stalled
+ * GUI thread, so it must be thread-safe and must not call back into Qt.
+ */
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StallWatchdog(JavaVM* jvm, QObject* parent = nullptr);
+    ~StallWatchdog() override;
+
+    // Start monitoring (thresholdMs <= 0 stops). Safe to call from any thread.
+    void start(int thresholdMs, bool captureJavaStack);
+    void stop();
+
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // JVM callback: qml.Bridge$StallHandler (nullptr to remove)
+    void setHandler(JNIEnv* env, jobject handler);
+
+private:
+    void beat();
+    void watchLoop();
+    void report(JNIEnv* env, const GuiOperation::Snapshot& op, qint64 durationNs,
+                bool recovered, jstring stack);
+    jstring captureGuiStack(JNIEnv* env);
+
+    JavaVM* m_jvm;
+    QTimer* m_heartbeat;
+
+    std::atomic<qint64> m_lastBeatNs{0};
+    std::atomic<qint64> m_lastStallNs{0};   // Longest heartbeat gap over the threshold
+    std::atomic<int> m_thresholdMs{0};
+    std::atomic<bool> m_captureStack{false};
+    std::atomic<bool> m_running{false};
+
+    std::thread m_thread;
+    std::mutex m_mutex;               // Guards m_handler and the wakeup
+    std::condition_variable m_wake;
+    jobject m_handler = nullptr;      // GlobalRef to StallHandler
+    jmethodID m_onStallMethod = nullptr;
+
+    jobject m_guiJavaThread = nullptr;  // GlobalRef to the GUI thread's java.lang.Thread
+};
+
+#endif // STALLWATCHDOG_H
@@ -1,15 +1,18 @@
 #include "stateobject.h"
-#include <QDebug>
+#include "log.h"
+#include "jsonpatch.h"
+
+#include <QSet>
 
 StateObject::StateObject(QObject *parent)
     : QQmlPropertyMap(this, parent)
 {
-    qDebug() << "[CPP] StateObject created (QQmlPropertyMap)";
+    qCDebug(lcState) << "StateObject created (QQmlPropertyMap)";
 }
 
 StateObject::~StateObject()
 {
-    qDebug() << "[CPP] StateObject destroyed";
+    qCDebug(lcState) << "StateObject destroyed";
 }
 
 void StateObject::setProp(const QString& name, const QVariant& value)
@@ -17,7 +20,7 @@ void StateObject::setProp(const QString& name, const QVariant& value)
     // QQmlPropertyMap::insert() automatically emits valueChanged signal
     // which QML will detect and update bindings
     insert(name, value);
-    qDebug() << "[CPP] StateObject: Property" << name << "=" << value << "(signal emitted)";
+    qCTrace(lcState) << "Property" << name << "=" << value << "(signal emitted)";
 }
 
 QVariant StateObject::getProp(const QString& name) const
@@ -29,3 +32,60 @@ bool StateObject::hasProp(const QString& name) const
 {
     return contains(name);
 }
+
+bool StateObject::applyJsonPatch(const QJsonArray& patch, QString* error)
+{
+    QVector<JsonPatch::Operation> ops;
+    if (!JsonPatch::parse(patch, &ops, error)) {
+        qCWarning(lcState) << "Rejected JSON patch:" << (error ? *error : QString());
+        return false;
+    }
+
+    // Stage only the properties the patch reads or writes, as one object
+    QVariantMap staged;
+    QSet<QString> written;
+    for (const JsonPatch::Operation& op : std::as_const(ops)) {
+        for (const QStringList* path : { &op.path, &op.from }) {
+            if (!path->isEmpty() && !staged.contains(path->first()) && contains(path->first())) {
+                staged.insert(path->first(), value(path->first()));
+            }
+        }
+        if (op.type != JsonPatch::Operation::Test && !op.path.isEmpty()) {
+            written.insert(op.path.first());
+        }
+        if (op.type == JsonPatch::Operation::Move && !op.from.isEmpty()) {
+            written.insert(op.from.first());
+        }
+    }
+
+    QVariant document(staged);
+    for (int i = 0; i < ops.size(); ++i) {
+        const JsonPatch::Operation& op = ops.at(i);
+        const bool needsFrom = op.type == JsonPatch::Operation::Move || op.type == JsonPatch::Operation::Copy;
+        QString reason;
+        if (op.path.isEmpty() || (needsFrom && op.from.isEmpty())) {
+            reason = QStringLiteral("paths must start with a property name");
+        } else if (JsonPatch::apply(document, op, &reason)) {
+            continue;
+        }
+        const QString message = JsonPatch::describe(i, op, reason);
+        qCWarning(lcState) << "Rejected JSON patch:" << message;
+        if (error) {
+            *error = message;
+        }
+        return false;
+    }
+
+    // Commit; QQmlPropertyMap cannot drop a key, so a removed property becomes undefined
+    staged = document.toMap();
+    for (const QString& name : std::as_const(written)) {
+        const auto it = staged.constFind(name);
+        if (it != staged.cend()) {
+            insert(name, *it);
+        } else if (contains(name)) {
+            insert(name, QVariant());
+        }
+    }
+    qCTrace(lcState) << "Patched" << written.size() << "properties with" << ops.size() << "operations";
+    return true;
+}
@@ -1,6 +1,7 @@
 #ifndef STATEOBJECT_H
 #define STATEOBJECT_H
 
+#include <QJsonArray>
 #include <QQmlPropertyMap>
 #include <QString>
 #include <QVariant>
@@ -10,6 +11,12 @@
  *
  * Uses QQmlPropertyMap which provides automatic property change notifications.
  * This is the proper Qt way to do reactive data binding with dynamic properties.
+ *
+ * applyJsonPatch() edits nested values in place of re-sending them: the
+ * first token of each RFC 6902 path is a property ("/user/name"). The
+ * patch runs against copies of the properties it writes, which are only
+ * stored once every operation has succeeded, so QML sees one valueChanged
+ * per written property or nothing at all.
  */
 class StateObject : public QQmlPropertyMap
 {
@@ -27,6 +34,10 @@ public:
 
     // Check if property exists
     Q_INVOKABLE bool hasProp(const QString& name) const;
+
+    // Apply an RFC 6902 JSON Patch atomically; on failure nothing changes
+    // and `error` names the operation that failed
+    bool applyJsonPatch(const QJsonArray& patch, QString* error = nullptr);
 };
 
 #endif // STATEOBJECT_H
@@ -0,0 +1,693 @@
+#include "strokecanvas.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGRendererInterface>
+#include <QSGVertexColorMaterial>
+#include <QtQml>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr int kJoinSegments = 8;                   // Triangles per round join
+constexpr int kJoinVertices = kJoinSegments * 3;
+constexpr int kSegmentVertices = 6;                // One quad
+constexpr int kPointVertices = kJoinVertices + kSegmentVertices;
+constexpr qreal kMinPointDistance = 0.5;           // Closer points are dropped
+
+using Vertex = QSGGeometry::ColoredPoint2D;
+
+// Vertex colors are premultiplied
+void setVertex(Vertex& v, QPointF p, QRgb color)
+{
+    const int a = qAlpha(color);
+    v.set(static_cast<float>(p.x()), static_cast<float>(p.y()),
+          static_cast<uchar>(qRed(color) * a / 255), static_cast<uchar>(qGreen(color) * a / 255),
+          static_cast<uchar>(qBlue(color) * a / 255), static_cast<uchar>(a));
+}
+
+// Round join / cap: a triangle fan around the point
+void writeDisc(Vertex*& v, QPointF center, qreal radius, QRgb color)
+{
+    for (int s = 0; s < kJoinSegments; ++s) {
+        const qreal a0 = 2 * M_PI * s / kJoinSegments;
+        const qreal a1 = 2 * M_PI * (s + 1) / kJoinSegments;
+        setVertex(v[0], center, color);
+        setVertex(v[1], center + QPointF(std::cos(a0), std::sin(a0)) * radius, color);
+        setVertex(v[2], center + QPointF(std::cos(a1), std::sin(a1)) * radius, color);
+        v += 3;
+    }
+}
+
+// Segment quad extruded along its normal
+void writeSegment(Vertex*& v, QPointF from, QPointF to, qreal radius, QRgb color)
+{
+    const QPointF d = to - from;
+    const qreal length = std::hypot(d.x(), d.y());
+    const QPointF n = length > 0 ? QPointF(-d.y(), d.x()) * (radius / length) : QPointF();
+    setVertex(v[0], from + n, color);
+    setVertex(v[1], from - n, color);
+    setVertex(v[2], to + n, color);
+    setVertex(v[3], from - n, color);
+    setVertex(v[4], to - n, color);
+    setVertex(v[5], to + n, color);
+    v += kSegmentVertices;
+}
+
+QSGGeometryNode* createChunk()
+{
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), StrokeCanvas::kChunkVertices);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+    // Unused vertices stay zero: degenerate, fully transparent triangles
+    std::memset(geometry->vertexData(), 0, StrokeCanvas::kChunkVertices * sizeof(Vertex));
+
+    auto* node = new QSGGeometryNode();
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGVertexColorMaterial());
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+QRectF tileRect(quint64 key)
+{
+    const int tx = static_cast<qint32>(key >> 32);
+    const int ty = static_cast<qint32>(key & 0xffffffffu);
+    return QRectF(tx * StrokeCanvas::kTileSize, ty * StrokeCanvas::kTileSize,
+                  StrokeCanvas::kTileSize, StrokeCanvas::kTileSize);
+}
+
+// Whether segment ab passes within `margin` of rect. Tested against the
+// rect grown by the margin (Liang-Barsky clipping), which errs towards
+// yes at the corners.
+bool segmentNearRect(QPointF a, QPointF b, const QRectF& rect, qreal margin)
+{
+    const QRectF r = rect.adjusted(-margin, -margin, margin, margin);
+    const qreal dx = b.x() - a.x();
+    const qreal dy = b.y() - a.y();
+    const qreal p[4] = { -dx, dx, -dy, dy };
+    const qreal q[4] = { a.x() - r.left(), r.right() - a.x(), a.y() - r.top(), r.bottom() - a.y() };
+    qreal t0 = 0;
+    qreal t1 = 1;
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0) {
+            if (q[i] < 0) {
+                return false;  // Parallel to and outside this edge
+            }
+            continue;
+        }
+        const qreal t = q[i] / p[i];
+        if (p[i] < 0) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        if (t0 > t1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Premultiplied ARGB: fully transparent means every pixel is zero
+bool isTransparent(const QImage& image)
+{
+    for (int y = 0; y < image.height(); ++y) {
+        const auto* line = reinterpret_cast<const quint32*>(image.constScanLine(y));
+        if (std::any_of(line, line + image.width(), [](quint32 pixel) { return pixel != 0; })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+StrokeCanvas::StrokeCanvas(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    setAcceptedMouseButtons(Qt::LeftButton);
+}
+
+StrokeCanvas::~StrokeCanvas()
+{
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+}
+
+QHash<QString, StrokeCanvas*>& StrokeCanvas::registry()
+{
+    static QHash<QString, StrokeCanvas*> canvases;
+    return canvases;
+}
+
+void StrokeCanvas::registerType()
+{
+    qmlRegisterType<StrokeCanvas>("Cuirq", 1, 0, "StrokeCanvas");
+}
+
+StrokeCanvas* StrokeCanvas::find(const QString& name)
+{
+    return registry().value(name, nullptr);
+}
+
+void StrokeCanvas::setName(const QString& name)
+{
+    if (name == m_name) {
+        return;
+    }
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+    m_name = name;
+    if (!m_name.isEmpty()) {
+        registry().insert(m_name, this);
+    }
+    emit nameChanged();
+}
+
+void StrokeCanvas::setColor(const QColor& color)
+{
+    if (color == m_color) {
+        return;
+    }
+    m_color = color;
+    emit colorChanged();
+}
+
+void StrokeCanvas::setPenWidth(qreal width)
+{
+    width = qMax<qreal>(0.5, width);
+    if (qFuzzyCompare(width, m_penWidth)) {
+        return;
+    }
+    m_penWidth = width;
+    emit penWidthChanged();
+}
+
+void StrokeCanvas::setInteractive(bool interactive)
+{
+    if (interactive == m_interactive) {
+        return;
+    }
+    m_interactive = interactive;
+    setAcceptedMouseButtons(interactive ? Qt::LeftButton : Qt::NoButton);
+    emit interactiveChanged();
+}
+
+quint64 StrokeCanvas::tileKey(int tx, int ty)
+{
+    return (static_cast<quint64>(static_cast<quint32>(tx)) << 32) | static_cast<quint32>(ty);
+}
+
+// ---------------------------------------------------------------------------
+// Strokes and history
+// ---------------------------------------------------------------------------
+
+int StrokeCanvas::appendPoints(const float* xy, int count, QRgb color, qreal width, bool end)
+{
+    if (!m_drawing) {
+        beginStroke(color, width);
+    }
+    const int before = m_active.points.size();
+    for (int i = 0; i < count; ++i) {
+        addPoint(QPointF(xy[2 * i], xy[2 * i + 1]));
+    }
+    const int added = m_active.points.size() - before;
+    if (end) {
+        finishStroke();
+    }
+    return added;
+}
+
+void StrokeCanvas::startStroke(qreal x, qreal y)
+{
+    beginStroke(m_color.rgba(), m_penWidth);
+    addPoint(QPointF(x, y));
+}
+
+void StrokeCanvas::addStrokePoint(qreal x, qreal y)
+{
+    if (m_drawing) {
+        addPoint(QPointF(x, y));
+    }
+}
+
+void StrokeCanvas::endStroke()
+{
+    if (m_drawing) {
+        finishStroke();
+    }
+}
+
+void StrokeCanvas::beginStroke(QRgb color, qreal width)
+{
+    if (m_drawing) {
+        finishStroke();
+    }
+    m_active = Stroke{ {}, color, qMax<qreal>(0.5, width), QRectF() };
+    m_drawing = true;
+    m_resetLive = true;
+    emit historyChanged();
+}
+
+void StrokeCanvas::addPoint(QPointF point)
+{
+    if (!m_active.points.isEmpty()) {
+        const QPointF d = point - m_active.points.last();
+        if (std::hypot(d.x(), d.y()) < kMinPointDistance) {
+            return;
+        }
+    }
+    m_active.points.append(point);
+
+    // One pixel of slack for antialiasing
+    const qreal r = m_active.width / 2 + 1;
+    m_active.bounds = m_active.bounds.united(QRectF(point.x() - r, point.y() - r, 2 * r, 2 * r));
+    update();
+}
+
+void StrokeCanvas::finishStroke()
+{
+    m_drawing = false;
+    m_resetLive = true;
+    Stroke stroke = std::move(m_active);
+    m_active = Stroke();
+
+    // Software backend: the live stroke was painted into tiles as it went
+    const QList<quint64> liveTiles = m_liveTiles.values();
+    m_liveTiles.clear();
+
+    if (stroke.points.isEmpty()) {
+        repaintTiles(liveTiles);
+        emit historyChanged();
+        update();
+        return;
+    }
+
+    // A new stroke drops the redo history
+    for (int i = m_visible; i < m_strokes.size(); ++i) {
+        m_strokeIndex.remove(i);
+    }
+    m_strokes.resize(m_visible);
+
+    const int index = m_strokes.size();
+    m_strokeIndex.insert(index, stroke.bounds);
+    m_strokes.append(std::move(stroke));
+    m_visible = m_strokes.size();
+
+    if (liveTiles.isEmpty()) {
+        paintStroke(m_strokes[index]);
+    } else {
+        QVector<quint64> keys = tilesFor(m_strokes[index]);
+        for (quint64 key : liveTiles) {
+            if (!keys.contains(key)) {
+                keys.append(key);
+            }
+        }
+        repaintTiles(keys);
+    }
+
+    emit historyChanged();
+    emit strokeFinished(index);
+    update();
+}
+
+bool StrokeCanvas::undo()
+{
+    if (m_drawing) {
+        // Discard the stroke in progress
+        m_drawing = false;
+        m_resetLive = true;
+        m_active = Stroke();
+        repaintTiles(m_liveTiles.values());
+        m_liveTiles.clear();
+    } else if (m_visible > 0) {
+        --m_visible;
+        repaintTiles(tilesFor(m_strokes[m_visible]));
+    } else {
+        return false;
+    }
+    emit historyChanged();
+    update();
+    return true;
+}
+
+bool StrokeCanvas::redo()
+{
+    if (!canRedo()) {
+        return false;
+    }
+    paintStroke(m_strokes[m_visible]);
+    ++m_visible;
+    emit historyChanged();
+    update();
+    return true;
+}
+
+void StrokeCanvas::clear()
+{
+    m_strokes.clear();
+    m_strokeIndex.clear();
+    m_visible = 0;
+    m_drawing = false;
+    m_active = Stroke();
+    m_resetLive = true;
+
+    for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it) {
+        m_removedTiles.insert(it.key());
+    }
+    m_tiles.clear();
+    m_dirtyTiles.clear();
+    m_liveTiles.clear();
+
+    static Gauge& tiles = Metrics::gauge("stroke.tiles");
+    tiles.set(0);
+
+    emit historyChanged();
+    update();
+}
+
+// ---------------------------------------------------------------------------
+// Tiled layer
+// ---------------------------------------------------------------------------
+
+QVector<quint64> StrokeCanvas::tilesFor(const Stroke& stroke, int from) const
+{
+    // Same antialiasing slack as Stroke::bounds
+    const qreal r = stroke.width / 2 + 1;
+    const QVector<QPointF>& points = stroke.points;
+
+    QSet<quint64> keys;
+    for (int i = qMax(from, 0); i < points.size(); ++i) {
+        // The first point stands alone (a dot); later ones end a segment
+        const QPointF a = points[i > from ? i - 1 : i];
+        const QPointF b = points[i];
+        const QRectF box = QRectF(a, b).normalized().adjusted(-r, -r, r, r);
+        const int left = static_cast<int>(std::floor(box.left() / kTileSize));
+        const int right = static_cast<int>(std::floor(box.right() / kTileSize));
+        const int top = static_cast<int>(std::floor(box.top() / kTileSize));
+        const int bottom = static_cast<int>(std::floor(box.bottom() / kTileSize));
+        for (int ty = top; ty <= bottom; ++ty) {
+            for (int tx = left; tx <= right; ++tx) {
+                const quint64 key = tileKey(tx, ty);
+                if (!keys.contains(key) && segmentNearRect(a, b, tileRect(key), r)) {
+                    keys.insert(key);
+                }
+            }
+        }
+    }
+    return keys.values();
+}
+
+QImage& StrokeCanvas::tile(quint64 key)
+{
+    auto it = m_tiles.find(key);
+    if (it == m_tiles.end()) {
+        QImage image(kTileSize, kTileSize, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        it = m_tiles.insert(key, image);
+        m_removedTiles.remove(key);
+
+        static Gauge& tiles = Metrics::gauge("stroke.tiles");
+        tiles.set(m_tiles.size());
+    }
+    m_dirtyTiles.insert(key);
+    return it.value();
+}
+
+void StrokeCanvas::drawStroke(QPainter& painter, const Stroke& stroke, int from)
+{
+    painter.setPen(QPen(QColor::fromRgba(stroke.color), stroke.width, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+    if (from >= stroke.points.size() - 1) {
+        painter.drawPoint(stroke.points.last());
+        return;
+    }
+    QPainterPath path(stroke.points[from]);
+    for (int i = from + 1; i < stroke.points.size(); ++i) {
+        path.lineTo(stroke.points[i]);
+    }
+    painter.drawPath(path);
+}
+
+// Finish / redo: draw on top of what the tiles already show
+void StrokeCanvas::paintStroke(const Stroke& stroke)
+{
+    CUIRQ_TRACE_SCOPE("StrokeCanvas::paintStroke", "render");
+    for (quint64 key : tilesFor(stroke)) {
+        QPainter painter(&tile(key));
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.translate(-tileRect(key).topLeft());
+        drawStroke(painter, stroke);
+    }
+}
+
+// Undo: rebuild only the given tiles from the visible strokes overlapping
+// them; tiles left empty are dropped
+void StrokeCanvas::repaintTiles(const QVector<quint64>& keys)
+{
+    static Counter& repainted = Metrics::counter("stroke.tiles_repainted");
+    CUIRQ_TRACE_SCOPE("StrokeCanvas::repaintTiles", "render");
+
+    for (quint64 key : keys) {
+        const QRectF rect = tileRect(key);
+        QVector<int> strokes = m_strokeIndex.intersecting(rect);
+        strokes.erase(std::remove_if(strokes.begin(), strokes.end(), [this](int i) { return i >= m_visible; }),
+                      strokes.end());
+
+        // Bounds only say a stroke may cross the tile: paint aside and keep
+        // the result only if something landed on it
+        QImage image;
+        if (!strokes.isEmpty()) {
+            std::sort(strokes.begin(), strokes.end());
+            image = QImage(kTileSize, kTileSize, QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::transparent);
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.translate(-rect.topLeft());
+            for (int i : std::as_const(strokes)) {
+                drawStroke(painter, m_strokes[i]);
+            }
+            repainted.add();
+        }
+
+        if (image.isNull() || isTransparent(image)) {
+            if (m_tiles.remove(key) > 0) {
+                m_dirtyTiles.remove(key);
+                m_removedTiles.insert(key);
+            }
+            continue;
+        }
+        m_tiles.insert(key, image);
+        m_removedTiles.remove(key);
+        m_dirtyTiles.insert(key);
+    }
+
+    static Gauge& tiles = Metrics::gauge("stroke.tiles");
+    tiles.set(m_tiles.size());
+}
+
+// ---------------------------------------------------------------------------
+// Pointer input
+// ---------------------------------------------------------------------------
+
+void StrokeCanvas::mousePressEvent(QMouseEvent* event)
+{
+    if (!m_interactive || event->button() != Qt::LeftButton) {
+        event->ignore();
+        return;
+    }
+    startStroke(event->position().x(), event->position().y());
+    event->accept();
+}
+
+void StrokeCanvas::mouseMoveEvent(QMouseEvent* event)
+{
+    addStrokePoint(event->position().x(), event->position().y());
+    event->accept();
+}
+
+void StrokeCanvas::mouseReleaseEvent(QMouseEvent* event)
+{
+    addStrokePoint(event->position().x(), event->position().y());
+    endStroke();
+    event->accept();
+}
+
+void StrokeCanvas::mouseUngrabEvent()
+{
+    endStroke();
+}
+
+// ---------------------------------------------------------------------------
+// Scene graph
+// ---------------------------------------------------------------------------
+
+QSGNode* StrokeCanvas::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* /* data */)
+{
+    static Histogram& syncTime = Metrics::histogram("stroke.sync_ns");
+    ScopedTimer timer(syncTime);
+    CUIRQ_TRACE_SCOPE("StrokeCanvas::updatePaintNode", "render");
+
+    QSGNode* root = oldNode;
+    if (!root) {
+        root = new QSGNode();
+        m_structureDirty = true;
+    }
+
+    const bool software = window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+    if (m_structureDirty || software != m_software) {
+        while (QSGNode* child = root->firstChild()) {
+            root->removeChildNode(child);
+            delete child;
+        }
+        m_software = software;
+        m_tileNodes.clear();
+        m_liveChunks.clear();
+        m_removedTiles.clear();
+
+        // Tiles first so the live stroke draws over them
+        m_tileRoot = new QSGNode();
+        m_liveRoot = new QSGNode();
+        root->appendChildNode(m_tileRoot);
+        root->appendChildNode(m_liveRoot);
+        for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it) {
+            m_dirtyTiles.insert(it.key());
+        }
+        m_resetLive = true;
+        m_structureDirty = false;
+    }
+
+    if (m_resetLive) {
+        resetLive();
+        m_resetLive = false;
+    }
+    if (m_drawing) {
+        if (m_software) {
+            paintLive();
+        } else {
+            tessellate();
+        }
+    }
+    syncTiles();
+    return root;
+}
+
+void StrokeCanvas::itemChange(ItemChange change, const ItemChangeData& value)
+{
+    if (change == ItemSceneChange) {
+        m_structureDirty = true;
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void StrokeCanvas::releaseResources()
+{
+    // The scene graph is going away: node pointers die with it
+    m_tileRoot = nullptr;
+    m_liveRoot = nullptr;
+    m_tileNodes.clear();
+    m_liveChunks.clear();
+    m_structureDirty = true;
+}
+
+void StrokeCanvas::syncTiles()
+{
+    static Counter& uploads = Metrics::counter("stroke.tile_uploads");
+
+    for (quint64 key : std::as_const(m_removedTiles)) {
+        if (QSGImageNode* node = m_tileNodes.take(key)) {
+            m_tileRoot->removeChildNode(node);
+            delete node;
+        }
+    }
+    m_removedTiles.clear();
+
+    for (quint64 key : std::as_const(m_dirtyTiles)) {
+        QSGImageNode* node = m_tileNodes.value(key, nullptr);
+        if (!node) {
+            node = window()->createImageNode();
+            node->setOwnsTexture(true);
+            node->setRect(tileRect(key));
+            m_tileRoot->appendChildNode(node);
+            m_tileNodes.insert(key, node);
+        }
+        node->setTexture(window()->createTextureFromImage(m_tiles.value(key)));
+        uploads.add();
+    }
+    m_dirtyTiles.clear();
+}
+
+void StrokeCanvas::resetLive()
+{
+    for (QSGGeometryNode* chunk : std::as_const(m_liveChunks)) {
+        m_liveRoot->removeChildNode(chunk);
+        delete chunk;
+    }
+    m_liveChunks.clear();
+    m_chunkUsed = 0;
+    m_tessellated = 0;
+}
+
+// Append triangles for the points added since the last frame; only the
+// chunks written to are re-uploaded
+void StrokeCanvas::tessellate()
+{
+    const QVector<QPointF>& points = m_active.points;
+    const qreal radius = m_active.width / 2;
+    QSGGeometryNode* chunk = m_liveChunks.isEmpty() ? nullptr : m_liveChunks.last();
+    QSGGeometryNode* touched = nullptr;
+
+    for (int i = m_tessellated; i < points.size(); ++i) {
+        if (!chunk || m_chunkUsed + kPointVertices > kChunkVertices) {
+            if (touched) {
+                touched->markDirty(QSGNode::DirtyGeometry);
+            }
+            chunk = createChunk();
+            m_liveRoot->appendChildNode(chunk);
+            m_liveChunks.append(chunk);
+            m_chunkUsed = 0;
+        }
+        Vertex* v = chunk->geometry()->vertexDataAsColoredPoint2D() + m_chunkUsed;
+        Vertex* const start = v;
+        if (i > 0) {
+            writeSegment(v, points[i - 1], points[i], radius, m_active.color);
+        }
+        writeDisc(v, points[i], radius, m_active.color);
+        m_chunkUsed += static_cast<int>(v - start);
+        touched = chunk;
+    }
+    m_tessellated = points.size();
+
+    if (touched) {
+        touched->markDirty(QSGNode::DirtyGeometry);
+    }
+}
+
+// Software backend: paint the new part of the live stroke into the tiles;
+// finishStroke repaints those tiles cleanly
+void StrokeCanvas::paintLive()
+{
+    if (m_tessellated >= m_active.points.size()) {
+        return;
+    }
+    const int from = qMax(0, m_tessellated - 1);
+    for (quint64 key : tilesFor(m_active, from)) {
+        QPainter painter(&tile(key));
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.translate(-tileRect(key).topLeft());
+        drawStroke(painter, m_active, from);
+        m_liveTiles.insert(key);
+    }
+    m_tessellated = m_active.points.size();
+}
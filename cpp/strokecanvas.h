@@ -0,0 +1,179 @@
+#ifndef STROKECANVAS_H
+#define STROKECANVAS_H
+
+#include <QColor>
+#include <QHash>
+#include <QImage>
+#include <QPointF>
+#include <QQuickItem>
+#include <QRectF>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "spatialindex.h"
+
+class QPainter;
+class QSGGeometryNode;
+class QSGImageNode;
+class QSGNode;
+
+/**
+ * StrokeCanvas - Scene-graph item for freehand drawing (graphics editors).
+ *
+ * The stroke being drawn is tessellated incrementally: each frame only the
+ * segments added since the last frame are turned into triangles, appended
+ * to fixed-size geometry chunks, and only the last chunk is re-uploaded.
+ *
+ * Finished strokes are rasterized into a layer of kTileSize tiles that
+ * exist only where something was drawn. Finishing (or redoing) a stroke
+ * paints it onto the tiles it touches; undo invalidates just those tiles
+ * and repaints them from the strokes that overlap them, found through a
+ * SpatialIndex of stroke bounds. Only changed tiles are re-uploaded.
+ *
+ * Points come from pointer events (press / move / release, when
+ * interactive) or in bulk from the JVM through Bridge.appendStrokePoints.
+ *
+ * With the software backend (no custom geometry) the live stroke is
+ * painted straight into the tiles and repainted cleanly when it ends.
+ *
+ * QML:
+ *   import Cuirq 1.0
+ *   StrokeCanvas { name: "sketch"; anchors.fill: parent; color: "black"; penWidth: 3 }
+ */
+class StrokeCanvas : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(qreal penWidth READ penWidth WRITE setPenWidth NOTIFY penWidthChanged)
+    Q_PROPERTY(bool interactive READ interactive WRITE setInteractive NOTIFY interactiveChanged)
+    Q_PROPERTY(int strokeCount READ strokeCount NOTIFY historyChanged)
+    Q_PROPERTY(bool canUndo READ canUndo NOTIFY historyChanged)
+    Q_PROPERTY(bool canRedo READ canRedo NOTIFY historyChanged)
+
+public:
+    struct Stroke
+    {
+        QVector<QPointF> points;
+        QRgb color;
+        qreal width;
+        QRectF bounds;  // Including the pen
+    };
+
+    static constexpr int kTileSize = 256;
+    static constexpr int kChunkVertices = 4096;
+
+    explicit StrokeCanvas(QQuickItem* parent = nullptr);
+    ~StrokeCanvas() override;
+
+    // Register the "Cuirq 1.0 / StrokeCanvas" QML type
+    static void registerType();
+
+    // Canvas declared in QML with the given name, or nullptr
+    static StrokeCanvas* find(const QString& name);
+
+    QString name() const { return m_name; }
+    void setName(const QString& name);
+
+    QColor color() const { return m_color; }
+    void setColor(const QColor& color);
+
+    qreal penWidth() const { return m_penWidth; }
+    void setPenWidth(qreal width);
+
+    bool interactive() const { return m_interactive; }
+    void setInteractive(bool interactive);
+
+    // Visible (not undone) strokes
+    int strokeCount() const { return m_visible; }
+    bool canUndo() const { return m_visible > 0 || m_drawing; }
+    bool canRedo() const { return !m_drawing && m_visible < m_strokes.size(); }
+
+    // Append x, y pairs to the current stroke, starting one with the given
+    // style if none is in progress; finish it if `end`. Returns points added.
+    int appendPoints(const float* xy, int count, QRgb color, qreal width, bool end);
+
+    Q_INVOKABLE void startStroke(qreal x, qreal y);
+    Q_INVOKABLE void addStrokePoint(qreal x, qreal y);
+    Q_INVOKABLE void endStroke();
+
+    // Undo discards the stroke in progress, if any
+    Q_INVOKABLE bool undo();
+    Q_INVOKABLE bool redo();
+    Q_INVOKABLE void clear();
+
+signals:
+    void nameChanged();
+    void colorChanged();
+    void penWidthChanged();
+    void interactiveChanged();
+    void historyChanged();
+    void strokeFinished(int index);
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void itemChange(ItemChange change, const ItemChangeData& value) override;
+    void releaseResources() override;
+
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseUngrabEvent() override;
+
+private:
+    static QHash<QString, StrokeCanvas*>& registry();
+    static quint64 tileKey(int tx, int ty);
+
+    void beginStroke(QRgb color, qreal width);
+    void addPoint(QPointF point);
+    void finishStroke();
+
+    // Tiled layer; a stroke covers the tiles its segments (plus the pen)
+    // cross from point `from` on, not every tile in its bounding box
+    QVector<quint64> tilesFor(const Stroke& stroke, int from = 0) const;
+    QImage& tile(quint64 key);
+    void paintStroke(const Stroke& stroke);
+    void repaintTiles(const QVector<quint64>& keys);
+    static void drawStroke(QPainter& painter, const Stroke& stroke, int from = 0);
+
+    // Scene graph
+    void syncTiles();
+    void tessellate();
+    void resetLive();
+    void paintLive();  // Software backend
+
+    QString m_name;
+    QColor m_color = Qt::black;
+    qreal m_penWidth = 3.0;
+    bool m_interactive = true;
+
+    // m_strokes[0, m_visible) are shown, the rest can be redone
+    QVector<Stroke> m_strokes;
+    int m_visible = 0;
+    SpatialIndex m_strokeIndex;  // Keyed by stroke index
+
+    bool m_drawing = false;
+    Stroke m_active;
+
+    // Tiles exist only where something is drawn
+    QHash<quint64, QImage> m_tiles;
+    QSet<quint64> m_dirtyTiles;    // Need a texture upload
+    QSet<quint64> m_removedTiles;  // Emptied by undo / clear
+
+    // Pending changes, consumed by updatePaintNode
+    bool m_structureDirty = true;
+    bool m_resetLive = false;  // A stroke ended or began: drop live geometry
+
+    // Scene-graph state (only touched in updatePaintNode)
+    bool m_software = false;
+    int m_tessellated = 0;  // Points of m_active already in the live geometry
+    QSGNode* m_tileRoot = nullptr;
+    QSGNode* m_liveRoot = nullptr;
+    QHash<quint64, QSGImageNode*> m_tileNodes;
+    QVector<QSGGeometryNode*> m_liveChunks;
+    int m_chunkUsed = 0;  // Vertices written to the last live chunk
+    QSet<quint64> m_liveTiles;  // Software: tiles the live stroke was painted into
+};
+
+#endif // STROKECANVAS_H
@@ -0,0 +1,286 @@
+#include "thumbnailprovider.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QQuickTextureFactory>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <climits>
+
+namespace {
+
+QSize thumbnailBounds(const QSize& requested)
+{
+    const int w = requested.width() > 0 ? requested.width() : 0;
+    const int h = requested.height() > 0 ? requested.height() : 0;
+    if (w == 0 && h == 0) {
+        return QSize(ThumbnailProvider::kDefaultSize, ThumbnailProvider::kDefaultSize);
+    }
+    // One dimension given: bound only that one
+    return QSize(w > 0 ? w : INT_MAX, h > 0 ? h : INT_MAX);
+}
+
+QString sizeTag(const QSize& size)
+{
+    return QStringLiteral("%1x%2").arg(size.width() == INT_MAX ? 0 : size.width())
+                                  .arg(size.height() == INT_MAX ? 0 : size.height());
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ThumbnailResponse
+// ---------------------------------------------------------------------------
+
+ThumbnailResponse::ThumbnailResponse()
+    : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+QQuickTextureFactory* ThumbnailResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+void ThumbnailResponse::cancel()
+{
+    static Counter& cancelled = Metrics::counter("thumbs.cancelled");
+    if (m_finished) {
+        return;
+    }
+    m_cancelled->store(true, std::memory_order_relaxed);
+    cancelled.add();
+
+    // Qt still expects finished() from a cancelled response to clean it up
+    m_finished = true;
+    m_error = QStringLiteral("cancelled");
+    emit finished();
+}
+
+void ThumbnailResponse::deliver(const QImage& image, const QString& error)
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    m_image = image;
+    m_error = error;
+    emit finished();
+}
+
+// ---------------------------------------------------------------------------
+// ThumbnailJob
+// ---------------------------------------------------------------------------
+
+ThumbnailJob::ThumbnailJob(ThumbnailProvider* provider, const QString& path, const QSize& size,
+                           const QString& memoryKey, std::shared_ptr<std::atomic<bool>> cancelled)
+    : m_provider(provider)
+    , m_path(path)
+    , m_size(size)
+    , m_memoryKey(memoryKey)
+    , m_cancelled(std::move(cancelled))
+{
+}
+
+void ThumbnailJob::run()
+{
+    static Counter& diskHits = Metrics::counter("thumbs.disk_hits");
+    static Counter& misses = Metrics::counter("thumbs.misses");
+    static Counter& errors = Metrics::counter("thumbs.errors");
+    static Histogram& decodeTime = Metrics::histogram("thumbs.decode_ns");
+    static Gauge& pending = Metrics::gauge("thumbs.pending");
+
+    struct PendingGuard {
+        ~PendingGuard() { pending.add(-1); }
+    } guard;
+
+    // Scrolled away while queued: skip the work entirely
+    if (m_cancelled->load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    CUIRQ_TRACE_SCOPE("thumbnail", "image");
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errors.add();
+        emit done(QImage(), QStringLiteral("cannot open ") + m_path);
+        return;
+    }
+    // Read once: the same bytes are hashed for the disk cache and decoded on a miss
+    QByteArray contents = file.readAll();
+    file.close();
+
+    const QString cacheDir = m_provider->cacheDir();
+    QString cachePath;
+    if (!cacheDir.isEmpty()) {
+        const QByteArray hash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1).toHex();
+        cachePath = cacheDir + QLatin1Char('/') + QString::fromLatin1(hash)
+                  + QLatin1Char('_') + sizeTag(m_size);
+
+        for (const char* ext : { ".jpg", ".png" }) {
+            QImage cached(cachePath + QLatin1String(ext));
+            if (!cached.isNull()) {
+                diskHits.add();
+                m_provider->storeInMemory(m_memoryKey, cached);
+                emit done(cached, QString());
+                return;
+            }
+        }
+    }
+
+    misses.add();
+    if (m_cancelled->load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    QImage image;
+    {
+        ScopedTimer timer(decodeTime);
+        QBuffer buffer(&contents);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        reader.setAutoTransform(true);
+
+        // Downscale while decoding (JPEG decodes at 1/2, 1/4, 1/8 directly); never upscale
+        const QSize original = reader.size();
+        if (original.isValid() && (original.width() > m_size.width() || original.height() > m_size.height())) {
+            reader.setScaledSize(original.scaled(m_size, Qt::KeepAspectRatio));
+        }
+        image = reader.read();
+        if (image.isNull()) {
+            errors.add();
+            emit done(QImage(), reader.errorString());
+            return;
+        }
+        // Formats without scaled decoding ignore setScaledSize
+        if (image.width() > m_size.width() || image.height() > m_size.height()) {
+            image = image.scaled(m_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+
+    m_provider->storeInMemory(m_memoryKey, image);
+
+    if (!cachePath.isEmpty()) {
+        const bool alpha = image.hasAlphaChannel();
+        QSaveFile out(cachePath + QLatin1String(alpha ? ".png" : ".jpg"));
+        if (out.open(QIODevice::WriteOnly) && image.save(&out, alpha ? "PNG" : "JPG", alpha ? -1 : 85)) {
+            out.commit();
+        }
+    }
+
+    emit done(image, QString());
+}
+
+// ---------------------------------------------------------------------------
+// ThumbnailProvider
+// ---------------------------------------------------------------------------
+
+ThumbnailProvider::ThumbnailProvider()
+{
+    // Leave a core for the GUI and render threads
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    m_pool.setObjectName(QStringLiteral("cuirq-thumbnails"));
+    m_memory.setMaxCost(kDefaultMemoryBudgetBytes);
+
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (!base.isEmpty()) {
+        setCacheDir(base + QStringLiteral("/cuirq/thumbnails"));
+    }
+}
+
+ThumbnailProvider::~ThumbnailProvider()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QQuickImageResponse* ThumbnailProvider::requestImageResponse(const QString& id, const QSize& requestedSize)
+{
+    static Counter& memoryHits = Metrics::counter("thumbs.memory_hits");
+    static Gauge& pending = Metrics::gauge("thumbs.pending");
+
+    auto* response = new ThumbnailResponse();
+
+    const QString path = QUrl::fromPercentEncoding(id.toUtf8());
+    const QSize size = thumbnailBounds(requestedSize);
+
+    // Memory key includes mtime and size so edited files are re-read
+    const QFileInfo info(path);
+    const QString memoryKey = path + QLatin1Char('|') + QString::number(info.lastModified().toMSecsSinceEpoch())
+                            + QLatin1Char('|') + QString::number(info.size()) + QLatin1Char('|') + sizeTag(size);
+
+    QImage cached;
+    {
+        QMutexLocker lock(&m_mutex);
+        if (QImage* hit = m_memory.object(memoryKey)) {
+            cached = *hit;
+        }
+    }
+    if (!cached.isNull()) {
+        memoryHits.add();
+        // finished() must not be emitted before the engine has the response
+        QTimer::singleShot(0, response, [response, cached]() { response->deliver(cached, QString()); });
+        return response;
+    }
+
+    auto* job = new ThumbnailJob(this, path, size, memoryKey, response->cancelFlag());
+    QObject::connect(job, &ThumbnailJob::done, response, &ThumbnailResponse::deliver);
+
+    // Newest first: the delegates that just scrolled into view
+    pending.add(1);
+    m_pool.start(job, m_nextPriority.fetch_add(1, std::memory_order_relaxed));
+    return response;
+}
+
+void ThumbnailProvider::setCacheDir(const QString& dir)
+{
+    if (!dir.isEmpty() && !QDir().mkpath(dir)) {
+        qCWarning(lcBridge) << "ThumbnailProvider: Cannot create cache directory" << dir;
+        return;
+    }
+    QMutexLocker lock(&m_mutex);
+    m_cacheDir = dir;
+}
+
+QString ThumbnailProvider::cacheDir() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_cacheDir;
+}
+
+void ThumbnailProvider::setMaxThreads(int threads)
+{
+    m_pool.setMaxThreadCount(qMax(1, threads));
+}
+
+void ThumbnailProvider::setMemoryBudget(qint64 bytes)
+{
+    QMutexLocker lock(&m_mutex);
+    m_memory.setMaxCost(qMax<qint64>(0, bytes));
+    updateGauges();
+}
+
+void ThumbnailProvider::storeInMemory(const QString& key, const QImage& image)
+{
+    QMutexLocker lock(&m_mutex);
+    m_memory.insert(key, new QImage(image), image.sizeInBytes());
+    updateGauges();
+}
+
+void ThumbnailProvider::updateGauges()
+{
+    static Gauge& memoryBytes = Metrics::gauge("thumbs.memory_bytes");
+    memoryBytes.set(m_memory.totalCost());
+}
@@ -0,0 +1,131 @@
+#ifndef THUMBNAILPROVIDER_H
+#define THUMBNAILPROVIDER_H
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQuickAsyncImageProvider>
+#include <QRunnable>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+class ThumbnailProvider;
+
+/**
+ * ThumbnailResponse - One pending image://thumbs/ request.
+ *
+ * Finishes either from the memory cache (on the next event-loop turn) or
+ * when its ThumbnailJob delivers. cancel() is called by Qt when the Image
+ * that asked is destroyed or changes source, e.g. a delegate scrolled out
+ * of a ListView; the job then skips the decode if it has not started.
+ */
+class ThumbnailResponse : public QQuickImageResponse
+{
+    Q_OBJECT
+
+public:
+    ThumbnailResponse();
+
+    QQuickTextureFactory* textureFactory() const override;
+    QString errorString() const override { return m_error; }
+    void cancel() override;
+
+    std::shared_ptr<std::atomic<bool>> cancelFlag() const { return m_cancelled; }
+
+public slots:
+    void deliver(const QImage& image, const QString& error);
+
+private:
+    QImage m_image;
+    QString m_error;
+    bool m_finished = false;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+/**
+ * ThumbnailJob - Loads one thumbnail on the provider's thread pool.
+ *
+ * Order of lookup: disk cache (keyed by a hash of the file's contents and
+ * the target size), then decode with QImageReader::setScaledSize so large
+ * JPEGs are downsampled while decoding instead of after.
+ */
+class ThumbnailJob : public QObject, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    ThumbnailJob(ThumbnailProvider* provider, const QString& path, const QSize& size,
+                 const QString& memoryKey, std::shared_ptr<std::atomic<bool>> cancelled);
+
+    void run() override;
+
+signals:
+    void done(const QImage& image, const QString& error);
+
+private:
+    ThumbnailProvider* m_provider;
+    QString m_path;
+    QSize m_size;
+    QString m_memoryKey;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+/**
+ * ThumbnailProvider - Native thumbnail pipeline for image://thumbs/<path>.
+ *
+ * Decodes and scales local image files on a bounded thread pool, fronted
+ * by a two-level cache: an in-memory LRU of decoded thumbnails bounded by
+ * bytes, and an on-disk cache of encoded thumbnails keyed by content hash
+ * (so renamed or copied files still hit, edited files do not).
+ *
+ * The most recent request runs first: while scrolling, the delegates that
+ * just became visible are decoded before the ones that scrolled past, and
+ * those are cancelled by Qt as their delegates are destroyed.
+ *
+ * QML:
+ *   Image {
+ *       source: "image://thumbs/" + model.path
+ *       sourceSize: Qt.size(160, 160)   // Thumbnail bounds (default 256x256)
+ *       asynchronous: true
+ *   }
+ *
+ * Metrics: thumbs.memory_hits, thumbs.disk_hits, thumbs.misses,
+ * thumbs.cancelled, thumbs.errors, histogram thumbs.decode_ns and gauges
+ * thumbs.pending and thumbs.memory_bytes.
+ */
+class ThumbnailProvider : public QQuickAsyncImageProvider
+{
+public:
+    static constexpr int kDefaultSize = 256;
+    static constexpr qint64 kDefaultMemoryBudgetBytes = 64ll * 1024 * 1024;
+
+    ThumbnailProvider();
+    ~ThumbnailProvider() override;
+
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
+
+    // Configuration (thread-safe)
+    void setCacheDir(const QString& dir);  // Empty disables the disk cache
+    QString cacheDir() const;
+    void setMaxThreads(int threads);
+    void setMemoryBudget(qint64 bytes);
+
+private:
+    friend class ThumbnailJob;
+
+    void storeInMemory(const QString& key, const QImage& image);
+    void updateGauges();
+
+    QThreadPool m_pool;
+    std::atomic<int> m_nextPriority{0};
+
+    mutable QMutex m_mutex;
+    QCache<QString, QImage> m_memory;
+    QString m_cacheDir;
+};
+
+#endif // THUMBNAILPROVIDER_H
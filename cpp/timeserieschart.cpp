@@ -0,0 +1,418 @@
+#include "timeserieschart.h"
+#include "metrics.h"
+#include "log.h"
+
+#include <QImage>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGRendererInterface>
+#include <QtNumeric>
+#include <QtQml>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+// Default series colors, in order of creation
+const QRgb kPalette[] = { 0xff4e79a7, 0xfff28e2b, 0xffe15759, 0xff76b7b2,
+                          0xff59a14f, 0xffedc948, 0xffb07aa1, 0xffff9da7 };
+
+// NaN == NaN here: both mean automatic
+bool assignRange(qreal& field, qreal value)
+{
+    if (field == value || (qIsNaN(field) && qIsNaN(value))) {
+        return false;
+    }
+    field = value;
+    return true;
+}
+
+} // namespace
+
+TimeSeriesChart::TimeSeriesChart(QQuickItem* parent)
+    : QQuickItem(parent)
+    , m_xMin(qQNaN())
+    , m_xMax(qQNaN())
+    , m_yMin(qQNaN())
+    , m_yMax(qQNaN())
+{
+    setFlag(ItemHasContents, true);
+    // Lines run to the neighbouring points just outside the range
+    setClip(true);
+}
+
+TimeSeriesChart::~TimeSeriesChart()
+{
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+}
+
+QHash<QString, TimeSeriesChart*>& TimeSeriesChart::registry()
+{
+    static QHash<QString, TimeSeriesChart*> charts;
+    return charts;
+}
+
+void TimeSeriesChart::registerType()
+{
+    qmlRegisterType<TimeSeriesChart>("Cuirq", 1, 0, "TimeSeriesChart");
+}
+
+TimeSeriesChart* TimeSeriesChart::find(const QString& name)
+{
+    return registry().value(name, nullptr);
+}
+
+void TimeSeriesChart::setName(const QString& name)
+{
+    if (name == m_name) {
+        return;
+    }
+    if (!m_name.isEmpty() && registry().value(m_name) == this) {
+        registry().remove(m_name);
+    }
+    m_name = name;
+    if (!m_name.isEmpty()) {
+        registry().insert(m_name, this);
+    }
+    emit nameChanged();
+}
+
+void TimeSeriesChart::setDecimation(Decimation decimation)
+{
+    if (decimation == m_decimation) {
+        return;
+    }
+    m_decimation = decimation;
+    emit decimationChanged();
+    invalidate();
+}
+
+void TimeSeriesChart::setXMin(qreal value)
+{
+    if (assignRange(m_xMin, value)) {
+        emit rangeChanged();
+        invalidate();
+    }
+}
+
+void TimeSeriesChart::setXMax(qreal value)
+{
+    if (assignRange(m_xMax, value)) {
+        emit rangeChanged();
+        invalidate();
+    }
+}
+
+void TimeSeriesChart::setYMin(qreal value)
+{
+    if (assignRange(m_yMin, value)) {
+        emit rangeChanged();
+        invalidate();
+    }
+}
+
+void TimeSeriesChart::setYMax(qreal value)
+{
+    if (assignRange(m_yMax, value)) {
+        emit rangeChanged();
+        invalidate();
+    }
+}
+
+void TimeSeriesChart::setTimeWindow(qreal span)
+{
+    if (assignRange(m_timeWindow, qMax<qreal>(0, span))) {
+        emit rangeChanged();
+        invalidate();
+    }
+}
+
+int TimeSeriesChart::pointCount() const
+{
+    int count = 0;
+    for (const Series& s : m_series) {
+        count += s.data.size();
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// Data
+// ---------------------------------------------------------------------------
+
+TimeSeriesChart::Series& TimeSeriesChart::series(const QString& id)
+{
+    for (Series& s : m_series) {
+        if (s.id == id) {
+            return s;
+        }
+    }
+    const QRgb color = kPalette[m_nextColor++ % std::size(kPalette)];
+    m_series.append(Series{ id, color, SeriesPyramid() });
+    return m_series.last();
+}
+
+void TimeSeriesChart::setSeries(const QString& id, const double* x, const double* y, int count)
+{
+    Series& s = series(id);
+    s.data.clear();
+    s.data.reserve(count);
+    s.data.append(x, y, count);
+    emit seriesChanged();
+    invalidate();
+}
+
+void TimeSeriesChart::appendSeries(const QString& id, const double* x, const double* y, int count)
+{
+    static Counter& appended = Metrics::counter("chart.points_appended");
+    series(id).data.append(x, y, count);
+    appended.add(count);
+    emit seriesChanged();
+    invalidate();
+}
+
+void TimeSeriesChart::setSeriesColor(const QString& id, QRgb color)
+{
+    series(id).color = color;
+    invalidate();
+}
+
+bool TimeSeriesChart::removeSeries(const QString& id)
+{
+    for (int i = 0; i < m_series.size(); ++i) {
+        if (m_series[i].id == id) {
+            m_series.remove(i);
+            emit seriesChanged();
+            invalidate();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TimeSeriesChart::invalidate()
+{
+    updateVisibleRange();
+    m_dirty = true;
+    update();
+}
+
+// Ranges come from the pyramids: O(levels) per series, not O(points)
+void TimeSeriesChart::updateVisibleRange()
+{
+    qreal x0 = qInf();
+    qreal x1 = -qInf();
+    for (const Series& s : std::as_const(m_series)) {
+        if (!s.data.isEmpty()) {
+            x0 = qMin(x0, s.data.x(0));
+            x1 = qMax(x1, s.data.x(s.data.size() - 1));
+        }
+    }
+    if (m_timeWindow > 0) {
+        x0 = x1 - m_timeWindow;
+    }
+    x0 = qIsNaN(m_xMin) ? x0 : m_xMin;
+    x1 = qIsNaN(m_xMax) ? x1 : m_xMax;
+
+    qreal y0 = qInf();
+    qreal y1 = -qInf();
+    if (qIsNaN(m_yMin) || qIsNaN(m_yMax)) {
+        for (const Series& s : std::as_const(m_series)) {
+            const SeriesPyramid::Extent e = s.data.extent(s.data.lowerBound(x0), s.data.lowerBound(std::nextafter(x1, qInf())));
+            y0 = qMin(y0, e.min);
+            y1 = qMax(y1, e.max);
+        }
+        // A little headroom so lines do not sit on the edges
+        const qreal pad = std::isfinite(y1 - y0) ? (y1 - y0) * 0.05 : 0;
+        y0 -= pad;
+        y1 += pad;
+    }
+    y0 = qIsNaN(m_yMin) ? y0 : m_yMin;
+    y1 = qIsNaN(m_yMax) ? y1 : m_yMax;
+
+    if (!std::isfinite(x0) || !std::isfinite(x1)) {
+        x0 = 0;
+        x1 = 1;
+    }
+    if (!std::isfinite(y0) || !std::isfinite(y1)) {
+        y0 = 0;
+        y1 = 1;
+    }
+    if (x1 <= x0) {
+        x1 = x0 + 1;
+    }
+    if (y1 <= y0) {
+        y0 -= 0.5;
+        y1 = y0 + 1;
+    }
+
+    const QRectF range(QPointF(x0, y0), QPointF(x1, y1));
+    if (range != m_visibleRange) {
+        m_visibleRange = range;
+        emit visibleRangeChanged();
+    }
+}
+
+QVector<QPointF> TimeSeriesChart::decimate(const Series& series, int columns) const
+{
+    const qreal x0 = m_visibleRange.left();
+    const qreal x1 = m_visibleRange.right();
+    return m_decimation == Lttb ? series.data.decimateLttb(x0, x1, columns)
+                                : series.data.decimateMinMax(x0, x1, columns);
+}
+
+// ---------------------------------------------------------------------------
+// Scene graph
+// ---------------------------------------------------------------------------
+
+QSGNode* TimeSeriesChart::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* /* data */)
+{
+    static Histogram& decimateTime = Metrics::histogram("chart.decimate_ns");
+    CUIRQ_TRACE_SCOPE("TimeSeriesChart::updatePaintNode", "render");
+
+    QSGNode* root = oldNode;
+    if (!root) {
+        root = new QSGNode();
+        m_dirty = true;
+    }
+
+    const bool software = window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+    if (software != m_software) {
+        while (QSGNode* child = root->firstChild()) {
+            root->removeChildNode(child);
+            delete child;
+        }
+        m_lines.clear();
+        m_image = nullptr;
+        m_software = software;
+        m_dirty = true;
+    }
+    if (!m_dirty) {
+        return root;
+    }
+    m_dirty = false;
+
+    // One column per device pixel
+    const int columns = qMax(1, static_cast<int>(std::ceil(width() * window()->effectiveDevicePixelRatio())));
+    QVector<QVector<QPointF>> lines;
+    lines.reserve(m_series.size());
+    {
+        ScopedTimer timer(decimateTime);
+        const qreal sx = width() / m_visibleRange.width();
+        const qreal sy = height() / m_visibleRange.height();
+        for (const Series& s : std::as_const(m_series)) {
+            QVector<QPointF> points = decimate(s, columns);
+            for (QPointF& p : points) {
+                p = QPointF((p.x() - m_visibleRange.left()) * sx, height() - (p.y() - m_visibleRange.top()) * sy);
+            }
+            lines.append(std::move(points));
+        }
+    }
+
+    if (m_software) {
+        paintImage(root, lines);
+    } else {
+        syncGeometry(root, lines);
+    }
+    return root;
+}
+
+void TimeSeriesChart::syncGeometry(QSGNode* root, const QVector<QVector<QPointF>>& lines)
+{
+    while (m_lines.size() > lines.size()) {
+        QSGGeometryNode* node = m_lines.takeLast();
+        root->removeChildNode(node);
+        delete node;
+    }
+    while (m_lines.size() < lines.size()) {
+        auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+        geometry->setLineWidth(1);
+        geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+
+        auto* node = new QSGGeometryNode();
+        node->setGeometry(geometry);
+        node->setMaterial(new QSGFlatColorMaterial());
+        node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+        root->appendChildNode(node);
+        m_lines.append(node);
+    }
+
+    for (int i = 0; i < lines.size(); ++i) {
+        QSGGeometryNode* node = m_lines[i];
+        QSGGeometry* geometry = node->geometry();
+        const QVector<QPointF>& points = lines[i];
+        if (geometry->vertexCount() != points.size()) {
+            geometry->allocate(points.size());
+        }
+        QSGGeometry::Point2D* v = geometry->vertexDataAsPoint2D();
+        for (const QPointF& p : points) {
+            (v++)->set(static_cast<float>(p.x()), static_cast<float>(p.y()));
+        }
+        node->markDirty(QSGNode::DirtyGeometry);
+
+        auto* material = static_cast<QSGFlatColorMaterial*>(node->material());
+        const QColor color = QColor::fromRgba(m_series[i].color);
+        if (material->color() != color) {
+            material->setColor(color);
+            node->markDirty(QSGNode::DirtyMaterial);
+        }
+    }
+}
+
+void TimeSeriesChart::paintImage(QSGNode* root, const QVector<QVector<QPointF>>& lines)
+{
+    if (!m_image) {
+        m_image = window()->createImageNode();
+        m_image->setOwnsTexture(true);
+        root->appendChildNode(m_image);
+    }
+
+    const qreal dpr = window()->effectiveDevicePixelRatio();
+    QImage image(qMax(1, static_cast<int>(std::ceil(width() * dpr))),
+                 qMax(1, static_cast<int>(std::ceil(height() * dpr))),
+                 QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        for (int i = 0; i < lines.size(); ++i) {
+            painter.setPen(QPen(QColor::fromRgba(m_series[i].color), 1));
+            painter.drawPolyline(lines[i].constData(), lines[i].size());
+        }
+    }
+
+    m_image->setTexture(window()->createTextureFromImage(image));
+    m_image->setRect(boundingRect());
+}
+
+void TimeSeriesChart::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_dirty = true;
+        update();
+    }
+}
+
+void TimeSeriesChart::itemChange(ItemChange change, const ItemChangeData& value)
+{
+    if (change == ItemSceneChange) {
+        m_dirty = true;
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void TimeSeriesChart::releaseResources()
+{
+    // The scene graph is going away: node pointers die with it
+    m_lines.clear();
+    m_image = nullptr;
+    m_dirty = true;
+}
@@ -0,0 +1,155 @@
+#ifndef TIMESERIESCHART_H
+#define TIMESERIESCHART_H
+
+#include <QColor>
+#include <QHash>
+#include <QQuickItem>
+#include <QString>
+#include <QVector>
+
+#include "seriespyramid.h"
+
+class QSGGeometryNode;
+class QSGImageNode;
+class QSGNode;
+
+/**
+ * TimeSeriesChart - Scene-graph line chart for very large series.
+ *
+ * Series are pushed from the JVM as primitive double arrays or direct
+ * DoubleBuffers and stored natively in a SeriesPyramid, so appending
+ * points only updates the tail of each pyramid level.
+ *
+ * Each frame a series is decimated to the pixel width of the item
+ * (min/max per pixel column, or LTTB) and drawn as one line strip, so
+ * drawing cost depends on the item width, not on the number of points.
+ * Decimation only reruns when data, range or size changed.
+ *
+ * The x range is the data extent, or [xMin, xMax] when set, or the
+ * last `timeWindow` units when timeWindow > 0 (live tail). The y range
+ * follows the visible data unless yMin/yMax are set. visibleXMin/Max and
+ * visibleYMin/Max report the ranges in use, for axes drawn in QML.
+ *
+ * With the software backend series are painted into an image.
+ *
+ * QML:
+ *   import Cuirq 1.0
+ *   TimeSeriesChart { name: "cpu"; anchors.fill: parent; timeWindow: 60 }
+ *
+ * JVM: Bridge.setSeriesData / appendSeriesData / appendSeriesBuffer("cpu", "user", ...)
+ */
+class TimeSeriesChart : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(Decimation decimation READ decimation WRITE setDecimation NOTIFY decimationChanged)
+    Q_PROPERTY(qreal xMin READ xMin WRITE setXMin NOTIFY rangeChanged)
+    Q_PROPERTY(qreal xMax READ xMax WRITE setXMax NOTIFY rangeChanged)
+    Q_PROPERTY(qreal yMin READ yMin WRITE setYMin NOTIFY rangeChanged)
+    Q_PROPERTY(qreal yMax READ yMax WRITE setYMax NOTIFY rangeChanged)
+    Q_PROPERTY(qreal timeWindow READ timeWindow WRITE setTimeWindow NOTIFY rangeChanged)
+    Q_PROPERTY(qreal visibleXMin READ visibleXMin NOTIFY visibleRangeChanged)
+    Q_PROPERTY(qreal visibleXMax READ visibleXMax NOTIFY visibleRangeChanged)
+    Q_PROPERTY(qreal visibleYMin READ visibleYMin NOTIFY visibleRangeChanged)
+    Q_PROPERTY(qreal visibleYMax READ visibleYMax NOTIFY visibleRangeChanged)
+    Q_PROPERTY(int seriesCount READ seriesCount NOTIFY seriesChanged)
+    Q_PROPERTY(int pointCount READ pointCount NOTIFY seriesChanged)
+
+public:
+    enum Decimation { MinMax, Lttb };
+    Q_ENUM(Decimation)
+
+    explicit TimeSeriesChart(QQuickItem* parent = nullptr);
+    ~TimeSeriesChart() override;
+
+    // Register the "Cuirq 1.0 / TimeSeriesChart" QML type
+    static void registerType();
+
+    // Chart declared in QML with the given name, or nullptr
+    static TimeSeriesChart* find(const QString& name);
+
+    QString name() const { return m_name; }
+    void setName(const QString& name);
+
+    Decimation decimation() const { return m_decimation; }
+    void setDecimation(Decimation decimation);
+
+    // NaN (the default) means automatic
+    qreal xMin() const { return m_xMin; }
+    void setXMin(qreal value);
+    qreal xMax() const { return m_xMax; }
+    void setXMax(qreal value);
+    qreal yMin() const { return m_yMin; }
+    void setYMin(qreal value);
+    qreal yMax() const { return m_yMax; }
+    void setYMax(qreal value);
+    qreal timeWindow() const { return m_timeWindow; }
+    void setTimeWindow(qreal span);
+
+    qreal visibleXMin() const { return m_visibleRange.left(); }
+    qreal visibleXMax() const { return m_visibleRange.right(); }
+    qreal visibleYMin() const { return m_visibleRange.top(); }
+    qreal visibleYMax() const { return m_visibleRange.bottom(); }
+
+    int seriesCount() const { return m_series.size(); }
+    int pointCount() const;
+
+    // x may be null (x = point index). Creates the series if needed.
+    void setSeries(const QString& id, const double* x, const double* y, int count);
+    void appendSeries(const QString& id, const double* x, const double* y, int count);
+    void setSeriesColor(const QString& id, QRgb color);
+    Q_INVOKABLE bool removeSeries(const QString& id);
+
+signals:
+    void nameChanged();
+    void decimationChanged();
+    void rangeChanged();
+    void visibleRangeChanged();
+    void seriesChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData& value) override;
+    void releaseResources() override;
+
+private:
+    struct Series
+    {
+        QString id;
+        QRgb color;
+        SeriesPyramid data;
+    };
+
+    static QHash<QString, TimeSeriesChart*>& registry();
+
+    Series& series(const QString& id);
+    void invalidate();
+    void updateVisibleRange();
+    QVector<QPointF> decimate(const Series& series, int columns) const;
+
+    void syncGeometry(QSGNode* root, const QVector<QVector<QPointF>>& lines);
+    void paintImage(QSGNode* root, const QVector<QVector<QPointF>>& lines);
+
+    QString m_name;
+    Decimation m_decimation = MinMax;
+    qreal m_xMin;
+    qreal m_xMax;
+    qreal m_yMin;
+    qreal m_yMax;
+    qreal m_timeWindow = 0;
+    QRectF m_visibleRange;  // x/y data range in use (top = y min)
+
+    QVector<Series> m_series;
+    int m_nextColor = 0;
+
+    // Pending changes, consumed by updatePaintNode
+    bool m_dirty = true;
+
+    // Scene-graph state (only touched in updatePaintNode)
+    bool m_software = false;
+    QVector<QSGGeometryNode*> m_lines;
+    QSGImageNode* m_image = nullptr;
+};
+
+#endif // TIMESERIESCHART_H
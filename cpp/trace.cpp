@@ -0,0 +1,330 @@
+#include "trace.h"
+#include "log.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+std::atomic<bool> Trace::s_enabled{false};
+
+namespace {
+
+struct TraceEvent
+{
+    const char* name;
+    const char* category;
+    const char* detail;
+    qint64 timestampNs;
+    qint64 durationNs;
+    char phase;
+};
+
+// Events kept per thread before the oldest are overwritten
+constexpr quint64 kEventsPerThread = 1 << 14;
+
+struct ThreadBuffer
+{
+    std::array<TraceEvent, kEventsPerThread> events;
+    std::atomic<quint64> head{0};
+    int tid = 0;
+    std::atomic<bool> exited{false};  // Owner is gone: free after the next dump or clear()
+
+    // Single producer: only the owning thread writes
+    void push(const TraceEvent& event)
+    {
+        const quint64 index = head.load(std::memory_order_relaxed);
+        events[index % kEventsPerThread] = event;
+        head.store(index + 1, std::memory_order_release);
+    }
+};
+
+struct TraceState
+{
+    QMutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    QHash<int, const char*> threadNames;  // By tid; interned
+    std::unordered_set<std::string> interned;
+    int nextTid = 1;
+};
+
+TraceState& state()
+{
+    // Intentionally leaked: spans may close during static destruction
+    static TraceState* instance = new TraceState();
+    return *instance;
+}
+
+const std::chrono::steady_clock::time_point kEpoch = std::chrono::steady_clock::now();
+
+// Per-thread trace identity; the ring buffer is only allocated once the
+// thread records while tracing is enabled
+struct ThreadSlot
+{
+    int tid = 0;
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ~ThreadSlot()
+    {
+        if (buffer) {
+            // The name stays until the buffer is released with it
+            buffer->exited.store(true, std::memory_order_release);
+        } else if (tid != 0) {
+            TraceState& st = state();
+            QMutexLocker lock(&st.mutex);
+            st.threadNames.remove(tid);
+        }
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+// Caller holds the state mutex
+int slotTid(TraceState& st)
+{
+    if (t_slot.tid == 0) {
+        t_slot.tid = st.nextTid++;
+    }
+    return t_slot.tid;
+}
+
+// The calling thread's buffer, or nullptr if it has none and tracing is off
+ThreadBuffer* threadBuffer()
+{
+    if (!t_slot.buffer) {
+        if (!Trace::enabled()) {
+            return nullptr;
+        }
+        auto created = std::make_shared<ThreadBuffer>();
+        TraceState& st = state();
+        QMutexLocker lock(&st.mutex);
+        created->tid = slotTid(st);
+        st.buffers.push_back(created);
+        t_slot.buffer = std::move(created);
+    }
+    return t_slot.buffer.get();
+}
+
+void push(const TraceEvent& event)
+{
+    if (ThreadBuffer* buffer = threadBuffer()) {
+        buffer->push(event);
+    }
+}
+
+// Drop the buffers (and names) of threads that have exited; caller holds the state mutex
+void releaseExited(TraceState& st)
+{
+    std::erase_if(st.buffers, [&st](const std::shared_ptr<ThreadBuffer>& buffer) {
+        if (!buffer->exited.load(std::memory_order_acquire)) {
+            return false;
+        }
+        st.threadNames.remove(buffer->tid);
+        return true;
+    });
+}
+
+QByteArray jsonString(const char* value)
+{
+    QByteArray out;
+    out.reserve(static_cast<int>(qstrlen(value)) + 2);
+    out.append('"');
+    for (const char* c = value; *c != '\0'; ++c) {
+        switch (*c) {
+        case '"':  out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(*c) < 0x20) {
+                out.append(QByteArray("\\u00") + QByteArray::number(static_cast<unsigned char>(*c), 16).rightJustified(2, '0'));
+            } else {
+                out.append(*c);
+            }
+        }
+    }
+    out.append('"');
+    return out;
+}
+
+} // namespace
+
+void Trace::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    qCInfo(lcBridge) << "Tracing" << (enabled ? "enabled" : "disabled");
+}
+
+qint64 Trace::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - kEpoch).count();
+}
+
+void Trace::complete(const char* name, const char* category, qint64 startNs, qint64 durationNs,
+                     const char* detail)
+{
+    push({ name, category, detail, startNs, durationNs, 'X' });
+}
+
+void Trace::begin(const char* name, const char* category)
+{
+    if (!enabled()) {
+        return;
+    }
+    push({ name, category, nullptr, nowNs(), 0, 'B' });
+}
+
+void Trace::end()
+{
+    if (!enabled()) {
+        return;
+    }
+    push({ "", "", nullptr, nowNs(), 0, 'E' });
+}
+
+void Trace::instant(const char* name, const char* category, const char* detail)
+{
+    if (!enabled()) {
+        return;
+    }
+    push({ name, category, detail, nowNs(), 0, 'i' });
+}
+
+const char* Trace::intern(const QByteArray& value)
+{
+    TraceState& st = state();
+    QMutexLocker lock(&st.mutex);
+    return st.interned.emplace(value.constData(), static_cast<size_t>(value.size())).first->c_str();
+}
+
+void Trace::setThreadName(const QString& name)
+{
+    const char* interned = intern(name.toUtf8());
+    TraceState& st = state();
+    QMutexLocker lock(&st.mutex);
+    st.threadNames.insert(slotTid(st), interned);
+}
+
+bool Trace::writeChromeTrace(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(lcBridge) << "Cannot write" << path;
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    QHash<int, const char*> threadNames;
+    {
+        TraceState& st = state();
+        QMutexLocker lock(&st.mutex);
+        buffers = st.buffers;
+        threadNames = st.threadNames;
+        // Exited threads' events are in this dump (the copy above keeps them alive)
+        releaseExited(st);
+    }
+
+    const QByteArray pid = QByteArray::number(static_cast<qint64>(QCoreApplication::applicationPid()));
+    quint64 written = 0;
+
+    file.write("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            file.write(",\n");
+        }
+        first = false;
+    };
+
+    for (const auto& buffer : buffers) {
+        const QByteArray tid = QByteArray::number(buffer->tid);
+
+        const char* threadName = threadNames.value(buffer->tid);
+        const QByteArray name = threadName ? QByteArray(threadName) : "thread-" + tid;
+        separator();
+        file.write("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid
+                   + ",\"args\":{\"name\":" + jsonString(name.constData()) + "}}");
+
+        const quint64 head = buffer->head.load(std::memory_order_acquire);
+        const quint64 start = head > kEventsPerThread ? head - kEventsPerThread : 0;
+
+        for (quint64 i = start; i < head; ++i) {
+            const TraceEvent& event = buffer->events[i % kEventsPerThread];
+
+            QByteArray line;
+            line.reserve(160);
+            line.append("{\"ph\":\"").append(event.phase).append("\",\"pid\":").append(pid)
+                .append(",\"tid\":").append(tid)
+                .append(",\"ts\":").append(QByteArray::number(event.timestampNs / 1000.0, 'f', 3));
+
+            if (event.phase != 'E') {
+                line.append(",\"name\":").append(jsonString(event.name))
+                    .append(",\"cat\":").append(jsonString(event.category));
+            }
+            if (event.phase == 'X') {
+                line.append(",\"dur\":").append(QByteArray::number(event.durationNs / 1000.0, 'f', 3));
+            }
+            if (event.phase == 'i') {
+                line.append(",\"s\":\"t\"");
+            }
+            if (event.detail != nullptr) {
+                line.append(",\"args\":{\"detail\":").append(jsonString(event.detail)).append('}');
+            }
+            line.append('}');
+
+            separator();
+            file.write(line);
+            ++written;
+        }
+    }
+
+    file.write("\n]}\n");
+    qCInfo(lcBridge) << "Wrote" << written << "events to" << path;
+    return true;
+}
+
+void Trace::clear()
+{
+    TraceState& st = state();
+    QMutexLocker lock(&st.mutex);
+    releaseExited(st);
+    for (const auto& buffer : st.buffers) {
+        buffer->head.store(0, std::memory_order_release);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// QmlTracer
+// ---------------------------------------------------------------------------
+
+QmlTracer::QmlTracer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void QmlTracer::begin(const QString& name)
+{
+    if (Trace::enabled()) {
+        Trace::begin(Trace::intern(name.toUtf8()), "qml");
+    }
+}
+
+void QmlTracer::end()
+{
+    Trace::end();
+}
+
+void QmlTracer::instant(const QString& name)
+{
+    if (Trace::enabled()) {
+        Trace::instant(Trace::intern(name.toUtf8()), "qml");
+    }
+}
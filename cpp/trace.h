@@ -0,0 +1,137 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * Trace - Cross-language span tracing in Chrome trace / Perfetto format.
+ *
+ * Spans from the bridge (JNI natives, signals, models, hot-reload), from
+ * QML (via the "tracer" context property) and from the JVM (via
+ * Bridge.traceBegin/traceEnd) are recorded into the same timeline and
+ * dumped as Chrome trace JSON, which ui.perfetto.dev and chrome://tracing
+ * open directly.
+ *
+ * Recording:
+ *   - Each thread writes into its own fixed-size ring buffer (single
+ *     producer, no locks); the oldest events are overwritten on wrap
+ *   - A thread's buffer is allocated the first time it records while
+ *     tracing is enabled, and freed by the first writeChromeTrace() or
+ *     clear() after the thread exits
+ *   - Thread names are kept apart from the buffers, so naming a thread
+ *     costs nothing while tracing is off
+ *   - Event names must outlive the trace: use string literals or intern()
+ *
+ * Cost when disabled is one relaxed atomic load per span. Building with
+ * -DCUIRQ_ENABLE_TRACING=OFF compiles the scope macros out entirely.
+ *
+ * For a consistent dump, disable tracing before calling writeChromeTrace().
+ */
+class Trace
+{
+public:
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+
+    // Monotonic timestamp in nanoseconds (trace clock)
+    static qint64 nowNs();
+
+    // Complete event ("X"): a span with known start and duration
+    static void complete(const char* name, const char* category, qint64 startNs, qint64 durationNs,
+                         const char* detail = nullptr);
+
+    // Begin/end events ("B"/"E") for spans opened and closed across calls (JVM API)
+    static void begin(const char* name, const char* category);
+    static void end();
+
+    // Instant event ("i")
+    static void instant(const char* name, const char* category, const char* detail = nullptr);
+
+    // Return a stable pointer for a dynamic string (deduplicated, never freed)
+    static const char* intern(const QByteArray& value);
+
+    // Name the calling thread in the trace
+    static void setThreadName(const QString& name);
+
+    // Write all buffered events as Chrome trace JSON
+    static bool writeChromeTrace(const QString& path);
+
+    // Drop all buffered events
+    static void clear();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * Records a complete event for the lifetime of the scope.
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category, const char* detail = nullptr)
+        : m_name(name)
+        , m_category(category)
+        , m_detail(detail)
+        , m_startNs(Trace::enabled() ? Trace::nowNs() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_startNs >= 0) {
+            Trace::complete(m_name, m_category, m_startNs, Trace::nowNs() - m_startNs, m_detail);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    const char* m_detail;
+    qint64 m_startNs;
+};
+
+/**
+ * QmlTracer - Lets QML JavaScript add spans to the same trace.
+ *
+ * Exposed to QML as "tracer":
+ *   onClicked: { tracer.begin("filter"); doFilter(); tracer.end() }
+ */
+class QmlTracer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QmlTracer(QObject *parent = nullptr);
+
+    Q_INVOKABLE bool isEnabled() const { return Trace::enabled(); }
+
+    Q_INVOKABLE void begin(const QString& name);
+    Q_INVOKABLE void end();
+    Q_INVOKABLE void instant(const QString& name);
+};
+
+#define CUIRQ_TRACE_CONCAT_(a, b) a##b
+#define CUIRQ_TRACE_CONCAT(a, b) CUIRQ_TRACE_CONCAT_(a, b)
+
+#ifdef CUIRQ_TRACING
+// Trace the enclosing scope; name/category must be string literals
+#define CUIRQ_TRACE_SCOPE(name, category) \
+    TraceScope CUIRQ_TRACE_CONCAT(cuirqTraceScope_, __LINE__)(name, category)
+// Same, with a dynamic detail string (interned only while tracing)
+#define CUIRQ_TRACE_SCOPE_DETAIL(name, category, detailBytes) \
+    TraceScope CUIRQ_TRACE_CONCAT(cuirqTraceScope_, __LINE__)( \
+        name, category, Trace::enabled() ? Trace::intern(detailBytes) : nullptr)
+#else
+#define CUIRQ_TRACE_SCOPE(name, category) do { } while (0)
+#define CUIRQ_TRACE_SCOPE_DETAIL(name, category, detailBytes) do { } while (0)
+#endif
+
+#endif // TRACE_H
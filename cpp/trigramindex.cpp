@@ -0,0 +1,243 @@
+#include "trigramindex.h"
+#include "metrics.h"
+
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+constexpr int kMinRowsPerTask = 16384;  // Smaller builds stay on the calling thread
+
+} // namespace
+
+QString TrigramIndex::fold(const QString& text)
+{
+    return text.toCaseFolded();
+}
+
+void TrigramIndex::trigrams(const QString& text, QVector<Trigram>& out)
+{
+    out.clear();
+    const QChar* s = text.constData();
+    for (qsizetype i = 0; i + 2 < text.size(); ++i) {
+        out.append(Trigram(s[i].unicode()) << 32 | Trigram(s[i + 1].unicode()) << 16 | s[i + 2].unicode());
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void TrigramIndex::clear()
+{
+    m_texts.clear();
+    m_docRows.clear();
+    m_rowDocs.clear();
+    m_postings.clear();
+    m_postingCount = 0;
+    m_dead = 0;
+}
+
+void TrigramIndex::build(const QVector<QString>& texts)
+{
+    static Histogram& buildTime = Metrics::histogram("filter.index_build_ns");
+    ScopedTimer timer(buildTime);
+    CUIRQ_TRACE_SCOPE("TrigramIndex::build", "model");
+
+    clear();
+    const int rows = texts.size();
+    m_texts.resize(rows);
+    m_docRows.resize(rows);
+    m_rowDocs.resize(rows);
+    for (int r = 0; r < rows; ++r) {
+        m_docRows[r] = r;
+        m_rowDocs[r] = static_cast<quint32>(r);
+    }
+
+    // Each task folds a contiguous slice and indexes it privately; slices
+    // are merged in order, so every posting list comes out sorted
+    const int tasks = std::clamp(rows / kMinRowsPerTask, 1, QThread::idealThreadCount());
+    QVector<Postings> partial(tasks);
+    QString* folded = m_texts.data();  // Detached once here, not from the tasks
+    Postings* slices = partial.data();
+    auto index = [&](int task) {
+        const int begin = static_cast<int>(qint64(rows) * task / tasks);
+        const int end = static_cast<int>(qint64(rows) * (task + 1) / tasks);
+        Postings& postings = slices[task];
+        QVector<Trigram> grams;
+        for (int r = begin; r < end; ++r) {
+            folded[r] = fold(texts[r]);
+            trigrams(folded[r], grams);
+            for (Trigram g : std::as_const(grams)) {
+                postings[g].append(static_cast<quint32>(r));
+            }
+        }
+    };
+
+    if (tasks == 1) {
+        index(0);
+    } else {
+        QSemaphore done;
+        for (int t = 1; t < tasks; ++t) {
+            QThreadPool::globalInstance()->start([&, t] {
+                index(t);
+                done.release();
+            });
+        }
+        index(0);
+        done.acquire(tasks - 1);
+    }
+
+    m_postings = std::move(partial[0]);
+    for (int t = 1; t < tasks; ++t) {
+        for (auto it = partial[t].begin(); it != partial[t].end(); ++it) {
+            m_postings[it.key()].append(it.value());
+        }
+        partial[t] = Postings();
+    }
+    for (auto it = m_postings.cbegin(); it != m_postings.cend(); ++it) {
+        m_postingCount += it.value().size();
+    }
+}
+
+quint32 TrigramIndex::addDocument(const QString& folded, int row)
+{
+    const quint32 doc = static_cast<quint32>(m_texts.size());
+    m_texts.append(folded);
+    m_docRows.append(row);
+
+    QVector<Trigram> grams;
+    trigrams(folded, grams);
+    for (Trigram g : std::as_const(grams)) {
+        m_postings[g].append(doc);
+    }
+    m_postingCount += grams.size();
+    return doc;
+}
+
+void TrigramIndex::killDocument(quint32 doc)
+{
+    m_docRows[doc] = -1;
+    m_texts[doc] = QString();
+    ++m_dead;
+}
+
+void TrigramIndex::renumberFrom(int row)
+{
+    for (int r = row; r < m_rowDocs.size(); ++r) {
+        m_docRows[m_rowDocs[r]] = r;
+    }
+}
+
+void TrigramIndex::compactIfNeeded()
+{
+    if (m_dead <= m_rowDocs.size()) {
+        return;
+    }
+    QVector<QString> texts;
+    texts.reserve(m_rowDocs.size());
+    for (quint32 doc : std::as_const(m_rowDocs)) {
+        texts.append(m_texts[doc]);  // Already folded; folding again is a no-op
+    }
+    build(texts);
+}
+
+void TrigramIndex::insertRows(int first, const QVector<QString>& texts)
+{
+    QVector<quint32> docs;
+    docs.reserve(texts.size());
+    for (const QString& text : texts) {
+        docs.append(addDocument(fold(text), -1));
+    }
+    m_rowDocs.insert(first, texts.size(), 0);
+    std::copy(docs.cbegin(), docs.cend(), m_rowDocs.begin() + first);
+    renumberFrom(first);
+}
+
+void TrigramIndex::removeRows(int first, int count)
+{
+    for (int r = first; r < first + count; ++r) {
+        killDocument(m_rowDocs[r]);
+    }
+    m_rowDocs.remove(first, count);
+    renumberFrom(first);
+    compactIfNeeded();
+}
+
+void TrigramIndex::updateRow(int row, const QString& text)
+{
+    const QString folded = fold(text);
+    const quint32 old = m_rowDocs[row];
+    if (m_texts[old] == folded) {
+        return;
+    }
+    killDocument(old);
+    m_rowDocs[row] = addDocument(folded, row);
+    compactIfNeeded();
+}
+
+bool TrigramIndex::matches(int row, const QString& query) const
+{
+    return m_texts[m_rowDocs[row]].contains(query);
+}
+
+QVector<int> TrigramIndex::search(const QString& query) const
+{
+    static Histogram& searchTime = Metrics::histogram("filter.search_ns");
+    ScopedTimer timer(searchTime);
+
+    QVector<int> rows;
+    if (query.size() < 3) {
+        for (int r = 0; r < m_rowDocs.size(); ++r) {
+            if (m_texts[m_rowDocs[r]].contains(query)) {
+                rows.append(r);
+            }
+        }
+        return rows;
+    }
+
+    QVector<Trigram> grams;
+    trigrams(query, grams);
+    QVector<const QVector<quint32>*> lists;
+    lists.reserve(grams.size());
+    for (Trigram g : std::as_const(grams)) {
+        const auto it = m_postings.constFind(g);
+        if (it == m_postings.cend()) {
+            return rows;
+        }
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const QVector<quint32>* a, const QVector<quint32>* b) { return a->size() < b->size(); });
+
+    QVector<quint32> candidates = *lists.first();
+    QVector<quint32> next;
+    for (int i = 1; i < lists.size() && !candidates.isEmpty(); ++i) {
+        next.clear();
+        std::set_intersection(candidates.cbegin(), candidates.cend(), lists[i]->cbegin(), lists[i]->cend(),
+                              std::back_inserter(next));
+        candidates.swap(next);
+    }
+
+    for (quint32 doc : std::as_const(candidates)) {
+        const int row = m_docRows[doc];
+        if (row >= 0 && (query.size() == 3 || m_texts[doc].contains(query))) {
+            rows.append(row);
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+qint64 TrigramIndex::memoryUsage() const
+{
+    qint64 bytes = m_postingCount * static_cast<qint64>(sizeof(quint32))
+                 + m_postings.size() * static_cast<qint64>(sizeof(Trigram) + sizeof(QVector<quint32>) + 16)
+                 + m_texts.size() * static_cast<qint64>(sizeof(QString) + sizeof(int))
+                 + m_rowDocs.size() * static_cast<qint64>(sizeof(quint32));
+    for (const QString& text : m_texts) {
+        bytes += text.capacity() * static_cast<qint64>(sizeof(QChar));
+    }
+    return bytes;
+}
@@ -0,0 +1,66 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * TrigramIndex - Substring index over one text per row.
+ *
+ * Texts are case-folded and every distinct run of three UTF-16 units
+ * (trigram) maps to a posting list of the documents containing it. A
+ * query of three or more units intersects the posting lists of its
+ * trigrams, starting from the shortest, and confirms the survivors with a
+ * plain substring test; shorter queries scan the folded texts.
+ *
+ * Documents are numbered in insertion order and never renumbered, so
+ * posting lists stay sorted and row inserts or removals only touch the
+ * row <-> document tables. Changed and removed rows leave dead documents
+ * behind, which are skipped at query time and dropped by a rebuild once
+ * they outnumber the live ones.
+ *
+ * build() spreads folding and trigram extraction over the global thread
+ * pool. Otherwise not thread-safe: owned and used by one thread.
+ */
+class TrigramIndex
+{
+public:
+    // Replace the contents with one text per row
+    void build(const QVector<QString>& texts);
+    void clear();
+
+    void insertRows(int first, const QVector<QString>& texts);
+    void removeRows(int first, int count);
+    void updateRow(int row, const QString& text);
+
+    int rowCount() const { return m_rowDocs.size(); }
+
+    // Rows whose text contains `query` (already folded), ascending
+    QVector<int> search(const QString& query) const;
+    bool matches(int row, const QString& query) const;
+
+    static QString fold(const QString& text);
+
+    // Approximate heap footprint of texts, posting lists and row tables
+    qint64 memoryUsage() const;
+
+private:
+    using Trigram = quint64;
+    using Postings = QHash<Trigram, QVector<quint32>>;
+
+    static void trigrams(const QString& text, QVector<Trigram>& out);
+    quint32 addDocument(const QString& folded, int row);
+    void killDocument(quint32 doc);
+    void renumberFrom(int row);
+    void compactIfNeeded();
+
+    QVector<QString> m_texts;    // Folded text per document (empty once dead)
+    QVector<int> m_docRows;      // Document -> row, -1 when dead
+    QVector<quint32> m_rowDocs;  // Row -> document
+    Postings m_postings;
+    qint64 m_postingCount = 0;
+    int m_dead = 0;
+};
+
+#endif // TRIGRAMINDEX_H
@@ -1,5 +1,8 @@
 package qml;
 
+import java.nio.ByteBuffer;
+import java.nio.DoubleBuffer;
+
 /**
  * JNI Bridge between JVM and Qt QML.
  *
@@ -12,6 +15,32 @@ public class Bridge {
         System.loadLibrary("qmlbridge");
     }
 
+    /** 32-bit ints in native byte order, 0xAARRGGBB with premultiplied alpha. */
+    public static final int IMAGE_FORMAT_ARGB32_PREMULTIPLIED = 0;
+    /** 32-bit ints in native byte order, 0xAARRGGBB (BufferedImage.TYPE_INT_ARGB). */
+    public static final int IMAGE_FORMAT_ARGB32 = 1;
+    /** 32-bit ints in native byte order, 0xffRRGGBB (BufferedImage.TYPE_INT_RGB). */
+    public static final int IMAGE_FORMAT_RGB32 = 2;
+    /** Bytes R, G, B, A. */
+    public static final int IMAGE_FORMAT_RGBA8888 = 3;
+    /** Bytes R, G, B. */
+    public static final int IMAGE_FORMAT_RGB888 = 4;
+    /** One byte per pixel. */
+    public static final int IMAGE_FORMAT_GRAYSCALE8 = 5;
+
+    /** Add rows [first, last] to a selection. */
+    public static final int SELECTION_SELECT = 0;
+    /** Remove rows [first, last] from a selection. */
+    public static final int SELECTION_DESELECT = 1;
+    /** Flip rows [first, last]. */
+    public static final int SELECTION_TOGGLE = 2;
+    /** Select every row. */
+    public static final int SELECTION_ALL = 3;
+    /** Select no rows. */
+    public static final int SELECTION_CLEAR = 4;
+    /** Flip every row. */
+    public static final int SELECTION_INVERT = 5;
+
     /**
      * Initialize Qt application with command-line arguments.
      * Must be called before any other Qt operations.
@@ -39,6 +68,16 @@ public class Bridge {
      */
     public static native void setContextProperty(String name, String value);
 
+    /**
+     * Edit nested state values with an RFC 6902 JSON Patch instead of
+     * re-sending whole properties. Paths start with the property name,
+     * e.g. "/user/name".
+     *
+     * @param jsonPatch JSON array of operations
+     * @return false (and nothing applied) if any operation fails
+     */
+    public static native boolean applyStatePatch(String jsonPatch);
+
     /**
      * Run Qt event loop (blocking call).
      * Returns when quit() is called or window is closed.
@@ -64,6 +103,16 @@ public class Bridge {
      */
     public static native void registerSignalHandler(String signalName, SignalHandler handler);
 
+    /**
+     * Dispatch a signal to its registered handler as if QML had emitted it.
+     *
+     * Useful for exercising handlers from the REPL and for benchmarks.
+     *
+     * @param signalName Name of the signal
+     * @param args Signal arguments
+     */
+    public static native void emitSignal(String signalName, String[] args);
+
     /**
      * Create a list model and register it as a context property.
      *
@@ -74,6 +123,10 @@ public class Bridge {
     /**
      * Set list model data from JSON string.
      *
+     * Safe from any thread: the JSON is parsed on the calling thread and the
+     * rows are handed to the Qt thread, which swaps them in between frames.
+     * If several updates arrive before it does, only the latest is shown.
+     *
      * @param modelName Name of the model
      * @param jsonData JSON array of objects, e.g. [{"name":"A","count":1}]
      */
@@ -94,6 +147,488 @@ public class Bridge {
      */
     public static native int getModelCount(String modelName);
 
+    /**
+     * Destroy a list model and release its storage.
+     *
+     * The QML context property becomes null, so views bound to it empty out.
+     *
+     * @param modelName Name of the model
+     * @return true if the model existed
+     */
+    public static native boolean destroyModel(String modelName);
+
+    /**
+     * Approximate heap footprint of a list model (rows, strings, role tables).
+     *
+     * @param modelName Name of the model
+     * @return Size in bytes, or -1 if the model does not exist
+     */
+    public static native long getModelMemory(String modelName);
+
+    /**
+     * Memory breakdown of every model as a JSON object string:
+     * {name: {"total", "rows", "strings", "roles", "budget"}}, in bytes.
+     *
+     * @return JSON report
+     */
+    public static native String getModelMemoryReport();
+
+    /**
+     * Set a memory budget for a list model.
+     *
+     * When the model's footprint goes above the budget, a warning is logged
+     * and the signal "modelMemoryBudgetExceeded" is emitted with the model
+     * name, its size and the budget as arguments.
+     *
+     * @param modelName Name of the model
+     * @param bytes Budget in bytes, 0 to disable
+     */
+    public static native void setModelMemoryBudget(String modelName, long bytes);
+
+    /**
+     * Index a list model's rows by a key role for patchModel.
+     *
+     * @param modelName Model name
+     * @param role Role whose value identifies a row; empty removes the index
+     * @return false if the model does not exist
+     */
+    public static native boolean setModelKey(String modelName, String role);
+
+    /**
+     * Set one field of one row, found by key.
+     *
+     * @param modelName Model name (keyed with setModelKey)
+     * @param key Key of the row (string form of the key role's value)
+     * @param role Role to set
+     * @param jsonValue New value as JSON (e.g. "42", "\"text\"", "null")
+     * @return false if no row has the key or the value is not valid JSON;
+     *         called off the Qt thread, the patch is queued and true returned
+     */
+    public static native boolean patchModel(String modelName, String key, String role, String jsonValue);
+
+    /**
+     * Set several fields by key in one call.
+     *
+     * @param modelName Model name (keyed with setModelKey)
+     * @param jsonPatches JSON array of [key, role, value] triples
+     * @return Patches applied, or -1 if the model does not exist or the JSON is invalid
+     */
+    public static native int patchModelMany(String modelName, String jsonPatches);
+
+    /**
+     * Apply an RFC 6902 JSON Patch to a model's rows: "/3" addresses a row
+     * ("/-" appends) and "/3/name" a role in it. Views see row inserts,
+     * removals and moves rather than a reset.
+     *
+     * @param modelName Model name
+     * @param jsonPatch JSON array of operations, e.g. [{"op":"remove","path":"/0"}]
+     * @return false (and nothing applied) if any operation fails
+     */
+    public static native boolean applyModelPatch(String modelName, String jsonPatch);
+
+    /**
+     * Replace the rows of an Arrow-backed list model with a record batch
+     * exported through the Arrow C Data Interface. The model is created and
+     * registered as a QML context property on first use; each column becomes a
+     * role and is read in place, without conversion.
+     *
+     * <p>Ownership of the batch always passes to the bridge (the structs are
+     * moved and marked released); it is released when the model's rows are
+     * replaced or the model is destroyed. Close the Java-side struct wrappers
+     * afterwards as usual:
+     *
+     * <pre>
+     * try (ArrowSchema schema = ArrowSchema.allocateNew(allocator);
+     *      ArrowArray array = ArrowArray.allocateNew(allocator)) {
+     *     Data.exportVectorSchemaRoot(allocator, root, null, array, schema);
+     *     Bridge.setArrowModelData("trades", schema.memoryAddress(), array.memoryAddress());
+     * }
+     * </pre>
+     *
+     * @param modelName Name of the model (context property)
+     * @param schemaAddress Address of a struct ArrowSchema (format "+s")
+     * @param arrayAddress Address of the matching struct ArrowArray
+     * @return false if the batch is not a record batch (it is released anyway)
+     */
+    public static native boolean setArrowModelData(String modelName, long schemaAddress, long arrayAddress);
+
+    /**
+     * Append an exported Arrow record batch to an Arrow-backed list model
+     * (rows are inserted, not reset). Columns must match the model's.
+     * Ownership passes to the bridge as with {@link #setArrowModelData}.
+     *
+     * @param modelName Name of the model
+     * @param schemaAddress Address of a struct ArrowSchema
+     * @param arrayAddress Address of the matching struct ArrowArray
+     * @return false if the batch was rejected (it is released anyway)
+     */
+    public static native boolean appendArrowModelData(String modelName, long schemaAddress, long arrayAddress);
+
+    /**
+     * Destroy an Arrow-backed list model. Its batches are released through
+     * their release callbacks.
+     *
+     * @param modelName Name of the model
+     * @return false if no Arrow model has that name
+     */
+    public static native boolean destroyArrowModel(String modelName);
+
+    /**
+     * Open a column file as a memory-mapped list model.
+     *
+     * @param modelName Model name (QML context property)
+     * @param path Column file written by the JVM (see MappedListModel)
+     * @return false if the file cannot be opened or has a bad header
+     */
+    public static native boolean openMappedModel(String modelName, String path);
+
+    /**
+     * Show segments appended to a mapped model's file.
+     *
+     * @param modelName Model name
+     * @param rows Row count after the last append, or -1 for every complete segment
+     * @return Rows now shown, or -1 if the model does not exist
+     */
+    public static native int refreshMappedModel(String modelName, long rows);
+
+    /**
+     * Destroy a mapped model and unmap its file.
+     *
+     * @param modelName Model name
+     * @return false if no such model
+     */
+    public static native boolean destroyMappedModel(String modelName);
+
+    /**
+     * Create a filter-as-you-type view of a model.
+     *
+     * @param filterName Name of the view (QML context property)
+     * @param sourceName Model to filter
+     * @param roles Roles whose text is searched
+     * @return false if the name is taken or the source does not exist
+     */
+    public static native boolean createFilterModel(String filterName, String sourceName, String[] roles);
+
+    /**
+     * Set a filter view's query (case-insensitive substring).
+     *
+     * @param filterName Filter view name
+     * @param query Text to match; empty shows every row
+     * @return Matching rows, or -1 if the view does not exist
+     */
+    public static native int setFilterQuery(String filterName, String query);
+
+    /**
+     * Destroy a filter view and its index.
+     *
+     * @param filterName Filter view name
+     * @return false if no such view
+     */
+    public static native boolean destroyFilterModel(String filterName);
+
+    /**
+     * Create a selection view of a model (source rows plus an isSelected role).
+     *
+     * @param selectionName Name of the view (QML context property)
+     * @param sourceName Model to select from
+     * @return false if the name is taken or the source does not exist
+     */
+    public static native boolean createSelectionModel(String selectionName, String sourceName);
+
+    /**
+     * Edit a selection.
+     *
+     * @param selectionName Selection view name
+     * @param op One of the SELECTION_* constants
+     * @param first First row (ignored by SELECTION_ALL, _CLEAR and _INVERT)
+     * @param last Last row, inclusive
+     * @return Selected row count, or -1 if the view does not exist
+     */
+    public static native int changeSelection(String selectionName, int op, int first, int last);
+
+    /**
+     * Read a selection in one call.
+     *
+     * @param selectionName Selection view name
+     * @return Sorted inclusive ranges as first, last pairs (empty if none)
+     */
+    public static native int[] getSelectionRanges(String selectionName);
+
+    /**
+     * Destroy a selection view.
+     *
+     * @param selectionName Selection view name
+     * @return false if no such view
+     */
+    public static native boolean destroySelectionModel(String selectionName);
+
+    /**
+     * Publish an image for QML as {@code image://jvm/<id>}.
+     *
+     * The pixels are used in place, without copying: the buffer must be
+     * direct and must not be written to after this call (allocate a new
+     * one per image). It is released once the image is evicted or replaced
+     * and no longer on screen.
+     *
+     * QML reuses the texture while the URL is unchanged; append the returned
+     * generation to refresh an id: {@code "image://jvm/chart?v=" + generation}.
+     *
+     * @param id Image id
+     * @param pixels Direct ByteBuffer with the pixel rows
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param stride Bytes per row, or 0 for tightly packed rows
+     * @param format One of the IMAGE_FORMAT_* constants
+     * @return Generation of the stored image, or -1 if it was rejected
+     */
+    public static native long putImage(String id, ByteBuffer pixels, int width, int height,
+                                       int stride, int format);
+
+    /**
+     * Remove an image published with {@link #putImage}.
+     *
+     * @param id Image id
+     * @return true if the image was cached
+     */
+    public static native boolean removeImage(String id);
+
+    /**
+     * Set the byte budget of the image cache behind {@code image://jvm/}
+     * (default 256 MiB). Least recently used images are evicted first.
+     *
+     * @param bytes Budget in bytes
+     */
+    public static native void setImageCacheBudget(long bytes);
+
+    /**
+     * Configure the native thumbnail pipeline behind {@code image://thumbs/<path>}.
+     *
+     * Hit, miss, cancel and decode-time statistics are in {@link #getMetrics}
+     * under the "thumbs." prefix.
+     *
+     * @param cacheDir Disk cache directory, "" to disable it, null to keep the current one
+     * @param threads Decoder threads, or 0 to keep the current count
+     * @param memoryBudget Bytes of decoded thumbnails kept in memory, or -1 to keep it
+     */
+    public static native void configureThumbnails(String cacheDir, int threads, long memoryBudget);
+
+    /**
+     * Replace the nodes of a {@code NodeCanvas} declared in QML
+     * ({@code import Cuirq 1.0; NodeCanvas { name: "graph" }}).
+     *
+     * Existing edges are kept when both of their nodes still exist.
+     *
+     * @param canvas Canvas name
+     * @param ids Node ids
+     * @param rects x, y, width, height per node
+     * @param colors ARGB body color per node (may be null)
+     * @param ports Input and output port counts per node (may be null)
+     * @param labels Label per node (may be null)
+     * @return false if no canvas has that name
+     */
+    public static native boolean setCanvasNodes(String canvas, int[] ids, float[] rects,
+                                                int[] colors, int[] ports, String[] labels);
+
+    /**
+     * Replace the edges of a {@code NodeCanvas}.
+     *
+     * @param canvas Canvas name
+     * @param edges fromId, fromPort, toId, toPort per edge
+     * @param colors ARGB color per edge (may be null)
+     * @return false if no canvas has that name
+     */
+    public static native boolean setCanvasEdges(String canvas, int[] edges, int[] colors);
+
+    /**
+     * Move nodes of a {@code NodeCanvas} by id. Only the moved nodes and
+     * their edges are rewritten in the scene graph.
+     *
+     * @param canvas Canvas name
+     * @param ids Node ids
+     * @param positions x, y per id
+     * @return Number of ids found
+     */
+    public static native int moveCanvasNodes(String canvas, int[] ids, float[] positions);
+
+    /**
+     * Hit-test a {@code NodeCanvas} through its spatial index.
+     *
+     * @param canvas Canvas name
+     * @param x X in canvas coordinates
+     * @param y Y in canvas coordinates
+     * @return Id of the topmost node at the point, or -1
+     */
+    public static native int queryCanvasPoint(String canvas, float x, float y);
+
+    /**
+     * Ids of the {@code NodeCanvas} nodes overlapping a rect, in draw order.
+     *
+     * @param canvas Canvas name
+     * @param x Left edge in canvas coordinates
+     * @param y Top edge in canvas coordinates
+     * @param width Rect width
+     * @param height Rect height
+     * @return Node ids (empty if no canvas has that name)
+     */
+    public static native int[] queryCanvasRect(String canvas, float x, float y, float width, float height);
+
+    /**
+     * Ids of the {@code NodeCanvas} nodes whose center lies inside a lasso
+     * polygon, in draw order.
+     *
+     * @param canvas Canvas name
+     * @param points x, y per polygon vertex
+     * @return Node ids (empty if no canvas has that name)
+     */
+    public static native int[] queryCanvasPolygon(String canvas, float[] points);
+
+    /**
+     * Append points to the stroke in progress on a {@code StrokeCanvas}
+     * ({@code import Cuirq 1.0; StrokeCanvas { name: "sketch" }}), starting
+     * a new stroke if none is in progress. Only the new segments are
+     * tessellated on the next frame.
+     *
+     * @param canvas Canvas name
+     * @param points x, y per point
+     * @param color ARGB color, used when a stroke is started
+     * @param width Pen width, used when a stroke is started
+     * @param end Finish the stroke after these points
+     * @return Number of points added (points closer than half a pixel are dropped)
+     */
+    public static native int appendStrokePoints(String canvas, float[] points, int color,
+                                                float width, boolean end);
+
+    /**
+     * Undo the last stroke of a {@code StrokeCanvas}, or discard the one in
+     * progress. Only the tiles it covered are repainted.
+     *
+     * @param canvas Canvas name
+     * @return false if there was nothing to undo
+     */
+    public static native boolean undoStroke(String canvas);
+
+    /**
+     * Redo the last undone stroke of a {@code StrokeCanvas}.
+     *
+     * @param canvas Canvas name
+     * @return false if there was nothing to redo
+     */
+    public static native boolean redoStroke(String canvas);
+
+    /**
+     * Remove all strokes and the undo history of a {@code StrokeCanvas}.
+     *
+     * @param canvas Canvas name
+     * @return false if no canvas has that name
+     */
+    public static native boolean clearStrokes(String canvas);
+
+    /**
+     * Replace a series of a {@code TimeSeriesChart} declared in QML
+     * ({@code import Cuirq 1.0; TimeSeriesChart { name: "cpu" }}),
+     * creating it if needed. Points are copied into native storage.
+     *
+     * @param chart Chart name
+     * @param series Series id
+     * @param x Non-decreasing x values, or null to use the point index
+     * @param y y values (NaN leaves a value out of min/max)
+     * @return false if no chart has that name
+     */
+    public static native boolean setSeriesData(String chart, String series, double[] x, double[] y);
+
+    /**
+     * Append points to a {@code TimeSeriesChart} series. Only the tail of
+     * its min/max pyramid is updated.
+     *
+     * @param chart Chart name
+     * @param series Series id
+     * @param x Non-decreasing x values continuing the series, or null
+     * @param y y values
+     * @return false if no chart has that name
+     */
+    public static native boolean appendSeriesData(String chart, String series, double[] x, double[] y);
+
+    /**
+     * Append points from direct buffers (e.g.
+     * {@code ByteBuffer.allocateDirect(n * 8).order(ByteOrder.nativeOrder()).asDoubleBuffer()}),
+     * read from index 0 regardless of position.
+     *
+     * @param chart Chart name
+     * @param series Series id
+     * @param x Direct buffer of x values, or null
+     * @param y Direct buffer of y values
+     * @param count Number of points to read
+     * @return false if no chart has that name or a buffer is not direct or too small
+     */
+    public static native boolean appendSeriesBuffer(String chart, String series,
+                                                    DoubleBuffer x, DoubleBuffer y, int count);
+
+    /**
+     * Set the line color of a {@code TimeSeriesChart} series.
+     *
+     * @param chart Chart name
+     * @param series Series id
+     * @param color ARGB color
+     * @return false if no chart has that name
+     */
+    public static native boolean setSeriesColor(String chart, String series, int color);
+
+    /**
+     * Remove a {@code TimeSeriesChart} series.
+     *
+     * @param chart Chart name
+     * @param series Series id
+     * @return false if the chart or series does not exist
+     */
+    public static native boolean removeSeries(String chart, String series);
+
+    /**
+     * Show a file in a {@code LogView}. The file is memory-mapped and its
+     * lines indexed on a background thread; progress arrives as
+     * {@code logViewIndexed} signals (view, lines, bytes, done) and an
+     * in-place truncation as {@code logViewTruncated} (view).
+     *
+     * @param view LogView name
+     * @param path Local file path
+     * @param follow Keep indexing appended data and stick to the end (tail -f)
+     * @return false if no view has that name
+     */
+    public static native boolean openLogView(String view, String path, boolean follow);
+
+    /**
+     * Search the indexed part of a {@code LogView} file in the background,
+     * cancelling the previous search. Matches stream in as
+     * {@code logViewMatches} signals (view, id, then line, column, length
+     * per match) followed by one {@code logViewSearchFinished}
+     * (view, id, total, cancelled).
+     *
+     * @param view LogView name
+     * @param pattern Text or regular expression
+     * @param regex Treat the pattern as a regular expression
+     * @param caseSensitive Match case
+     * @return The search id, or -1 if the view does not exist or the pattern is invalid
+     */
+    public static native int searchLogView(String view, String pattern, boolean regex, boolean caseSensitive);
+
+    /**
+     * Cancel the running search of a {@code LogView}. Matches found so far
+     * are kept.
+     *
+     * @param view LogView name
+     * @return false if no view has that name
+     */
+    public static native boolean cancelLogSearch(String view);
+
+    /**
+     * Scroll a {@code LogView} so {@code line} (0-based) is the first
+     * visible line.
+     *
+     * @param view LogView name
+     * @param line Line index, clamped to the file
+     * @return false if no view has that name
+     */
+    public static native boolean scrollLogView(String view, long line);
+
     /**
      * Enable or disable automatic QML hot-reload (dev mode).
      *
@@ -108,6 +643,152 @@ public class Bridge {
      */
     public static native boolean isAutoReloadEnabled();
 
+    /**
+     * Snapshot of the bridge's runtime metrics as a JSON object string.
+     *
+     * Keys: "counters" (JNI calls per native, bytes marshaled, model resets),
+     * "gauges", "histograms" (latencies in nanoseconds with count, mean,
+     * max, p50, p90, p99, p999) and "models" (per-model statistics).
+     *
+     * @return JSON snapshot
+     */
+    public static native String getMetrics();
+
+    /**
+     * Reset all counters and histograms.
+     */
+    public static native void resetMetrics();
+
+    /**
+     * Enable or disable span tracing (spans from C++, QML and the JVM).
+     *
+     * @param enabled true to start recording spans
+     */
+    public static native void setTracingEnabled(boolean enabled);
+
+    /**
+     * Check if span tracing is enabled.
+     *
+     * @return true if spans are being recorded
+     */
+    public static native boolean isTracingEnabled();
+
+    /**
+     * Open a span on the calling thread. Must be paired with traceEnd().
+     *
+     * @param name Span name (keep low-cardinality; names are interned)
+     * @param category Span category, e.g. "clj" (null for "jvm")
+     */
+    public static native void traceBegin(String name, String category);
+
+    /**
+     * Close the innermost span opened on the calling thread.
+     */
+    public static native void traceEnd();
+
+    /**
+     * Name the calling thread in the trace.
+     *
+     * @param name Thread name shown in the trace viewer
+     */
+    public static native void setTraceThreadName(String name);
+
+    /**
+     * Write buffered spans as Chrome trace JSON (open in ui.perfetto.dev).
+     *
+     * @param path Output file path
+     * @return true if the file was written
+     */
+    public static native boolean dumpTrace(String path);
+
+    /**
+     * Drop all buffered spans.
+     */
+    public static native void clearTrace();
+
+    /**
+     * Set the log level for all cuirq.* categories.
+     *
+     * Levels below the one compiled in (CMake CUIRQ_LOG_LEVEL) are
+     * accepted but produce no output.
+     *
+     * @param level "trace", "debug", "info", "warning" or "error"
+     * @return false if the level name is unknown
+     */
+    public static native boolean setLogLevel(String level);
+
+    /**
+     * Get the current log level.
+     *
+     * @return Level name, e.g. "info"
+     */
+    public static native String getLogLevel();
+
+    /**
+     * Apply Qt logging filter rules on top of the log level.
+     *
+     * Example: "cuirq.model.debug=true" to open up a single category.
+     *
+     * @param rules Newline-separated QLoggingCategory rules
+     */
+    public static native void setLogFilterRules(String rules);
+
+    /**
+     * Start or stop the GUI-thread stall watchdog.
+     *
+     * A stall is reported when the Qt event loop does not run for longer
+     * than the threshold, together with the bridge operation or signal
+     * that was in progress.
+     *
+     * @param thresholdMs Stall threshold in milliseconds (0 stops the watchdog)
+     * @param captureJavaStack Also capture the Java stack of the GUI thread
+     */
+    public static native void setStallWatchdog(long thresholdMs, boolean captureJavaStack);
+
+    /**
+     * Set the callback for stall reports.
+     *
+     * Called on the watchdog thread, not on the (stalled) GUI thread.
+     *
+     * @param handler Callback, or null to remove
+     */
+    public static native void setStallHandler(StallHandler handler);
+
+    /**
+     * Start recording bridge traffic (state, models, signals, loads and
+     * reloads, with timestamps) to a compact binary log.
+     *
+     * Replay it without a JVM: cuirq_replay session.cuirqrec --qml ui/main.qml
+     *
+     * @param path Output file (truncated)
+     * @return true if recording started
+     */
+    public static native boolean startRecording(String path);
+
+    /**
+     * Stop recording and close the log.
+     */
+    public static native void stopRecording();
+
+    /**
+     * Check if bridge traffic is being recorded.
+     *
+     * @return true while recording
+     */
+    public static native boolean isRecording();
+
+    /**
+     * Show or hide the performance HUD (FPS, frame-time graph, JNI calls/s,
+     * log queue depth, model resets, last reload time).
+     *
+     * Overlays a HUD on every window unless the scene declares its own
+     * (import Cuirq 1.0; PerfHud {}).
+     *
+     * @param visible Whether to show the HUD
+     * @return false if the HUD is compiled out of this build
+     */
+    public static native boolean setPerfHudVisible(boolean visible);
+
     /**
      * Functional interface for signal callbacks from QML.
      */
@@ -120,4 +801,26 @@ public class Bridge {
          */
         void handle(String[] args);
     }
+
+    /**
+     * Callback for GUI-thread stalls.
+     */
+    @FunctionalInterface
+    public interface StallHandler {
+        /**
+         * Report a stall.
+         *
+         * Called once when a stall is detected (recovered = false, with the
+         * time stalled so far) and once when the event loop runs again
+         * (recovered = true, with the total stall time).
+         *
+         * @param operation Bridge operation in progress, e.g. "setModelData",
+         *                  "signal", "reload" or "event-loop"
+         * @param detail Signal name or file path, or null
+         * @param durationMs Stall duration in milliseconds
+         * @param recovered Whether the GUI thread is running again
+         * @param javaStack Java stack of the GUI thread, or null
+         */
+        void onStall(String operation, String detail, long durationMs, boolean recovered, String javaStack);
+    }
 }
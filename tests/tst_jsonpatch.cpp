@@ -0,0 +1,347 @@
+/**
+ * RFC 6902 JSON Patch over QVariant documents, and its use by
+ * JvmListModel::applyJsonPatch().
+ *
+ * Covers every operation, RFC 6901 pointer parsing (~0 / ~1 escapes,
+ * "-" for append), rejected pointers and patches, and that a model patch
+ * which fails halfway leaves the rows exactly as they were.
+ */
+
+#include "jsonpatch.h"
+#include "jvmlistmodel.h"
+
+#include <QJsonDocument>
+#include <QTest>
+
+namespace {
+
+QVariant json(const char* text)
+{
+    // Wrapped in an array so scalars parse too
+    const QJsonDocument doc = QJsonDocument::fromJson(QByteArray("[") + text + "]");
+    return doc.array().at(0).toVariant();
+}
+
+QJsonArray patchDocument(const char* text)
+{
+    return QJsonDocument::fromJson(QByteArray(text)).array();
+}
+
+// Parse and apply `patch` in order; stops at the first failing operation
+bool applyPatch(QVariant& document, const char* patch, QString* error = nullptr)
+{
+    QVector<JsonPatch::Operation> operations;
+    if (!JsonPatch::parse(patchDocument(patch), &operations, error)) {
+        return false;
+    }
+    for (const JsonPatch::Operation& operation : std::as_const(operations)) {
+        if (!JsonPatch::apply(document, operation, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameJson(const QVariant& actual, const char* expected)
+{
+    return JsonPatch::equal(actual, json(expected));
+}
+
+} // namespace
+
+class TestJsonPatch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsePointer_data()
+    {
+        QTest::addColumn<QString>("pointer");
+        QTest::addColumn<QStringList>("tokens");
+        QTest::newRow("whole document") << QString() << QStringList();
+        QTest::newRow("empty key") << QStringLiteral("/") << QStringList{ QString() };
+        QTest::newRow("nested") << QStringLiteral("/a/0/b") << QStringList{ "a", "0", "b" };
+        QTest::newRow("~1 is /") << QStringLiteral("/a~1b") << QStringList{ "a/b" };
+        QTest::newRow("~0 is ~") << QStringLiteral("/m~0n") << QStringList{ "m~n" };
+        QTest::newRow("~01 is ~1") << QStringLiteral("/~01") << QStringList{ "~1" };
+        QTest::newRow("~10 is /0") << QStringLiteral("/~10") << QStringList{ "/0" };
+        QTest::newRow("empty tokens") << QStringLiteral("/a//b/") << QStringList{ "a", "", "b", "" };
+    }
+
+    void parsePointer()
+    {
+        QFETCH(QString, pointer);
+        QFETCH(QStringList, tokens);
+        QStringList parsed;
+        QVERIFY(JsonPatch::parsePointer(pointer, &parsed));
+        QCOMPARE(parsed, tokens);
+        QCOMPARE(JsonPatch::pointer(parsed), pointer);
+    }
+
+    void invalidPointer_data()
+    {
+        QTest::addColumn<QString>("pointer");
+        QTest::newRow("no leading slash") << QStringLiteral("a/b");
+        QTest::newRow("bare ~") << QStringLiteral("/a~");
+        QTest::newRow("~2") << QStringLiteral("/a~2b");
+        QTest::newRow("~ before slash") << QStringLiteral("/a~/b");
+    }
+
+    void invalidPointer()
+    {
+        QFETCH(QString, pointer);
+        QStringList parsed;
+        QVERIFY(!JsonPatch::parsePointer(pointer, &parsed));
+    }
+
+    void arrayIndex_data()
+    {
+        QTest::addColumn<QString>("token");
+        QTest::addColumn<bool>("allowEnd");
+        QTest::addColumn<int>("index");
+        QTest::newRow("first") << QStringLiteral("0") << false << 0;
+        QTest::newRow("last") << QStringLiteral("2") << false << 2;
+        QTest::newRow("past the end") << QStringLiteral("3") << false << -1;
+        QTest::newRow("end allowed") << QStringLiteral("3") << true << 3;
+        QTest::newRow("- appends") << QStringLiteral("-") << true << 3;
+        QTest::newRow("- not allowed") << QStringLiteral("-") << false << -1;
+        QTest::newRow("leading zero") << QStringLiteral("01") << false << -1;
+        QTest::newRow("negative") << QStringLiteral("-1") << true << -1;
+        QTest::newRow("not a number") << QStringLiteral("1a") << false << -1;
+        QTest::newRow("empty") << QString() << true << -1;
+        QTest::newRow("huge") << QStringLiteral("99999999999") << true << -1;
+    }
+
+    void arrayIndex()
+    {
+        QFETCH(QString, token);
+        QFETCH(bool, allowEnd);
+        QFETCH(int, index);
+        QCOMPARE(JsonPatch::arrayIndex(token, 3, allowEnd), index);
+    }
+
+    void add()
+    {
+        QVariant doc = json(R"({"a": 1, "list": [1, 2]})");
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/b", "value": {"c": true}}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/a", "value": "replaced"}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/list/0", "value": 0}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/list/3", "value": 3}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/list/-", "value": 4}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/b/d~1e", "value": null}])"));
+        QVERIFY(sameJson(doc, R"({"a": "replaced", "b": {"c": true, "d/e": null}, "list": [0, 1, 2, 3, 4]})"));
+
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "", "value": [1]}])"));
+        QVERIFY(sameJson(doc, "[1]"));
+    }
+
+    void addFails_data()
+    {
+        QTest::addColumn<QString>("patch");
+        QTest::addColumn<QString>("reason");
+        QTest::newRow("missing parent") << R"([{"op": "add", "path": "/x/y", "value": 1}])"
+                                        << "parent does not exist";
+        QTest::newRow("scalar parent") << R"([{"op": "add", "path": "/a/y", "value": 1}])"
+                                       << "parent is not an object or array";
+        QTest::newRow("index past end") << R"([{"op": "add", "path": "/list/3", "value": 1}])"
+                                        << "array index out of range";
+        QTest::newRow("leading zero") << R"([{"op": "add", "path": "/list/01", "value": 1}])"
+                                      << "array index out of range";
+    }
+
+    void addFails()
+    {
+        QFETCH(QString, patch);
+        QFETCH(QString, reason);
+        const QVariant original = json(R"({"a": 1, "list": [1, 2]})");
+        QVariant doc = original;
+        QString error;
+        QVERIFY(!applyPatch(doc, patch.toUtf8().constData(), &error));
+        QCOMPARE(error, reason);
+        QCOMPARE(doc, original);
+    }
+
+    void remove()
+    {
+        QVariant doc = json(R"({"a": 1, "b": {"c": 2}, "list": [1, 2, 3]})");
+        QVERIFY(applyPatch(doc, R"([{"op": "remove", "path": "/a"}, {"op": "remove", "path": "/list/1"}])"));
+        QVERIFY(sameJson(doc, R"({"b": {"c": 2}, "list": [1, 3]})"));
+
+        QString error;
+        QVERIFY(!applyPatch(doc, R"([{"op": "remove", "path": "/a"}])", &error));
+        QCOMPARE(error, QStringLiteral("member does not exist"));
+        QVERIFY(!applyPatch(doc, R"([{"op": "remove", "path": "/list/-"}])", &error));
+        QCOMPARE(error, QStringLiteral("array index out of range"));
+        QVERIFY(!applyPatch(doc, R"([{"op": "remove", "path": ""}])", &error));
+        QCOMPARE(error, QStringLiteral("cannot remove the whole document"));
+        QVERIFY(sameJson(doc, R"({"b": {"c": 2}, "list": [1, 3]})"));
+    }
+
+    void replace()
+    {
+        QVariant doc = json(R"({"a": 1, "list": [1, 2]})");
+        QVERIFY(applyPatch(doc, R"([{"op": "replace", "path": "/a", "value": [true]},
+                                    {"op": "replace", "path": "/list/1", "value": "two"}])"));
+        QVERIFY(sameJson(doc, R"({"a": [true], "list": [1, "two"]})"));
+
+        QString error;
+        QVERIFY(!applyPatch(doc, R"([{"op": "replace", "path": "/missing", "value": 1}])", &error));
+        QCOMPARE(error, QStringLiteral("target does not exist"));
+        QVERIFY(!applyPatch(doc, R"([{"op": "replace", "path": "/list/2", "value": 1}])", &error));
+        QCOMPARE(error, QStringLiteral("target does not exist"));
+    }
+
+    void move()
+    {
+        QVariant doc = json(R"({"a": {"b": 1}, "list": [1, 2, 3]})");
+        QVERIFY(applyPatch(doc, R"([{"op": "move", "from": "/a/b", "path": "/c"}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "move", "from": "/list/0", "path": "/list/-"}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "move", "from": "/list/0", "path": "/a/x"}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "move", "from": "/c", "path": "/c"}])"));
+        QVERIFY(sameJson(doc, R"({"a": {"x": 2}, "c": 1, "list": [3, 1]})"));
+
+        QString error;
+        QVERIFY(!applyPatch(doc, R"([{"op": "move", "from": "/missing", "path": "/d"}])", &error));
+        QCOMPARE(error, QStringLiteral("\"from\" does not exist"));
+
+        // A failed add after the remove leaves the source in place
+        QVERIFY(!applyPatch(doc, R"([{"op": "move", "from": "/c", "path": "/nowhere/d"}])", &error));
+        QCOMPARE(error, QStringLiteral("parent does not exist"));
+        QVERIFY(sameJson(doc, R"({"a": {"x": 2}, "c": 1, "list": [3, 1]})"));
+    }
+
+    void copy()
+    {
+        QVariant doc = json(R"({"a": {"b": [1]}, "list": []})");
+        QVERIFY(applyPatch(doc, R"([{"op": "copy", "from": "/a", "path": "/list/-"},
+                                    {"op": "copy", "from": "/a/b/0", "path": "/c"}])"));
+        QVERIFY(sameJson(doc, R"({"a": {"b": [1]}, "c": 1, "list": [{"b": [1]}]})"));
+
+        // The copy is independent of its source
+        QVERIFY(applyPatch(doc, R"([{"op": "add", "path": "/a/b/-", "value": 2}])"));
+        QVERIFY(sameJson(doc, R"({"a": {"b": [1, 2]}, "c": 1, "list": [{"b": [1]}]})"));
+
+        QString error;
+        QVERIFY(!applyPatch(doc, R"([{"op": "copy", "from": "/x", "path": "/y"}])", &error));
+        QCOMPARE(error, QStringLiteral("\"from\" does not exist"));
+    }
+
+    void test()
+    {
+        QVariant doc = json(R"({"n": 1, "s": "x", "o": {"a": 1, "b": [1, 2]}, "z": null})");
+        QVERIFY(applyPatch(doc, R"([{"op": "test", "path": "/n", "value": 1.0}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "test", "path": "/o", "value": {"b": [1, 2], "a": 1}}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "test", "path": "/z", "value": null}])"));
+        QVERIFY(applyPatch(doc, R"([{"op": "test", "path": "/o/b/1", "value": 2}])"));
+
+        QString error;
+        QVERIFY(!applyPatch(doc, R"([{"op": "test", "path": "/s", "value": "y"}])", &error));
+        QCOMPARE(error, QStringLiteral("test failed"));
+        QVERIFY(!applyPatch(doc, R"([{"op": "test", "path": "/n", "value": "1"}])", &error));
+        QCOMPARE(error, QStringLiteral("test failed"));
+        QVERIFY(!applyPatch(doc, R"([{"op": "test", "path": "/o/b", "value": [2, 1]}])", &error));
+        QCOMPARE(error, QStringLiteral("test failed"));
+        QVERIFY(!applyPatch(doc, R"([{"op": "test", "path": "/missing", "value": 1}])", &error));
+        QCOMPARE(error, QStringLiteral("target does not exist"));
+    }
+
+    void invalidPatch_data()
+    {
+        QTest::addColumn<QString>("patch");
+        QTest::addColumn<QString>("error");
+        QTest::newRow("unknown op") << R"([{"op": "frobnicate", "path": "/a"}])"
+                                    << "operation 0: unknown or missing \"op\"";
+        QTest::newRow("missing op") << R"([{"path": "/a"}])"
+                                    << "operation 0: unknown or missing \"op\"";
+        QTest::newRow("missing path") << R"([{"op": "remove"}])"
+                                      << "operation 0: invalid \"path\"";
+        QTest::newRow("path not a string") << R"([{"op": "remove", "path": 3}])"
+                                           << "operation 0: invalid \"path\"";
+        QTest::newRow("bad escape") << R"([{"op": "remove", "path": "/a~2"}])"
+                                    << "operation 0: invalid \"path\"";
+        QTest::newRow("missing value") << R"([{"op": "test", "path": "/a"}, {"op": "add", "path": "/a"}])"
+                                       << "operation 0: missing \"value\"";
+        QTest::newRow("missing from") << R"([{"op": "remove", "path": "/a"}, {"op": "copy", "path": "/a"}])"
+                                      << "operation 1: invalid \"from\"";
+        QTest::newRow("move into itself") << R"([{"op": "move", "from": "/a", "path": "/a/b"}])"
+                                          << "operation 0: cannot move a value into itself";
+    }
+
+    void invalidPatch()
+    {
+        QFETCH(QString, patch);
+        QFETCH(QString, error);
+        QVector<JsonPatch::Operation> operations;
+        QString message;
+        QVERIFY(!JsonPatch::parse(patchDocument(patch.toUtf8().constData()), &operations, &message));
+        QCOMPARE(message, error);
+    }
+
+    void describe()
+    {
+        JsonPatch::Operation operation;
+        operation.type = JsonPatch::Operation::Replace;
+        operation.path = QStringList{ "3", "a/b" };
+        QCOMPARE(JsonPatch::describe(2, operation, QStringLiteral("target does not exist")),
+                 QStringLiteral("operation 2 (replace \"/3/a~1b\"): target does not exist"));
+    }
+
+    void modelPatchIsAtomic()
+    {
+        JvmListModel model;
+        model.setJsonData(QStringLiteral(R"([{"id": 1, "name": "a", "tags": ["x"]}, {"id": 2, "name": "b"}])"));
+        QCOMPARE(model.count(), 2);
+
+        // Valid first operations, then one that fails: nothing is applied
+        QString error;
+        QVERIFY(!model.applyJsonPatch(patchDocument(R"([{"op": "replace", "path": "/0/name", "value": "changed"},
+                                                         {"op": "add", "path": "/-", "value": {"id": 3}},
+                                                         {"op": "remove", "path": "/1"},
+                                                         {"op": "move", "from": "/0", "path": "/1"},
+                                                         {"op": "remove", "path": "/5"}])"),
+                                      &error));
+        QVERIFY(error.startsWith(QStringLiteral("operation 4 (remove \"/5\")")));
+        QCOMPARE(model.count(), 2);
+        QCOMPARE(model.rows().at(0).value(QStringLiteral("name")).toString(), QStringLiteral("a"));
+        QCOMPARE(model.rows().at(1).value(QStringLiteral("name")).toString(), QStringLiteral("b"));
+        QVERIFY(sameJson(model.rows().at(0).value(QStringLiteral("tags")), R"(["x"])"));
+
+        // A failing test operation rejects the patch too
+        QVERIFY(!model.applyJsonPatch(patchDocument(R"([{"op": "remove", "path": "/0"},
+                                                         {"op": "test", "path": "/0/name", "value": "z"}])"),
+                                      &error));
+        QCOMPARE(model.count(), 2);
+
+        // So does a patch that does not parse
+        QVERIFY(!model.applyJsonPatch(patchDocument(R"([{"op": "remove", "path": "/0"}, {"op": "nope"}])"), &error));
+        QCOMPARE(model.count(), 2);
+    }
+
+    void modelPatchRows()
+    {
+        JvmListModel model;
+        model.setJsonData(QStringLiteral(R"([{"id": 1, "name": "a", "tags": ["x"]}, {"id": 2, "name": "b"}])"));
+
+        QString error;
+        QVERIFY2(model.applyJsonPatch(patchDocument(R"([{"op": "add", "path": "/-", "value": {"id": 3, "name": "c"}},
+                                                         {"op": "move", "from": "/2", "path": "/0"},
+                                                         {"op": "add", "path": "/1/tags/-", "value": "y"},
+                                                         {"op": "replace", "path": "/2/name", "value": "B"},
+                                                         {"op": "copy", "from": "/0/name", "path": "/2/alias"},
+                                                         {"op": "test", "path": "/1/id", "value": 1}])"),
+                                      &error),
+                 qPrintable(error));
+        QCOMPARE(model.count(), 3);
+        QCOMPARE(model.rows().at(0).value(QStringLiteral("name")).toString(), QStringLiteral("c"));
+        QVERIFY(sameJson(model.rows().at(1).value(QStringLiteral("tags")), R"(["x", "y"])"));
+        QCOMPARE(model.rows().at(2).value(QStringLiteral("name")).toString(), QStringLiteral("B"));
+        QCOMPARE(model.rows().at(2).value(QStringLiteral("alias")).toString(), QStringLiteral("c"));
+
+        QVERIFY(model.applyJsonPatch(patchDocument(R"([{"op": "remove", "path": "/0"}])"), &error));
+        QCOMPARE(model.count(), 2);
+        QCOMPARE(model.rows().at(0).value(QStringLiteral("name")).toString(), QStringLiteral("a"));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestJsonPatch)
+#include "tst_jsonpatch.moc"
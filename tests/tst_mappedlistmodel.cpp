@@ -0,0 +1,154 @@
+/**
+ * MappedListModel against truncated and forged column files.
+ *
+ * The file comes from another process, so every length in it is untrusted:
+ * a bad header must fail open() and a bad segment must stop the model at
+ * the rows before it, never read outside the mapping.
+ */
+
+#include "mappedlistmodel.h"
+
+#include <QByteArray>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QtEndian>
+
+#include <limits>
+
+namespace {
+
+template <typename T>
+void put(QByteArray& out, T value)
+{
+    const T le = qToLittleEndian(value);
+    out.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+void pad8(QByteArray& out)
+{
+    while (out.size() % 8 != 0) {
+        out.append('\0');
+    }
+}
+
+// Header with one int64 column "n"
+QByteArray header()
+{
+    QByteArray out("CUIRQCF1");
+    put<quint32>(out, 1);
+    put<quint32>(out, 24);
+    put<quint16>(out, 1);
+    put<quint16>(out, 1);
+    out.append("nl");
+    pad8(out);
+    return out;
+}
+
+// One int64 segment holding `values`, declaring `rows` rows
+QByteArray segment(const QVector<qint64>& values, qint64 rows)
+{
+    const qint64 valueBytes = values.size() * qint64(sizeof(qint64));
+    QByteArray out("SEG1");
+    put<quint32>(out, 0);
+    put<qint64>(out, 24 + 24 + valueBytes);
+    put<qint64>(out, rows);
+    put<qint64>(out, 0);
+    put<qint64>(out, valueBytes);
+    put<qint64>(out, 0);
+    for (qint64 v : values) {
+        put<qint64>(out, v);
+    }
+    return out;
+}
+
+} // namespace
+
+class TestMappedListModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        QVERIFY(m_dir.isValid());
+        m_path = m_dir.filePath(QStringLiteral("rows.cuirqcf"));
+    }
+
+    void validFile()
+    {
+        write(header() + segment({ 1, 2, 3 }, 3));
+        MappedListModel model;
+        QVERIFY(model.open(m_path));
+        QCOMPARE(model.count(), 3);
+        QCOMPARE(model.data(model.index(2), Qt::UserRole + 1).toLongLong(), 3);
+    }
+
+    void truncatedHeader()
+    {
+        write(header().left(20));
+        MappedListModel model;
+        QVERIFY(!model.open(m_path));
+        QCOMPARE(model.count(), 0);
+    }
+
+    void forgedHeaderSize()
+    {
+        QByteArray file = header();
+        qToLittleEndian<quint32>(1u << 30, file.data() + 12);
+        write(file);
+        MappedListModel model;
+        QVERIFY(!model.open(m_path));
+    }
+
+    void forgedColumnList()
+    {
+        QByteArray file = header();
+        qToLittleEndian<quint16>(0xffff, file.data() + 16);
+        write(file);
+        MappedListModel model;
+        QVERIFY(!model.open(m_path));
+    }
+
+    void forgedRowCount_data()
+    {
+        QTest::addColumn<qint64>("rows");
+        QTest::newRow("max") << std::numeric_limits<qint64>::max();
+        QTest::newRow("wraps buffer size") << (qint64(1) << 61);
+        QTest::newRow("past bitmap bound") << qint64(8 * 56 + 1);
+        QTest::newRow("past value bound") << qint64(2);
+        QTest::newRow("negative") << qint64(-1);
+    }
+
+    void forgedRowCount()
+    {
+        QFETCH(qint64, rows);
+        // A good segment, then one whose row count its buffers cannot hold
+        write(header() + segment({ 7 }, 1) + segment({ 8 }, rows));
+        MappedListModel model;
+        QVERIFY(model.open(m_path));
+        QCOMPARE(model.count(), 1);
+        QCOMPARE(model.data(model.index(0), Qt::UserRole + 1).toLongLong(), 7);
+    }
+
+    void truncatedSegment()
+    {
+        write(header() + segment({ 1, 2 }, 2).left(40));
+        MappedListModel model;
+        QVERIFY(model.open(m_path));
+        QCOMPARE(model.count(), 0);
+    }
+
+private:
+    void write(const QByteArray& contents)
+    {
+        QFile file(m_path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(file.write(contents), contents.size());
+    }
+
+    QTemporaryDir m_dir;
+    QString m_path;
+};
+
+QTEST_GUILESS_MAIN(TestMappedListModel)
+#include "tst_mappedlistmodel.moc"
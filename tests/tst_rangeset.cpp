@@ -0,0 +1,235 @@
+/**
+ * RangeSet against a plain per-row bitmap.
+ *
+ * After every edit the ranges must stay sorted, disjoint and
+ * non-adjacent, and describe exactly the rows the bitmap holds.
+ */
+
+#include "rangeset.h"
+
+#include <QPair>
+#include <QRandomGenerator>
+#include <QTest>
+
+namespace {
+
+using Ranges = QVector<QPair<int, int>>;
+
+Ranges ranges(const RangeSet& set)
+{
+    Ranges out;
+    for (const RangeSet::Range& r : set.ranges()) {
+        out.append(qMakePair(r.begin, r.end));
+    }
+    return out;
+}
+
+// Rows [0, rows.size()) of the set, checking the range invariants on the way
+bool matches(const RangeSet& set, const QVector<bool>& rows)
+{
+    int count = 0;
+    int previousEnd = -1;
+    for (const RangeSet::Range& r : set.ranges()) {
+        if (r.begin >= r.end || r.begin <= previousEnd) {
+            return false;  // Empty, overlapping, adjacent or unsorted
+        }
+        previousEnd = r.end;
+        count += r.end - r.begin;
+    }
+    if (count != set.count() || previousEnd > rows.size()) {
+        return false;
+    }
+    for (int row = 0; row < rows.size(); ++row) {
+        if (set.contains(row) != rows[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+class TestRangeSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertMerges()
+    {
+        RangeSet set;
+        set.insert(10, 20);
+        set.insert(30, 40);
+        QCOMPARE(ranges(set), (Ranges{ { 10, 20 }, { 30, 40 } }));
+        set.insert(15, 35);
+        QCOMPARE(ranges(set), (Ranges{ { 10, 40 } }));
+        set.insert(0, 5);
+        set.insert(5, 10);  // Adjacent on both sides: one range
+        QCOMPARE(ranges(set), (Ranges{ { 0, 40 } }));
+        set.insert(40, 41);
+        QCOMPARE(ranges(set), (Ranges{ { 0, 41 } }));
+        QCOMPARE(set.count(), 41);
+
+        set.insert(50, 50);  // Empty
+        set.insert(60, 55);
+        QCOMPARE(ranges(set), (Ranges{ { 0, 41 } }));
+    }
+
+    void removeSplits()
+    {
+        RangeSet set;
+        set.insert(0, 100);
+        set.remove(40, 60);
+        QCOMPARE(ranges(set), (Ranges{ { 0, 40 }, { 60, 100 } }));
+        QCOMPARE(set.count(), 80);
+        set.remove(30, 70);
+        QCOMPARE(ranges(set), (Ranges{ { 0, 30 }, { 70, 100 } }));
+        set.remove(0, 30);
+        set.remove(100, 200);
+        QCOMPARE(ranges(set), (Ranges{ { 70, 100 } }));
+        set.remove(0, 1000);
+        QVERIFY(set.isEmpty());
+        QCOMPARE(set.count(), 0);
+    }
+
+    void toggleFlipsAndCoalesces()
+    {
+        RangeSet set;
+        set.insert(10, 20);
+        set.insert(30, 40);
+        set.toggle(15, 35);
+        QCOMPARE(ranges(set), (Ranges{ { 10, 15 }, { 20, 30 }, { 35, 40 } }));
+        set.toggle(15, 20);  // Fills the gap on the left
+        QCOMPARE(ranges(set), (Ranges{ { 10, 30 }, { 35, 40 } }));
+        set.toggle(30, 35);
+        QCOMPARE(ranges(set), (Ranges{ { 10, 40 } }));
+        set.toggle(0, 50);
+        QCOMPARE(ranges(set), (Ranges{ { 0, 10 }, { 40, 50 } }));
+        QCOMPARE(set.count(), 20);
+    }
+
+    void contains()
+    {
+        RangeSet set;
+        set.insert(5, 10);
+        set.insert(20, 21);
+        QVERIFY(!set.contains(4));
+        QVERIFY(set.contains(5));
+        QVERIFY(set.contains(9));
+        QVERIFY(!set.contains(10));
+        QVERIFY(set.contains(20));
+        QVERIFY(!set.contains(21));
+        QVERIFY(!set.contains(-1));
+    }
+
+    void insertRowsShifts()
+    {
+        RangeSet set;
+        set.insert(10, 20);
+        set.insert(30, 40);
+        set.insertRows(15, 5);  // Splits the first range
+        QCOMPARE(ranges(set), (Ranges{ { 10, 15 }, { 20, 25 }, { 35, 45 } }));
+        set.insertRows(25, 2);  // Right after a range: it stays
+        QCOMPARE(ranges(set), (Ranges{ { 10, 15 }, { 20, 25 }, { 37, 47 } }));
+        set.insertRows(0, 3);
+        QCOMPARE(ranges(set), (Ranges{ { 13, 18 }, { 23, 28 }, { 40, 50 } }));
+        QCOMPARE(set.count(), 20);
+    }
+
+    void removeRowsShiftsAndCoalesces()
+    {
+        RangeSet set;
+        set.insert(10, 20);
+        set.insert(30, 40);
+        set.removeRows(20, 10);  // Removing the gap joins the ranges
+        QCOMPARE(ranges(set), (Ranges{ { 10, 30 } }));
+        set.removeRows(5, 10);
+        QCOMPARE(ranges(set), (Ranges{ { 5, 20 } }));
+        QCOMPARE(set.count(), 15);
+        set.removeRows(0, 100);
+        QVERIFY(set.isEmpty());
+    }
+
+    void moveRows()
+    {
+        RangeSet set;
+        set.insert(0, 2);
+        set.insert(5, 6);
+        set.moveRows(5, 1, 2);  // Row 5 to before row 2: joins [0, 2)
+        QCOMPARE(ranges(set), (Ranges{ { 0, 3 } }));
+        set.moveRows(0, 2, 10);  // Rows 0-1 to before row 10
+        QCOMPARE(ranges(set), (Ranges{ { 0, 1 }, { 8, 10 } }));
+        set.moveRows(8, 2, 9);  // Into itself: no-op
+        QCOMPARE(ranges(set), (Ranges{ { 0, 1 }, { 8, 10 } }));
+    }
+
+    void randomAgainstBitmap()
+    {
+        QRandomGenerator random(2024);
+        RangeSet set;
+        QVector<bool> rows(300, false);
+
+        for (int step = 0; step < 5000; ++step) {
+            const int size = rows.size();
+            const int a = random.bounded(size + 1);
+            const int b = random.bounded(size + 1);
+            const int begin = qMin(a, b);
+            const int end = qMax(a, b);
+            switch (random.bounded(6)) {
+            case 0:
+                set.insert(begin, end);
+                std::fill(rows.begin() + begin, rows.begin() + end, true);
+                break;
+            case 1:
+                set.remove(begin, end);
+                std::fill(rows.begin() + begin, rows.begin() + end, false);
+                break;
+            case 2:
+                set.toggle(begin, end);
+                for (int r = begin; r < end; ++r) {
+                    rows[r] = !rows[r];
+                }
+                break;
+            case 3: {
+                const int count = random.bounded(1, 20);
+                set.insertRows(begin, count);
+                rows.insert(begin, count, false);
+                break;
+            }
+            case 4: {
+                const int count = qMin(random.bounded(1, 20), size - begin);
+                set.removeRows(begin, count);
+                rows.remove(begin, count);
+                break;
+            }
+            default: {
+                const int from = random.bounded(size);
+                const int count = random.bounded(1, qMin(20, size - from) + 1);
+                const int to = random.bounded(size + 1);
+                set.moveRows(from, count, to);
+                if (to < from || to > from + count) {
+                    const QVector<bool> block = rows.mid(from, count);
+                    rows.remove(from, count);
+                    const int at = to > from ? to - count : to;
+                    for (int i = 0; i < count; ++i) {
+                        rows.insert(at + i, block[i]);
+                    }
+                }
+                break;
+            }
+            }
+            QVERIFY2(matches(set, rows), qPrintable(QStringLiteral("step %1").arg(step)));
+
+            // Keep the row count in a useful range
+            if (rows.size() < 100) {
+                set.insertRows(rows.size(), 100);
+                rows.insert(rows.size(), 100, false);
+            } else if (rows.size() > 600) {
+                set.removeRows(300, rows.size() - 300);
+                rows.resize(300);
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(TestRangeSet)
+#include "tst_rangeset.moc"
@@ -0,0 +1,253 @@
+/**
+ * RowStore snapshots against plain row vectors.
+ *
+ * A copy of the store (what JvmListModel::rows() hands out) must keep
+ * reading the rows it was taken with while the original is edited, and
+ * the original must match a QVector of the same edits, across chunk
+ * splits and merges.
+ */
+
+#include "rowstore.h"
+#include "jvmlistmodel.h"
+
+#include <QPair>
+#include <QRandomGenerator>
+#include <QTest>
+
+namespace {
+
+using Rows = QVector<QVariantMap>;
+
+QVariantMap row(int id)
+{
+    return QVariantMap{ { QStringLiteral("id"), id } };
+}
+
+Rows rowsOf(const RowStore& store)
+{
+    Rows rows;
+    rows.reserve(store.size());
+    for (const RowStore::Chunk& chunk : store.chunks()) {
+        rows.append(chunk);
+    }
+    return rows;
+}
+
+// Every row through at() and through chunks(), and no empty chunks
+bool matches(const RowStore& store, const Rows& expected)
+{
+    if (store.size() != expected.size() || store.isEmpty() != expected.isEmpty()) {
+        return false;
+    }
+    for (const RowStore::Chunk& chunk : store.chunks()) {
+        if (chunk.isEmpty()) {
+            return false;
+        }
+    }
+    for (int i = 0; i < expected.size(); ++i) {
+        if (store.at(i) != expected.at(i)) {
+            return false;
+        }
+    }
+    return rowsOf(store) == expected;
+}
+
+RowStore filled(int count, Rows* rows)
+{
+    RowStore store;
+    store.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        store.append(row(i));
+        rows->append(row(i));
+    }
+    return store;
+}
+
+} // namespace
+
+class TestRowStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void appendAcrossChunks()
+    {
+        Rows rows;
+        const RowStore store = filled(3 * RowStore::kChunkRows + 5, &rows);
+        QCOMPARE(store.chunks().size(), qsizetype(4));
+        QVERIFY(matches(store, rows));
+    }
+
+    void snapshotSurvivesInsert()
+    {
+        Rows rows;
+        RowStore store = filled(2 * RowStore::kChunkRows, &rows);
+        const RowStore snapshot = store;
+        const Rows before = rows;
+
+        // Enough inserts into one chunk to split it
+        for (int i = 0; i < 2 * RowStore::kChunkRows; ++i) {
+            store.insert(10, row(-i));
+            rows.insert(10, row(-i));
+        }
+        store.insert(store.size(), row(99999));
+        rows.append(row(99999));
+        QVERIFY(store.chunks().size() > 2);
+        QVERIFY(matches(store, rows));
+        QVERIFY(matches(snapshot, before));
+    }
+
+    void snapshotSurvivesRemove()
+    {
+        Rows rows;
+        RowStore store = filled(RowStore::kChunkRows + RowStore::kChunkRows / 2, &rows);
+        const RowStore snapshot = store;
+        const Rows before = rows;
+        QCOMPARE(store.chunks().size(), qsizetype(2));
+
+        // Shrinks the first chunk until it folds into the second
+        while (store.chunks().size() == 2) {
+            store.removeAt(1);
+            rows.removeAt(1);
+        }
+        QCOMPARE(store.chunks().size(), qsizetype(1));
+        QCOMPARE(store.size(), RowStore::kChunkRows / 4 - 1 + RowStore::kChunkRows / 2);
+        QVERIFY(matches(store, rows));
+        QVERIFY(matches(snapshot, before));
+
+        while (!store.isEmpty()) {
+            store.removeAt(0);
+        }
+        QVERIFY(store.chunks().isEmpty());
+        QVERIFY(matches(snapshot, before));
+    }
+
+    void snapshotSurvivesMove()
+    {
+        Rows rows;
+        RowStore store = filled(2 * RowStore::kChunkRows + 7, &rows);
+        const RowStore snapshot = store;
+        const Rows before = rows;
+
+        const QVector<QPair<int, int>> moves = { { 0, 2 * RowStore::kChunkRows + 6 },
+                                                 { 2 * RowStore::kChunkRows, 3 },
+                                                 { 5, 5 },
+                                                 { 100, RowStore::kChunkRows + 100 } };
+        for (const auto& move : moves) {
+            store.move(move.first, move.second);
+            rows.move(move.first, move.second);
+        }
+        QVERIFY(matches(store, rows));
+        QVERIFY(matches(snapshot, before));
+    }
+
+    void snapshotSurvivesEdit()
+    {
+        Rows rows;
+        RowStore store = filled(2 * RowStore::kChunkRows, &rows);
+        const RowStore snapshot = store;
+        const Rows before = rows;
+
+        store.edit(3).insert(QStringLiteral("name"), QStringLiteral("edited"));
+        rows[3].insert(QStringLiteral("name"), QStringLiteral("edited"));
+        store.set(RowStore::kChunkRows + 1, row(-1));
+        rows[RowStore::kChunkRows + 1] = row(-1);
+        QVERIFY(matches(store, rows));
+        QVERIFY(matches(snapshot, before));
+
+        // Snapshots of snapshots are independent too
+        RowStore second = snapshot;
+        second.edit(0).insert(QStringLiteral("name"), QStringLiteral("second"));
+        QVERIFY(matches(snapshot, before));
+        QCOMPARE(store.at(0), before.at(0));
+    }
+
+    void clearKeepsSnapshot()
+    {
+        Rows rows;
+        RowStore store = filled(RowStore::kChunkRows + 1, &rows);
+        const RowStore snapshot = store;
+        store.clear();
+        QVERIFY(store.isEmpty());
+        QVERIFY(matches(store, Rows()));
+        QVERIFY(matches(snapshot, rows));
+    }
+
+    void randomEditsAgainstVector()
+    {
+        QRandomGenerator random(75);
+        Rows rows;
+        RowStore store = filled(RowStore::kChunkRows, &rows);
+        RowStore snapshot = store;
+        Rows snapshotRows = rows;
+        int nextId = rows.size();
+
+        for (int step = 0; step < 20000; ++step) {
+            const int size = rows.size();
+            const int action = size == 0 ? 0 : random.bounded(5);
+            if (action <= 1) {
+                const int at = random.bounded(size + 1);
+                store.insert(at, row(nextId));
+                rows.insert(at, row(nextId));
+                ++nextId;
+            } else if (action == 2) {
+                const int at = random.bounded(size);
+                store.removeAt(at);
+                rows.removeAt(at);
+            } else if (action == 3) {
+                const int from = random.bounded(size);
+                const int to = random.bounded(size);
+                store.move(from, to);
+                rows.move(from, to);
+            } else {
+                const int at = random.bounded(size);
+                store.edit(at).insert(QStringLiteral("step"), step);
+                rows[at].insert(QStringLiteral("step"), step);
+            }
+
+            // Take a fresh snapshot now and then; the old one must not move
+            if (step % 1000 == 999) {
+                QVERIFY(matches(snapshot, snapshotRows));
+                snapshot = store;
+                snapshotRows = rows;
+            }
+        }
+        QVERIFY(matches(store, rows));
+        QVERIFY(matches(snapshot, snapshotRows));
+    }
+
+    void modelRowsSnapshot()
+    {
+        JvmListModel model;
+        model.setJsonData(QStringLiteral(R"([{"id": 0, "name": "a"}, {"id": 1, "name": "b"}, {"id": 2, "name": "c"}])"));
+        const RowStore snapshot = model.rows();
+        const Rows before = rowsOf(snapshot);
+        QCOMPARE(before.size(), qsizetype(3));
+
+        // Insert, remove, move and edit through the model
+        QString error;
+        QVERIFY2(model.applyJsonPatch(QJsonDocument::fromJson(R"([{"op": "add", "path": "/1", "value": {"id": 3}},
+                                                                  {"op": "remove", "path": "/0"},
+                                                                  {"op": "move", "from": "/2", "path": "/0"},
+                                                                  {"op": "add", "path": "/1/name", "value": "z"}])")
+                                          .array(),
+                                      &error),
+                 qPrintable(error));
+        model.setKeyRole(QStringLiteral("id"));
+        QVERIFY(model.patch(QStringLiteral("2"), QStringLiteral("name"), QStringLiteral("patched")));
+        QCOMPARE(model.count(), 3);
+
+        QVERIFY(matches(snapshot, before));
+        QCOMPARE(model.rows().at(0).value(QStringLiteral("name")).toString(), QStringLiteral("patched"));
+        QCOMPARE(model.rows().at(1).value(QStringLiteral("name")).toString(), QStringLiteral("z"));
+        QCOMPARE(model.rows().at(2).value(QStringLiteral("name")).toString(), QStringLiteral("b"));
+
+        // Replacing every row leaves an older snapshot alone as well
+        model.setJsonData(QStringLiteral("[]"));
+        QCOMPARE(model.count(), 0);
+        QVERIFY(matches(snapshot, before));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestRowStore)
+#include "tst_rowstore.moc"
@@ -0,0 +1,238 @@
+/**
+ * SeriesPyramid against direct scans of the raw points.
+ *
+ * Every bucket of every level and arbitrary index ranges must report the
+ * same min/max as a linear pass, however the points were appended.
+ * Decimation must keep the endpoints and the spikes.
+ */
+
+#include "seriespyramid.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+int bucketSize(int level)
+{
+    int size = SeriesPyramid::kBaseBucket;
+    for (int l = 1; l < level; ++l) {
+        size *= SeriesPyramid::kFanout;
+    }
+    return size;
+}
+
+QVector<double> noise(int count, quint32 seed, int nanEvery = 0)
+{
+    QRandomGenerator random(seed);
+    QVector<double> y;
+    y.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        y.append(nanEvery > 0 && i % nanEvery == 0 ? kNaN : random.bounded(1000.0) - 500.0);
+    }
+    return y;
+}
+
+// Min/max over [first, last) by a linear pass, NaN skipped
+SeriesPyramid::Extent scan(const QVector<double>& y, int first, int last)
+{
+    SeriesPyramid::Extent e{ std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), -1, -1 };
+    for (int i = first; i < last; ++i) {
+        if (y[i] < e.min) {
+            e.min = y[i];
+            e.minIndex = i;
+        }
+        if (y[i] > e.max) {
+            e.max = y[i];
+            e.maxIndex = i;
+        }
+    }
+    return e;
+}
+
+} // namespace
+
+class TestSeriesPyramid : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void levelsGrowAtBoundaries()
+    {
+        SeriesPyramid series;
+        const QVector<double> y = noise(1024, 1);
+        int appended = 0;
+        const auto appendUpTo = [&](int count) {
+            series.append(nullptr, y.constData() + appended, count - appended);
+            appended = count;
+        };
+
+        appendUpTo(SeriesPyramid::kBaseBucket - 1);
+        QCOMPARE(series.levelCount(), 0);
+        appendUpTo(bucketSize(1));
+        QCOMPARE(series.levelCount(), 1);
+        appendUpTo(bucketSize(2) - 1);
+        QCOMPARE(series.levelCount(), 1);
+        appendUpTo(bucketSize(2));
+        QCOMPARE(series.levelCount(), 2);
+        appendUpTo(bucketSize(4));
+        QCOMPARE(series.levelCount(), 4);
+        QCOMPARE(series.size(), bucketSize(4));
+        QCOMPARE(series.x(100), 100.0);
+    }
+
+    void levelBucketsMatchScan_data()
+    {
+        QTest::addColumn<int>("chunk");
+        QTest::newRow("one append") << 0;
+        QTest::newRow("single points") << 1;
+        QTest::newRow("odd chunks") << 7;
+        QTest::newRow("straddling chunks") << 100;
+    }
+
+    void levelBucketsMatchScan()
+    {
+        QFETCH(int, chunk);
+
+        // Not a multiple of any bucket, so every level has a partial tail
+        const QVector<double> y = noise(5000, 2, 13);
+        SeriesPyramid series;
+        const int step = chunk > 0 ? chunk : y.size();
+        for (int i = 0; i < y.size(); i += step) {
+            series.append(nullptr, y.constData() + i, qMin(step, int(y.size()) - i));
+        }
+        QCOMPARE(series.size(), int(y.size()));
+        QVERIFY(series.levelCount() >= 4);
+
+        for (int level = 1; level <= series.levelCount(); ++level) {
+            const int size = bucketSize(level);
+            for (int first = 0; first < y.size(); first += size) {
+                const int last = qMin(first + size, int(y.size()));
+                const SeriesPyramid::Extent expected = scan(y, first, last);
+                const SeriesPyramid::Extent actual = series.extent(first, last);
+                QCOMPARE(actual.min, expected.min);
+                QCOMPARE(actual.max, expected.max);
+                QCOMPARE(actual.minIndex, expected.minIndex);
+                QCOMPARE(actual.maxIndex, expected.maxIndex);
+            }
+        }
+    }
+
+    void rangesMatchScan()
+    {
+        const QVector<double> y = noise(20000, 3, 101);
+        SeriesPyramid series;
+        series.append(nullptr, y.constData(), y.size());
+
+        QRandomGenerator random(4);
+        for (int i = 0; i < 2000; ++i) {
+            int first = random.bounded(int(y.size()));
+            int last = random.bounded(int(y.size()) + 1);
+            if (first > last) {
+                std::swap(first, last);
+            }
+            const SeriesPyramid::Extent expected = scan(y, first, last);
+            const SeriesPyramid::Extent actual = series.extent(first, last);
+            QCOMPARE(actual.minIndex >= 0, expected.minIndex >= 0);
+            if (expected.minIndex >= 0) {
+                QCOMPARE(actual.min, expected.min);
+                QCOMPARE(actual.max, expected.max);
+                QCOMPARE(y[actual.minIndex], expected.min);
+                QCOMPARE(y[actual.maxIndex], expected.max);
+            }
+        }
+
+        // Out-of-range bounds are clamped
+        QCOMPARE(series.extent(-10, 1 << 30).min, scan(y, 0, y.size()).min);
+    }
+
+    void nanOnlyRange()
+    {
+        SeriesPyramid series;
+        const QVector<double> y(64, kNaN);
+        series.append(nullptr, y.constData(), y.size());
+        const SeriesPyramid::Extent e = series.extent(0, 64);
+        QCOMPARE(e.minIndex, -1);
+        QCOMPARE(e.maxIndex, -1);
+    }
+
+    void lowerBound()
+    {
+        SeriesPyramid series;
+        const QVector<double> x = { 0, 1, 1, 2, 5, 8 };
+        const QVector<double> y(x.size(), 0.0);
+        series.append(x.constData(), y.constData(), x.size());
+        QCOMPARE(series.lowerBound(-1), 0);
+        QCOMPARE(series.lowerBound(1), 1);
+        QCOMPARE(series.lowerBound(3), 4);
+        QCOMPARE(series.lowerBound(9), 6);
+    }
+
+    void decimateMinMaxKeepsExtremes()
+    {
+        QVector<double> y = noise(100000, 5);
+        y[12345] = 1e6;
+        y[67890] = -1e6;
+        SeriesPyramid series;
+        series.append(nullptr, y.constData(), y.size());
+
+        const int columns = 200;
+        const QVector<QPointF> points = series.decimateMinMax(0, y.size() - 1, columns);
+        QVERIFY(points.size() <= 4 * columns + 2);
+        QCOMPARE(points.first(), QPointF(0, y[0]));
+        QCOMPARE(points.last(), QPointF(y.size() - 1, y.last()));
+        QVERIFY(points.contains(QPointF(12345, 1e6)));
+        QVERIFY(points.contains(QPointF(67890, -1e6)));
+        for (int i = 1; i < points.size(); ++i) {
+            QVERIFY(points[i - 1].x() < points[i].x());
+        }
+
+        // Few enough points: returned as is, plus a neighbour on each side
+        const QVector<QPointF> raw = series.decimateMinMax(100, 110, columns);
+        QCOMPARE(raw.size(), 12);
+        QCOMPARE(raw.first(), QPointF(99, y[99]));
+    }
+
+    void lttb()
+    {
+        QVector<double> y(1000, 0.0);
+        y[500] = 100;
+        SeriesPyramid series;
+        series.append(nullptr, y.constData(), y.size());
+
+        const QVector<QPointF> all = series.decimateLttb(0, 999, 2000);
+        QCOMPARE(all.size(), 1000);
+
+        const QVector<QPointF> points = series.decimateLttb(0, 999, 50);
+        QCOMPARE(points.size(), 50);
+        QCOMPARE(points.first(), QPointF(0, 0));
+        QCOMPARE(points.last(), QPointF(999, 0));
+        QVERIFY(points.contains(QPointF(500, 100)));
+        for (int i = 1; i < points.size(); ++i) {
+            QVERIFY(points[i - 1].x() < points[i].x());
+        }
+    }
+
+    void lttbOverMinMaxColumns()
+    {
+        // Past the raw limit LTTB runs on min/max columns; the spike survives
+        QVector<double> y = noise(300000, 6);
+        y[150001] = 1e6;
+        SeriesPyramid series;
+        series.append(nullptr, y.constData(), y.size());
+
+        const QVector<QPointF> points = series.decimateLttb(0, y.size() - 1, 500);
+        QCOMPARE(points.size(), 500);
+        QCOMPARE(points.first(), QPointF(0, y[0]));
+        QCOMPARE(points.last(), QPointF(y.size() - 1, y.last()));
+        QVERIFY(points.contains(QPointF(150001, 1e6)));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestSeriesPyramid)
+#include "tst_seriespyramid.moc"
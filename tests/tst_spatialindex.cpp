@@ -0,0 +1,215 @@
+/**
+ * SpatialIndex against a brute-force scan.
+ *
+ * Every query result is compared with a linear pass over the same rects,
+ * so splits, in-place moves, re-inserts and root growth can't lose or
+ * duplicate an item.
+ */
+
+#include "spatialindex.h"
+
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+
+namespace {
+
+// Same edge rule as the index: touching rects overlap
+bool overlaps(const QRectF& a, const QRectF& b)
+{
+    return a.left() <= b.right() && b.left() <= a.right()
+        && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+QVector<int> sorted(QVector<int> ids)
+{
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+QRectF randomRect(QRandomGenerator& random, qreal extent, qreal maxSize)
+{
+    return QRectF(random.bounded(extent), random.bounded(extent),
+                  random.bounded(maxSize), random.bounded(maxSize));
+}
+
+// Linear reference kept alongside the index
+class Reference
+{
+public:
+    QVector<int> intersecting(const QRectF& area) const
+    {
+        QVector<int> ids;
+        for (auto it = m_rects.constBegin(); it != m_rects.constEnd(); ++it) {
+            if (overlaps(it.value(), area)) {
+                ids.append(it.key());
+            }
+        }
+        return sorted(ids);
+    }
+
+    QVector<int> insidePolygon(const QPolygonF& lasso) const
+    {
+        QVector<int> ids;
+        for (auto it = m_rects.constBegin(); it != m_rects.constEnd(); ++it) {
+            if (lasso.containsPoint(it.value().center(), Qt::OddEvenFill)) {
+                ids.append(it.key());
+            }
+        }
+        return sorted(ids);
+    }
+
+    QHash<int, QRectF> m_rects;
+};
+
+} // namespace
+
+class TestSpatialIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty()
+    {
+        SpatialIndex index;
+        QCOMPARE(index.size(), 0);
+        QVERIFY(index.at(QPointF(0, 0)).isEmpty());
+        QVERIFY(index.intersecting(QRectF(-10, -10, 20, 20)).isEmpty());
+        QVERIFY(!index.remove(1));
+    }
+
+    void insertAndQuery()
+    {
+        SpatialIndex index;
+        index.insert(1, QRectF(0, 0, 10, 10));
+        index.insert(2, QRectF(20, 0, 10, 10));
+        index.insert(3, QRectF(5, 5, 20, 20));
+
+        QCOMPARE(index.size(), 3);
+        QVERIFY(index.contains(2));
+        QCOMPARE(index.rect(3), QRectF(5, 5, 20, 20));
+        QCOMPARE(sorted(index.at(QPointF(7, 7))), (QVector<int>{ 1, 3 }));
+        QCOMPARE(sorted(index.at(QPointF(10, 0))), (QVector<int>{ 1 }));
+        QCOMPARE(sorted(index.intersecting(QRectF(18, 4, 4, 4))), (QVector<int>{ 2, 3 }));
+        QCOMPARE(sorted(index.intersecting(QRectF(40, 40, -60, -60))), (QVector<int>{ 1, 2, 3 }));
+
+        const QPolygonF triangle({ QPointF(0, 0), QPointF(26, 0), QPointF(0, 60) });
+        QCOMPARE(sorted(index.insidePolygon(triangle)), (QVector<int>{ 1, 3 }));
+        QVERIFY(index.insidePolygon(QPolygonF({ QPointF(0, 0), QPointF(40, 0) })).isEmpty());
+    }
+
+    void splitAtCapacity()
+    {
+        // Capacity 4: the fifth item forces a split
+        SpatialIndex index(4);
+        const QVector<QPointF> corners = { QPointF(-400, -400), QPointF(400, -400),
+                                           QPointF(-400, 400), QPointF(400, 400) };
+        int id = 0;
+        for (const QPointF& corner : corners) {
+            index.insert(id++, QRectF(corner, QSizeF(1, 1)));
+        }
+        index.insert(id++, QRectF(-1, -1, 2, 2));  // Straddles both split lines
+        index.insert(id++, QRectF(401, 401, 1, 1));
+        QCOMPARE(index.size(), 6);
+
+        for (int i = 0; i < corners.size(); ++i) {
+            QCOMPARE(index.at(corners[i]), (QVector<int>{ i }));
+        }
+        QCOMPARE(index.at(QPointF(0, 0)), (QVector<int>{ 4 }));
+        QCOMPARE(sorted(index.intersecting(QRectF(390, 390, 20, 20))), (QVector<int>{ 3, 5 }));
+
+        // Drop back below capacity and refill the same quadrant
+        QVERIFY(index.remove(3));
+        QVERIFY(index.remove(5));
+        for (int i = 0; i < 8; ++i) {
+            index.insert(10 + i, QRectF(300 + i * 10, 300, 5, 5));
+        }
+        QCOMPARE(sorted(index.intersecting(QRectF(300, 300, 100, 10))),
+                 (QVector<int>{ 10, 11, 12, 13, 14, 15, 16, 17 }));
+    }
+
+    void growsRoot()
+    {
+        SpatialIndex index;
+        index.insert(1, QRectF(0, 0, 1, 1));
+        index.insert(2, QRectF(-1e6, -1e6, 1, 1));
+        index.insert(3, QRectF(1e6, 5e5, 1, 1));
+        QCOMPARE(index.at(QPointF(0.5, 0.5)), (QVector<int>{ 1 }));
+        QCOMPARE(index.at(QPointF(-1e6, -1e6)), (QVector<int>{ 2 }));
+        QCOMPARE(index.at(QPointF(1e6, 5e5)), (QVector<int>{ 3 }));
+        QCOMPARE(sorted(index.intersecting(QRectF(-2e6, -2e6, 4e6, 4e6))), (QVector<int>{ 1, 2, 3 }));
+    }
+
+    void moveAndRemove()
+    {
+        SpatialIndex index(4);
+        index.insert(1, QRectF(0, 0, 10, 10));
+        index.insert(1, QRectF(2, 2, 10, 10));       // Same quadrant: in place
+        QCOMPARE(index.size(), 1);
+        QCOMPARE(index.rect(1), QRectF(2, 2, 10, 10));
+        index.insert(1, QRectF(5000, 5000, 10, 10)); // Re-inserted past the root
+        QCOMPARE(index.size(), 1);
+        QVERIFY(index.at(QPointF(5, 5)).isEmpty());
+        QCOMPARE(index.at(QPointF(5005, 5005)), (QVector<int>{ 1 }));
+
+        QVERIFY(index.remove(1));
+        QVERIFY(!index.contains(1));
+        QVERIFY(!index.remove(1));
+        QVERIFY(index.intersecting(QRectF(-1e4, -1e4, 2e4, 2e4)).isEmpty());
+    }
+
+    void randomAgainstBruteForce_data()
+    {
+        QTest::addColumn<int>("capacity");
+        QTest::addColumn<int>("maxDepth");
+        QTest::newRow("capacity 1") << 1 << 16;
+        QTest::newRow("capacity 4") << 4 << 16;
+        QTest::newRow("default") << 16 << 16;
+        QTest::newRow("depth capped") << 2 << 3;
+    }
+
+    void randomAgainstBruteForce()
+    {
+        QFETCH(int, capacity);
+        QFETCH(int, maxDepth);
+
+        QRandomGenerator random(1234);
+        SpatialIndex index(capacity, maxDepth);
+        Reference reference;
+
+        for (int step = 0; step < 3000; ++step) {
+            const int id = random.bounded(400);
+            const int action = random.bounded(10);
+            if (action < 6) {
+                // Mostly small moves, sometimes far away
+                const qreal extent = action == 0 ? 20000 : 2000;
+                const QRectF rect = randomRect(random, extent, 60).translated(-extent / 2, -extent / 2);
+                index.insert(id, rect);
+                reference.m_rects.insert(id, rect);
+            } else if (action < 8) {
+                QCOMPARE(index.remove(id), reference.m_rects.remove(id));
+            } else {
+                const QRectF area = randomRect(random, 2000, 400).translated(-1000, -1000);
+                QCOMPARE(sorted(index.intersecting(area)), reference.intersecting(area));
+                QCOMPARE(sorted(index.at(area.topLeft())), reference.intersecting(QRectF(area.topLeft(), QSizeF(0, 0))));
+            }
+            QCOMPARE(index.size(), int(reference.m_rects.size()));
+        }
+
+        for (auto it = reference.m_rects.constBegin(); it != reference.m_rects.constEnd(); ++it) {
+            QCOMPARE(index.rect(it.key()), it.value());
+        }
+        const QPolygonF lasso({ QPointF(-900, -900), QPointF(900, -600), QPointF(0, 0),
+                                QPointF(700, 900), QPointF(-800, 500) });
+        QCOMPARE(sorted(index.insidePolygon(lasso)), reference.insidePolygon(lasso));
+
+        index.clear();
+        QCOMPARE(index.size(), 0);
+        QVERIFY(index.intersecting(QRectF(-1e5, -1e5, 2e5, 2e5)).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(TestSpatialIndex)
+#include "tst_spatialindex.moc"
@@ -0,0 +1,194 @@
+/**
+ * TrigramIndex against a plain substring scan.
+ *
+ * Short queries take the scan path, longer ones the posting lists; both
+ * must agree with QString::contains over the folded texts, including
+ * after row inserts, removals, edits and the compaction they trigger.
+ */
+
+#include "trigramindex.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+namespace {
+
+// Rows whose folded text contains the (folded) query
+QVector<int> scan(const QVector<QString>& texts, const QString& query)
+{
+    QVector<int> rows;
+    for (int r = 0; r < texts.size(); ++r) {
+        if (TrigramIndex::fold(texts[r]).contains(query)) {
+            rows.append(r);
+        }
+    }
+    return rows;
+}
+
+// Short words over a small alphabet, so most trigrams are shared
+QString randomText(QRandomGenerator& random, int maxLength)
+{
+    static const QString alphabet = QStringLiteral("abcABC d");
+    QString text;
+    const int length = random.bounded(maxLength + 1);
+    for (int i = 0; i < length; ++i) {
+        text.append(alphabet[random.bounded(int(alphabet.size()))]);
+    }
+    return text;
+}
+
+} // namespace
+
+class TestTrigramIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void shortQueries_data()
+    {
+        QTest::addColumn<QString>("query");
+        QTest::newRow("empty") << QString();
+        QTest::newRow("one") << QStringLiteral("o");
+        QTest::newRow("two") << QStringLiteral("lo");
+        QTest::newRow("two, absent") << QStringLiteral("zz");
+    }
+
+    void shortQueries()
+    {
+        QFETCH(QString, query);
+        const QVector<QString> texts = { QStringLiteral("Hello"), QStringLiteral("lo"), QString(),
+                                         QStringLiteral("World"), QStringLiteral("o") };
+        TrigramIndex index;
+        index.build(texts);
+        QCOMPARE(index.search(query), scan(texts, query));
+    }
+
+    void caseFolding()
+    {
+        const QVector<QString> texts = { QStringLiteral("Hello World"), QStringLiteral("HELLO"),
+                                         QStringLiteral("yellow"), QStringLiteral("Ärger"),
+                                         QStringLiteral("äRGER") };
+        TrigramIndex index;
+        index.build(texts);
+
+        QCOMPARE(index.search(TrigramIndex::fold(QStringLiteral("HeLLo"))), (QVector<int>{ 0, 1 }));
+        QCOMPARE(index.search(TrigramIndex::fold(QStringLiteral("ELL"))), (QVector<int>{ 0, 1, 2 }));
+        QCOMPARE(index.search(TrigramIndex::fold(QStringLiteral("ÄRG"))), (QVector<int>{ 3, 4 }));
+        QCOMPARE(index.search(TrigramIndex::fold(QStringLiteral("o W"))), (QVector<int>{ 0 }));
+        QVERIFY(index.matches(1, QStringLiteral("hello")));
+        QVERIFY(!index.matches(1, QStringLiteral("HELLO")));  // Queries arrive folded
+    }
+
+    void longerQueriesConfirmed()
+    {
+        // Every trigram of "abcabd" occurs in row 0, but not the whole query
+        const QVector<QString> texts = { QStringLiteral("abca bcab cabd"), QStringLiteral("xabcabdx") };
+        TrigramIndex index;
+        index.build(texts);
+        QCOMPARE(index.search(QStringLiteral("abcabd")), (QVector<int>{ 1 }));
+        QCOMPARE(index.search(QStringLiteral("abc")), (QVector<int>{ 0, 1 }));
+        QVERIFY(index.search(QStringLiteral("zzz")).isEmpty());
+    }
+
+    void rowEdits()
+    {
+        QVector<QString> texts = { QStringLiteral("alpha"), QStringLiteral("beta"), QStringLiteral("gamma") };
+        TrigramIndex index;
+        index.build(texts);
+        QCOMPARE(index.search(QStringLiteral("mma")), (QVector<int>{ 2 }));
+
+        // Inserted rows shift the rows after them
+        index.insertRows(1, { QStringLiteral("Comma"), QStringLiteral("delta") });
+        texts.insert(1, QStringLiteral("Comma"));
+        texts.insert(2, QStringLiteral("delta"));
+        QCOMPARE(index.rowCount(), 5);
+        QCOMPARE(index.search(QStringLiteral("mma")), (QVector<int>{ 1, 4 }));
+        QCOMPARE(index.search(QStringLiteral("lta")), (QVector<int>{ 2 }));
+
+        index.updateRow(4, QStringLiteral("GAMUT"));
+        texts[4] = QStringLiteral("GAMUT");
+        QCOMPARE(index.search(QStringLiteral("mma")), (QVector<int>{ 1 }));
+        QCOMPARE(index.search(QStringLiteral("gamu")), (QVector<int>{ 4 }));
+
+        index.removeRows(0, 2);
+        texts.remove(0, 2);
+        QCOMPARE(index.rowCount(), 3);
+        QCOMPARE(index.search(QStringLiteral("lta")), (QVector<int>{ 0 }));
+        QCOMPARE(index.search(QStringLiteral("gam")), (QVector<int>{ 2 }));
+        QVERIFY(index.search(QStringLiteral("alp")).isEmpty());
+        QCOMPARE(index.search(QStringLiteral("a")), scan(texts, QStringLiteral("a")));
+    }
+
+    void compaction()
+    {
+        // Rewriting one row over and over kills enough documents to rebuild
+        TrigramIndex index;
+        index.build({ QStringLiteral("seed"), QStringLiteral("other") });
+        for (int i = 0; i < 50; ++i) {
+            index.updateRow(0, QStringLiteral("value %1").arg(i));
+        }
+        QCOMPARE(index.rowCount(), 2);
+        QCOMPARE(index.search(QStringLiteral("lue 49")), (QVector<int>{ 0 }));
+        QVERIFY(index.search(QStringLiteral("lue 48")).isEmpty());
+        QCOMPARE(index.search(QStringLiteral("oth")), (QVector<int>{ 1 }));
+    }
+
+    void randomEditsAgainstScan()
+    {
+        QRandomGenerator random(99);
+        QVector<QString> texts;
+        for (int i = 0; i < 200; ++i) {
+            texts.append(randomText(random, 12));
+        }
+        TrigramIndex index;
+        index.build(texts);
+
+        for (int step = 0; step < 2000; ++step) {
+            const int action = random.bounded(4);
+            if (action == 0 || texts.isEmpty()) {
+                const int first = random.bounded(int(texts.size()) + 1);
+                QVector<QString> inserted;
+                for (int n = random.bounded(1, 4); n > 0; --n) {
+                    inserted.append(randomText(random, 12));
+                }
+                index.insertRows(first, inserted);
+                for (int i = 0; i < inserted.size(); ++i) {
+                    texts.insert(first + i, inserted[i]);
+                }
+            } else if (action == 1) {
+                const int first = random.bounded(int(texts.size()));
+                const int count = qMin(random.bounded(1, 4), int(texts.size()) - first);
+                index.removeRows(first, count);
+                texts.remove(first, count);
+            } else if (action == 2) {
+                const int row = random.bounded(int(texts.size()));
+                texts[row] = randomText(random, 12);
+                index.updateRow(row, texts[row]);
+            } else {
+                const QString query = TrigramIndex::fold(randomText(random, 5));
+                QCOMPARE(index.search(query), scan(texts, query));
+            }
+            QCOMPARE(index.rowCount(), int(texts.size()));
+        }
+    }
+
+    void parallelBuild()
+    {
+        // Large enough to split the build over several pool tasks
+        QRandomGenerator random(7);
+        QVector<QString> texts;
+        for (int i = 0; i < 70000; ++i) {
+            texts.append(randomText(random, 10));
+        }
+        TrigramIndex index;
+        index.build(texts);
+        for (const QString& query : { QStringLiteral("abc"), QStringLiteral("cab d"), QStringLiteral("bb"),
+                                      QStringLiteral("aaaa") }) {
+            QCOMPARE(index.search(query), scan(texts, query));
+        }
+        QVERIFY(index.memoryUsage() > 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestTrigramIndex)
+#include "tst_trigramindex.moc"